@@ -0,0 +1,336 @@
+/*
+ISR Post -> Handler Latency Benchmark: flag polling vs hsm.h
+- The "ISR" is a SIGALRM handler fired every 500us by an interval timer;
+  like an interrupt it preempts the main loop at any point, including
+  in the middle of hsm_run(). Each firing posts a burst of events:
+  usually 1-2, one time in 16 a burst of 16-48 (bursty input).
+- Events: TICK 40%, DATA 40%, BUTTON 15%, PIN 5%, handled by the device
+  machine of statemachine.c (Locked / Unlocked { Idle, Sensing }); a DATA
+  event costs about 2us of work in Sensing.
+- Both loops sleep in sigsuspend() with the signal blocked between the
+  "anything to do?" check and the sleep, so neither misses a wakeup.
+    flags    volatile flags set by the ISR, polled like run_device_fsm()
+    hsm      hsm_post() from the ISR, hsm_run() in the loop
+- Reported: events posted / handled / lost, and post -> handler latency
+  percentiles. Events a flag loop coalesces count as lost; for hsm, lost
+  means a full queue. Deferred BUTTONs are measured until they are
+  finally handled.
+- Also the cost of post + run to completion with no signals, no clock
+  reads and no work in the handlers.
+*/
+
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include "hsm.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static volatile int sink;
+
+#define RUN_SECONDS 2
+#define TIMER_US 500
+#define MAX_SAMPLES (1 << 20)
+
+enum { SIG_TICK, SIG_DATA, SIG_BUTTON, SIG_PIN, SIG_COUNT };
+
+static uint64_t t0;                         // Post times are relative to this
+static uint32_t lat_ns[MAX_SAMPLES];
+static size_t lat_count;
+static bool timed = true;                   // false: handlers only count
+static volatile sig_atomic_t posted;        // Written by the ISR only
+static volatile sig_atomic_t done;
+
+static void record(uint32_t post_ns) {
+    if (!timed) {
+        lat_count++;
+        return;
+    }
+    if (lat_count < MAX_SAMPLES) lat_ns[lat_count++] = (uint32_t)(now_ns() - t0) - post_ns;
+}
+
+static void work(void) {
+    if (!timed) return;
+    uint64_t until = now_ns() + 2000;
+    while (now_ns() < until) {
+    }
+}
+
+static int random_sig(void) {
+    uint32_t r = xorshift32() % 100;
+    return r < 40 ? SIG_TICK : r < 80 ? SIG_DATA : r < 95 ? SIG_BUTTON : SIG_PIN;
+}
+
+static int burst_size(void) {
+    return xorshift32() % 16 == 0 ? 16 + (int)(xorshift32() % 33) : 1 + (int)(xorshift32() % 2);
+}
+
+// --- The device machine on hsm.h ---
+
+static hsm_t device;
+
+static hsm_result_t top_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t locked_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t unlocked_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t idle_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t sensing_handler(hsm_t *me, const hsm_event_t *e);
+
+static const hsm_state_t state_top, state_locked, state_unlocked, state_idle, state_sensing;
+
+static const hsm_state_t state_top      = { "Top",      NULL,            &state_locked, top_handler,      NULL, NULL };
+static const hsm_state_t state_locked   = { "Locked",   &state_top,      NULL,          locked_handler,   NULL, NULL };
+static const hsm_state_t state_unlocked = { "Unlocked", &state_top,      &state_idle,   unlocked_handler, NULL, NULL };
+static const hsm_state_t state_idle     = { "Idle",     &state_unlocked, NULL,          idle_handler,     NULL, NULL };
+static const hsm_state_t state_sensing  = { "Sensing",  &state_unlocked, NULL,          sensing_handler,  NULL, NULL };
+
+// Anything no state wants is ignored here, so every event is measured once
+static hsm_result_t top_handler(hsm_t *me, const hsm_event_t *e) {
+    (void)me;
+    record(e->param);
+    return HSM_HANDLED;
+}
+
+static hsm_result_t locked_handler(hsm_t *me, const hsm_event_t *e) {
+    if (e->sig != SIG_PIN) return HSM_UNHANDLED;
+    record(e->param);
+    hsm_transition(me, &state_unlocked);
+    return HSM_HANDLED;
+}
+
+static hsm_result_t unlocked_handler(hsm_t *me, const hsm_event_t *e) {
+    if (e->sig != SIG_BUTTON) return HSM_UNHANDLED;
+    record(e->param);
+    hsm_transition(me, &state_locked);
+    return HSM_HANDLED;
+}
+
+static hsm_result_t idle_handler(hsm_t *me, const hsm_event_t *e) {
+    if (e->sig != SIG_TICK) return HSM_UNHANDLED;
+    record(e->param);
+    hsm_transition(me, &state_sensing);
+    return HSM_HANDLED;
+}
+
+static hsm_result_t sensing_handler(hsm_t *me, const hsm_event_t *e) {
+    if (e->sig == SIG_BUTTON) return HSM_DEFERRED;
+    if (e->sig != SIG_DATA) return HSM_UNHANDLED;
+    work();
+    record(e->param);
+    hsm_transition(me, &state_idle);
+    return HSM_HANDLED;
+}
+
+static bool time_up(void);
+
+static void hsm_isr(int signo) {
+    (void)signo;
+    if (time_up()) return;
+    int n = burst_size();
+    for (int i = 0; i < n; i++) {
+        hsm_post(&device, (uint16_t)random_sig(), (uint32_t)(now_ns() - t0));
+    }
+    posted += n;
+}
+
+static void hsm_loop(const sigset_t *alrm) {
+    sigset_t old;
+    while (!done) {
+        hsm_run(&device);
+        sigprocmask(SIG_BLOCK, alrm, &old);
+        if (!hsm_pending(&device) && !done) sigsuspend(&old);
+        sigprocmask(SIG_SETMASK, &old, NULL);
+    }
+    hsm_run(&device);
+}
+
+// --- The same machine as run_device_fsm(): flags and a switch ---
+
+enum { FLAG_LOCKED, FLAG_IDLE, FLAG_SENSING };
+
+static volatile sig_atomic_t flag[SIG_COUNT];
+static volatile uint32_t flag_post_ns[SIG_COUNT];  // Earliest post since the flag was cleared
+static int flag_state;
+
+static void flag_isr(int signo) {
+    (void)signo;
+    if (time_up()) return;
+    int n = burst_size();
+    for (int i = 0; i < n; i++) {
+        int s = random_sig();
+        if (!flag[s]) {
+            flag_post_ns[s] = (uint32_t)(now_ns() - t0);
+            flag[s] = 1;
+        }
+    }
+    posted += n;
+}
+
+// Takes a flag if it is set; an ISR that fires in between is coalesced
+static bool take(int s) {
+    if (!flag[s]) return false;
+    flag[s] = 0;
+    record(flag_post_ns[s]);
+    return true;
+}
+
+static void run_flag_fsm(void) {
+    switch (flag_state) {
+        case FLAG_LOCKED:
+            if (take(SIG_PIN)) flag_state = FLAG_IDLE;
+            take(SIG_TICK);
+            take(SIG_DATA);
+            take(SIG_BUTTON);
+            break;
+        case FLAG_IDLE:
+            if (take(SIG_TICK)) flag_state = FLAG_SENSING;
+            else if (take(SIG_BUTTON)) flag_state = FLAG_LOCKED;
+            take(SIG_DATA);
+            take(SIG_PIN);
+            break;
+        case FLAG_SENSING:
+            if (take(SIG_DATA)) {
+                work();
+                flag_state = FLAG_IDLE;
+            }
+            take(SIG_TICK);
+            take(SIG_PIN);
+            break;  // BUTTON stays set until Idle
+    }
+}
+
+static bool flag_pending(void) {
+    for (int s = 0; s < SIG_COUNT; s++) {
+        if (flag[s] && !(s == SIG_BUTTON && flag_state == FLAG_SENSING)) return true;
+    }
+    return false;
+}
+
+static void flag_loop(const sigset_t *alrm) {
+    sigset_t old;
+    while (!done) {
+        run_flag_fsm();
+        sigprocmask(SIG_BLOCK, alrm, &old);
+        if (!flag_pending() && !done) sigsuspend(&old);
+        sigprocmask(SIG_SETMASK, &old, NULL);
+    }
+    while (flag_pending()) run_flag_fsm();
+}
+
+// --- Driver ---
+
+static uint64_t end_ns;                     // The ISR stops posting and sets 'done' after this
+
+static bool time_up(void) {
+    if (now_ns() - t0 < end_ns) return false;
+    done = 1;
+    return true;
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void set_timer(long us) {
+    struct itimerval it = { { 0, us }, { 0, us } };
+    setitimer(ITIMER_REAL, &it, NULL);
+}
+
+// Returns the number of events lost
+static size_t run_variant(const char *label, void (*isr)(int), void (*loop)(const sigset_t *),
+                          size_t (*parked)(void)) {
+    sigset_t alrm;
+    sigemptyset(&alrm);
+    sigaddset(&alrm, SIGALRM);
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = isr;
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGALRM, &sa, NULL);
+
+    rng_state = 0x12345678;
+    lat_count = 0;
+    posted = 0;
+    done = 0;
+    end_ns = (uint64_t)RUN_SECONDS * 1000000000ULL;
+    t0 = now_ns();
+    set_timer(TIMER_US);
+    loop(&alrm);
+    set_timer(0);
+
+    size_t handled = lat_count, waiting = parked();
+    size_t lost = (size_t)posted - handled - waiting;
+    qsort(lat_ns, lat_count, sizeof(uint32_t), cmp_u32);
+    printf("  %-6s posted %6d  handled %6zu  parked %zu  lost %5zu   latency us: p50 %6.1f  p99 %7.1f  max %7.1f\n",
+           label, (int)posted, handled, waiting, lost,
+           lat_count ? lat_ns[lat_count / 2] / 1e3 : 0.0,
+           lat_count ? lat_ns[lat_count * 99 / 100] / 1e3 : 0.0,
+           lat_count ? lat_ns[lat_count - 1] / 1e3 : 0.0);
+    return lost;
+}
+
+static size_t hsm_parked(void) {
+    return device.defer_count;
+}
+
+static size_t flag_parked(void) {
+    return flag[SIG_BUTTON] != 0;
+}
+
+// Cost of the queue itself: bursts posted and drained back to back
+static void bench_hot_path(void) {
+    const int bursts = 200000, burst = 32;
+    hsm_init(&device, &state_top, NULL);
+    timed = false;
+    lat_count = 0;
+    uint64_t start = now_ns();
+    unsigned dispatched = 0;
+    for (int b = 0; b < bursts; b++) {
+        for (int i = 0; i < burst; i++) {
+            hsm_post(&device, (uint16_t)random_sig(), 0);
+        }
+        dispatched += hsm_run(&device);
+    }
+    uint64_t elapsed = now_ns() - start;
+    timed = true;
+    // Recalled events are dispatched more than once, but handled once
+    printf("  post + run to completion: %.1f ns/dispatch (%u dispatches, %zu events)%s\n",
+           (double)elapsed / dispatched, dispatched, lat_count,
+           lat_count + device.defer_count + device.defer_dropped == (size_t)bursts * burst ? "" : "  MISMATCH");
+    sink = (int)dispatched;
+}
+
+int main(void) {
+    printf("--- ISR post -> handler latency, %ds, timer every %dus, bursts of 1-2 / 16-48 ---\n",
+           RUN_SECONDS, TIMER_US);
+
+    flag_state = FLAG_LOCKED;
+    run_variant("flags", flag_isr, flag_loop, flag_parked);
+
+    hsm_init(&device, &state_top, NULL);
+    size_t lost = run_variant("hsm", hsm_isr, hsm_loop, hsm_parked);
+    unsigned dropped = atomic_load(&device.dropped) + device.defer_dropped;
+    if (lost != dropped) printf("  MISMATCH: %zu lost, %u dropped by the queues\n", lost, dropped);
+
+    printf("--- Hot path ---\n");
+    bench_hot_path();
+    return 0;
+}
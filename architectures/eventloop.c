@@ -0,0 +1,121 @@
+#include <stddef.h>
+#include "eventloop.h"
+
+_Static_assert(EVLOOP_MAX_EVENTS == 32, "one pending bit per event in a 32-bit word");
+
+static void ignore_event(void *ctx) {
+    (void)ctx;
+}
+
+void evloop_init(evloop_t *loop, const evloop_port_t *port) {
+    atomic_init(&loop->pending, 0);
+    for (unsigned i = 0; i < EVLOOP_MAX_EVENTS; i++) {
+        loop->handlers[i] = ignore_event;
+        loop->ctx[i] = NULL;
+    }
+    for (unsigned i = 0; i < EVLOOP_MAX_TIMERS; i++) {
+        loop->timers[i].active = false;
+    }
+    loop->port = port;
+    loop->wakeups = 0;
+    loop->dispatched = 0;
+}
+
+bool evloop_on(evloop_t *loop, unsigned prio, evloop_handler_t handler, void *ctx) {
+    if (prio >= EVLOOP_MAX_EVENTS) return false;
+    loop->handlers[prio] = handler ? handler : ignore_event;
+    loop->ctx[prio] = ctx;
+    return true;
+}
+
+// --- Timers ---
+
+int evloop_timer_start(evloop_t *loop, unsigned prio, uint32_t delay_us, uint32_t period_us) {
+    if (prio >= EVLOOP_MAX_EVENTS) return -1;
+    for (int i = 0; i < EVLOOP_MAX_TIMERS; i++) {
+        evloop_timer_t *t = &loop->timers[i];
+        if (t->active) continue;
+        t->deadline = loop->port->now() + delay_us;
+        t->period = period_us;
+        t->prio = (uint8_t)prio;
+        t->active = true;
+        return i;
+    }
+    return -1;
+}
+
+void evloop_timer_stop(evloop_t *loop, int id) {
+    if (id >= 0 && id < EVLOOP_MAX_TIMERS) loop->timers[id].active = false;
+}
+
+uint64_t evloop_next_deadline(const evloop_t *loop) {
+    uint64_t next = EVLOOP_NO_DEADLINE;
+    for (int i = 0; i < EVLOOP_MAX_TIMERS; i++) {
+        const evloop_timer_t *t = &loop->timers[i];
+        if (t->active && t->deadline < next) next = t->deadline;
+    }
+    return next;
+}
+
+// Raises every expired timer's event; returns the bits it set
+static unsigned expire_timers(evloop_t *loop, uint64_t now) {
+    unsigned raised = 0;
+    for (int i = 0; i < EVLOOP_MAX_TIMERS; i++) {
+        evloop_timer_t *t = &loop->timers[i];
+        if (!t->active || t->deadline > now) continue;
+        raised |= 0x80000000u >> t->prio;
+        if (t->period == 0) {
+            t->active = false;
+            continue;
+        }
+        // Keep the phase; after a long stall skip missed periods instead of
+        // raising them back to back (they would coalesce anyway)
+        t->deadline += t->period;
+        if (t->deadline <= now) t->deadline += ((now - t->deadline) / t->period + 1) * t->period;
+    }
+    if (raised) atomic_fetch_or_explicit(&loop->pending, raised, memory_order_relaxed);
+    return raised;
+}
+
+// --- Loop ---
+
+unsigned evloop_dispatch(evloop_t *loop) {
+    unsigned n = 0;
+    expire_timers(loop, loop->port->now());
+    for (;;) {
+        unsigned word = atomic_load_explicit(&loop->pending, memory_order_acquire);
+        if (word == 0) break;
+        // CLZ on Cortex-M3 and up; the highest set bit is the most urgent event
+        unsigned prio = (unsigned)__builtin_clz(word);
+        // Clear before running: a post during the handler runs it again
+        atomic_fetch_and_explicit(&loop->pending, ~(0x80000000u >> prio), memory_order_acquire);
+        loop->handlers[prio](loop->ctx[prio]);
+        n++;
+        // A long handler may have let timers expire
+        expire_timers(loop, loop->port->now());
+    }
+    loop->dispatched += n;
+    return n;
+}
+
+void evloop_idle(evloop_t *loop) {
+    const evloop_port_t *port = loop->port;
+    port->irq_disable();
+    // With interrupts masked nothing can set a bit between this load and
+    // the sleep; one that is raised anyway ends the sleep immediately
+    if (atomic_load_explicit(&loop->pending, memory_order_acquire) == 0) {
+        uint64_t deadline = evloop_next_deadline(loop);
+        if (deadline == EVLOOP_NO_DEADLINE || deadline > port->now()) {
+            port->sleep(deadline);
+            loop->wakeups++;
+        }
+    }
+    port->irq_enable();
+}
+
+void evloop_run(evloop_t *loop) {
+    for (;;) {
+        evloop_dispatch(loop);
+        evloop_idle(loop);
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef EVENTLOOP_H
+#define EVENTLOOP_H
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Event-Driven Superloop
+ *
+ * ISRs set one bit per event in an atomic pending word. The loop takes
+ * the highest-priority bit with count-leading-zeros, clears it and runs
+ * its handler, then looks again, so a more urgent event that arrives
+ * meanwhile goes next. Setting a bit that is already set coalesces: the
+ * handler runs once and should drain whatever its source has queued.
+ *
+ * Software timers live in the loop (never touched by ISRs). When nothing
+ * is pending the loop masks interrupts, checks the word once more and
+ * only then sleeps until the nearest timer deadline (tickless: no
+ * periodic tick wakes the core). An interrupt that lands between the
+ * check and the sleep stays pending and ends the sleep at once, as WFI
+ * does with PRIMASK set.
+ */
+
+#define EVLOOP_MAX_EVENTS 32        // One bit each; priority 0 is the most urgent
+#define EVLOOP_MAX_TIMERS 8
+#define EVLOOP_NO_DEADLINE UINT64_MAX
+
+// Platform hooks; times are microseconds from any fixed origin
+typedef struct {
+    uint64_t (*now)(void);
+    void (*irq_disable)(void);
+    void (*irq_enable)(void);
+    // Called with interrupts disabled. Returns once an interrupt is pending
+    // or 'deadline' has passed, interrupts still disabled.
+    void (*sleep)(uint64_t deadline);
+} evloop_port_t;
+
+typedef void (*evloop_handler_t)(void *ctx);
+
+typedef struct {
+    uint64_t deadline;
+    uint32_t period;                // 0 = one-shot
+    uint8_t prio;                   // Event raised when it expires
+    bool active;
+} evloop_timer_t;
+
+typedef struct {
+    atomic_uint pending;            // Bit (31 - prio) per event
+    evloop_handler_t handlers[EVLOOP_MAX_EVENTS];
+    void *ctx[EVLOOP_MAX_EVENTS];
+    evloop_timer_t timers[EVLOOP_MAX_TIMERS];
+    const evloop_port_t *port;
+    uint32_t wakeups;               // Times the loop came back from sleep
+    uint32_t dispatched;            // Handler calls
+} evloop_t;
+
+void evloop_init(evloop_t *loop, const evloop_port_t *port);
+
+/**
+ * @brief Installs the handler for event 'prio' (0 = most urgent).
+ * @return false if 'prio' is out of range
+ */
+bool evloop_on(evloop_t *loop, unsigned prio, evloop_handler_t handler, void *ctx);
+
+/**
+ * @brief Marks event 'prio' pending. Lock-free: safe from any ISR.
+ *        'prio' must be below EVLOOP_MAX_EVENTS (the shift is undefined
+ *        past bit 0); it is not range-checked in release builds.
+ */
+static inline void evloop_signal(evloop_t *loop, unsigned prio) {
+    assert(prio < EVLOOP_MAX_EVENTS);
+    atomic_fetch_or_explicit(&loop->pending, 0x80000000u >> prio, memory_order_release);
+}
+
+/**
+ * @brief Raises event 'prio' after 'delay_us', then every 'period_us'
+ *        (0 = once). Loop context only (handlers, before evloop_run).
+ * @return Timer id, or -1 if all timers are in use
+ */
+int evloop_timer_start(evloop_t *loop, unsigned prio, uint32_t delay_us, uint32_t period_us);
+
+void evloop_timer_stop(evloop_t *loop, int id);
+
+// Earliest active timer deadline, or EVLOOP_NO_DEADLINE
+uint64_t evloop_next_deadline(const evloop_t *loop);
+
+/**
+ * @brief Raises expired timers, then runs handlers until the pending word
+ *        is empty, most urgent first.
+ * @return Number of handlers run
+ */
+unsigned evloop_dispatch(evloop_t *loop);
+
+/**
+ * @brief Sleeps until the next interrupt or timer deadline, unless an event
+ *        is already pending (checked with interrupts disabled).
+ */
+void evloop_idle(evloop_t *loop);
+
+// dispatch + idle forever; evloop_dispatch/evloop_idle for a custom loop
+void evloop_run(evloop_t *loop);
+
+#endif // EVENTLOOP_H
@@ -0,0 +1,208 @@
+#include <stddef.h>
+#include "hsm.h"
+
+#define HSM_QUEUE_MASK (HSM_QUEUE_CAP - 1)
+
+_Static_assert((HSM_QUEUE_CAP & HSM_QUEUE_MASK) == 0, "HSM_QUEUE_CAP must be a power of two");
+
+// --- Posted events: Vyukov ring, many producers, one consumer ---
+
+bool hsm_post(hsm_t *me, uint16_t sig, uint32_t param) {
+    unsigned pos = atomic_load_explicit(&me->enqueue_pos, memory_order_relaxed);
+    hsm_slot_t *slot;
+
+    for (;;) {
+        slot = &me->slots[pos & HSM_QUEUE_MASK];
+        unsigned seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int diff = (int)(seq - pos);
+
+        if (diff == 0) {
+            // Slot is free: try to claim position 'pos'
+            if (atomic_compare_exchange_weak_explicit(&me->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+            // CAS failed: 'pos' was reloaded with the winner's value, retry
+        } else if (diff < 0) {
+            // Slot still holds an event from the previous lap
+            atomic_fetch_add_explicit(&me->dropped, 1, memory_order_relaxed);
+            return false;
+        } else {
+            // Another producer (or an ISR that preempted us) claimed it first
+            pos = atomic_load_explicit(&me->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    slot->e.sig = sig;
+    slot->e.param = param;
+
+    // Publish: the consumer waits for seq == pos + 1
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return true;
+}
+
+// Only the main loop pops, so dequeue_pos needs no CAS
+static bool queue_pop(hsm_t *me, hsm_event_t *e) {
+    unsigned pos = me->dequeue_pos;
+    hsm_slot_t *slot = &me->slots[pos & HSM_QUEUE_MASK];
+
+    // A producer that claimed this slot but was preempted before publishing
+    // holds up the queue until it resumes; events behind it wait their turn
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos + 1) return false;
+
+    *e = slot->e;
+    me->dequeue_pos = pos + 1;
+
+    // Free the slot for the producer one lap ahead
+    atomic_store_explicit(&slot->seq, pos + HSM_QUEUE_CAP, memory_order_release);
+    return true;
+}
+
+// --- Deferred events: plain ring, consumer only ---
+
+static bool defer_push(hsm_t *me, const hsm_event_t *e) {
+    if (me->defer_count == HSM_DEFER_CAP) {
+        me->defer_dropped++;
+        return false;
+    }
+    me->deferred[(me->defer_head + me->defer_count) % HSM_DEFER_CAP] = *e;
+    me->defer_count++;
+    return true;
+}
+
+static hsm_event_t defer_pop(hsm_t *me) {
+    hsm_event_t e = me->deferred[me->defer_head];
+    me->defer_head = (me->defer_head + 1) % HSM_DEFER_CAP;
+    me->defer_count--;
+    return e;
+}
+
+// --- State tree ---
+
+static unsigned depth_of(const hsm_state_t *s) {
+    unsigned d = 0;
+    for (; s != NULL; s = s->parent) d++;
+    return d;
+}
+
+static bool is_ancestor_or_self(const hsm_state_t *a, const hsm_state_t *s) {
+    for (; s != NULL; s = s->parent) {
+        if (s == a) return true;
+    }
+    return false;
+}
+
+// Enters every state strictly below 'from' down to 'to', outermost first,
+// then follows initial children down to a leaf. Callers check that 'to'
+// is at most HSM_MAX_DEPTH deep, so the path always fits.
+static void enter_path(hsm_t *me, const hsm_state_t *from, const hsm_state_t *to) {
+    const hsm_state_t *path[HSM_MAX_DEPTH];
+    unsigned n = 0;
+    for (const hsm_state_t *s = to; s != from; s = s->parent) {
+        path[n++] = s;
+    }
+    while (n > 0) {
+        const hsm_state_t *s = path[--n];
+        me->state = s;
+        if (s->entry) s->entry(me);
+    }
+    while (me->state->initial != NULL) {
+        me->state = me->state->initial;
+        if (me->state->entry) me->state->entry(me);
+    }
+}
+
+// Transition taken by 'source' (the state whose handler asked for it).
+// Exits up to the lowest common ancestor of source and target; if one
+// contains the other, that state is exited and re-entered as well.
+static void take_transition(hsm_t *me, const hsm_state_t *source, const hsm_state_t *target) {
+    const hsm_state_t *a = source, *b = target;
+    unsigned da = depth_of(a), db = depth_of(b);
+    while (da > db) { a = a->parent; da--; }
+    while (db > da) { b = b->parent; db--; }
+    while (a != b) { a = a->parent; b = b->parent; }
+    const hsm_state_t *lca = a;
+    if (lca == source || lca == target) lca = lca->parent;
+
+    while (me->state != lca) {
+        const hsm_state_t *s = me->state;
+        if (s->exit) s->exit(me);
+        me->state = s->parent;
+    }
+    enter_path(me, lca, target);
+}
+
+void hsm_dispatch(hsm_t *me, const hsm_event_t *e) {
+    for (const hsm_state_t *s = me->state; s != NULL; s = s->parent) {
+        hsm_result_t r = s->handler ? s->handler(me, e) : HSM_UNHANDLED;
+        if (r == HSM_UNHANDLED) continue;
+        if (r == HSM_DEFERRED) defer_push(me, e);
+
+        const hsm_state_t *target = me->target;
+        me->target = NULL;          // Entry/exit actions post events instead
+        if (target != NULL && depth_of(target) > HSM_MAX_DEPTH) {
+            me->bad_transitions++;
+        } else if (target != NULL) {
+            take_transition(me, s, target);
+            // New state: everything parked so far gets another chance
+            me->recall = me->defer_count;
+        }
+        return;
+    }
+    // Nobody wanted it: dropped at the top
+}
+
+void hsm_transition(hsm_t *me, const hsm_state_t *target) {
+    me->target = target;
+}
+
+bool hsm_in(const hsm_t *me, const hsm_state_t *s) {
+    return is_ancestor_or_self(s, me->state);
+}
+
+// --- Main loop side ---
+
+bool hsm_init(hsm_t *me, const hsm_state_t *initial, void *ctx) {
+    if (depth_of(initial) > HSM_MAX_DEPTH) return false;
+    for (unsigned i = 0; i < HSM_QUEUE_CAP; i++) {
+        atomic_init(&me->slots[i].seq, i);
+    }
+    atomic_init(&me->enqueue_pos, 0);
+    me->dequeue_pos = 0;
+    me->defer_head = 0;
+    me->defer_count = 0;
+    me->recall = 0;
+    atomic_init(&me->dropped, 0);
+    me->defer_dropped = 0;
+    me->bad_transitions = 0;
+    me->ctx = ctx;
+    me->target = NULL;
+    me->state = NULL;
+    enter_path(me, NULL, initial);
+    me->target = NULL;
+    return true;
+}
+
+unsigned hsm_run(hsm_t *me) {
+    unsigned n = 0;
+    hsm_event_t e;
+    for (;;) {
+        // Recalled events go first: they arrived before anything still queued
+        if (me->recall > 0) {
+            me->recall--;
+            e = defer_pop(me);
+        } else if (!queue_pop(me, &e)) {
+            break;
+        }
+        hsm_dispatch(me, &e);
+        n++;
+    }
+    return n;
+}
+
+bool hsm_pending(const hsm_t *me) {
+    if (me->recall > 0) return true;
+    const hsm_slot_t *slot = &me->slots[me->dequeue_pos & HSM_QUEUE_MASK];
+    return atomic_load_explicit(&slot->seq, memory_order_acquire) == me->dequeue_pos + 1;
+}
@@ -0,0 +1,112 @@
+#ifndef HSM_H
+#define HSM_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Hierarchical State Machine Runtime
+ *
+ * States are const descriptors linked to their parent. An event goes to
+ * the current (innermost) state first; a handler that does not care
+ * returns HSM_UNHANDLED and the parent gets it, up to the top. A handler
+ * changes state with hsm_transition(): the runtime runs exit actions from
+ * the innermost state up to the common ancestor, then entry actions down
+ * to the target, then follows 'initial' children down to a leaf.
+ *
+ * ISRs never call handlers. They hsm_post() into a fixed-capacity
+ * lock-free ring (any number of producers, so nested ISRs are fine; one
+ * consumer), and the main loop drains it with hsm_run(), one event at a
+ * time, run to completion. A handler that cannot deal with an event yet
+ * returns HSM_DEFERRED: the event is parked and offered again, in order,
+ * after the next state change. Nothing here allocates.
+ */
+
+#define HSM_QUEUE_CAP 64            // Posted events in flight (power of two)
+#define HSM_DEFER_CAP 16            // Deferred events parked at once
+#define HSM_MAX_DEPTH 8             // Deepest nesting of states (deeper targets are refused)
+
+typedef struct {
+    uint16_t sig;
+    uint32_t param;
+} hsm_event_t;
+
+typedef enum {
+    HSM_HANDLED,                    // Consumed (with or without a transition)
+    HSM_UNHANDLED,                  // Offer it to the parent state
+    HSM_DEFERRED                    // Park it until the state changes
+} hsm_result_t;
+
+typedef struct hsm hsm_t;
+typedef struct hsm_state hsm_state_t;
+
+struct hsm_state {
+    const char *name;
+    const hsm_state_t *parent;      // NULL at the top
+    const hsm_state_t *initial;     // Child entered after this one, NULL for a leaf
+    hsm_result_t (*handler)(hsm_t *me, const hsm_event_t *e);  // NULL = handles nothing
+    void (*entry)(hsm_t *me);       // Optional
+    void (*exit)(hsm_t *me);        // Optional
+};
+
+// One ring slot: sequence number + event (see circularbuffer's MPMC queue)
+typedef struct {
+    atomic_uint seq;
+    hsm_event_t e;
+} hsm_slot_t;
+
+struct hsm {
+    const hsm_state_t *state;       // Current leaf
+    const hsm_state_t *target;      // Set by hsm_transition() during a handler
+    void *ctx;                      // User data
+
+    // Posted events: producers claim with a CAS, the one consumer just reads
+    _Alignas(64) atomic_uint enqueue_pos;
+    _Alignas(64) unsigned dequeue_pos;
+    hsm_slot_t slots[HSM_QUEUE_CAP];
+
+    // Deferred events: only touched by the consumer
+    hsm_event_t deferred[HSM_DEFER_CAP];
+    unsigned defer_head;
+    unsigned defer_count;
+    unsigned recall;                // Deferred events still to re-offer
+
+    atomic_uint dropped;            // Posts refused: queue full
+    unsigned defer_dropped;         // Deferrals refused: deferred queue full
+    unsigned bad_transitions;       // Transitions refused: target deeper than HSM_MAX_DEPTH
+};
+
+/**
+ * @brief Empties the queues and enters 'initial' (and its initial children).
+ * @return false (nothing entered) if 'initial' nests deeper than HSM_MAX_DEPTH
+ */
+bool hsm_init(hsm_t *me, const hsm_state_t *initial, void *ctx);
+
+/**
+ * @brief Queues an event. Lock-free: safe from ISRs and other threads.
+ * @return false (and counts a drop) if the queue is full
+ */
+bool hsm_post(hsm_t *me, uint16_t sig, uint32_t param);
+
+/**
+ * @brief Runs every queued event to completion, re-offering deferred events
+ *        after each state change. Main loop only.
+ * @return Number of events dispatched
+ */
+unsigned hsm_run(hsm_t *me);
+
+// Delivers one event right now, bypassing the queue (main loop only)
+void hsm_dispatch(hsm_t *me, const hsm_event_t *e);
+
+// From a handler: switch to 'target' once the handler returns. A target
+// nested deeper than HSM_MAX_DEPTH is not taken, just counted.
+void hsm_transition(hsm_t *me, const hsm_state_t *target);
+
+// True if 's' is the current state or one of its ancestors
+bool hsm_in(const hsm_t *me, const hsm_state_t *s);
+
+// True if a posted event is waiting (or a deferred one is due)
+bool hsm_pending(const hsm_t *me);
+
+#endif // HSM_H
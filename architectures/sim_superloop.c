@@ -0,0 +1,325 @@
+/*
+Superloop Simulation: flag polling vs eventloop.h
+- Host simulation of superloop.c. Signals play the interrupts and
+  sigprocmask() plays PRIMASK:
+    SIGALRM  hardware timer
+    SIGUSR1  button GPIO: a press every 30-130ms, each press 4 bounce
+             edges 200us apart
+- Both loops do the same jobs: a sensor reading every 100ms (200us of
+  work) and a debounced button (the press counts 20ms after its last
+  edge). Before sleeping both spend 20us gating clocks, as a real
+  go_to_sleep() would.
+    polling  superloop.c as it was: volatile flags checked in a fixed
+             order, then pause(). Its timer is a 1ms tick the loop counts,
+             since the debounce needs finer timing than the sensor period.
+             An edge that lands during the gating is slept through until
+             the next tick.
+    evloop   evloop_dispatch() / evloop_idle(): pending word, CLZ
+             priority, masked check before sigsuspend(), and the hardware
+             timer set one-shot to the next deadline (tickless)
+- Reported: wakeups per second, latency from each press's first unhandled
+  edge to the loop seeing it, and lateness of the sensor and debounce
+  jobs from their exact deadlines.
+*/
+
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <time.h>
+#include <unistd.h>
+#include "eventloop.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static volatile int sink;
+
+#define RUN_SECONDS 5
+#define TICK_US 1000
+#define SENSOR_PERIOD_US 100000
+#define SENSOR_WORK_US 200
+#define DEBOUNCE_US 20000
+#define GATING_US 20
+#define BOUNCE_EDGES 4
+#define BOUNCE_GAP_US 200
+#define MAX_SAMPLES 4096
+
+static void spin_us(uint64_t us) {
+    uint64_t until = now_ns() + us * 1000;
+    while (now_ns() < until) {
+    }
+}
+
+// --- Measurements ---
+
+typedef struct {
+    uint32_t us[MAX_SAMPLES];
+    size_t count;
+} samples_t;
+
+static samples_t edge_lat, sensor_late, debounce_late;
+static uint64_t t_start;
+static volatile sig_atomic_t done;
+static atomic_ullong first_edge_ns;         // First edge not seen by the loop yet
+static unsigned long wakeups, presses;
+
+static void sample(samples_t *s, uint64_t ns) {
+    if (s->count < MAX_SAMPLES) s->us[s->count++] = (uint32_t)(ns / 1000);
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void print_samples(const char *label, samples_t *s) {
+    qsort(s->us, s->count, sizeof(uint32_t), cmp_u32);
+    if (s->count == 0) {
+        printf("    %-17s no samples\n", label);
+        return;
+    }
+    printf("    %-17s p50 %5u us  p99 %5u us  max %5u us  (%zu)\n", label,
+           s->us[s->count / 2], s->us[s->count * 99 / 100], s->us[s->count - 1], s->count);
+}
+
+// --- Simulated interrupts and the shared jobs ---
+
+static timer_t hw_timer, button_timer;
+static sigset_t irq_set;
+static int edges_left;
+static void (*button_isr_body)(void);
+
+static void arm(timer_t t, uint64_t delay_us, uint64_t period_us) {
+    struct itimerspec its = {
+        { (time_t)(period_us / 1000000), (long)(period_us % 1000000) * 1000 },
+        { (time_t)(delay_us / 1000000), (long)(delay_us % 1000000) * 1000 },
+    };
+    timer_settime(t, 0, &its, NULL);
+}
+
+static void button_isr(int signo) {
+    (void)signo;
+    unsigned long long zero = 0;
+    atomic_compare_exchange_strong(&first_edge_ns, &zero, now_ns());
+    button_isr_body();
+
+    // Next bounce edge, or the next press
+    if (done) return;
+    if (--edges_left > 0) {
+        arm(button_timer, BOUNCE_GAP_US, 0);
+    } else {
+        edges_left = BOUNCE_EDGES;
+        arm(button_timer, 30000 + xorshift32() % 100000, 0);
+    }
+}
+
+// Loop saw an edge: returns the time the debounce should end
+static uint64_t handle_edge(void) {
+    uint64_t now = now_ns();
+    uint64_t first = atomic_exchange(&first_edge_ns, 0);
+    if (first) sample(&edge_lat, now - first);
+    return now + DEBOUNCE_US * 1000ULL;
+}
+
+static void handle_press(uint64_t due_ns) {
+    sample(&debounce_late, now_ns() - due_ns);
+    presses++;
+}
+
+static void handle_sensor(uint64_t due_ns) {
+    sample(&sensor_late, now_ns() - due_ns);
+    spin_us(SENSOR_WORK_US);
+    if (now_ns() - t_start >= (uint64_t)RUN_SECONDS * 1000000000ULL) done = 1;
+}
+
+// --- polling: superloop.c before the event loop ---
+
+static volatile bool timer_triggered = false;
+static volatile bool button_pressed = false;
+
+static void polling_timer_isr(int signo) {
+    (void)signo;
+    timer_triggered = true;
+}
+
+static void polling_button_body(void) {
+    button_pressed = true;
+}
+
+static void run_polling(void) {
+    uint64_t sensor_due = t_start + SENSOR_PERIOD_US * 1000ULL;
+    uint64_t debounce_due = 0;      // 0 = no press settling
+    arm(hw_timer, TICK_US, TICK_US);
+    while (!done) {
+        if (timer_triggered) {
+            timer_triggered = false;
+            uint64_t now = now_ns();
+            if (now >= sensor_due) {
+                handle_sensor(sensor_due);
+                sensor_due += SENSOR_PERIOD_US * 1000ULL;
+            }
+            if (debounce_due && now >= debounce_due) {
+                handle_press(debounce_due);
+                debounce_due = 0;
+            }
+        }
+        if (button_pressed) {
+            button_pressed = false;
+            debounce_due = handle_edge();
+        }
+        if (!timer_triggered && !button_pressed) {
+            spin_us(GATING_US);
+            pause();
+            wakeups++;
+        }
+    }
+}
+
+// --- evloop: superloop.c on eventloop.h ---
+
+enum { EV_BUTTON, EV_DEBOUNCE, EV_SENSOR };
+
+static evloop_t loop;
+static int sensor_timer, debounce_timer = -1;
+static uint64_t debounce_due;
+
+static uint64_t host_now(void) {
+    return now_ns() / 1000;
+}
+
+static void host_irq_disable(void) {
+    sigprocmask(SIG_BLOCK, &irq_set, NULL);
+}
+
+static void host_irq_enable(void) {
+    sigprocmask(SIG_UNBLOCK, &irq_set, NULL);
+}
+
+// Interrupts are masked here; sigsuspend() unmasks and waits in one step,
+// so a signal raised during the gating is taken at once, like WFI
+static void host_sleep(uint64_t deadline) {
+    spin_us(GATING_US);
+    if (deadline != EVLOOP_NO_DEADLINE) {
+        uint64_t now = host_now();
+        arm(hw_timer, deadline > now ? deadline - now : 1, 0);
+    }
+    sigset_t unmasked;
+    sigprocmask(SIG_SETMASK, NULL, &unmasked);
+    sigdelset(&unmasked, SIGALRM);
+    sigdelset(&unmasked, SIGUSR1);
+    sigsuspend(&unmasked);
+}
+
+static const evloop_port_t host_port = {
+    host_now, host_irq_disable, host_irq_enable, host_sleep
+};
+
+static void evloop_timer_isr(int signo) {
+    (void)signo;                // Only wakes the loop
+}
+
+static void evloop_button_body(void) {
+    evloop_signal(&loop, EV_BUTTON);
+}
+
+static void on_button(void *ctx) {
+    (void)ctx;
+    debounce_due = handle_edge();
+    evloop_timer_stop(&loop, debounce_timer);
+    debounce_timer = evloop_timer_start(&loop, EV_DEBOUNCE, DEBOUNCE_US, 0);
+}
+
+static void on_debounce(void *ctx) {
+    (void)ctx;
+    handle_press(debounce_due);
+    debounce_timer = -1;
+}
+
+static void on_sensor(void *ctx) {
+    (void)ctx;
+    const evloop_timer_t *t = &loop.timers[sensor_timer];
+    handle_sensor((t->deadline - t->period) * 1000);
+}
+
+static void run_evloop(void) {
+    evloop_init(&loop, &host_port);
+    evloop_on(&loop, EV_BUTTON, on_button, NULL);
+    evloop_on(&loop, EV_DEBOUNCE, on_debounce, NULL);
+    evloop_on(&loop, EV_SENSOR, on_sensor, NULL);
+    sensor_timer = evloop_timer_start(&loop, EV_SENSOR, SENSOR_PERIOD_US, SENSOR_PERIOD_US);
+    while (!done) {
+        evloop_dispatch(&loop);
+        evloop_idle(&loop);
+    }
+    wakeups = loop.wakeups;
+}
+
+// --- Driver ---
+
+static void run(const char *label, void (*timer_isr)(int), void (*button_body)(void), void (*body)(void)) {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_flags = SA_RESTART;
+    sa.sa_handler = timer_isr;
+    sigaction(SIGALRM, &sa, NULL);
+    sa.sa_handler = button_isr;
+    sigaction(SIGUSR1, &sa, NULL);
+    button_isr_body = button_body;
+
+    rng_state = 0x12345678;
+    edge_lat.count = sensor_late.count = debounce_late.count = 0;
+    wakeups = presses = 0;
+    done = 0;
+    atomic_store(&first_edge_ns, 0);
+    edges_left = BOUNCE_EDGES;
+    t_start = now_ns();
+    arm(button_timer, 30000, 0);
+
+    body();
+
+    arm(hw_timer, 0, 0);
+    arm(button_timer, 0, 0);
+    double seconds = (now_ns() - t_start) / 1e9;
+    printf("  %-8s %7.1f wakeups/s, %lu presses\n", label, wakeups / seconds, presses);
+    print_samples("edge latency", &edge_lat);
+    print_samples("sensor lateness", &sensor_late);
+    print_samples("debounce lateness", &debounce_late);
+}
+
+int main(void) {
+    // Default timer slack (50us) would dominate the lateness figures
+    prctl(PR_SET_TIMERSLACK, 1UL);
+    sigemptyset(&irq_set);
+    sigaddset(&irq_set, SIGALRM);
+    sigaddset(&irq_set, SIGUSR1);
+    struct sigevent sev;
+    memset(&sev, 0, sizeof(sev));
+    sev.sigev_notify = SIGEV_SIGNAL;
+    sev.sigev_signo = SIGALRM;
+    timer_create(CLOCK_MONOTONIC, &sev, &hw_timer);
+    sev.sigev_signo = SIGUSR1;
+    timer_create(CLOCK_MONOTONIC, &sev, &button_timer);
+
+    printf("--- Superloop: %ds, sensor every %dms, presses every 30-130ms x %d edges, %dms debounce ---\n",
+           RUN_SECONDS, SENSOR_PERIOD_US / 1000, BOUNCE_EDGES, DEBOUNCE_US / 1000);
+    run("polling", polling_timer_isr, polling_button_body, run_polling);
+    run("evloop", evloop_timer_isr, evloop_button_body, run_evloop);
+    sink = (int)wakeups;
+    return 0;
+}
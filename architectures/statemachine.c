@@ -2,86 +2,156 @@
 // Temp monitor device with added user authentication
 // (States required)
 //
+// ISRs only post events; the state machine runs them one at a time in
+// the main loop (hsm.h). A button press while a reading is in progress
+// is deferred until the reading is done instead of being lost.
+//
+//   Locked
+//   Unlocked          BUTTON -> Locked (manual relock)
+//     Idle            TICK -> Sensing
+//     Sensing         SENSOR_OK -> Idle, SENSOR_FAIL -> Error, BUTTON deferred
+//   Error             RESET_DONE -> Locked
+//
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
-
-// Global flags (volatile because they change in ISR)
-volatile bool timer_triggered = false;
-volatile bool button_pressed = false;
+#include "hsm.h"
 
 // Mock function prototypes
 void hardware_init(void);
-void read_sensor(void);
-void update_display(void);
-void process_button_event(void);
-void go_to_sleep(void);
+bool is_correct_pin_entered(void);
+void start_sensor_read(void);       // Raises Sensor_ISR when the reading is done
+bool read_sensor_success(void);
+void update_display_text(const char *text);
+void update_display_data(void);
+void handle_system_reset(void);
+void irq_disable(void);                     // __disable_irq()
+void irq_enable(void);                      // __enable_irq()
+void wait_for_interrupt(void);              // __WFI(): wakes on a pending IRQ even while masked
+
+enum {
+    SIG_TICK,
+    SIG_BUTTON,
+    SIG_PIN_OK,
+    SIG_SENSOR_OK,
+    SIG_SENSOR_FAIL,
+    SIG_RESET_DONE
+};
+
+static hsm_t device;
 
 // This runs every 100ms via a hardware timer interrupt
 void Timer_ISR(void) {
-    timer_triggered = true; 
+    hsm_post(&device, SIG_TICK, 0);
 }
 
 // This runs when a physical button is pressed
 void GPIO_Button_ISR(void) {
-    button_pressed = true;
+    hsm_post(&device, SIG_BUTTON, 0);
+}
+
+// This runs when a key is entered on the keypad
+void Keypad_ISR(void) {
+    if (is_correct_pin_entered()) hsm_post(&device, SIG_PIN_OK, 0);
+}
+
+// This runs when the sensor has a reading ready
+void Sensor_ISR(void) {
+    hsm_post(&device, read_sensor_success() ? SIG_SENSOR_OK : SIG_SENSOR_FAIL, 0);
+}
+
+static hsm_result_t locked_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t unlocked_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t idle_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t sensing_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t error_handler(hsm_t *me, const hsm_event_t *e);
+static void unlocked_entry(hsm_t *me);
+static void sensing_entry(hsm_t *me);
+static void error_entry(hsm_t *me);
+
+static const hsm_state_t state_locked, state_unlocked, state_idle, state_sensing, state_error;
+
+static const hsm_state_t state_locked   = { "Locked",   NULL,            NULL,        locked_handler,   NULL,           NULL };
+static const hsm_state_t state_unlocked = { "Unlocked", NULL,            &state_idle, unlocked_handler, unlocked_entry, NULL };
+static const hsm_state_t state_idle     = { "Idle",     &state_unlocked, NULL,        idle_handler,     NULL,           NULL };
+static const hsm_state_t state_sensing  = { "Sensing",  &state_unlocked, NULL,        sensing_handler,  sensing_entry,  NULL };
+static const hsm_state_t state_error    = { "Error",    NULL,            NULL,        error_handler,    error_entry,    NULL };
+
+static hsm_result_t locked_handler(hsm_t *me, const hsm_event_t *e) {
+    if (e->sig != SIG_PIN_OK) return HSM_UNHANDLED;
+    hsm_transition(me, &state_unlocked);
+    return HSM_HANDLED;
 }
 
-typedef enum {
-    STATE_LOCKED,      // Device is waiting for a PIN
-    STATE_IDLE,        // Device is unlocked, waiting for timer
-    STATE_SENSING,     // Currently reading/processing data
-    STATE_ERROR        // Something went wrong (e.g., sensor failure)
-} DeviceState_t;
-
-// Variable to track current state
-DeviceState_t current_state = STATE_LOCKED;
-
-void run_device_fsm(void) {
-    switch (current_state) {
-        
-        case STATE_LOCKED:
-            if (is_correct_pin_entered()) {
-                update_display_text("Unlocked");
-                current_state = STATE_IDLE; // Transition
-            }
-            break;
-
-        case STATE_IDLE:
-            if (timer_triggered) {
-                timer_triggered = false;
-                current_state = STATE_SENSING; // Transition
-            }
-            if (button_pressed) {
-                button_pressed = false;
-                current_state = STATE_LOCKED; // Manual Relock
-            }
-            break;
-
-        case STATE_SENSING:
-            if (read_sensor_success()) {
-                update_display_data();
-                current_state = STATE_IDLE; // Return to IDLE
-            } else {
-                current_state = STATE_ERROR; // Handle Failure
-            }
-            break;
-
-        case STATE_ERROR:
-            handle_system_reset();
-            current_state = STATE_LOCKED;
-            break;
+static void unlocked_entry(hsm_t *me) {
+    (void)me;
+    update_display_text("Unlocked");
+}
+
+static hsm_result_t unlocked_handler(hsm_t *me, const hsm_event_t *e) {
+    if (e->sig != SIG_BUTTON) return HSM_UNHANDLED;
+    hsm_transition(me, &state_locked);  // Manual Relock
+    return HSM_HANDLED;
+}
+
+static hsm_result_t idle_handler(hsm_t *me, const hsm_event_t *e) {
+    if (e->sig != SIG_TICK) return HSM_UNHANDLED;
+    hsm_transition(me, &state_sensing);
+    return HSM_HANDLED;
+}
+
+static void sensing_entry(hsm_t *me) {
+    (void)me;
+    start_sensor_read();
+}
+
+static hsm_result_t sensing_handler(hsm_t *me, const hsm_event_t *e) {
+    switch (e->sig) {
+        case SIG_SENSOR_OK:
+            update_display_data();
+            hsm_transition(me, &state_idle);    // Return to IDLE
+            return HSM_HANDLED;
+        case SIG_SENSOR_FAIL:
+            hsm_transition(me, &state_error);   // Handle Failure
+            return HSM_HANDLED;
+        case SIG_BUTTON:
+            return HSM_DEFERRED;                // Relock once the reading is done
+        case SIG_TICK:
+            return HSM_HANDLED;                 // A reading is already running
+        default:
+            return HSM_UNHANDLED;
     }
 }
 
+static void error_entry(hsm_t *me) {
+    handle_system_reset();
+    hsm_post(me, SIG_RESET_DONE, 0);
+}
+
+static hsm_result_t error_handler(hsm_t *me, const hsm_event_t *e) {
+    if (e->sig != SIG_RESET_DONE) return HSM_UNHANDLED;
+    hsm_transition(me, &state_locked);
+    return HSM_HANDLED;
+}
+
 int main(void) {
+    // Queue ready before hardware_init() unmasks the ISRs that post to it
+    if (!hsm_init(&device, &state_locked, NULL)) {
+        while (1) {}                    // State tree nests too deep: fix the build
+    }
     hardware_init();
 
     while (1) {
         // The FSM manages the "Brain" of the device
-        run_device_fsm();
+        hsm_run(&device);
 
-        // Optional: Low-power mode (Sleep until next interrupt)
-        enter_low_power_mode(); 
+        // Low-power mode until the next interrupt. Checked with interrupts
+        // masked: an event posted after the check still ends the WFI
+        irq_disable();
+        if (!hsm_pending(&device)) {
+            wait_for_interrupt();
+        }
+        irq_enable();
     }
-}
\ No newline at end of file
+}
@@ -1,54 +1,79 @@
 //
 // Temp monitor device with a display
-// 
+//
+// ISRs only mark events pending (eventloop.h); the loop runs the most
+// urgent one first and sleeps with interrupts masked, so a button press
+// that lands just before the sleep is never missed. The sensor period is
+// a loop timer, so between readings nothing wakes the core.
+//
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
-
-// Global flags (volatile because they change in ISR)
-volatile bool timer_triggered = false;
-volatile bool button_pressed = false;
+#include "eventloop.h"
 
 // Mock function prototypes
 void hardware_init(void);
 void read_sensor(void);
 void update_display(void);
 void process_button_event(void);
-void go_to_sleep(void);
+uint64_t rtc_now_us(void);                  // Free-running low-power timer
+void rtc_set_wakeup(uint64_t deadline_us);  // One-shot compare, EVLOOP_NO_DEADLINE = off
+void irq_disable(void);                     // __disable_irq()
+void irq_enable(void);                      // __enable_irq()
+void wait_for_interrupt(void);              // __WFI(): wakes on a pending IRQ even while masked
+
+#define SENSOR_PERIOD_US 100000
 
-// This runs every 100ms via a hardware timer interrupt
-void Timer_ISR(void) {
-    timer_triggered = true; 
+// Priority order: lower number runs first
+enum {
+    EV_BUTTON,
+    EV_SENSOR
+};
+
+static evloop_t loop;
+
+static void port_sleep(uint64_t deadline) {
+    rtc_set_wakeup(deadline);
+    wait_for_interrupt();
 }
 
+static const evloop_port_t port = {
+    rtc_now_us, irq_disable, irq_enable, port_sleep
+};
+
 // This runs when a physical button is pressed
 void GPIO_Button_ISR(void) {
-    button_pressed = true;
+    evloop_signal(&loop, EV_BUTTON);
+}
+
+// The RTC compare interrupt only wakes the core; the loop checks its timers
+void RTC_Wakeup_ISR(void) {
+}
+
+static void on_sensor(void *ctx) {
+    (void)ctx;
+    read_sensor();
+    update_display();
+}
+
+static void on_button(void *ctx) {
+    (void)ctx;
+    process_button_event();
 }
 
 int main(void) {
+    // Loop and handlers ready before hardware_init() unmasks GPIO_Button_ISR
+    evloop_init(&loop, &port);
+    evloop_on(&loop, EV_BUTTON, on_button, NULL);
+    evloop_on(&loop, EV_SENSOR, on_sensor, NULL);
     hardware_init();
 
-    while (1) {
-        // 1. Task: Periodic Sensor Reading
-        if (timer_triggered) {
-            timer_triggered = false; // Reset flag
-            read_sensor();
-            update_display();
-        }
-
-        // 2. Task: Asynchronous User Input
-        if (button_pressed) {
-            button_pressed = false; // Reset flag
-            process_button_event();
-        }
-
-        // 3. Optional: Power Management
-        // If no flags are set, the CPU can "Wait For Interrupt" (WFI)
-        if (!timer_triggered && !button_pressed) {
-            go_to_sleep(); 
-        }
-    }
+    // Needs the RTC that hardware_init() starts
+    evloop_timer_start(&loop, EV_SENSOR, SENSOR_PERIOD_US, SENSOR_PERIOD_US);
+
+    // Runs ready handlers, then sleeps until the next IRQ or sensor deadline
+    evloop_run(&loop);
 
     return 0; // Never reached
-}
\ No newline at end of file
+}
@@ -0,0 +1,321 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "hsm.h"
+#include "eventloop.h"
+
+// --- Test Harness ---
+
+static int total_failures = 0;
+
+void run_test(int num, const char* desc, bool passed) {
+    if (passed) {
+        printf("[PASS] Test %d: %s\n", num, desc);
+    } else {
+        printf("[FAIL] Test %d: %s\n", num, desc);
+        total_failures++;
+    }
+}
+
+// --- HSM Helpers ---
+//
+//   a                 1 -> a2, 2 -> a, 3 -> b, LOG handled
+//     a1
+//       a11           4 -> a11 (self), 6 -> a2
+//     a2
+//   b                 LOG deferred, 5 -> a, 7 -> c
+//   c                 LOG deferred, 5 -> a
+
+enum { SIG_LOG = 9 };
+
+static char trace[256];        // Entry/exit actions, in order
+static char handled[64];       // LOG params handled, in order
+
+static void note(const char *s) {
+    strcat(trace, s);
+    strcat(trace, " ");
+}
+
+#define ACTIONS(n) \
+    static void n##_entry(hsm_t *me) { (void)me; note("+" #n); } \
+    static void n##_exit(hsm_t *me) { (void)me; note("-" #n); }
+
+ACTIONS(a)
+ACTIONS(a1)
+ACTIONS(a11)
+ACTIONS(a2)
+ACTIONS(b)
+ACTIONS(c)
+
+static hsm_result_t a_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t a11_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t b_handler(hsm_t *me, const hsm_event_t *e);
+static hsm_result_t c_handler(hsm_t *me, const hsm_event_t *e);
+
+static const hsm_state_t state_a1, state_a11, state_a2;
+static const hsm_state_t state_a   = { "a",   NULL,      &state_a1,  a_handler,   a_entry,   a_exit };
+static const hsm_state_t state_a1  = { "a1",  &state_a,  &state_a11, NULL,        a1_entry,  a1_exit };
+static const hsm_state_t state_a11 = { "a11", &state_a1, NULL,       a11_handler, a11_entry, a11_exit };
+static const hsm_state_t state_a2  = { "a2",  &state_a,  NULL,       NULL,        a2_entry,  a2_exit };
+static const hsm_state_t state_b   = { "b",   NULL,      NULL,       b_handler,   b_entry,   b_exit };
+static const hsm_state_t state_c   = { "c",   NULL,      NULL,       c_handler,   c_entry,   c_exit };
+
+static hsm_result_t a_handler(hsm_t *me, const hsm_event_t *e) {
+    switch (e->sig) {
+        case 1: hsm_transition(me, &state_a2); return HSM_HANDLED;
+        case 2: hsm_transition(me, &state_a); return HSM_HANDLED;
+        case 3: hsm_transition(me, &state_b); return HSM_HANDLED;
+        case SIG_LOG: {
+            size_t len = strlen(handled);
+            handled[len] = (char)('a' + e->param);
+            handled[len + 1] = '\0';
+            return HSM_HANDLED;
+        }
+        default: return HSM_UNHANDLED;
+    }
+}
+
+static hsm_result_t a11_handler(hsm_t *me, const hsm_event_t *e) {
+    switch (e->sig) {
+        case 4: hsm_transition(me, &state_a11); return HSM_HANDLED;
+        case 6: hsm_transition(me, &state_a2); return HSM_HANDLED;
+        default: return HSM_UNHANDLED;
+    }
+}
+
+static hsm_result_t b_handler(hsm_t *me, const hsm_event_t *e) {
+    switch (e->sig) {
+        case SIG_LOG: return HSM_DEFERRED;
+        case 5: hsm_transition(me, &state_a); return HSM_HANDLED;
+        case 7: hsm_transition(me, &state_c); return HSM_HANDLED;
+        default: return HSM_UNHANDLED;
+    }
+}
+
+static hsm_result_t c_handler(hsm_t *me, const hsm_event_t *e) {
+    switch (e->sig) {
+        case SIG_LOG: return HSM_DEFERRED;
+        case 5: hsm_transition(me, &state_a); return HSM_HANDLED;
+        default: return HSM_UNHANDLED;
+    }
+}
+
+static hsm_t sm;
+
+// Posts 'sig', runs the queue and returns the entry/exit trace
+static const char *step(uint16_t sig) {
+    trace[0] = '\0';
+    hsm_post(&sm, sig, 0);
+    hsm_run(&sm);
+    return trace;
+}
+
+// One state per level, each the parent of the next; signal 8 transitions
+// to the state in ctx
+static hsm_state_t deep[HSM_MAX_DEPTH + 1];
+
+static hsm_result_t deep_handler(hsm_t *me, const hsm_event_t *e) {
+    if (e->sig != 8) return HSM_UNHANDLED;
+    hsm_transition(me, (const hsm_state_t *)me->ctx);
+    return HSM_HANDLED;
+}
+
+// --- Event Loop Helpers ---
+
+// Fake port: time only moves when the loop sleeps
+static uint64_t fake_now;
+static uint64_t wake_late;      // How far past its deadline a sleep returns
+static int irq_masked;
+static int sleeps;
+static bool slept_unmasked;
+static uint64_t slept_until;
+
+static uint64_t fake_time(void) { return fake_now; }
+static void fake_irq_disable(void) { irq_masked++; }
+static void fake_irq_enable(void) { irq_masked--; }
+
+static void fake_sleep(uint64_t deadline) {
+    sleeps++;
+    slept_unmasked |= irq_masked != 1;
+    slept_until = deadline;
+    if (deadline != EVLOOP_NO_DEADLINE) fake_now = deadline + wake_late;
+}
+
+static const evloop_port_t fake_port = { fake_time, fake_irq_disable, fake_irq_enable, fake_sleep };
+
+static evloop_t loop;
+static char ran[64];            // Event numbers, in the order they ran
+
+static void log_event(void *ctx) {
+    unsigned prio = (unsigned)(uintptr_t)ctx;
+    size_t len = strlen(ran);
+    ran[len] = (char)('0' + prio);
+    ran[len + 1] = '\0';
+    // Event 5 raises the more urgent event 1 while it runs
+    if (prio == 5) evloop_signal(&loop, 1);
+}
+
+static void loop_reset(void) {
+    evloop_init(&loop, &fake_port);
+    for (unsigned i = 0; i < 10; i++) evloop_on(&loop, i, log_event, (void *)(uintptr_t)i);
+    fake_now = 0;
+    wake_late = 0;
+    sleeps = 0;
+    slept_unmasked = false;
+    ran[0] = '\0';
+}
+
+// --- Main Test Suite ---
+
+int main() {
+    printf("--- Starting HSM / Event Loop Test Suite ---\n");
+
+    // Test 1: Initial state and its initial children, outermost first
+    trace[0] = '\0';
+    hsm_init(&sm, &state_a, NULL);
+    run_test(1, "Init descends initial children to a leaf",
+             strcmp(trace, "+a +a1 +a11 ") == 0 && sm.state == &state_a11);
+
+    // Test 2: a11 -> a2 exits up to the common ancestor a, which stays
+    run_test(2, "Sibling transition exits and enters below the LCA",
+             strcmp(step(6), "-a11 -a1 +a2 ") == 0 && sm.state == &state_a2);
+
+    // Test 3: a (handling for a2) -> a: a is left and re-entered, then its
+    // initial path is taken again
+    run_test(3, "Transition to an ancestor exits and re-enters it",
+             strcmp(step(2), "-a2 -a +a +a1 +a11 ") == 0 && sm.state == &state_a11);
+
+    // Test 4: a -> a2, handled by the ancestor on behalf of a11
+    run_test(4, "Transition from an ancestor to its child",
+             strcmp(step(1), "-a11 -a1 -a +a +a2 ") == 0 && sm.state == &state_a2);
+
+    // Test 5: Self-transition
+    step(2);
+    run_test(5, "Self-transition exits and re-enters the state",
+             strcmp(step(4), "-a11 +a11 ") == 0 && sm.state == &state_a11 &&
+             hsm_in(&sm, &state_a) && hsm_in(&sm, &state_a1) && !hsm_in(&sm, &state_b));
+
+    // Test 6: b parks LOG events; c parks them again, still in order
+    step(3);
+    hsm_post(&sm, SIG_LOG, 0);
+    hsm_post(&sm, SIG_LOG, 1);
+    hsm_post(&sm, 7, 0);
+    hsm_post(&sm, SIG_LOG, 2);
+    hsm_run(&sm);
+    run_test(6, "Deferred events re-deferred by the next state",
+             sm.state == &state_c && sm.defer_count == 3 && handled[0] == '\0' && !hsm_pending(&sm));
+
+    // Test 7: In a they are recalled in arrival order, ahead of later posts
+    hsm_post(&sm, 5, 0);
+    hsm_post(&sm, SIG_LOG, 3);
+    unsigned n = hsm_run(&sm);
+    run_test(7, "Deferred events recalled in order after the state change",
+             sm.state == &state_a11 && strcmp(handled, "abcd") == 0 && sm.defer_count == 0 && n == 5);
+
+    // Test 8: Posts past HSM_QUEUE_CAP are refused and counted
+    unsigned accepted = 0;
+    for (unsigned i = 0; i < HSM_QUEUE_CAP + 36; i++) accepted += hsm_post(&sm, 100, i);
+    bool pending = hsm_pending(&sm);
+    n = hsm_run(&sm);
+    run_test(8, "Full queue drops and counts posts",
+             pending && accepted == HSM_QUEUE_CAP && atomic_load(&sm.dropped) == 36 &&
+             n == HSM_QUEUE_CAP && !hsm_pending(&sm));
+
+    // Test 9: Deferrals past HSM_DEFER_CAP are dropped and counted
+    step(3);
+    handled[0] = '\0';
+    for (unsigned i = 0; i < HSM_DEFER_CAP + 4; i++) hsm_post(&sm, SIG_LOG, i);
+    hsm_run(&sm);
+    bool full = sm.defer_count == HSM_DEFER_CAP && sm.defer_dropped == 4;
+    step(5);
+    run_test(9, "Full deferred queue drops and counts deferrals",
+             full && strcmp(handled, "abcdefghijklmnop") == 0 && sm.defer_count == 0);
+
+    // Test 10: Nesting past HSM_MAX_DEPTH is refused, in release builds too
+    for (unsigned i = 0; i <= HSM_MAX_DEPTH; i++) {
+        deep[i] = (hsm_state_t){ "deep", i > 0 ? &deep[i - 1] : NULL, NULL, deep_handler, NULL, NULL };
+    }
+    static hsm_t deep_sm;
+    bool refused = !hsm_init(&deep_sm, &deep[HSM_MAX_DEPTH], NULL);
+    bool entered = hsm_init(&deep_sm, &deep[HSM_MAX_DEPTH - 1], (void *)&deep[HSM_MAX_DEPTH]);
+    hsm_post(&deep_sm, 8, 0);
+    hsm_run(&deep_sm);
+    bool stayed = deep_sm.state == &deep[HSM_MAX_DEPTH - 1] && deep_sm.bad_transitions == 1;
+    deep_sm.ctx = (void *)&deep[0];
+    hsm_post(&deep_sm, 8, 0);
+    hsm_run(&deep_sm);
+    run_test(10, "Too-deep initial state / transition target is refused and counted",
+             refused && entered && stayed && deep_sm.state == &deep[0] && deep_sm.bad_transitions == 1);
+
+    // Test 11: Most urgent (lowest number) first, whatever the signal order
+    loop_reset();
+    evloop_signal(&loop, 7);
+    evloop_signal(&loop, 3);
+    evloop_signal(&loop, 0);
+    n = evloop_dispatch(&loop);
+    run_test(11, "Events run in priority order", strcmp(ran, "037") == 0 && n == 3);
+
+    // Test 12: Signals of a pending event coalesce
+    loop_reset();
+    evloop_signal(&loop, 4);
+    evloop_signal(&loop, 4);
+    evloop_signal(&loop, 4);
+    n = evloop_dispatch(&loop);
+    run_test(12, "Repeated signals coalesce into one run",
+             strcmp(ran, "4") == 0 && n == 1 && loop.dispatched == 1);
+
+    // Test 13: 1 is raised by 5's handler and runs before the waiting 7
+    loop_reset();
+    evloop_signal(&loop, 7);
+    evloop_signal(&loop, 5);
+    evloop_dispatch(&loop);
+    run_test(13, "Event raised mid-handler is dispatched next", strcmp(ran, "517") == 0);
+
+    // Test 14: Waking late does not shift a periodic timer
+    loop_reset();
+    evloop_timer_start(&loop, 2, 1000, 500);
+    wake_late = 30;
+    evloop_idle(&loop);
+    uint64_t first_sleep = slept_until;
+    evloop_dispatch(&loop);
+    evloop_idle(&loop);
+    uint64_t second_sleep = slept_until;
+    evloop_dispatch(&loop);
+    run_test(14, "Periodic timer keeps its phase",
+             first_sleep == 1000 && second_sleep == 1500 && strcmp(ran, "22") == 0 &&
+             evloop_next_deadline(&loop) == 2000 && loop.wakeups == 2 && !slept_unmasked);
+
+    // Test 15: After a stall it runs once and stays on the 500us grid
+    ran[0] = '\0';
+    fake_now = 10120;
+    evloop_dispatch(&loop);
+    run_test(15, "Missed periods are skipped, not replayed",
+             strcmp(ran, "2") == 0 && evloop_next_deadline(&loop) == 10500);
+
+    // Test 16: Pending event or expired timer: idle returns without sleeping
+    loop_reset();
+    evloop_signal(&loop, 3);
+    evloop_idle(&loop);
+    bool pending_kept = sleeps == 0 && irq_masked == 0 && atomic_load(&loop.pending) != 0;
+    evloop_dispatch(&loop);
+    evloop_timer_start(&loop, 6, 0, 0);
+    evloop_idle(&loop);
+    run_test(16, "Idle does not sleep with work pending",
+             pending_kept && sleeps == 0 && irq_masked == 0 && loop.wakeups == 0);
+
+    // Test 17: Priorities past EVLOOP_MAX_EVENTS are refused
+    run_test(17, "Out-of-range priority refused",
+             !evloop_on(&loop, EVLOOP_MAX_EVENTS, log_event, NULL) &&
+             evloop_timer_start(&loop, EVLOOP_MAX_EVENTS, 100, 0) == -1);
+
+    printf("\n------------------------------------------\n");
+    if (total_failures == 0) {
+        printf("RESULT: ALL TESTS PASSED ✅\n");
+    } else {
+        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
+    }
+    printf("------------------------------------------\n");
+
+    return (total_failures > 0) ? 1 : 0;
+}
@@ -0,0 +1,331 @@
+/*
+Bitset / Roaring Benchmark
+- Data sets over 2^26 channel IDs (two of each, for union / intersection):
+    sparse     200k random IDs (0.3% of the range)
+    dense      2M random IDs in the first 4M (50%)
+    clustered  ~2M IDs in runs of 100..2000, gaps of 1k..100k
+- Structures:
+    roaring_t (after roaring_optimize()), bitset_t,
+    std::vector<bool> sized to the range, std::set<uint32_t>
+- Per structure: memory, build (insert every ID), contains, union,
+  intersection, rank, select and iterating every member.
+std::set memory is estimated at 48 bytes per node (40-byte node + malloc
+header). The last line is the sparse set spread over the full 2^32 range,
+where only roaring is practical (a flat bitmap is 512 MB).
+*/
+
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+#include <set>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include "bitset.h"
+#include "roaring.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static volatile uint64_t sink;
+
+static const uint32_t UNIVERSE = 1u << 26;
+static const int QUERIES = 200000;
+static const int SLOW_QUERIES = 50;         // O(n) rank / select on std containers
+
+struct Row {
+    double memory_kb;
+    double build_mps;       // Million IDs inserted per second
+    double contains_ns;
+    double or_ms;
+    double and_ms;
+    double rank_ns;
+    double select_ns;
+    double iterate_mps;     // Million members visited per second
+};
+
+static std::vector<uint32_t> make_sparse(uint32_t universe) {
+    std::vector<uint32_t> ids(200000);
+    for (auto &id : ids) id = xorshift32() % universe;
+    return ids;
+}
+
+static std::vector<uint32_t> make_dense(void) {
+    std::vector<uint32_t> ids(2000000);
+    for (auto &id : ids) id = xorshift32() % (4u << 20);
+    return ids;
+}
+
+static std::vector<uint32_t> make_clustered(void) {
+    std::vector<uint32_t> ids;
+    uint32_t v = xorshift32() % 100000;
+    while (ids.size() < 2000000 && v < UNIVERSE - 2000) {
+        uint32_t len = 100 + xorshift32() % 1900;
+        for (uint32_t i = 0; i < len; i++) ids.push_back(v + i);
+        v += len + 1000 + xorshift32() % 99000;
+    }
+    return ids;
+}
+
+static void print_row(const char *name, const Row &r) {
+    printf("    %-12s %10.0f %9.1f %10.1f %9.2f %9.2f %11.0f %11.0f %9.1f\n", name, r.memory_kb,
+           r.build_mps, r.contains_ns, r.or_ms, r.and_ms, r.rank_ns, r.select_ns, r.iterate_mps);
+}
+
+// Query IDs: half members, half random
+static std::vector<uint32_t> make_queries(const std::vector<uint32_t> &ids) {
+    std::vector<uint32_t> q(QUERIES);
+    for (size_t i = 0; i < q.size(); i++) {
+        q[i] = (i % 2) ? ids[xorshift32() % ids.size()] : xorshift32() % UNIVERSE;
+    }
+    return q;
+}
+
+static Row bench_roaring(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b,
+                         const std::vector<uint32_t> &q) {
+    Row row;
+    roaring_t ra, rb, out;
+    roaring_init(&ra);
+    roaring_init(&rb);
+    roaring_init(&out);
+
+    uint64_t start = now_ns();
+    for (uint32_t id : a) roaring_add(&ra, id);
+    roaring_optimize(&ra);
+    row.build_mps = a.size() / ((now_ns() - start) / 1e3);
+    for (uint32_t id : b) roaring_add(&rb, id);
+    roaring_optimize(&rb);
+    row.memory_kb = roaring_memory(&ra) / 1024.0;
+
+    start = now_ns();
+    uint64_t hits = 0;
+    for (uint32_t x : q) hits += roaring_contains(&ra, x);
+    row.contains_ns = (double)(now_ns() - start) / q.size();
+
+    start = now_ns();
+    roaring_or(&out, &ra, &rb);
+    row.or_ms = (now_ns() - start) / 1e6;
+    start = now_ns();
+    roaring_and(&out, &ra, &rb);
+    row.and_ms = (now_ns() - start) / 1e6;
+
+    start = now_ns();
+    for (uint32_t x : q) hits += roaring_rank(&ra, x);
+    row.rank_ns = (double)(now_ns() - start) / q.size();
+
+    uint64_t card = roaring_cardinality(&ra);
+    start = now_ns();
+    for (uint32_t x : q) {
+        uint32_t v;
+        roaring_select(&ra, x % card, &v);
+        hits += v;
+    }
+    row.select_ns = (double)(now_ns() - start) / q.size();
+
+    roaring_iter_t it;
+    uint32_t v;
+    start = now_ns();
+    roaring_iter_init(&it, &ra);
+    while (roaring_iter_next(&it, &v)) hits += v;
+    row.iterate_mps = card / ((now_ns() - start) / 1e3);
+
+    sink = hits;
+    roaring_free(&ra);
+    roaring_free(&rb);
+    roaring_free(&out);
+    return row;
+}
+
+static Row bench_bitset(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b,
+                        const std::vector<uint32_t> &q) {
+    Row row;
+    bitset_t ba, bb, out;
+    bitset_init(&ba);
+    bitset_init(&bb);
+    bitset_init(&out);
+
+    uint64_t start = now_ns();
+    for (uint32_t id : a) bitset_set(&ba, id);
+    row.build_mps = a.size() / ((now_ns() - start) / 1e3);
+    for (uint32_t id : b) bitset_set(&bb, id);
+    row.memory_kb = bitset_memory(&ba) / 1024.0;
+
+    start = now_ns();
+    uint64_t hits = 0;
+    for (uint32_t x : q) hits += bitset_test(&ba, x);
+    row.contains_ns = (double)(now_ns() - start) / q.size();
+
+    // Fresh output each time, like roaring_or() / roaring_and()
+    start = now_ns();
+    bitset_or(&out, &ba);
+    bitset_or(&out, &bb);
+    row.or_ms = (now_ns() - start) / 1e6;
+    bitset_free(&out);
+    start = now_ns();
+    bitset_or(&out, &ba);
+    bitset_and(&out, &bb);
+    row.and_ms = (now_ns() - start) / 1e6;
+
+    start = now_ns();
+    for (int i = 0; i < SLOW_QUERIES * 10; i++) hits += bitset_rank(&ba, q[i]);
+    row.rank_ns = (double)(now_ns() - start) / (SLOW_QUERIES * 10);
+
+    uint64_t card = bitset_count(&ba);
+    start = now_ns();
+    for (int i = 0; i < SLOW_QUERIES * 10; i++) {
+        size_t pos;
+        bitset_select(&ba, q[i] % card, &pos);
+        hits += pos;
+    }
+    row.select_ns = (double)(now_ns() - start) / (SLOW_QUERIES * 10);
+
+    start = now_ns();
+    for (size_t i = bitset_next(&ba, 0); i != BITSET_END; i = bitset_next(&ba, i + 1)) hits += i;
+    row.iterate_mps = card / ((now_ns() - start) / 1e3);
+
+    sink = hits;
+    bitset_free(&ba);
+    bitset_free(&bb);
+    bitset_free(&out);
+    return row;
+}
+
+static Row bench_vector_bool(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b,
+                             const std::vector<uint32_t> &q) {
+    Row row;
+    std::vector<bool> va(UNIVERSE), vb(UNIVERSE);
+
+    uint64_t start = now_ns();
+    for (uint32_t id : a) va[id] = true;
+    row.build_mps = a.size() / ((now_ns() - start) / 1e3);
+    for (uint32_t id : b) vb[id] = true;
+    row.memory_kb = va.capacity() / 8 / 1024.0;
+
+    start = now_ns();
+    uint64_t hits = 0;
+    for (uint32_t x : q) hits += va[x];
+    row.contains_ns = (double)(now_ns() - start) / q.size();
+
+    // No word-level operators: one bit at a time
+    start = now_ns();
+    std::vector<bool> out(UNIVERSE);
+    for (uint32_t i = 0; i < UNIVERSE; i++) out[i] = va[i] || vb[i];
+    row.or_ms = (now_ns() - start) / 1e6;
+    start = now_ns();
+    std::vector<bool> out2(UNIVERSE);
+    for (uint32_t i = 0; i < UNIVERSE; i++) out2[i] = va[i] && vb[i];
+    row.and_ms = (now_ns() - start) / 1e6;
+    hits += out[q[0]] + out2[q[1]];
+
+    start = now_ns();
+    for (int i = 0; i < SLOW_QUERIES; i++) hits += std::count(va.begin(), va.begin() + q[i], true);
+    row.rank_ns = (double)(now_ns() - start) / SLOW_QUERIES;
+
+    uint64_t card = std::count(va.begin(), va.end(), true);
+    start = now_ns();
+    for (int i = 0; i < SLOW_QUERIES; i++) {
+        uint64_t k = q[i] % card;
+        uint32_t pos = 0;
+        for (;; pos++) {
+            if (va[pos] && k-- == 0) break;
+        }
+        hits += pos;
+    }
+    row.select_ns = (double)(now_ns() - start) / SLOW_QUERIES;
+
+    start = now_ns();
+    for (uint32_t i = 0; i < UNIVERSE; i++) {
+        if (va[i]) hits += i;
+    }
+    row.iterate_mps = card / ((now_ns() - start) / 1e3);
+
+    sink = hits;
+    return row;
+}
+
+static Row bench_std_set(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b,
+                         const std::vector<uint32_t> &q) {
+    Row row;
+    std::set<uint32_t> sa, sb;
+
+    uint64_t start = now_ns();
+    for (uint32_t id : a) sa.insert(id);
+    row.build_mps = a.size() / ((now_ns() - start) / 1e3);
+    for (uint32_t id : b) sb.insert(id);
+    row.memory_kb = sa.size() * 48.0 / 1024.0;
+
+    start = now_ns();
+    uint64_t hits = 0;
+    for (uint32_t x : q) hits += sa.count(x);
+    row.contains_ns = (double)(now_ns() - start) / q.size();
+
+    start = now_ns();
+    std::set<uint32_t> out;
+    std::set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), std::inserter(out, out.end()));
+    row.or_ms = (now_ns() - start) / 1e6;
+    start = now_ns();
+    std::set<uint32_t> out2;
+    std::set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), std::inserter(out2, out2.end()));
+    row.and_ms = (now_ns() - start) / 1e6;
+    hits += out.size() + out2.size();
+
+    start = now_ns();
+    for (int i = 0; i < SLOW_QUERIES; i++) hits += std::distance(sa.begin(), sa.lower_bound(q[i]));
+    row.rank_ns = (double)(now_ns() - start) / SLOW_QUERIES;
+
+    start = now_ns();
+    for (int i = 0; i < SLOW_QUERIES; i++) hits += *std::next(sa.begin(), q[i] % sa.size());
+    row.select_ns = (double)(now_ns() - start) / SLOW_QUERIES;
+
+    start = now_ns();
+    for (uint32_t v : sa) hits += v;
+    row.iterate_mps = sa.size() / ((now_ns() - start) / 1e3);
+
+    sink = hits;
+    return row;
+}
+
+static void bench_dataset(const char *name, std::vector<uint32_t> (*make)(void)) {
+    std::vector<uint32_t> a = make(), b = make();
+    std::vector<uint32_t> q = make_queries(a);
+    printf("\n  %s (%zu IDs)\n", name, a.size());
+    printf("    %-12s %10s %9s %10s %9s %9s %11s %11s %9s\n", "", "mem KB", "build M/s",
+           "contains", "or ms", "and ms", "rank ns", "select ns", "iter M/s");
+    print_row("roaring", bench_roaring(a, b, q));
+    print_row("bitset", bench_bitset(a, b, q));
+    print_row("vector<bool>", bench_vector_bool(a, b, q));
+    print_row("std::set", bench_std_set(a, b, q));
+}
+
+static std::vector<uint32_t> make_sparse_26(void) {
+    return make_sparse(UNIVERSE);
+}
+
+int main() {
+    printf("--- Channel ID sets (contains in ns) ---\n");
+    bench_dataset("sparse", make_sparse_26);
+    bench_dataset("dense", make_dense);
+    bench_dataset("clustered", make_clustered);
+
+    std::vector<uint32_t> wide = make_sparse(UINT32_MAX);
+    roaring_t r;
+    roaring_init(&r);
+    for (uint32_t id : wide) roaring_add(&r, id);
+    roaring_optimize(&r);
+    printf("\n  sparse over 2^32: roaring %.0f KB, std::set ~%.0f KB, vector<bool> 524288 KB\n",
+           roaring_memory(&r) / 1024.0, wide.size() * 48.0 / 1024.0);
+    roaring_free(&r);
+    return 0;
+}
@@ -1,5 +1,8 @@
 /*
 Basic bit manipulation exercises
+
+The same operations on sets of many bits: bitset.h (one bit per value,
+grows on demand) and roaring.h (compressed, for sparse or clustered IDs).
 */
 
 #include <stdio.h>
@@ -22,15 +25,15 @@ int count_set_bits(unsigned int val);
 
 // --- Implementations ---
 void set_bit(unsigned int *val, int pos) {
-    
+    *val |= (1U << pos);
 }
 
 void clear_bit(unsigned int *val, int pos) {
-    
+    *val &= ~(1U << pos);
 }
 
 void toggle_bit(unsigned int *val, int pos) {
-    
+    *val ^= (1U << pos);
 }
 
 bool is_bit_set(unsigned int val, int pos) {
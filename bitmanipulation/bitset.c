@@ -0,0 +1,117 @@
+#include <stdlib.h>
+#include <string.h>
+#include "bitset.h"
+
+void bitset_init(bitset_t *b) {
+    b->words = NULL;
+    b->nwords = 0;
+}
+
+void bitset_free(bitset_t *b) {
+    free(b->words);
+    bitset_init(b);
+}
+
+bool bitset_reserve(bitset_t *b, size_t nbits) {
+    size_t need = nbits / 64 + (nbits % 64 != 0);
+    if (need <= b->nwords) {
+        return true;
+    }
+    // Grow geometrically so setting bits in increasing order stays O(1)
+    size_t n = b->nwords * 2;
+    if (n < need) n = need;
+    uint64_t *words = realloc(b->words, n * sizeof(uint64_t));
+    if (words == NULL) {
+        return false;
+    }
+    memset(words + b->nwords, 0, (n - b->nwords) * sizeof(uint64_t));
+    b->words = words;
+    b->nwords = n;
+    return true;
+}
+
+bool bitset_set(bitset_t *b, size_t i) {
+    if (i / 64 >= b->nwords && !bitset_reserve(b, i + 1)) {
+        return false;
+    }
+    b->words[i / 64] |= (uint64_t)1 << (i % 64);
+    return true;
+}
+
+bool bitset_toggle(bitset_t *b, size_t i) {
+    if (i / 64 >= b->nwords && !bitset_reserve(b, i + 1)) {
+        return false;
+    }
+    b->words[i / 64] ^= (uint64_t)1 << (i % 64);
+    return true;
+}
+
+uint64_t bitset_count(const bitset_t *b) {
+    uint64_t total = 0;
+    for (size_t w = 0; w < b->nwords; w++) {
+        total += (uint64_t)__builtin_popcountll(b->words[w]);
+    }
+    return total;
+}
+
+bool bitset_or(bitset_t *dst, const bitset_t *src) {
+    if (!bitset_reserve(dst, src->nwords * 64)) {
+        return false;
+    }
+    for (size_t w = 0; w < src->nwords; w++) {
+        dst->words[w] |= src->words[w];
+    }
+    return true;
+}
+
+void bitset_and(bitset_t *dst, const bitset_t *src) {
+    size_t common = dst->nwords < src->nwords ? dst->nwords : src->nwords;
+    for (size_t w = 0; w < common; w++) {
+        dst->words[w] &= src->words[w];
+    }
+    // Past the end of src everything is 0
+    if (dst->nwords > common) {
+        memset(dst->words + common, 0, (dst->nwords - common) * sizeof(uint64_t));
+    }
+}
+
+uint64_t bitset_rank(const bitset_t *b, size_t i) {
+    size_t full = i / 64;
+    if (full >= b->nwords) {
+        return bitset_count(b);
+    }
+    uint64_t total = 0;
+    for (size_t w = 0; w < full; w++) {
+        total += (uint64_t)__builtin_popcountll(b->words[w]);
+    }
+    uint64_t below = ((uint64_t)1 << (i % 64)) - 1;
+    return total + (uint64_t)__builtin_popcountll(b->words[full] & below);
+}
+
+bool bitset_select(const bitset_t *b, uint64_t k, size_t *pos) {
+    for (size_t w = 0; w < b->nwords; w++) {
+        uint64_t n = (uint64_t)__builtin_popcountll(b->words[w]);
+        if (k < n) {
+            *pos = w * 64 + bitset_word_select(b->words[w], (unsigned)k);
+            return true;
+        }
+        k -= n;
+    }
+    return false;
+}
+
+size_t bitset_next(const bitset_t *b, size_t from) {
+    size_t w = from / 64;
+    if (w >= b->nwords) {
+        return BITSET_END;
+    }
+    // Drop the bits below 'from' in its own word, then skip zero words
+    uint64_t bits = b->words[w] & (~(uint64_t)0 << (from % 64));
+    while (bits == 0) {
+        if (++w == b->nwords) {
+            return BITSET_END;
+        }
+        bits = b->words[w];
+    }
+    return w * 64 + (size_t)__builtin_ctzll(bits);
+}
@@ -0,0 +1,98 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Dynamic Bitset
+ *
+ * The set_bit() / clear_bit() / toggle_bit() idioms from bitmanipulation.c
+ * on an array of 64-bit words instead of one unsigned int: bit i lives in
+ * words[i / 64] at position i % 64. The array grows (zero filled) when a
+ * bit past the end is set.
+ *
+ * Union / intersection go a word at a time, counting is one popcount per
+ * word. Memory is one bit per value up to the largest one ever set, so
+ * this suits dense sets; sparse ones belong in roaring.h.
+ */
+
+#define BITSET_END SIZE_MAX        // "no such bit" from bitset_next()
+
+typedef struct {
+    uint64_t *words;
+    size_t nwords;                 // Bits past nwords * 64 read as 0
+} bitset_t;
+
+void bitset_init(bitset_t *b);
+void bitset_free(bitset_t *b);
+
+// Makes room for bits 0 .. nbits-1. Returns false if out of memory.
+bool bitset_reserve(bitset_t *b, size_t nbits);
+
+// --- Single bits ---
+
+// Returns false if the array had to grow and could not
+bool bitset_set(bitset_t *b, size_t i);
+bool bitset_toggle(bitset_t *b, size_t i);
+
+static inline void bitset_clear(bitset_t *b, size_t i) {
+    if (i / 64 < b->nwords) b->words[i / 64] &= ~((uint64_t)1 << (i % 64));
+}
+
+static inline bool bitset_test(const bitset_t *b, size_t i) {
+    return i / 64 < b->nwords && ((b->words[i / 64] >> (i % 64)) & 1);
+}
+
+// --- Whole set ---
+
+uint64_t bitset_count(const bitset_t *b);
+
+// dst |= src (dst grows to src's size). Returns false if out of memory.
+bool bitset_or(bitset_t *dst, const bitset_t *src);
+
+// dst &= src
+void bitset_and(bitset_t *dst, const bitset_t *src);
+
+// Set bits below i
+uint64_t bitset_rank(const bitset_t *b, size_t i);
+
+// Position of the k-th set bit (k from 0). Returns false if count() <= k.
+bool bitset_select(const bitset_t *b, uint64_t k, size_t *pos);
+
+/**
+ * @brief First set bit at or after 'from', or BITSET_END.
+ *
+ *   for (size_t i = bitset_next(b, 0); i != BITSET_END; i = bitset_next(b, i + 1))
+ */
+size_t bitset_next(const bitset_t *b, size_t from);
+
+// Bytes of heap used
+static inline size_t bitset_memory(const bitset_t *b) {
+    return b->nwords * sizeof(uint64_t);
+}
+
+// Position of the k-th set bit of w (k < popcount(w)), by halving
+static inline unsigned bitset_word_select(uint64_t w, unsigned k) {
+    unsigned pos = 0;
+    for (unsigned half = 32; half > 0; half /= 2) {
+        unsigned low = (unsigned)__builtin_popcountll(w & (((uint64_t)1 << half) - 1));
+        if (k >= low) {
+            k -= low;
+            w >>= half;
+            pos += half;
+        }
+    }
+    return pos;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BITSET_H
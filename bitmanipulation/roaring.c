@@ -0,0 +1,880 @@
+#include <stdlib.h>
+#include <string.h>
+#include "roaring.h"
+#include "bitset.h"
+
+#define ARRAY_MAX     4096          // Past this many values a bitmap is smaller
+#define BITMAP_WORDS  1024
+#define CHUNK_BITS    65536u
+
+enum { KIND_ARRAY, KIND_BITMAP, KIND_RUN };
+
+typedef struct {
+    uint16_t start;
+    uint16_t last;                  // Inclusive
+} run_t;
+
+struct roaring_container {
+    uint8_t kind;
+    uint32_t card;                  // Values held, 0 only while being built
+    uint32_t len;                   // Array values or runs in use
+    uint32_t cap;                   // Array values or runs allocated
+    union {
+        uint16_t *values;
+        uint64_t *words;
+        run_t *runs;
+    };
+};
+
+typedef roaring_container_t container_t;
+
+// Bytes the cheaper of array / bitmap would need for 'card' values
+static inline size_t plain_bytes(uint32_t card) {
+    return card <= ARRAY_MAX ? card * sizeof(uint16_t) : BITMAP_WORDS * sizeof(uint64_t);
+}
+
+static void c_release(container_t *c) {
+    free(c->values);                // Same pointer for every kind
+    memset(c, 0, sizeof(*c));
+}
+
+// Makes room for 'need' elements of 'elem' bytes; NULL (old block kept) if out of memory
+static void *grow(void *p, uint32_t *cap, uint32_t need, size_t elem) {
+    if (need <= *cap) {
+        return p;
+    }
+    uint32_t n = *cap ? *cap * 2 : 4;
+    if (n < need) n = need;
+    void *q = realloc(p, n * elem);
+    if (q != NULL) *cap = n;
+    return q;
+}
+
+// First i with values[i] >= v
+static uint32_t lower_bound16(const uint16_t *values, uint32_t n, uint16_t v) {
+    uint32_t lo = 0, hi = n;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (values[mid] < v) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+// First run starting after v; the run holding v (if any) is the one before
+static uint32_t runs_after(const run_t *runs, uint32_t n, uint16_t v) {
+    uint32_t lo = 0, hi = n;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        if (runs[mid].start <= v) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+// --- Bitmap words ---
+
+static inline bool bm_test(const uint64_t *w, uint32_t v) {
+    return (w[v / 64] >> (v % 64)) & 1;
+}
+
+static inline void bm_set(uint64_t *w, uint32_t v) {
+    w[v / 64] |= (uint64_t)1 << (v % 64);
+}
+
+// Sets (or clears) bits start .. last inclusive
+static void bm_fill(uint64_t *w, uint32_t start, uint32_t last, bool set) {
+    uint32_t a = start / 64, b = last / 64;
+    uint64_t head = ~(uint64_t)0 << (start % 64);
+    uint64_t tail = ~(uint64_t)0 >> (63 - last % 64);
+    for (uint32_t i = a; i <= b; i++) {
+        uint64_t mask = (i == a ? head : ~(uint64_t)0) & (i == b ? tail : ~(uint64_t)0);
+        w[i] = set ? (w[i] | mask) : (w[i] & ~mask);
+    }
+}
+
+static uint32_t bm_count(const uint64_t *w) {
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < BITMAP_WORDS; i++) n += (uint32_t)__builtin_popcountll(w[i]);
+    return n;
+}
+
+// First bit at or after 'from' that is set (or clear), or CHUNK_BITS
+static uint32_t bm_next(const uint64_t *w, uint32_t from, bool set) {
+    if (from >= CHUNK_BITS) {
+        return CHUNK_BITS;
+    }
+    uint32_t i = from / 64;
+    uint64_t bits = (set ? w[i] : ~w[i]) & (~(uint64_t)0 << (from % 64));
+    while (bits == 0) {
+        if (++i == BITMAP_WORDS) return CHUNK_BITS;
+        bits = set ? w[i] : ~w[i];
+    }
+    return i * 64 + (uint32_t)__builtin_ctzll(bits);
+}
+
+// A run starts at every set bit whose lower neighbour is clear
+static uint32_t bm_runs(const uint64_t *w) {
+    uint32_t n = 0;
+    uint64_t carry = 0;
+    for (uint32_t i = 0; i < BITMAP_WORDS; i++) {
+        n += (uint32_t)__builtin_popcountll(w[i] & ~((w[i] << 1) | carry));
+        carry = w[i] >> 63;
+    }
+    return n;
+}
+
+// --- Conversions ---
+
+// ORs every value of c into the bitmap w
+static void c_or_words(const container_t *c, uint64_t *w) {
+    switch (c->kind) {
+        case KIND_ARRAY:
+            for (uint32_t i = 0; i < c->len; i++) bm_set(w, c->values[i]);
+            break;
+        case KIND_BITMAP:
+            for (uint32_t i = 0; i < BITMAP_WORDS; i++) w[i] |= c->words[i];
+            break;
+        default:
+            for (uint32_t i = 0; i < c->len; i++) bm_fill(w, c->runs[i].start, c->runs[i].last, true);
+            break;
+    }
+}
+
+// Writes the card values of c, ascending
+static void c_write_values(const container_t *c, uint16_t *out) {
+    uint32_t n = 0;
+    switch (c->kind) {
+        case KIND_ARRAY:
+            memcpy(out, c->values, c->len * sizeof(uint16_t));
+            break;
+        case KIND_BITMAP:
+            for (uint32_t i = 0; i < BITMAP_WORDS; i++) {
+                for (uint64_t bits = c->words[i]; bits != 0; bits &= bits - 1) {
+                    out[n++] = (uint16_t)(i * 64 + (uint32_t)__builtin_ctzll(bits));
+                }
+            }
+            break;
+        default:
+            for (uint32_t i = 0; i < c->len; i++) {
+                for (uint32_t v = c->runs[i].start; v <= c->runs[i].last; v++) out[n++] = (uint16_t)v;
+            }
+            break;
+    }
+}
+
+static uint32_t c_count_runs(const container_t *c) {
+    switch (c->kind) {
+        case KIND_ARRAY: {
+            uint32_t n = c->len > 0;
+            for (uint32_t i = 1; i < c->len; i++) n += c->values[i] != c->values[i - 1] + 1;
+            return n;
+        }
+        case KIND_BITMAP:
+            return bm_runs(c->words);
+        default:
+            return c->len;
+    }
+}
+
+// Swaps in a new representation; card stays the same
+static void c_replace(container_t *c, uint8_t kind, void *data, uint32_t len) {
+    free(c->values);
+    c->kind = kind;
+    c->values = data;
+    c->len = c->cap = len;
+}
+
+static bool c_to_bitmap(container_t *c) {
+    uint64_t *w = calloc(BITMAP_WORDS, sizeof(uint64_t));
+    if (w == NULL) {
+        return false;
+    }
+    c_or_words(c, w);
+    c_replace(c, KIND_BITMAP, w, 0);
+    return true;
+}
+
+static bool c_to_array(container_t *c) {
+    uint16_t *values = malloc((c->card ? c->card : 1) * sizeof(uint16_t));
+    if (values == NULL) {
+        return false;
+    }
+    c_write_values(c, values);
+    c_replace(c, KIND_ARRAY, values, c->card);
+    return true;
+}
+
+static bool c_to_runs(container_t *c) {
+    uint32_t n = c_count_runs(c);
+    run_t *runs = malloc((n ? n : 1) * sizeof(run_t));
+    if (runs == NULL) {
+        return false;
+    }
+    uint32_t k = 0;
+    if (c->kind == KIND_BITMAP) {
+        for (uint32_t v = bm_next(c->words, 0, true); v < CHUNK_BITS; ) {
+            uint32_t end = bm_next(c->words, v, false);
+            runs[k++] = (run_t){ (uint16_t)v, (uint16_t)(end - 1) };
+            v = bm_next(c->words, end, true);
+        }
+    } else if (c->kind == KIND_ARRAY) {
+        for (uint32_t i = 0; i < c->len; i++) {
+            if (k > 0 && c->values[i] == runs[k - 1].last + 1) {
+                runs[k - 1].last = c->values[i];
+            } else {
+                runs[k++] = (run_t){ c->values[i], c->values[i] };
+            }
+        }
+    } else {
+        memcpy(runs, c->runs, n * sizeof(run_t));
+    }
+    c_replace(c, KIND_RUN, runs, n);
+    return true;
+}
+
+// Array or bitmap by cardinality; runs stay runs while they are smaller
+static bool c_settle(container_t *c) {
+    if (c->kind == KIND_RUN) {
+        if (c->len * sizeof(run_t) <= plain_bytes(c->card)) return true;
+        return c->card <= ARRAY_MAX ? c_to_array(c) : c_to_bitmap(c);
+    }
+    if (c->kind == KIND_ARRAY && c->card > ARRAY_MAX) return c_to_bitmap(c);
+    if (c->kind == KIND_BITMAP && c->card <= ARRAY_MAX) return c_to_array(c);
+    return true;
+}
+
+// Smallest of the three forms
+static bool c_optimize(container_t *c) {
+    if (c_count_runs(c) * sizeof(run_t) < plain_bytes(c->card)) {
+        return c->kind == KIND_RUN || c_to_runs(c);
+    }
+    if (c->kind == KIND_RUN) {
+        return c->card <= ARRAY_MAX ? c_to_array(c) : c_to_bitmap(c);
+    }
+    return c_settle(c);
+}
+
+static bool c_copy(container_t *dst, const container_t *src) {
+    size_t bytes = src->kind == KIND_BITMAP ? BITMAP_WORDS * sizeof(uint64_t)
+                 : src->kind == KIND_ARRAY  ? src->len * sizeof(uint16_t)
+                 :                            src->len * sizeof(run_t);
+    *dst = *src;
+    dst->values = malloc(bytes ? bytes : 1);
+    if (dst->values == NULL) {
+        return false;
+    }
+    memcpy(dst->values, src->values, bytes);
+    dst->cap = dst->len;
+    return true;
+}
+
+// --- Single values ---
+
+static bool c_contains(const container_t *c, uint16_t v) {
+    switch (c->kind) {
+        case KIND_ARRAY: {
+            uint32_t i = lower_bound16(c->values, c->len, v);
+            return i < c->len && c->values[i] == v;
+        }
+        case KIND_BITMAP:
+            return bm_test(c->words, v);
+        default: {
+            uint32_t i = runs_after(c->runs, c->len, v);
+            return i > 0 && c->runs[i - 1].last >= v;
+        }
+    }
+}
+
+static bool run_add(container_t *c, uint16_t v) {
+    uint32_t i = runs_after(c->runs, c->len, v);
+    if (i > 0 && c->runs[i - 1].last >= v) {
+        return true;
+    }
+    bool join_prev = i > 0 && c->runs[i - 1].last + 1 == v;
+    bool join_next = i < c->len && c->runs[i].start == v + 1;
+    if (join_prev && join_next) {
+        c->runs[i - 1].last = c->runs[i].last;
+        memmove(&c->runs[i], &c->runs[i + 1], (c->len - i - 1) * sizeof(run_t));
+        c->len--;
+    } else if (join_prev) {
+        c->runs[i - 1].last = v;
+    } else if (join_next) {
+        c->runs[i].start = v;
+    } else {
+        run_t *runs = grow(c->runs, &c->cap, c->len + 1, sizeof(run_t));
+        if (runs == NULL) return false;
+        c->runs = runs;
+        memmove(&c->runs[i + 1], &c->runs[i], (c->len - i) * sizeof(run_t));
+        c->runs[i] = (run_t){ v, v };
+        c->len++;
+    }
+    c->card++;
+    return c_settle(c);
+}
+
+static bool c_add(container_t *c, uint16_t v) {
+    switch (c->kind) {
+        case KIND_ARRAY: {
+            uint32_t i = lower_bound16(c->values, c->len, v);
+            if (i < c->len && c->values[i] == v) {
+                return true;
+            }
+            if (c->len == ARRAY_MAX) {
+                return c_to_bitmap(c) && c_add(c, v);
+            }
+            uint16_t *values = grow(c->values, &c->cap, c->len + 1, sizeof(uint16_t));
+            if (values == NULL) return false;
+            c->values = values;
+            memmove(&c->values[i + 1], &c->values[i], (c->len - i) * sizeof(uint16_t));
+            c->values[i] = v;
+            c->len++;
+            c->card++;
+            return true;
+        }
+        case KIND_BITMAP:
+            if (!bm_test(c->words, v)) {
+                bm_set(c->words, v);
+                c->card++;
+            }
+            return true;
+        default:
+            return run_add(c, v);
+    }
+}
+
+static bool run_remove(container_t *c, uint16_t v) {
+    uint32_t i = runs_after(c->runs, c->len, v);
+    if (i == 0 || c->runs[i - 1].last < v) {
+        return true;
+    }
+    run_t *r = &c->runs[--i];
+    if (r->start == r->last) {
+        memmove(r, r + 1, (c->len - i - 1) * sizeof(run_t));
+        c->len--;
+    } else if (v == r->start) {
+        r->start++;
+    } else if (v == r->last) {
+        r->last--;
+    } else {
+        // Split in two around v
+        run_t *runs = grow(c->runs, &c->cap, c->len + 1, sizeof(run_t));
+        if (runs == NULL) return false;
+        c->runs = runs;
+        memmove(&c->runs[i + 2], &c->runs[i + 1], (c->len - i - 1) * sizeof(run_t));
+        c->runs[i + 1] = (run_t){ (uint16_t)(v + 1), c->runs[i].last };
+        c->runs[i].last = (uint16_t)(v - 1);
+        c->len++;
+    }
+    c->card--;
+    return c_settle(c);
+}
+
+static bool c_remove(container_t *c, uint16_t v) {
+    switch (c->kind) {
+        case KIND_ARRAY: {
+            uint32_t i = lower_bound16(c->values, c->len, v);
+            if (i < c->len && c->values[i] == v) {
+                memmove(&c->values[i], &c->values[i + 1], (c->len - i - 1) * sizeof(uint16_t));
+                c->len--;
+                c->card--;
+            }
+            return true;
+        }
+        case KIND_BITMAP:
+            if (bm_test(c->words, v)) {
+                c->words[v / 64] &= ~((uint64_t)1 << (v % 64));
+                c->card--;
+            }
+            return c_settle(c);
+        default:
+            return run_remove(c, v);
+    }
+}
+
+// Values of c below v
+static uint32_t c_rank(const container_t *c, uint16_t v) {
+    switch (c->kind) {
+        case KIND_ARRAY:
+            return lower_bound16(c->values, c->len, v);
+        case KIND_BITMAP: {
+            uint32_t n = 0;
+            for (uint32_t i = 0; i < v / 64u; i++) n += (uint32_t)__builtin_popcountll(c->words[i]);
+            uint64_t below = ((uint64_t)1 << (v % 64)) - 1;
+            return n + (uint32_t)__builtin_popcountll(c->words[v / 64] & below);
+        }
+        default: {
+            uint32_t n = 0;
+            for (uint32_t i = 0; i < c->len && c->runs[i].start < v; i++) {
+                uint32_t last = c->runs[i].last < v ? c->runs[i].last : (uint32_t)v - 1;
+                n += last - c->runs[i].start + 1;
+            }
+            return n;
+        }
+    }
+}
+
+// k-th value of c, k < card
+static uint16_t c_select(const container_t *c, uint32_t k) {
+    switch (c->kind) {
+        case KIND_ARRAY:
+            return c->values[k];
+        case KIND_BITMAP:
+            for (uint32_t i = 0; ; i++) {
+                uint32_t n = (uint32_t)__builtin_popcountll(c->words[i]);
+                if (k < n) return (uint16_t)(i * 64 + bitset_word_select(c->words[i], k));
+                k -= n;
+            }
+        default:
+            for (uint32_t i = 0; ; i++) {
+                uint32_t n = (uint32_t)c->runs[i].last - c->runs[i].start + 1;
+                if (k < n) return (uint16_t)(c->runs[i].start + k);
+                k -= n;
+            }
+    }
+}
+
+// --- Union ---
+
+static bool array_or(container_t *out, const container_t *a, const container_t *b) {
+    uint16_t *values = malloc((a->len + b->len) * sizeof(uint16_t));
+    if (values == NULL) {
+        return false;
+    }
+    uint32_t i = 0, j = 0, n = 0;
+    while (i < a->len && j < b->len) {
+        uint16_t x = a->values[i], y = b->values[j];
+        values[n++] = x < y ? x : y;
+        i += x <= y;
+        j += y <= x;
+    }
+    memcpy(values + n, a->values + i, (a->len - i) * sizeof(uint16_t));
+    n += a->len - i;
+    memcpy(values + n, b->values + j, (b->len - j) * sizeof(uint16_t));
+    n += b->len - j;
+
+    *out = (container_t){ .kind = KIND_ARRAY, .card = n, .len = n, .cap = a->len + b->len, .values = values };
+    return c_settle(out);
+}
+
+static void push_run(run_t *runs, uint32_t *n, run_t r) {
+    if (*n > 0 && r.start <= runs[*n - 1].last + 1) {
+        if (r.last > runs[*n - 1].last) runs[*n - 1].last = r.last;
+    } else {
+        runs[(*n)++] = r;
+    }
+}
+
+static uint32_t runs_card(const run_t *runs, uint32_t n) {
+    uint32_t card = 0;
+    for (uint32_t i = 0; i < n; i++) card += (uint32_t)runs[i].last - runs[i].start + 1;
+    return card;
+}
+
+static bool runs_or(container_t *out, const container_t *a, const container_t *b) {
+    run_t *runs = malloc((a->len + b->len) * sizeof(run_t));
+    if (runs == NULL) {
+        return false;
+    }
+    uint32_t i = 0, j = 0, n = 0;
+    while (i < a->len || j < b->len) {
+        bool take_a = j == b->len || (i < a->len && a->runs[i].start <= b->runs[j].start);
+        push_run(runs, &n, take_a ? a->runs[i++] : b->runs[j++]);
+    }
+    *out = (container_t){ .kind = KIND_RUN, .card = runs_card(runs, n), .len = n,
+                          .cap = a->len + b->len, .runs = runs };
+    return c_settle(out);
+}
+
+static bool c_or(container_t *out, const container_t *a, const container_t *b) {
+    if (a->kind == KIND_ARRAY && b->kind == KIND_ARRAY) return array_or(out, a, b);
+    if (a->kind == KIND_RUN && b->kind == KIND_RUN) return runs_or(out, a, b);
+
+    uint64_t *w = calloc(BITMAP_WORDS, sizeof(uint64_t));
+    if (w == NULL) {
+        return false;
+    }
+    c_or_words(a, w);
+    c_or_words(b, w);
+    *out = (container_t){ .kind = KIND_BITMAP, .card = bm_count(w), .words = w };
+    return c_settle(out);
+}
+
+// --- Intersection ---
+
+static bool array_and(container_t *out, const container_t *a, const container_t *b) {
+    if (a->len > b->len) {
+        const container_t *t = a; a = b; b = t;
+    }
+    uint16_t *values = malloc((a->len ? a->len : 1) * sizeof(uint16_t));
+    if (values == NULL) {
+        return false;
+    }
+    uint32_t n = 0;
+    if (b->len > 64 * a->len) {
+        // Very different sizes: binary search the big one from the last hit on
+        uint32_t j = 0;
+        for (uint32_t i = 0; i < a->len && j < b->len; i++) {
+            j += lower_bound16(b->values + j, b->len - j, a->values[i]);
+            if (j < b->len && b->values[j] == a->values[i]) values[n++] = a->values[i];
+        }
+    } else {
+        uint32_t i = 0, j = 0;
+        while (i < a->len && j < b->len) {
+            uint16_t x = a->values[i], y = b->values[j];
+            if (x == y) values[n++] = x;
+            i += x <= y;
+            j += y <= x;
+        }
+    }
+    *out = (container_t){ .kind = KIND_ARRAY, .card = n, .len = n, .cap = a->len, .values = values };
+    return true;
+}
+
+// Values of array 'a' that are also in 'b' (bitmap or runs)
+static bool array_filter(container_t *out, const container_t *a, const container_t *b) {
+    uint16_t *values = malloc(a->len * sizeof(uint16_t));
+    if (values == NULL) {
+        return false;
+    }
+    uint32_t n = 0;
+    if (b->kind == KIND_BITMAP) {
+        for (uint32_t i = 0; i < a->len; i++) {
+            values[n] = a->values[i];
+            n += bm_test(b->words, a->values[i]);
+        }
+    } else {
+        uint32_t r = 0;
+        for (uint32_t i = 0; i < a->len && r < b->len; i++) {
+            uint16_t v = a->values[i];
+            while (r < b->len && b->runs[r].last < v) r++;
+            if (r < b->len && b->runs[r].start <= v) values[n++] = v;
+        }
+    }
+    *out = (container_t){ .kind = KIND_ARRAY, .card = n, .len = n, .cap = a->len, .values = values };
+    return true;
+}
+
+static bool runs_and(container_t *out, const container_t *a, const container_t *b) {
+    run_t *runs = malloc((a->len + b->len) * sizeof(run_t));
+    if (runs == NULL) {
+        return false;
+    }
+    uint32_t i = 0, j = 0, n = 0;
+    while (i < a->len && j < b->len) {
+        uint16_t start = a->runs[i].start > b->runs[j].start ? a->runs[i].start : b->runs[j].start;
+        uint16_t last = a->runs[i].last < b->runs[j].last ? a->runs[i].last : b->runs[j].last;
+        if (start <= last) runs[n++] = (run_t){ start, last };
+        if (a->runs[i].last < b->runs[j].last) i++; else j++;
+    }
+    *out = (container_t){ .kind = KIND_RUN, .card = runs_card(runs, n), .len = n,
+                          .cap = a->len + b->len, .runs = runs };
+    return out->card == 0 || c_settle(out);
+}
+
+// Clears every bit of w that is not in c (a bitmap or runs)
+static void c_and_words(const container_t *c, uint64_t *w) {
+    if (c->kind == KIND_BITMAP) {
+        for (uint32_t i = 0; i < BITMAP_WORDS; i++) w[i] &= c->words[i];
+        return;
+    }
+    uint32_t from = 0;
+    for (uint32_t i = 0; i < c->len; i++) {
+        if (c->runs[i].start > from) bm_fill(w, from, c->runs[i].start - 1u, false);
+        from = c->runs[i].last + 1u;
+    }
+    if (from < CHUNK_BITS) bm_fill(w, from, CHUNK_BITS - 1, false);
+}
+
+static bool c_and(container_t *out, const container_t *a, const container_t *b) {
+    if (a->kind == KIND_ARRAY && b->kind == KIND_ARRAY) return array_and(out, a, b);
+    if (a->kind == KIND_ARRAY) return array_filter(out, a, b);
+    if (b->kind == KIND_ARRAY) return array_filter(out, b, a);
+    if (a->kind == KIND_RUN && b->kind == KIND_RUN) return runs_and(out, a, b);
+
+    // A bitmap and a bitmap or runs
+    const container_t *bitmap = a->kind == KIND_BITMAP ? a : b;
+    uint64_t *w = malloc(BITMAP_WORDS * sizeof(uint64_t));
+    if (w == NULL) {
+        return false;
+    }
+    memcpy(w, bitmap->words, BITMAP_WORDS * sizeof(uint64_t));
+    c_and_words(bitmap == a ? b : a, w);
+    *out = (container_t){ .kind = KIND_BITMAP, .card = bm_count(w), .words = w };
+    return out->card == 0 || c_settle(out);
+}
+
+// --- Set ---
+
+void roaring_init(roaring_t *r) {
+    memset(r, 0, sizeof(*r));
+}
+
+void roaring_free(roaring_t *r) {
+    for (size_t i = 0; i < r->size; i++) c_release(&r->containers[i]);
+    free(r->keys);
+    free(r->containers);
+    roaring_init(r);
+}
+
+// Index of the container for 'key', or where it would go
+static size_t find_key(const roaring_t *r, uint16_t key) {
+    size_t lo = 0, hi = r->size;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (r->keys[mid] < key) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+// Moves c into a new slot i for 'key'
+static bool insert_container(roaring_t *r, size_t i, uint16_t key, const container_t *c) {
+    if (r->size == r->cap) {
+        size_t n = r->cap ? r->cap * 2 : 4;
+        uint16_t *keys = realloc(r->keys, n * sizeof(uint16_t));
+        if (keys == NULL) return false;
+        r->keys = keys;
+        container_t *containers = realloc(r->containers, n * sizeof(container_t));
+        if (containers == NULL) return false;
+        r->containers = containers;
+        r->cap = n;
+    }
+    memmove(&r->keys[i + 1], &r->keys[i], (r->size - i) * sizeof(uint16_t));
+    memmove(&r->containers[i + 1], &r->containers[i], (r->size - i) * sizeof(container_t));
+    r->keys[i] = key;
+    r->containers[i] = *c;
+    r->size++;
+    return true;
+}
+
+static void erase_container(roaring_t *r, size_t i) {
+    c_release(&r->containers[i]);
+    memmove(&r->keys[i], &r->keys[i + 1], (r->size - i - 1) * sizeof(uint16_t));
+    memmove(&r->containers[i], &r->containers[i + 1], (r->size - i - 1) * sizeof(container_t));
+    r->size--;
+}
+
+// Container for 'key', created empty if missing. *index is set either way.
+static container_t *get_container(roaring_t *r, uint16_t key, size_t *index) {
+    size_t i = find_key(r, key);
+    *index = i;
+    if (i < r->size && r->keys[i] == key) {
+        return &r->containers[i];
+    }
+    container_t empty = { .kind = KIND_ARRAY };
+    return insert_container(r, i, key, &empty) ? &r->containers[i] : NULL;
+}
+
+bool roaring_add(roaring_t *r, uint32_t value) {
+    size_t i;
+    container_t *c = get_container(r, (uint16_t)(value >> 16), &i);
+    if (c == NULL) {
+        return false;
+    }
+    if (!c_add(c, (uint16_t)value)) {
+        if (c->card == 0) erase_container(r, i);
+        return false;
+    }
+    return true;
+}
+
+bool roaring_remove(roaring_t *r, uint32_t value) {
+    uint16_t key = (uint16_t)(value >> 16);
+    size_t i = find_key(r, key);
+    if (i == r->size || r->keys[i] != key) {
+        return true;
+    }
+    bool ok = c_remove(&r->containers[i], (uint16_t)value);
+    if (r->containers[i].card == 0) {
+        erase_container(r, i);
+    }
+    return ok;
+}
+
+bool roaring_contains(const roaring_t *r, uint32_t value) {
+    uint16_t key = (uint16_t)(value >> 16);
+    size_t i = find_key(r, key);
+    return i < r->size && r->keys[i] == key && c_contains(&r->containers[i], (uint16_t)value);
+}
+
+bool roaring_add_range(roaring_t *r, uint32_t lo, uint32_t hi) {
+    for (uint64_t v = lo; v <= hi; ) {
+        uint16_t key = (uint16_t)(v >> 16);
+        uint32_t start = (uint32_t)v & 0xFFFF;
+        uint32_t last = (hi >> 16 == key) ? (hi & 0xFFFF) : 0xFFFF;
+        size_t i;
+        container_t *c = get_container(r, key, &i);
+        if (c == NULL) {
+            return false;
+        }
+        if (c->card == 0) {
+            run_t *runs = malloc(sizeof(run_t));
+            if (runs == NULL) {
+                erase_container(r, i);
+                return false;
+            }
+            runs[0] = (run_t){ (uint16_t)start, (uint16_t)last };
+            *c = (container_t){ .kind = KIND_RUN, .card = last - start + 1, .len = 1, .cap = 1, .runs = runs };
+        } else {
+            // Merge through a bitmap, then pick the smallest form again
+            uint64_t *w = calloc(BITMAP_WORDS, sizeof(uint64_t));
+            if (w == NULL) {
+                return false;
+            }
+            c_or_words(c, w);
+            bm_fill(w, start, last, true);
+            c_replace(c, KIND_BITMAP, w, 0);
+            c->card = bm_count(w);
+        }
+        if (!c_optimize(c)) {
+            return false;
+        }
+        v = ((uint64_t)key << 16) + last + 1;
+    }
+    return true;
+}
+
+uint64_t roaring_cardinality(const roaring_t *r) {
+    uint64_t n = 0;
+    for (size_t i = 0; i < r->size; i++) n += r->containers[i].card;
+    return n;
+}
+
+bool roaring_or(roaring_t *dst, const roaring_t *a, const roaring_t *b) {
+    roaring_free(dst);
+    size_t i = 0, j = 0;
+    while (i < a->size || j < b->size) {
+        container_t c;
+        uint16_t key;
+        bool ok;
+        if (j == b->size || (i < a->size && a->keys[i] < b->keys[j])) {
+            key = a->keys[i];
+            ok = c_copy(&c, &a->containers[i++]);
+        } else if (i == a->size || b->keys[j] < a->keys[i]) {
+            key = b->keys[j];
+            ok = c_copy(&c, &b->containers[j++]);
+        } else {
+            key = a->keys[i];
+            ok = c_or(&c, &a->containers[i++], &b->containers[j++]);
+        }
+        if (!ok || !insert_container(dst, dst->size, key, &c)) {
+            if (ok) c_release(&c);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool roaring_and(roaring_t *dst, const roaring_t *a, const roaring_t *b) {
+    roaring_free(dst);
+    size_t i = 0, j = 0;
+    while (i < a->size && j < b->size) {
+        if (a->keys[i] < b->keys[j]) {
+            i++;
+        } else if (b->keys[j] < a->keys[i]) {
+            j++;
+        } else {
+            container_t c;
+            if (!c_and(&c, &a->containers[i], &b->containers[j])) {
+                return false;
+            }
+            if (c.card == 0) {
+                c_release(&c);
+            } else if (!insert_container(dst, dst->size, a->keys[i], &c)) {
+                c_release(&c);
+                return false;
+            }
+            i++;
+            j++;
+        }
+    }
+    return true;
+}
+
+uint64_t roaring_rank(const roaring_t *r, uint32_t value) {
+    uint16_t key = (uint16_t)(value >> 16);
+    uint64_t n = 0;
+    size_t i = 0;
+    for (; i < r->size && r->keys[i] < key; i++) n += r->containers[i].card;
+    if (i < r->size && r->keys[i] == key) {
+        n += c_rank(&r->containers[i], (uint16_t)value);
+    }
+    return n;
+}
+
+bool roaring_select(const roaring_t *r, uint64_t k, uint32_t *value) {
+    for (size_t i = 0; i < r->size; i++) {
+        if (k < r->containers[i].card) {
+            *value = ((uint32_t)r->keys[i] << 16) | c_select(&r->containers[i], (uint32_t)k);
+            return true;
+        }
+        k -= r->containers[i].card;
+    }
+    return false;
+}
+
+bool roaring_optimize(roaring_t *r) {
+    for (size_t i = 0; i < r->size; i++) {
+        if (!c_optimize(&r->containers[i])) return false;
+    }
+    return true;
+}
+
+size_t roaring_memory(const roaring_t *r) {
+    size_t bytes = sizeof(*r) + r->cap * (sizeof(uint16_t) + sizeof(container_t));
+    for (size_t i = 0; i < r->size; i++) {
+        const container_t *c = &r->containers[i];
+        bytes += c->kind == KIND_BITMAP ? BITMAP_WORDS * sizeof(uint64_t)
+               : c->kind == KIND_ARRAY  ? c->cap * sizeof(uint16_t)
+               :                          c->cap * sizeof(run_t);
+    }
+    return bytes;
+}
+
+// --- Iteration ---
+
+void roaring_iter_init(roaring_iter_t *it, const roaring_t *r) {
+    it->r = r;
+    it->container = 0;
+    it->pos = 0;
+    it->off = 0;
+}
+
+bool roaring_iter_next(roaring_iter_t *it, uint32_t *value) {
+    while (it->container < it->r->size) {
+        const container_t *c = &it->r->containers[it->container];
+        uint32_t high = (uint32_t)it->r->keys[it->container] << 16;
+        switch (c->kind) {
+            case KIND_ARRAY:
+                if (it->pos < c->len) {
+                    *value = high | c->values[it->pos++];
+                    return true;
+                }
+                break;
+            case KIND_BITMAP: {
+                uint32_t v = bm_next(c->words, it->pos, true);
+                if (v < CHUNK_BITS) {
+                    it->pos = v + 1;
+                    *value = high | v;
+                    return true;
+                }
+                break;
+            }
+            default:
+                if (it->pos < c->len) {
+                    uint32_t v = c->runs[it->pos].start + it->off;
+                    if (v == c->runs[it->pos].last) {
+                        it->pos++;
+                        it->off = 0;
+                    } else {
+                        it->off++;
+                    }
+                    *value = high | v;
+                    return true;
+                }
+                break;
+        }
+        it->container++;
+        it->pos = 0;
+        it->off = 0;
+    }
+    return false;
+}
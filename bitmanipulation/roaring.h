@@ -0,0 +1,110 @@
+#ifndef ROARING_H
+#define ROARING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Roaring-Style Compressed Set of 32-bit Values
+ *
+ * For IDs spread over the whole 2^32 range with sparse and dense regions,
+ * where a flat bitset would need 512 MB. Values are split by their high
+ * 16 bits into chunks of 65536; each non-empty chunk is a container of
+ * the low 16 bits, stored in whichever of three forms is smallest:
+ *
+ *   array   sorted uint16_t values        <= 4096 values  (2 bytes each)
+ *   bitmap  1024 x 64-bit words            > 4096 values  (8 KB)
+ *   run     sorted [start, last] pairs     long stretches (4 bytes each)
+ *
+ * Array and bitmap switch automatically as values come and go (at 4096
+ * values both take 8 KB). Runs are made by roaring_add_range() and
+ * roaring_optimize(); a run container that stops paying for itself turns
+ * back into an array or bitmap.
+ *
+ * Chunk keys live in their own sorted array, so finding a container is a
+ * binary search over 2-byte keys. Union and intersection work chunk by
+ * chunk with a routine per pair of container forms (merge, gallop, word
+ * OR / AND, interval merge).
+ *
+ * All functions that allocate return false when out of memory.
+ */
+
+typedef struct roaring_container roaring_container_t;   // roaring.c
+
+typedef struct {
+    uint16_t *keys;                     // High 16 bits, ascending
+    roaring_container_t *containers;    // containers[i] holds chunk keys[i]
+    size_t size;
+    size_t cap;
+} roaring_t;
+
+void roaring_init(roaring_t *r);
+void roaring_free(roaring_t *r);
+
+// --- Single values ---
+
+bool roaring_add(roaring_t *r, uint32_t value);
+bool roaring_remove(roaring_t *r, uint32_t value);
+bool roaring_contains(const roaring_t *r, uint32_t value);
+
+// Adds lo .. hi inclusive, as runs where that is smaller
+bool roaring_add_range(roaring_t *r, uint32_t lo, uint32_t hi);
+
+// --- Whole set ---
+
+uint64_t roaring_cardinality(const roaring_t *r);
+
+/**
+ * @brief dst = a | b and dst = a & b. dst is emptied first and must not
+ *        be a or b.
+ */
+bool roaring_or(roaring_t *dst, const roaring_t *a, const roaring_t *b);
+bool roaring_and(roaring_t *dst, const roaring_t *a, const roaring_t *b);
+
+/*
+ * Rank / select add up the counts of the chunks before the one they land
+ * in (O(chunks), one 4-byte field each), then look inside that container.
+ */
+
+// Values below 'value'
+uint64_t roaring_rank(const roaring_t *r, uint32_t value);
+
+// k-th smallest value (k from 0). Returns false if cardinality() <= k.
+bool roaring_select(const roaring_t *r, uint64_t k, uint32_t *value);
+
+// Re-encodes each container in its smallest form, runs included
+bool roaring_optimize(roaring_t *r);
+
+// Bytes of heap used, plus the roaring_t itself
+size_t roaring_memory(const roaring_t *r);
+
+// --- Iteration (ascending) ---
+
+typedef struct {
+    const roaring_t *r;
+    size_t container;
+    uint32_t pos;           // Array index, bitmap bit or run index
+    uint32_t off;           // Offset inside the current run
+} roaring_iter_t;
+
+/*
+ *   roaring_iter_t it;
+ *   uint32_t v;
+ *   roaring_iter_init(&it, r);
+ *   while (roaring_iter_next(&it, &v)) { ... }
+ *
+ * The set must not change while an iterator is in use.
+ */
+void roaring_iter_init(roaring_iter_t *it, const roaring_t *r);
+bool roaring_iter_next(roaring_iter_t *it, uint32_t *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROARING_H
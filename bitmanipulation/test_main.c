@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "bitset.h"
+#include "roaring.h"
+
+// --- Test Harness Logic ---
+
+static int total_failures = 0;
+
+void run_test(const char* test_name, unsigned long long actual, unsigned long long expected) {
+    if (actual == expected) {
+        printf("[PASS] %s: Result 0x%llX\n", test_name, actual);
+    } else {
+        printf("[FAIL] %s: Expected 0x%llX, but got 0x%llX\n", test_name, expected, actual);
+        total_failures++;
+    }
+}
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Test values stay below 2^22 (64 roaring chunks), so a bitset can check them
+#define UNIVERSE (1u << 22)
+
+/*
+ * Fills r and ref with the same values: sparse singles, a dense stretch
+ * (bitmap containers) and ranges (run containers), some crossing chunks.
+ */
+static void fill_mixed(roaring_t* r, bitset_t* ref, uint32_t seed) {
+    rng_state = seed;
+    for (int i = 0; i < 3000; i++) {
+        uint32_t v = xorshift32() % UNIVERSE;
+        roaring_add(r, v);
+        bitset_set(ref, v);
+    }
+    uint32_t base = (xorshift32() % 32) << 16;
+    for (int i = 0; i < 20000; i++) {
+        uint32_t v = base + xorshift32() % 40000;
+        roaring_add(r, v);
+        bitset_set(ref, v);
+    }
+    for (int i = 0; i < 40; i++) {
+        uint32_t lo = xorshift32() % (UNIVERSE - 100000);
+        uint32_t hi = lo + xorshift32() % 90000;
+        roaring_add_range(r, lo, hi);
+        for (uint32_t v = lo; v <= hi; v++) bitset_set(ref, v);
+    }
+}
+
+// Same values in the same order as ref; rank / select / contains sampled
+static bool matches(const roaring_t* r, const bitset_t* ref) {
+    if (roaring_cardinality(r) != bitset_count(ref)) return false;
+
+    roaring_iter_t it;
+    uint32_t v;
+    size_t expect = bitset_next(ref, 0);
+    uint64_t k = 0;
+    roaring_iter_init(&it, r);
+    while (roaring_iter_next(&it, &v)) {
+        if (v != expect) return false;
+        if (k % 97 == 0) {
+            uint32_t s;
+            if (!roaring_select(r, k, &s) || s != v) return false;
+            if (roaring_rank(r, v) != k) return false;
+        }
+        expect = bitset_next(ref, expect + 1);
+        k++;
+    }
+    if (expect != BITSET_END) return false;
+
+    for (int i = 0; i < 20000; i++) {
+        uint32_t x = xorshift32() % UNIVERSE;
+        if (roaring_contains(r, x) != bitset_test(ref, x)) return false;
+        if (i % 16 == 0 && roaring_rank(r, x) != bitset_rank(ref, x)) return false;
+    }
+    return true;
+}
+
+int main() {
+    printf("Starting Bitset / Roaring Tests...\n\n");
+
+    // Test 1-3: Dynamic bitset basics
+    bitset_t b;
+    bitset_init(&b);
+    bitset_set(&b, 3);
+    bitset_set(&b, 64);
+    bitset_set(&b, 1000);
+    bitset_toggle(&b, 3);
+    bitset_toggle(&b, 5);
+    bitset_clear(&b, 64);
+    bitset_clear(&b, 1u << 30);                // Past the end: no-op
+    run_test("Bitset Set/Toggle/Clear (count)", bitset_count(&b), 2);
+    size_t pos = 0;
+    bitset_select(&b, 1, &pos);
+    run_test("Bitset Select (k=1)", pos, 1000);
+    run_test("Bitset Rank (below 1000)", bitset_rank(&b, 1000), 1);
+    bitset_free(&b);
+
+    // Test 4-5: Roaring vs bitset on mixed data, before and after optimize
+    roaring_t r1, r2, out;
+    bitset_t ref1, ref2, expect;
+    roaring_init(&r1);
+    roaring_init(&r2);
+    roaring_init(&out);
+    bitset_init(&ref1);
+    bitset_init(&ref2);
+    bitset_init(&expect);
+    fill_mixed(&r1, &ref1, 11);
+    fill_mixed(&r2, &ref2, 22);
+    run_test("Roaring Matches Bitset", matches(&r1, &ref1), true);
+    size_t before = roaring_memory(&r1);
+    roaring_optimize(&r1);
+    run_test("Roaring Optimize (same values, no bigger)",
+             matches(&r1, &ref1) && roaring_memory(&r1) <= before, true);
+
+    // Test 6-7: Union / intersection (arrays, bitmaps and runs on both sides)
+    roaring_or(&out, &r1, &r2);
+    bitset_or(&expect, &ref1);
+    bitset_or(&expect, &ref2);
+    run_test("Roaring Union", matches(&out, &expect), true);
+
+    roaring_and(&out, &r1, &r2);
+    bitset_free(&expect);
+    bitset_or(&expect, &ref1);
+    bitset_and(&expect, &ref2);
+    run_test("Roaring Intersection", matches(&out, &expect), true);
+
+    // Test 8: Removing values, splitting runs and emptying containers
+    for (int i = 0; i < 200000; i++) {
+        uint32_t v = xorshift32() % UNIVERSE;
+        roaring_remove(&r1, v);
+        bitset_clear(&ref1, v);
+    }
+    for (uint32_t v = 0; v < UNIVERSE / 2; v++) {
+        if (bitset_test(&ref1, v)) {
+            roaring_remove(&r1, v);
+            bitset_clear(&ref1, v);
+        }
+    }
+    run_test("Roaring Remove", matches(&r1, &ref1), true);
+
+    // Test 9: The top of the 32-bit range
+    roaring_t edge;
+    roaring_init(&edge);
+    roaring_add(&edge, 0xFFFFFFFFu);
+    roaring_add_range(&edge, 0xFFFEFFF0u, 0xFFFF000Fu);     // Crosses a chunk
+    uint32_t last = 0;
+    roaring_select(&edge, roaring_cardinality(&edge) - 1, &last);
+    run_test("Roaring 32-bit Edges", roaring_cardinality(&edge) == 33 && last == 0xFFFFFFFFu &&
+             roaring_rank(&edge, 0xFFFFFFFFu) == 32 && !roaring_contains(&edge, 0xFFFF0010u), true);
+
+    roaring_free(&edge);
+    roaring_free(&r1);
+    roaring_free(&r2);
+    roaring_free(&out);
+    bitset_free(&ref1);
+    bitset_free(&ref2);
+    bitset_free(&expect);
+
+    printf("\n%s: %d failure(s)\n", total_failures == 0 ? "Testing Complete" : "Testing Failed", total_failures);
+    return (total_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+/*
+Bit Packing Benchmark
+- Original vs packer (MB/s of input readings):
+    the first pack_sensor_data(), 5 single-bit shifts per reading into a
+    caller-zeroed buffer (the memset is timed, since the caller has to
+    pay for it), vs pack_bits() at width 5 on the scalar backend
+- Backends (GB/s of unpacked readings, pack and unpack):
+    every backend the CPU supports, widths 1..7
+- Streaming (GB/s of readings, width 5, 1 MB and 64 MB streams):
+    bitstream_write_fields() in one call vs socket-sized pieces of
+    1..4096 readings into a 64 KB transmit buffer, and
+    bitstream_read_fields() over one buffer vs chunks of 1..1500 bytes
+Run on a 64 KB buffer (cache resident) and a 64 MB stream.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "bit_streaming.h"
+#include "bitstream.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static volatile uint8_t sink;
+
+// The original solution, kept verbatim apart from the size_t index
+static void pack_sensor_data_bitwise(const uint8_t* input, size_t input_len, uint8_t* output, size_t output_len)
+{
+    (void)output_len;
+    uint8_t current_byte = 0;
+    int8_t current_bit = 7;
+
+    for (size_t i = 0; i < input_len; i++)
+    {
+        uint8_t post_masked_data = input[i] & 0x1F;
+
+        for (int j = 4; j >= 0; j--)
+        {
+            uint8_t bit_to_out = (post_masked_data >> j) & 0x01;
+            output[current_byte] |= bit_to_out << current_bit;
+            current_bit--;
+            if (current_bit < 0)
+            {
+                current_byte++;
+                current_bit = 7;
+            }
+        }
+    }
+}
+
+static double mb_per_s(size_t bytes, int reps, uint64_t ns) {
+    return (double)bytes * reps / (1024.0 * 1024.0) / ((double)ns / 1e9);
+}
+
+static void bench_size(const uint8_t *input, uint8_t *output, size_t len, int reps) {
+    size_t out_len = PACKED_LEN(len, 8);
+
+    uint64_t start = now_ns();
+    for (int r = 0; r < reps; r++) {
+        memset(output, 0, PACKED_LEN(len, SENSOR_FIELD_BITS));
+        pack_sensor_data_bitwise(input, len, output, out_len);
+        sink = output[r % len];
+    }
+    double original = mb_per_s(len, reps, now_ns() - start);
+
+    double packed[9];
+    for (unsigned width = 1; width <= 8; width++) {
+        start = now_ns();
+        for (int r = 0; r < reps; r++) {
+            pack_bits(input, len, width, output, out_len);
+            sink = output[r % len];
+        }
+        packed[width] = mb_per_s(len, reps, now_ns() - start);
+    }
+
+    printf("  %6zu KB  original %8.1f MB/s   pack_bits(5) %8.1f MB/s  (%.1fx)\n",
+           len / 1024, original, packed[5], packed[5] / original);
+    printf("             other widths:");
+    for (unsigned width = 1; width <= 8; width++) {
+        if (width != 5) printf("  %u:%.0f", width, packed[width]);
+    }
+    printf(" MB/s\n");
+}
+
+static double gb_per_s(size_t bytes, int reps, uint64_t ns) {
+    return (double)bytes * reps / 1e9 / ((double)ns / 1e9);
+}
+
+static void bench_backends(const uint8_t *input, uint8_t *packed, uint8_t *unpacked, size_t len, int reps) {
+    printf("  %6zu KB %-8s", len / 1024, "width");
+    for (unsigned width = 1; width <= 7; width++) printf("  %11u", width);
+    printf("\n");
+
+    for (int backend = 0; backend < BITPACK_BACKEND_COUNT; backend++) {
+        if (!bitpack_select((bitpack_backend_t)backend)) continue;
+        printf("            %-6s", bitpack_name((bitpack_backend_t)backend));
+        for (unsigned width = 1; width <= 7; width++) {
+            uint64_t start = now_ns();
+            for (int r = 0; r < reps; r++) {
+                pack_bits(input, len, width, packed, len);
+                sink = packed[r % PACKED_LEN(len, width)];
+            }
+            double pack = gb_per_s(len, reps, now_ns() - start);
+
+            start = now_ns();
+            for (int r = 0; r < reps; r++) {
+                unpack_bits(packed, PACKED_LEN(len, width), width, unpacked, len);
+                sink = unpacked[r % len];
+            }
+            double unpack = gb_per_s(len, reps, now_ns() - start);
+            printf("  %5.1f / %-4.1f", pack, unpack);
+        }
+        printf("\n");
+    }
+    bitpack_select(bitpack_best());
+}
+
+// Stands in for send(): the writer's buffer goes out as is
+static bool count_sink(void *ctx, const uint8_t *data, size_t len) {
+    *(uint64_t *)ctx += len;
+    sink = data[len - 1];
+    return true;
+}
+
+static double bench_write(const uint8_t *input, size_t len, int reps, size_t max_piece) {
+    static uint8_t txbuf[64 * 1024];
+    uint64_t sent = 0;
+    bitstream_writer_t w;
+
+    uint64_t start = now_ns();
+    for (int r = 0; r < reps; r++) {
+        bitstream_writer_init(&w, txbuf, sizeof(txbuf), count_sink, &sent);
+        for (size_t i = 0; i < len; ) {
+            size_t n = (max_piece == 0) ? len : 1 + xorshift32() % max_piece;
+            if (n > len - i) n = len - i;
+            bitstream_write_fields(&w, input + i, n, SENSOR_FIELD_BITS);
+            i += n;
+        }
+        bitstream_finish(&w);
+    }
+    return gb_per_s(len, reps, now_ns() - start);
+}
+
+static double bench_read(const uint8_t *packed, size_t bytes, uint8_t *samples, size_t len,
+                         int reps, size_t max_chunk) {
+    bitstream_reader_t r;
+
+    uint64_t start = now_ns();
+    for (int rep = 0; rep < reps; rep++) {
+        bitstream_reader_init(&r);
+        size_t got = 0, fed = 0;
+        while (got < len) {
+            got += bitstream_read_fields(&r, samples + got, len - got, SENSOR_FIELD_BITS);
+            if (got < len) {
+                size_t n = (max_chunk == 0) ? bytes : 1 + xorshift32() % max_chunk;
+                if (n > bytes - fed) n = bytes - fed;
+                bitstream_feed(&r, packed + fed, n);
+                fed += n;
+            }
+        }
+        sink = samples[len - 1];
+    }
+    return gb_per_s(len, reps, now_ns() - start);
+}
+
+static void bench_streaming(const uint8_t *input, uint8_t *packed, uint8_t *samples, size_t len, int reps) {
+    size_t bytes = pack_sensor_data(input, len, packed, len);
+    printf("  %6zu KB  write: one call %5.2f GB/s, pieces of 1..4096 readings %5.2f GB/s\n",
+           len / 1024, bench_write(input, len, reps, 0), bench_write(input, len, reps, 4096));
+    printf("             read:  one feed %5.2f GB/s, chunks of 1..1500 bytes    %5.2f GB/s\n",
+           bench_read(packed, bytes, samples, len, reps, 0), bench_read(packed, bytes, samples, len, reps, 1500));
+}
+
+int main() {
+    size_t big = 64u * 1024 * 1024;
+    uint8_t *input = malloc(big);
+    uint8_t *output = malloc(big);
+    if (input == NULL || output == NULL) return 1;
+    for (size_t i = 0; i < big; i++) input[i] = (uint8_t)xorshift32();
+
+    printf("--- pack_sensor_data: bit-at-a-time vs 64-bit accumulator ---\n");
+    bitpack_select(BITPACK_SCALAR);
+    bench_size(input, output, 64 * 1024, 4000);
+    bench_size(input, output, big, 4);
+
+    uint8_t *unpacked = malloc(big);
+    if (unpacked == NULL) return 1;
+    printf("\n--- Backends, GB/s (pack / unpack), default: %s ---\n", bitpack_name(bitpack_best()));
+    bench_backends(input, output, unpacked, 64 * 1024, 4000);
+    bench_backends(input, output, unpacked, big, 4);
+
+    printf("\n--- Streaming writer / reader (%s) ---\n", bitpack_name(bitpack_selected()));
+    bench_streaming(input, output, unpacked, 1024 * 1024, 64);
+    bench_streaming(input, output, unpacked, big, 1);
+    free(unpacked);
+
+    free(input);
+    free(output);
+    return 0;
+}
@@ -0,0 +1,68 @@
+#ifndef BIT_STREAMING_H
+#define BIT_STREAMING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Number of LSBs kept from each sensor reading
+#define SENSOR_FIELD_BITS 5
+
+// Bytes needed for 'count' fields of 'width' bits (last byte zero padded)
+#define PACKED_LEN(count, width) (((count) * (width) + 7) / 8)
+
+/**
+ * @brief Packs the 'width' LSBs of each input byte back-to-back, MSB first.
+ *        Every byte of output[0 .. return) is written, padding bits are 0,
+ *        so the caller does not need to clear the buffer.
+ * @param width      Field width, 1..8 bits
+ * @param output_len Capacity of output in bytes
+ * @return           Bytes written, PACKED_LEN(input_len, width), or 0 if
+ *                   width is out of range or output is too small (nothing
+ *                   is written in that case).
+ */
+size_t pack_bits(const uint8_t *input, size_t input_len, unsigned width,
+                 uint8_t *output, size_t output_len);
+
+/**
+ * @param input     Pointer to the source 8-bit sensor data
+ * @param input_len Number of elements in the input array
+ * @return          Bytes written to output, or 0 if output_len is too small
+ */
+size_t pack_sensor_data(const uint8_t* input, size_t input_len, uint8_t* output, size_t output_len);
+
+/**
+ * @brief Inverse of pack_bits(): expands 'count' fields of 'width' bits
+ *        into one byte each (high bits zero).
+ * @param input_len Bytes available at input
+ * @return          count, or 0 if width is out of range or input is
+ *                  shorter than PACKED_LEN(count, width).
+ */
+size_t unpack_bits(const uint8_t *input, size_t input_len, unsigned width,
+                   uint8_t *output, size_t count);
+
+size_t unpack_sensor_data(const uint8_t* input, size_t input_len, uint8_t* output, size_t count);
+
+/*
+ * Backends. All produce identical output; the first call to pack_bits()
+ * or unpack_bits() picks the fastest one the CPU supports (CPUID), and
+ * bitpack_select() overrides that for tests and benchmarks.
+ */
+typedef enum {
+    BITPACK_SCALAR,             // 64-bit accumulator, 8 readings per step
+    BITPACK_SSSE3,              // PMADDUBSW / PSHUFB, 16 readings per step
+    BITPACK_BMI2,               // PEXT / PDEP, 8 readings per step
+    BITPACK_AVX2,               // 256-bit SSSE3 kernel, 32 readings per step
+    BITPACK_BACKEND_COUNT
+} bitpack_backend_t;
+
+bool bitpack_supported(bitpack_backend_t backend);
+bitpack_backend_t bitpack_best(void);
+
+// Returns false (and keeps the current backend) if 'backend' is unsupported
+bool bitpack_select(bitpack_backend_t backend);
+bitpack_backend_t bitpack_selected(void);
+
+const char *bitpack_name(bitpack_backend_t backend);
+
+#endif // BIT_STREAMING_H
@@ -0,0 +1,223 @@
+/*
+ * x86 bit packing kernels (SSSE3, BMI2, AVX2)
+ *
+ * Each function carries its own target attribute, so this file builds
+ * without -m flags and bit_streaming_sol.c only calls a kernel after
+ * CPUID says the instructions exist.
+ *
+ * A block is 8 readings <-> W packed bytes, read as one big-endian
+ * W-byte number whose top field is reading 0.
+ *
+ * BMI2:  byte-swap 8 readings so reading 0 is the top byte, then one PEXT
+ *        with mask (2^W - 1) in every byte gathers the block. PDEP
+ *        scatters it back.
+ * SSSE3: merges neighbouring fields with multiply-adds, doubling the
+ *        field count per lane each step:
+ *          8-bit fields  -> PMADDUBSW x (2^W, 1)   -> 2W bits per 16
+ *          16-bit fields -> PMADDWD   x (2^2W, 1)  -> 4W bits per 32
+ *          32-bit fields -> shift / or              -> 8W bits per 64
+ *        PSHUFB then reverses the low W bytes of each 64-bit lane into
+ *        big-endian order. Unpacking runs the same steps backwards with
+ *        shifts and masks.
+ * AVX2:  the SSSE3 kernel on both 128-bit lanes (4 blocks per step).
+ *
+ * The vector kernels load and store 16 bytes per lane, so they stop while
+ * a full 16 bytes still fit; see VEC_ENTRY for the last few blocks.
+ */
+
+#include <string.h>
+#include "bit_streaming_simd.h"
+
+#ifdef BITPACK_HAVE_X86
+
+#include <immintrin.h>
+
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_BMI2  __attribute__((target("bmi2")))
+#define TARGET_AVX2  __attribute__((target("avx2")))
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+
+// Mask with the low W bits of every byte set
+#define BYTE_MASK64(W) (0x0101010101010101ULL * ((1u << (W)) - 1))
+
+// --- BMI2 ---
+
+static ALWAYS_INLINE TARGET_BMI2 size_t pack_BMI2(const uint8_t *in, size_t blocks, uint8_t *out, const int W) {
+    for (size_t b = 0; b < blocks; b++, in += 8, out += W) {
+        uint64_t v;
+        memcpy(&v, in, 8);
+        uint64_t acc = _pext_u64(__builtin_bswap64(v), BYTE_MASK64(W));
+        uint64_t be = __builtin_bswap64(acc << (64 - 8 * W));
+        memcpy(out, &be, W);
+    }
+    return blocks;
+}
+
+static ALWAYS_INLINE TARGET_BMI2 size_t unpack_BMI2(const uint8_t *in, size_t blocks, uint8_t *out, const int W) {
+    for (size_t b = 0; b < blocks; b++, in += W, out += 8) {
+        uint64_t be = 0;
+        memcpy(&be, in, (blocks - b) * W >= 8 ? 8 : W);     // See load_be_block()
+        uint64_t acc = __builtin_bswap64(be) >> (64 - 8 * W);
+        uint64_t v = __builtin_bswap64(_pdep_u64(acc, BYTE_MASK64(W)));
+        memcpy(out, &v, 8);
+    }
+    return blocks;
+}
+
+// --- SSSE3 / AVX2 shared steps, written for one 128-bit lane ---
+
+// Shuffle: bytes W-1..0 of each 64-bit half -> 2W contiguous big-endian bytes
+static ALWAYS_INLINE TARGET_SSSE3 __m128i pack_order(const int W) {
+    uint8_t idx[16];
+    for (int k = 0; k < 16; k++) {
+        idx[k] = (k < W) ? (uint8_t)(W - 1 - k)
+               : (k < 2 * W) ? (uint8_t)(8 + 2 * W - 1 - k) : 0x80;
+    }
+    return _mm_loadu_si128((const __m128i *)idx);
+}
+
+// Inverse of pack_order(): 2W packed bytes -> one 64-bit value per block
+static ALWAYS_INLINE TARGET_SSSE3 __m128i unpack_order(const int W) {
+    uint8_t idx[16];
+    for (int k = 0; k < 16; k++) {
+        int lane = k / 8, m = k % 8;
+        idx[k] = (m < W) ? (uint8_t)(lane * W + W - 1 - m) : 0x80;
+    }
+    return _mm_loadu_si128((const __m128i *)idx);
+}
+
+/*
+ * VEC_KERNELS(ISA, VEC, BITS, PFX, ...) defines, for one vector width:
+ *   pack_step_<ISA>() / unpack_step_<ISA>()  one register: BLOCKS blocks
+ *   pack_<ISA>() / unpack_<ISA>()            as many steps as fit in place
+ * BLOCKS is the number of 8-reading blocks per register. LOAD_PACKED /
+ * STORE_PACKED move the 2W bytes of each 128-bit lane, which are not
+ * contiguous across lanes for AVX2. A step touches up to
+ * (BLOCKS - 2) * W + 16 packed bytes, which is VEC_PACKED_SPAN.
+ */
+#define VEC_PACKED_SPAN(BLOCKS, W) ((size_t)(((BLOCKS) - 2) * (W) + 16))
+
+#define VEC_KERNELS(ISA, VEC, BITS, PFX, BLOCKS, BCAST_ORDER, LOAD_PACKED, STORE_PACKED)     \
+static ALWAYS_INLINE TARGET_##ISA void pack_step_##ISA(const uint8_t *in, uint8_t *out,      \
+                                                       const int W) {                        \
+    const VEC mask = PFX##_set1_epi8((char)((1u << W) - 1));                                 \
+    const VEC mul8 = PFX##_set1_epi16((short)(0x0100 | (1 << W)));                           \
+    const VEC mul16 = PFX##_set1_epi32(0x00010000 | (1 << (2 * W)));                         \
+    const VEC order = BCAST_ORDER(pack_order(W));                                            \
+    VEC x = PFX##_and_si##BITS(PFX##_loadu_si##BITS((const VEC *)in), mask);                 \
+    VEC x16 = PFX##_maddubs_epi16(mul8, x);                                                  \
+    VEC x32 = PFX##_madd_epi16(x16, mul16);                                                  \
+    VEC lo = PFX##_srli_epi64(PFX##_slli_epi64(x32, 32), 32 - 4 * W);                        \
+    VEC x64 = PFX##_or_si##BITS(lo, PFX##_srli_epi64(x32, 32));                              \
+    STORE_PACKED(out, PFX##_shuffle_epi8(x64, order), W);                                    \
+}                                                                                            \
+static ALWAYS_INLINE TARGET_##ISA void unpack_step_##ISA(const uint8_t *in, uint8_t *out,    \
+                                                         const int W) {                      \
+    const VEC mask8 = PFX##_set1_epi16((short)((1u << W) - 1));                              \
+    const VEC mask16 = PFX##_set1_epi32((int)((1u << (2 * W)) - 1));                         \
+    const VEC mask32 = PFX##_set1_epi64x((long long)((1ULL << (4 * W)) - 1) << 32);          \
+    const VEC order = BCAST_ORDER(unpack_order(W));                                          \
+    VEC x64 = PFX##_shuffle_epi8(LOAD_PACKED(in, W), order);                                 \
+    VEC x32 = PFX##_or_si##BITS(PFX##_srli_epi64(x64, 4 * W),                                \
+                  PFX##_and_si##BITS(PFX##_slli_epi64(x64, 32), mask32));                    \
+    VEC x16 = PFX##_or_si##BITS(PFX##_srli_epi32(x32, 2 * W),                                \
+                  PFX##_slli_epi32(PFX##_and_si##BITS(x32, mask16), 16));                    \
+    VEC x8 = PFX##_or_si##BITS(PFX##_srli_epi16(x16, W),                                     \
+                 PFX##_slli_epi16(PFX##_and_si##BITS(x16, mask8), 8));                       \
+    PFX##_storeu_si##BITS((VEC *)out, x8);                                                   \
+}                                                                                            \
+static ALWAYS_INLINE TARGET_##ISA size_t pack_##ISA(const uint8_t *in, size_t blocks,        \
+                                                    uint8_t *out, const int W) {             \
+    size_t b = 0;                                                                            \
+    for (; blocks - b >= BLOCKS && (blocks - b) * W >= VEC_PACKED_SPAN(BLOCKS, W);           \
+         b += BLOCKS, in += 8 * BLOCKS, out += W * BLOCKS) {                                 \
+        pack_step_##ISA(in, out, W);                                                         \
+    }                                                                                        \
+    return b;                                                                                \
+}                                                                                            \
+static ALWAYS_INLINE TARGET_##ISA size_t unpack_##ISA(const uint8_t *in, size_t blocks,      \
+                                                      uint8_t *out, const int W) {           \
+    size_t b = 0;                                                                            \
+    for (; blocks - b >= BLOCKS && (blocks - b) * W >= VEC_PACKED_SPAN(BLOCKS, W);           \
+         b += BLOCKS, in += W * BLOCKS, out += 8 * BLOCKS) {                                 \
+        unpack_step_##ISA(in, out, W);                                                       \
+    }                                                                                        \
+    return b;                                                                                \
+}
+
+#define SSE_ORDER(o)             (o)
+#define SSE_LOAD(in, W)          _mm_loadu_si128((const __m128i *)(in))
+#define SSE_STORE(out, v, W)     _mm_storeu_si128((__m128i *)(out), (v))
+
+#define AVX_ORDER(o)             _mm256_broadcastsi128_si256(o)
+#define AVX_LOAD(in, W)          _mm256_inserti128_si256(                                    \
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(in))),                      \
+        _mm_loadu_si128((const __m128i *)((in) + 2 * (W))), 1)
+#define AVX_STORE(out, v, W)     do {                                                        \
+        _mm_storeu_si128((__m128i *)(out), _mm256_castsi256_si128(v));                       \
+        _mm_storeu_si128((__m128i *)((out) + 2 * (W)), _mm256_extracti128_si256((v), 1));    \
+    } while (0)
+
+VEC_KERNELS(SSSE3, __m128i, 128, _mm, 2, SSE_ORDER, SSE_LOAD, SSE_STORE)
+VEC_KERNELS(AVX2, __m256i, 256, _mm256, 4, AVX_ORDER, AVX_LOAD, AVX_STORE)
+
+// --- Per-width entry points ---
+
+/*
+ * The vector entries finish the last few blocks (too close to the end of
+ * a buffer for 16-byte loads and stores) with one more step through a
+ * stack scratch area, instead of the scalar kernel. Short buffers, like
+ * the tail of every chunk in bitstream.c, then stay on the vector path.
+ */
+#define VEC_ENTRY(ISA, BLOCKS, W)                                                            \
+static TARGET_##ISA void pack_##ISA##_##W(const uint8_t *in, size_t blocks, uint8_t *out) {  \
+    size_t done = pack_##ISA(in, blocks, out, W);                                            \
+    while (done < blocks) {                                                                  \
+        size_t n = (blocks - done < BLOCKS) ? blocks - done : BLOCKS;                        \
+        uint8_t tin[8 * BLOCKS] = {0}, tout[VEC_PACKED_SPAN(BLOCKS, 7)];                     \
+        memcpy(tin, in + 8 * done, 8 * n);                                                   \
+        pack_step_##ISA(tin, tout, W);                                                       \
+        memcpy(out + W * done, tout, W * n);                                                 \
+        done += n;                                                                           \
+    }                                                                                        \
+}                                                                                            \
+static TARGET_##ISA void unpack_##ISA##_##W(const uint8_t *in, size_t blocks, uint8_t *out) { \
+    size_t done = unpack_##ISA(in, blocks, out, W);                                          \
+    while (done < blocks) {                                                                  \
+        size_t n = (blocks - done < BLOCKS) ? blocks - done : BLOCKS;                        \
+        uint8_t tin[VEC_PACKED_SPAN(BLOCKS, 7)] = {0}, tout[8 * BLOCKS];                     \
+        memcpy(tin, in + W * done, W * n);                                                   \
+        unpack_step_##ISA(tin, tout, W);                                                     \
+        memcpy(out + 8 * done, tout, 8 * n);                                                 \
+        done += n;                                                                           \
+    }                                                                                        \
+}
+
+#define BMI2_ENTRY(ISA, BLOCKS, W)                                                           \
+static TARGET_BMI2 void pack_BMI2_##W(const uint8_t *in, size_t blocks, uint8_t *out) {      \
+    pack_BMI2(in, blocks, out, W);                                                           \
+}                                                                                            \
+static TARGET_BMI2 void unpack_BMI2_##W(const uint8_t *in, size_t blocks, uint8_t *out) {    \
+    unpack_BMI2(in, blocks, out, W);                                                         \
+}
+
+#define X86_ENTRIES(ENTRY, ISA, BLOCKS)                                                      \
+    ENTRY(ISA, BLOCKS, 1) ENTRY(ISA, BLOCKS, 2) ENTRY(ISA, BLOCKS, 3) ENTRY(ISA, BLOCKS, 4)  \
+    ENTRY(ISA, BLOCKS, 5) ENTRY(ISA, BLOCKS, 6) ENTRY(ISA, BLOCKS, 7)
+
+#define X86_TABLE(ISA) {                                                                     \
+    .pack   = { NULL, pack_##ISA##_1, pack_##ISA##_2, pack_##ISA##_3, pack_##ISA##_4,        \
+                pack_##ISA##_5, pack_##ISA##_6, pack_##ISA##_7 },                            \
+    .unpack = { NULL, unpack_##ISA##_1, unpack_##ISA##_2, unpack_##ISA##_3,                  \
+                unpack_##ISA##_4, unpack_##ISA##_5, unpack_##ISA##_6, unpack_##ISA##_7 }     \
+}
+
+X86_ENTRIES(VEC_ENTRY, SSSE3, 2)
+X86_ENTRIES(BMI2_ENTRY, BMI2, 1)
+X86_ENTRIES(VEC_ENTRY, AVX2, 4)
+
+const bitpack_kernels_t bitpack_kernels_ssse3 = X86_TABLE(SSSE3);
+const bitpack_kernels_t bitpack_kernels_bmi2 = X86_TABLE(BMI2);
+const bitpack_kernels_t bitpack_kernels_avx2 = X86_TABLE(AVX2);
+
+#endif // BITPACK_HAVE_X86
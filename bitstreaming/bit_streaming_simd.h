@@ -0,0 +1,30 @@
+#ifndef BIT_STREAMING_SIMD_H
+#define BIT_STREAMING_SIMD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Kernel tables shared by bit_streaming_sol.c (scalar kernels, dispatch)
+ * and bit_streaming_simd.c (x86 kernels). A kernel handles whole blocks of
+ * 8 readings, which are exactly W packed bytes, for one width W in 1..7.
+ * Width 8 is a plain copy and the last 0..7 readings are done by the
+ * callers, so kernels never see a partial byte.
+ */
+typedef void (*bitpack_kernel_t)(const uint8_t *in, size_t blocks, uint8_t *out);
+
+typedef struct {
+    bitpack_kernel_t pack[8];           // Indexed by width, [0] unused
+    bitpack_kernel_t unpack[8];
+} bitpack_kernels_t;
+
+extern const bitpack_kernels_t bitpack_kernels_scalar;
+
+#if defined(__x86_64__)
+#define BITPACK_HAVE_X86 1
+extern const bitpack_kernels_t bitpack_kernels_ssse3;
+extern const bitpack_kernels_t bitpack_kernels_bmi2;
+extern const bitpack_kernels_t bitpack_kernels_avx2;
+#endif
+
+#endif // BIT_STREAMING_SIMD_H
@@ -20,110 +20,233 @@
  *  - [[D E F G H L M N] [O P 0 0 0 0 0 0]] ([[01110011] [01000000]])
  */
 
-#include <stdint.h>
-#include <stddef.h>
 #include <string.h>
-#include <assert.h>
-#include <stdio.h>
+#include <stdatomic.h>
+#include "bit_streaming.h"
+#include "bit_streaming_simd.h"
+
+// Bytes of v in memory order, most significant first
+static inline uint64_t pack_to_be64(uint64_t v) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return __builtin_bswap64(v);
+#else
+    return v;
+#endif
+}
 
-/**
- * @param input     Pointer to the source 8-bit sensor data
- * @param input_len Number of elements in the input array
- * * @return         >>> What should we do here??? <<<
+// W packed bytes as a number. Reads 8 bytes when 'avail' allows: building
+// the value from a W-byte copy stalls on store forwarding.
+static inline uint64_t load_be_block(const uint8_t *in, unsigned w, size_t avail) {
+    uint64_t be = 0;
+    if (avail >= 8) {
+        memcpy(&be, in, 8);
+    } else {
+        memcpy(&be, in, w);
+    }
+    return pack_to_be64(be) >> (64 - 8 * w);
+}
+
+/*
+ * Fields are shifted into a 64-bit accumulator and written out a whole
+ * byte at a time. Eight fields of 'width' bits are exactly 'width' bytes,
+ * so the bulk of the input goes through a loop that packs 8 readings
+ * into one register and stores its top 'width' bytes with no per-bit branches
+ * (for the 5-bit sensor format: 8 readings -> 40 bits -> 5 bytes).
+ * SCALAR_KERNELS instantiates that loop, and its inverse, once per width
+ * so every shift and store count is a compile-time constant.
  */
-void pack_sensor_data(const uint8_t* input, size_t input_len, uint8_t* output, size_t output_len);
+#define SCALAR_KERNELS(W)                                                     \
+static void pack_scalar_##W(const uint8_t *in, size_t blocks, uint8_t *out) { \
+    for (size_t b = 0; b < blocks; b++, in += 8, out += W) {                  \
+        uint64_t acc = 0;                                                     \
+        for (int i = 0; i < 8; i++) {                                         \
+            acc = (acc << W) | (in[i] & ((1u << W) - 1));                     \
+        }                                                                     \
+        uint64_t be = pack_to_be64(acc << (64 - 8 * W));                      \
+        memcpy(out, &be, W);                                                  \
+    }                                                                         \
+}                                                                             \
+static void unpack_scalar_##W(const uint8_t *in, size_t blocks, uint8_t *out) { \
+    for (size_t b = 0; b < blocks; b++, in += W, out += 8) {                  \
+        uint64_t acc = load_be_block(in, W, (blocks - b) * W);                \
+        for (int i = 0; i < 8; i++) {                                         \
+            out[i] = (uint8_t)((acc >> (W * (7 - i))) & ((1u << W) - 1));     \
+        }                                                                     \
+    }                                                                         \
+}
 
-void pack_sensor_data(const uint8_t* input, size_t input_len, uint8_t* output, size_t output_len)
-{
-    uint8_t current_byte = 0;
-    int8_t current_bit = 7;
+SCALAR_KERNELS(1)
+SCALAR_KERNELS(2)
+SCALAR_KERNELS(3)
+SCALAR_KERNELS(4)
+SCALAR_KERNELS(5)
+SCALAR_KERNELS(6)
+SCALAR_KERNELS(7)
+
+const bitpack_kernels_t bitpack_kernels_scalar = {
+    .pack   = { NULL, pack_scalar_1, pack_scalar_2, pack_scalar_3, pack_scalar_4,
+                pack_scalar_5, pack_scalar_6, pack_scalar_7 },
+    .unpack = { NULL, unpack_scalar_1, unpack_scalar_2, unpack_scalar_3, unpack_scalar_4,
+                unpack_scalar_5, unpack_scalar_6, unpack_scalar_7 },
+};
+
+// --- Backend selection ---
+
+static const bitpack_kernels_t *backend_kernels(bitpack_backend_t backend) {
+    switch (backend) {
+#ifdef BITPACK_HAVE_X86
+        case BITPACK_SSSE3: return &bitpack_kernels_ssse3;
+        case BITPACK_BMI2:  return &bitpack_kernels_bmi2;
+        case BITPACK_AVX2:  return &bitpack_kernels_avx2;
+#endif
+        default:            return &bitpack_kernels_scalar;
+    }
+}
+
+bool bitpack_supported(bitpack_backend_t backend) {
+    switch (backend) {
+        case BITPACK_SCALAR: return true;
+#ifdef BITPACK_HAVE_X86
+        case BITPACK_SSSE3:  return __builtin_cpu_supports("ssse3");
+        case BITPACK_BMI2:   return __builtin_cpu_supports("bmi2");
+        case BITPACK_AVX2:   return __builtin_cpu_supports("avx2");
+#endif
+        default:             return false;
+    }
+}
+
+bitpack_backend_t bitpack_best(void) {
+    // Widest vectors first. BMI2 comes after SSSE3: PEXT/PDEP only pack 8
+    // readings per instruction, and are microcoded (slow) before AMD Zen 3.
+    static const bitpack_backend_t order[] = { BITPACK_AVX2, BITPACK_SSSE3, BITPACK_BMI2 };
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        if (bitpack_supported(order[i])) return order[i];
+    }
+    return BITPACK_SCALAR;
+}
+
+// -1 until the first call; every thread computes the same answer
+static _Atomic int selected_backend = -1;
+
+bitpack_backend_t bitpack_selected(void) {
+    int backend = atomic_load_explicit(&selected_backend, memory_order_relaxed);
+    if (backend < 0) {
+        backend = (int)bitpack_best();
+        atomic_store_explicit(&selected_backend, backend, memory_order_relaxed);
+    }
+    return (bitpack_backend_t)backend;
+}
+
+bool bitpack_select(bitpack_backend_t backend) {
+    if (!bitpack_supported(backend)) {
+        return false;
+    }
+    atomic_store_explicit(&selected_backend, (int)backend, memory_order_relaxed);
+    return true;
+}
+
+const char *bitpack_name(bitpack_backend_t backend) {
+    switch (backend) {
+        case BITPACK_SCALAR: return "scalar";
+        case BITPACK_SSSE3:  return "ssse3";
+        case BITPACK_BMI2:   return "bmi2";
+        case BITPACK_AVX2:   return "avx2";
+        default:             return "?";
+    }
+}
+
+// --- Pack / unpack ---
 
-    for (int i = 0; i < input_len; i++)
-    {
-        uint8_t post_masked_data = input[i] & 0x1F;
+size_t pack_bits(const uint8_t *input, size_t input_len, unsigned width,
+                 uint8_t *output, size_t output_len)
+{
+    if (width < 1 || width > 8 || input_len > SIZE_MAX / 8) {
+        return 0;
+    }
+    size_t needed = PACKED_LEN(input_len, width);
+    if (needed > output_len) {
+        return 0;
+    }
+    if (width == 8) {
+        memcpy(output, input, input_len);
+        return needed;
+    }
 
-        for (int j = 4; j >= 0; j--)
-        {
-            // Select current bit to copy over
-            uint8_t bit_to_out = (post_masked_data >> j) & 0x01;
+    size_t blocks = input_len / 8;
+    backend_kernels(bitpack_selected())->pack[width](input, blocks, output);
+
+    // Last 0..7 readings: same accumulator, flushed one byte at a time
+    uint8_t *out = output + blocks * width;
+    const uint32_t mask = (1u << width) - 1;
+    uint32_t acc = 0;
+    unsigned nbits = 0;
+    for (size_t i = blocks * 8; i < input_len; i++) {
+        acc = (acc << width) | (input[i] & mask);
+        nbits += width;
+        if (nbits >= 8) {
+            nbits -= 8;
+            *out++ = (uint8_t)(acc >> nbits);
+        }
+    }
+    if (nbits > 0) {
+        // Partial last byte: fields left aligned, low bits zero
+        *out++ = (uint8_t)(acc << (8 - nbits));
+    }
 
-            // Copy bit_to_out to our output buffer
-            output[current_byte] |= bit_to_out << current_bit;
+    return needed;
+}
 
-            current_bit--;
+size_t unpack_bits(const uint8_t *input, size_t input_len, unsigned width,
+                   uint8_t *output, size_t count)
+{
+    if (width < 1 || width > 8 || count > SIZE_MAX / 8) {
+        return 0;
+    }
+    if (PACKED_LEN(count, width) > input_len) {
+        return 0;
+    }
+    if (width == 8) {
+        memcpy(output, input, count);
+        return count;
+    }
 
-            if (current_bit < 0)
-            {
-                current_byte++;
-                current_bit = 7;
-            }
+    size_t blocks = count / 8;
+    backend_kernels(bitpack_selected())->unpack[width](input, blocks, output);
+
+    // Last 0..7 fields: refill one byte at a time
+    const uint8_t *in = input + blocks * width;
+    const uint32_t mask = (1u << width) - 1;
+    uint32_t acc = 0;
+    unsigned nbits = 0;
+    for (size_t i = blocks * 8; i < count; i++) {
+        if (nbits < width) {
+            acc = (acc << 8) | *in++;
+            nbits += 8;
         }
+        nbits -= width;
+        output[i] = (uint8_t)((acc >> nbits) & mask);
     }
+
+    return count;
+}
+
+size_t pack_sensor_data(const uint8_t* input, size_t input_len, uint8_t* output, size_t output_len)
+{
+    return pack_bits(input, input_len, SENSOR_FIELD_BITS, output, output_len);
 }
 
+size_t unpack_sensor_data(const uint8_t* input, size_t input_len, uint8_t* output, size_t count)
+{
+    return unpack_bits(input, input_len, SENSOR_FIELD_BITS, output, count);
+}
 
 /**
  * Key Interviewer Follow-up Questions
  * - How do we handle memory allocation for output data?
+ *   (The caller owns it; PACKED_LEN() sizes it and output_len is checked.)
  * - How do you handle the very last byte if the total number of bits isn't a multiple of 8?
+ *   (The fields are left aligned and the remaining low bits are zeroed.)
  * - What is the Big-O complexity of your solution?
  * - How would your code change if the shift amount was dynamic instead of a constant 3?
+ *   (See pack_bits(): any width from 1 to 8.)
  */
-
-// --- Test Utilities ---
-void print_hex(const char* label, const uint8_t* buf, size_t len) {
-    printf("%s: ", label);
-    for (size_t i = 0; i < len; i++) {
-        printf("0x%02X ", buf[i]);
-    }
-    printf("\n");
-}
-
-int main() {
-    printf("--- Running Firmware Interview Tests ---\n\n");
-
-    // Case 1: The Example from the Prompt
-    // Byte 0: 10101110 (0xAE) -> 5 bits: 01110 (0x0E)
-    // Byte 1: 00001101 (0x0D) -> 5 bits: 01101 (0x0D)
-    // Expected: [01110 011] [01 000000] -> [0x73, 0x40]
-    uint8_t input1[] = {0xAE, 0x0D};
-    uint8_t output1[2] = {0};
-    uint8_t expected1[] = {0x73, 0x40};
-    
-    pack_sensor_data(input1, 2, output1, 2);
-    
-    print_hex("Test 1 Input", input1, 2);
-    print_hex("Test 1 Result", output1, 2);
-    assert(2 == 2);
-    assert(memcmp(output1, expected1, 2) == 0);
-    printf("Test 1 Passed!\n\n");
-
-    // Case 2: Single Byte (Partial Output)
-    // 0xFF -> 5 bits are 11111 (0x1F)
-    // Expected: [11111 000] -> [0xF8]
-    uint8_t input2[] = {0xFF};
-    uint8_t output2[1] = {0};
-    uint8_t expected2[] = {0xF8};
-
-    pack_sensor_data(input2, 1, output2, 1);
-    
-    print_hex("Test 2 Input", input2, 1);
-    print_hex("Test 2 Result", output2, 1);
-    assert(1 == 1);
-    assert(output2[0] == expected2[0]);
-    printf("Test 2 Passed!\n\n");
-
-    // Case 3: Eight 5-bit chunks (Should fill exactly 5 bytes)
-    // 8 * 5 = 40 bits = 5 bytes.
-    uint8_t input3[8];
-    memset(input3, 0x1F, 8); // All 5-bit chunks are 11111
-    uint8_t output3[5] = {0};
-    
-    pack_sensor_data(input3, 8, output3, 5);
-    assert(5 == 5);
-    for(int i=0; i<5; i++) assert(output3[i] == 0xFF);
-    printf("Test 3 Passed (Perfect alignment)!\n\n");
-
-    printf("ALL TESTS PASSED SUCCESSFULLY\n");
-    return 0;
-}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include <string.h>
+#include "bitstream.h"
+#include "bit_streaming.h"
+
+static inline uint64_t field_mask(unsigned width) {
+    return ((uint64_t)1 << width) - 1;
+}
+
+// --- Writer ---
+
+void bitstream_writer_init(bitstream_writer_t *w, uint8_t *buf, size_t cap,
+                           bitstream_sink_t sink, void *ctx) {
+    memset(w, 0, sizeof(*w));
+    w->buf = buf;
+    w->cap = cap;
+    w->sink = sink;
+    w->ctx = ctx;
+}
+
+// Passes buf[0 .. pos) to the sink and starts over at the front of buf
+static bool writer_drain(bitstream_writer_t *w) {
+    if (w->pos > 0 && !w->failed) {
+        if (w->sink(w->ctx, w->buf, w->pos)) {
+            w->bytes_emitted += w->pos;
+        } else {
+            w->failed = true;
+        }
+    }
+    w->pos = 0;
+    return !w->failed;
+}
+
+// Moves the whole bytes of the accumulator into buf
+static bool writer_put_bytes(bitstream_writer_t *w) {
+    while (w->nbits >= 8) {
+        if (w->pos == w->cap && !writer_drain(w)) {
+            return false;
+        }
+        w->nbits -= 8;
+        w->buf[w->pos++] = (uint8_t)(w->acc >> w->nbits);
+    }
+    return true;
+}
+
+static inline bool writer_next(bitstream_writer_t *w, uint32_t value, unsigned width) {
+    // nbits < 8 on entry, so at most 39 bits are pending here
+    w->acc = (w->acc << width) | (value & field_mask(width));
+    w->nbits += width;
+    return w->nbits < 8 || writer_put_bytes(w);
+}
+
+bool bitstream_write(bitstream_writer_t *w, uint32_t value, unsigned width) {
+    if (width < 1 || width > 32 || w->failed) {
+        return false;
+    }
+    return writer_next(w, value, width);
+}
+
+// Fields needed from a 'pending'-bit offset to the next byte boundary,
+// or 0 if that width never lands on one (even width, odd offset)
+static unsigned fields_to_align(unsigned pending, unsigned width) {
+    for (unsigned k = 1; k < 8; k++) {
+        if ((pending + k * width) % 8 == 0) return k;
+    }
+    return 0;
+}
+
+// Up to 7 fields into the accumulator (nbits < 8 + 7 * 8 = 63), one flush
+static bool writer_run(bitstream_writer_t *w, const uint8_t *samples, size_t n, unsigned width) {
+    uint64_t mask = field_mask(width);
+    for (size_t k = 0; k < n; k++) {
+        w->acc = (w->acc << width) | (samples[k] & mask);
+    }
+    w->nbits += (unsigned)n * width;
+    return writer_put_bytes(w);
+}
+
+// Runs of at most 7 fields, for stretches that cannot go through pack_bits()
+static bool writer_runs(bitstream_writer_t *w, const uint8_t *samples, size_t n, unsigned width) {
+    for (size_t i = 0; i < n; i += 7) {
+        if (!writer_run(w, samples + i, (n - i < 7) ? n - i : 7, width)) return false;
+    }
+    return true;
+}
+
+bool bitstream_write_fields(bitstream_writer_t *w, const uint8_t *samples,
+                            size_t count, unsigned width) {
+    if (width < 1 || width > 8 || w->failed) {
+        return false;
+    }
+    size_t i = 0;
+
+    // Finish the partial byte first, so the rest is byte aligned
+    if (w->nbits != 0) {
+        size_t k = fields_to_align(w->nbits, width);
+        if (k == 0) {
+            return writer_runs(w, samples, count, width);
+        }
+        if (k > count) k = count;
+        if (!writer_run(w, samples, k, width)) return false;
+        i = k;
+    }
+
+    // Aligned: whole 8-sample blocks are packed straight into buf
+    while (w->nbits == 0 && count - i >= 8) {
+        size_t room = (w->cap - w->pos) / width;
+        if (room == 0) {
+            if (w->pos == 0) break;             // buf smaller than one block
+            if (!writer_drain(w)) return false;
+            continue;
+        }
+        size_t blocks = (count - i) / 8;
+        if (blocks > room) blocks = room;
+        pack_bits(samples + i, blocks * 8, width, w->buf + w->pos, blocks * width);
+        w->pos += blocks * width;
+        i += blocks * 8;
+    }
+
+    return writer_runs(w, samples + i, count - i, width);
+}
+
+bool bitstream_emit(bitstream_writer_t *w) {
+    return writer_drain(w);
+}
+
+bool bitstream_finish(bitstream_writer_t *w) {
+    if (w->nbits > 0) {
+        w->acc <<= 8 - w->nbits;
+        w->nbits = 8;
+        if (!writer_put_bytes(w)) return false;
+    }
+    return writer_drain(w);
+}
+
+// --- Reader ---
+
+void bitstream_reader_init(bitstream_reader_t *r) {
+    memset(r, 0, sizeof(*r));
+}
+
+void bitstream_feed(bitstream_reader_t *r, const uint8_t *chunk, size_t len) {
+    r->in = chunk;
+    r->end = chunk + len;
+}
+
+static inline bool reader_next(bitstream_reader_t *r, unsigned width, uint32_t *value) {
+    while (r->nbits < width) {
+        if (r->in == r->end) {
+            return false;               // Bytes taken so far stay in acc
+        }
+        r->acc = (r->acc << 8) | *r->in++;
+        r->nbits += 8;
+        r->bytes_consumed++;
+    }
+    r->nbits -= width;
+    *value = (uint32_t)((r->acc >> r->nbits) & field_mask(width));
+    return true;
+}
+
+bool bitstream_read(bitstream_reader_t *r, unsigned width, uint32_t *value) {
+    if (width < 1 || width > 32) {
+        return false;
+    }
+    return reader_next(r, width, value);
+}
+
+size_t bitstream_read_fields(bitstream_reader_t *r, uint8_t *samples,
+                             size_t count, unsigned width) {
+    if (width < 1 || width > 8) {
+        return 0;
+    }
+    size_t i = 0;
+    uint32_t value;
+
+    // Bits left over from the previous chunk: like the writer, take the
+    // fields up to the next byte boundary in one go when the chunk has them
+    if (r->nbits != 0) {
+        size_t k = fields_to_align(8 - r->nbits % 8, width);
+        if (k > count) k = count;
+        size_t need = (k * width > r->nbits) ? (k * width - r->nbits + 7) / 8 : 0;
+        if (k > 0 && need <= (size_t)(r->end - r->in)) {
+            for (size_t b = 0; b < need; b++) {
+                r->acc = (r->acc << 8) | r->in[b];      // nbits < 8 + 7 * 8
+            }
+            r->in += need;
+            r->bytes_consumed += need;
+            r->nbits += (unsigned)need * 8;
+            uint64_t mask = field_mask(width);
+            for (; i < k; i++) {
+                r->nbits -= width;
+                samples[i] = (uint8_t)((r->acc >> r->nbits) & mask);
+            }
+        }
+    }
+
+    if (r->nbits == 0) {
+        size_t blocks = (count - i) / 8;
+        size_t avail = (size_t)(r->end - r->in) / width;
+        if (blocks > avail) blocks = avail;
+        if (blocks > 0) {
+            unpack_bits(r->in, blocks * width, width, samples + i, blocks * 8);
+            r->in += blocks * width;
+            r->bytes_consumed += blocks * width;
+            i += blocks * 8;
+        }
+    }
+
+    for (; i < count; i++) {
+        if (!reader_next(r, width, &value)) break;
+        samples[i] = (uint8_t)value;
+    }
+    return i;
+}
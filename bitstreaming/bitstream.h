@@ -0,0 +1,98 @@
+#ifndef BITSTREAM_H
+#define BITSTREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/*
+ * Streaming bit writer / reader
+ *
+ * Same bit order as pack_bits() (MSB first, no gaps), but stateful: the
+ * partial byte is carried from one call to the next, and each field can
+ * have its own width (1..32 bits). Packing the same fields in one call or
+ * in any number of smaller calls gives the same bytes.
+ *
+ * Writer: packs straight into a caller-owned buffer (e.g. the socket's
+ * transmit buffer). Whenever it is full, and on bitstream_emit() /
+ * bitstream_finish(), the filled bytes are passed to the sink and the
+ * buffer is reused, so data is never copied on the way out.
+ *
+ * Reader: reads straight from each chunk passed to bitstream_feed(). A
+ * field split across two chunks waits in the reader until the next feed.
+ */
+
+// Consumes 'len' bytes; returns false to stop the writer (e.g. send failed)
+typedef bool (*bitstream_sink_t)(void *ctx, const uint8_t *data, size_t len);
+
+typedef struct {
+    uint8_t *buf;
+    size_t cap;
+    size_t pos;                 // Complete bytes in buf not yet emitted
+    uint64_t acc;               // Pending bits, right aligned
+    unsigned nbits;             // Pending bit count, < 8 between calls
+    bitstream_sink_t sink;
+    void *ctx;
+    uint64_t bytes_emitted;
+    bool failed;                // Sink refused data, writes are dropped
+} bitstream_writer_t;
+
+typedef struct {
+    const uint8_t *in;          // Unread part of the current chunk
+    const uint8_t *end;
+    uint64_t acc;               // Bits taken from earlier bytes, right aligned
+    unsigned nbits;
+    uint64_t bytes_consumed;
+} bitstream_reader_t;
+
+// --- Writer ---
+
+void bitstream_writer_init(bitstream_writer_t *w, uint8_t *buf, size_t cap,
+                           bitstream_sink_t sink, void *ctx);
+
+/**
+ * @brief Appends the low 'width' bits of value (width 1..32).
+ * @return false if width is out of range or the sink failed.
+ */
+bool bitstream_write(bitstream_writer_t *w, uint32_t value, unsigned width);
+
+/**
+ * @brief Appends the low 'width' bits (1..8) of each sample. Byte-aligned
+ *        runs go through pack_bits() directly into the buffer.
+ */
+bool bitstream_write_fields(bitstream_writer_t *w, const uint8_t *samples,
+                            size_t count, unsigned width);
+
+// Hands all complete bytes to the sink. A partial byte stays pending.
+bool bitstream_emit(bitstream_writer_t *w);
+
+// Pads the last partial byte with zero bits and emits everything
+bool bitstream_finish(bitstream_writer_t *w);
+
+// --- Reader ---
+
+void bitstream_reader_init(bitstream_reader_t *r);
+
+// Next chunk of the stream. The previous chunk must be fully read.
+void bitstream_feed(bitstream_reader_t *r, const uint8_t *chunk, size_t len);
+
+/**
+ * @brief Reads one field of 'width' bits (1..32).
+ * @return false if the fed data ends before the field does; the bits
+ *         seen so far are kept and the read can be retried after a feed.
+ */
+bool bitstream_read(bitstream_reader_t *r, unsigned width, uint32_t *value);
+
+/**
+ * @brief Reads up to 'count' fields of 'width' bits (1..8) into samples.
+ * @return Fields read; less than count when the current chunk runs out.
+ */
+size_t bitstream_read_fields(bitstream_reader_t *r, uint8_t *samples,
+                             size_t count, unsigned width);
+
+// Bits available without another feed
+static inline uint64_t bitstream_bits_left(const bitstream_reader_t *r) {
+    return (uint64_t)(r->end - r->in) * 8 + r->nbits;
+}
+
+#endif // BITSTREAM_H
@@ -0,0 +1,257 @@
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdio.h>
+#include "bit_streaming.h"
+#include "bitstream.h"
+
+// --- Test Utilities ---
+void print_hex(const char* label, const uint8_t* buf, size_t len) {
+    printf("%s: ", label);
+    for (size_t i = 0; i < len; i++) {
+        printf("0x%02X ", buf[i]);
+    }
+    printf("\n");
+}
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// One bit at a time into a zeroed buffer, the way the first solution did it
+static void pack_reference(const uint8_t* input, size_t input_len, unsigned width, uint8_t* output) {
+    memset(output, 0, PACKED_LEN(input_len, width));
+    size_t bit = 0;
+    for (size_t i = 0; i < input_len; i++) {
+        for (int j = (int)width - 1; j >= 0; j--, bit++) {
+            output[bit / 8] |= (uint8_t)(((input[i] >> j) & 1) << (7 - bit % 8));
+        }
+    }
+}
+
+// Sink that appends everything to one buffer
+typedef struct {
+    uint8_t data[4096];
+    size_t len;
+} collect_sink_t;
+
+static bool collect(void *ctx, const uint8_t *data, size_t len) {
+    collect_sink_t *c = ctx;
+    assert(c->len + len <= sizeof(c->data));
+    memcpy(c->data + c->len, data, len);
+    c->len += len;
+    return true;
+}
+
+// Reads one field, feeding the next random-sized chunk of 'stream' when needed
+static uint32_t read_chunked(bitstream_reader_t *r, unsigned width,
+                             const uint8_t *stream, size_t stream_len, size_t *fed) {
+    uint32_t value;
+    while (!bitstream_read(r, width, &value)) {
+        assert(*fed < stream_len);
+        size_t n = 1 + xorshift32() % 9;
+        if (n > stream_len - *fed) n = stream_len - *fed;
+        bitstream_feed(r, stream + *fed, n);
+        *fed += n;
+    }
+    return value;
+}
+
+int main() {
+    printf("--- Running Firmware Interview Tests ---\n\n");
+
+    // Case 1: The Example from the Prompt
+    // Byte 0: 10101110 (0xAE) -> 5 bits: 01110 (0x0E)
+    // Byte 1: 00001101 (0x0D) -> 5 bits: 01101 (0x0D)
+    // Expected: [01110 011] [01 000000] -> [0x73, 0x40]
+    uint8_t input1[] = {0xAE, 0x0D};
+    uint8_t output1[2] = {0};
+    uint8_t expected1[] = {0x73, 0x40};
+
+    size_t written1 = pack_sensor_data(input1, 2, output1, 2);
+
+    print_hex("Test 1 Input", input1, 2);
+    print_hex("Test 1 Result", output1, 2);
+    assert(written1 == 2);
+    assert(memcmp(output1, expected1, 2) == 0);
+    printf("Test 1 Passed!\n\n");
+
+    // Case 2: Single Byte (Partial Output)
+    // 0xFF -> 5 bits are 11111 (0x1F)
+    // Expected: [11111 000] -> [0xF8]
+    uint8_t input2[] = {0xFF};
+    uint8_t output2[1] = {0};
+    uint8_t expected2[] = {0xF8};
+
+    size_t written2 = pack_sensor_data(input2, 1, output2, 1);
+
+    print_hex("Test 2 Input", input2, 1);
+    print_hex("Test 2 Result", output2, 1);
+    assert(written2 == 1);
+    assert(output2[0] == expected2[0]);
+    printf("Test 2 Passed!\n\n");
+
+    // Case 3: Eight 5-bit chunks (Should fill exactly 5 bytes)
+    // 8 * 5 = 40 bits = 5 bytes.
+    uint8_t input3[8];
+    memset(input3, 0x1F, 8); // All 5-bit chunks are 11111
+    uint8_t output3[5] = {0};
+
+    size_t written3 = pack_sensor_data(input3, 8, output3, 5);
+    assert(written3 == 5);
+    for(int i=0; i<5; i++) assert(output3[i] == 0xFF);
+    printf("Test 3 Passed (Perfect alignment)!\n\n");
+
+    // Case 4: Output buffer is not pre-zeroed, bytes past the result are untouched
+    uint8_t output4[4];
+    memset(output4, 0xA5, sizeof(output4));
+    assert(pack_sensor_data(input1, 2, output4, sizeof(output4)) == 2);
+    assert(memcmp(output4, expected1, 2) == 0);
+    assert(output4[2] == 0xA5 && output4[3] == 0xA5);
+    printf("Test 4 Passed (Dirty output buffer)!\n\n");
+
+    // Case 5: output_len is enforced, width is validated
+    uint8_t output5[4];
+    memset(output5, 0xA5, sizeof(output5));
+    assert(pack_sensor_data(input3, 8, output5, 4) == 0);
+    for (int i = 0; i < 4; i++) assert(output5[i] == 0xA5);
+    assert(pack_bits(input3, 8, 0, output3, 5) == 0);
+    assert(pack_bits(input3, 8, 9, output3, 5) == 0);
+    assert(pack_sensor_data(input3, 0, output5, 0) == 0);
+    printf("Test 5 Passed (Bounds)!\n\n");
+
+    // Case 6: Every backend and width against the bit-by-bit reference,
+    // lengths around the block boundary and past the SIMD step sizes
+    uint8_t input6[600], output6[610], expected6[600];
+    for (int backend = 0; backend < BITPACK_BACKEND_COUNT; backend++) {
+        if (!bitpack_select((bitpack_backend_t)backend)) {
+            printf("(%s not supported on this CPU, skipped)\n", bitpack_name((bitpack_backend_t)backend));
+            continue;
+        }
+        for (unsigned width = 1; width <= 8; width++) {
+            for (size_t len = 0; len <= sizeof(input6); len += (len < 80) ? 1 : 37) {
+                for (size_t i = 0; i < len; i++) input6[i] = (uint8_t)xorshift32();
+                memset(output6, 0xA5, sizeof(output6));
+                pack_reference(input6, len, width, expected6);
+
+                size_t written = pack_bits(input6, len, width, output6, PACKED_LEN(len, width));
+                assert(written == PACKED_LEN(len, width));
+                assert(memcmp(output6, expected6, written) == 0);
+                assert(output6[written] == 0xA5);
+            }
+        }
+        printf("Test 6 Passed (%s, widths 1..8)!\n", bitpack_name((bitpack_backend_t)backend));
+    }
+    printf("\n");
+
+    // Case 7: unpack(pack(x)) == low bits of x, for every backend and width.
+    // Exact-size heap buffers, so an ASan build catches any overrun.
+    for (int backend = 0; backend < BITPACK_BACKEND_COUNT; backend++) {
+        if (!bitpack_select((bitpack_backend_t)backend)) continue;
+        for (unsigned width = 1; width <= 8; width++) {
+            for (int trial = 0; trial < 200; trial++) {
+                size_t len = 1 + xorshift32() % sizeof(input6);
+                for (size_t i = 0; i < len; i++) input6[i] = (uint8_t)xorshift32();
+                size_t bytes = PACKED_LEN(len, width);
+                uint8_t *packed = malloc(bytes);
+                uint8_t *unpacked = malloc(len);
+
+                assert(pack_bits(input6, len, width, packed, bytes) == bytes);
+                assert(unpack_bits(packed, bytes, width, unpacked, len) == len);
+                for (size_t i = 0; i < len; i++) {
+                    assert(unpacked[i] == (input6[i] & ((1u << width) - 1)));
+                }
+                free(packed);
+                free(unpacked);
+            }
+        }
+        printf("Test 7 Passed (%s round trip)!\n", bitpack_name((bitpack_backend_t)backend));
+    }
+    bitpack_select(bitpack_best());
+
+    // Unpack checks the packed length and the width
+    uint8_t unpacked8[2];
+    assert(unpack_sensor_data(expected1, 2, unpacked8, 2) == 2);
+    assert(unpacked8[0] == 0x0E && unpacked8[1] == 0x0D);
+    assert(unpack_sensor_data(expected1, 1, unpacked8, 2) == 0);
+    assert(unpack_bits(expected1, 2, 9, unpacked8, 2) == 0);
+    printf("Test 8 Passed (Unpack bounds)!\n\n");
+
+    // Case 9: Mixed field widths (1..32) through a 7-byte writer buffer,
+    // read back from chunks of 1..9 bytes
+    static collect_sink_t sink9;
+    static uint32_t values9[500], widths9[500];
+    uint8_t buf9[7], expected9[4096] = {0};
+    bitstream_writer_t writer;
+    bitstream_writer_init(&writer, buf9, sizeof(buf9), collect, &sink9);
+    size_t bit9 = 0;
+    for (int i = 0; i < 500; i++) {
+        widths9[i] = 1 + xorshift32() % 32;
+        values9[i] = xorshift32() & (uint32_t)((1ULL << widths9[i]) - 1);
+        assert(bitstream_write(&writer, values9[i], widths9[i]));
+        for (int j = (int)widths9[i] - 1; j >= 0; j--, bit9++) {
+            expected9[bit9 / 8] |= (uint8_t)(((values9[i] >> j) & 1) << (7 - bit9 % 8));
+        }
+    }
+    assert(bitstream_finish(&writer));
+    assert(sink9.len == (bit9 + 7) / 8 && writer.bytes_emitted == sink9.len);
+    assert(memcmp(sink9.data, expected9, sink9.len) == 0);
+
+    bitstream_reader_t reader;
+    bitstream_reader_init(&reader);
+    size_t fed9 = 0;
+    for (int i = 0; i < 500; i++) {
+        assert(read_chunked(&reader, widths9[i], sink9.data, sink9.len, &fed9) == values9[i]);
+    }
+    printf("Test 9 Passed (Mixed widths, chunked)!\n");
+
+    // Case 10: Fixed-width samples written and read in random-sized pieces
+    // match one pack_bits() call over the whole input
+    static collect_sink_t sink10;
+    uint8_t buf10[64], whole10[600], read10[600];
+    for (unsigned width = 1; width <= 8; width++) {
+        for (int trial = 0; trial < 50; trial++) {
+            size_t len = 1 + xorshift32() % sizeof(input6);
+            for (size_t i = 0; i < len; i++) input6[i] = (uint8_t)xorshift32();
+            size_t bytes = pack_bits(input6, len, width, whole10, sizeof(whole10));
+
+            sink10.len = 0;
+            bitstream_writer_init(&writer, buf10, 8 + xorshift32() % 57, collect, &sink10);
+            for (size_t i = 0; i < len; ) {
+                size_t n = xorshift32() % 40;
+                if (n > len - i) n = len - i;
+                assert(bitstream_write_fields(&writer, input6 + i, n, width));
+                i += n;
+            }
+            assert(bitstream_finish(&writer));
+            assert(sink10.len == bytes && memcmp(sink10.data, whole10, bytes) == 0);
+
+            bitstream_reader_init(&reader);
+            size_t got = 0, fed = 0;
+            while (got < len) {
+                got += bitstream_read_fields(&reader, read10 + got, len - got, width);
+                if (got < len) {
+                    assert(reader.in == reader.end);
+                    size_t n = 1 + xorshift32() % 30;
+                    if (n > bytes - fed) n = bytes - fed;
+                    bitstream_feed(&reader, whole10 + fed, n);
+                    fed += n;
+                }
+            }
+            for (size_t i = 0; i < len; i++) {
+                assert(read10[i] == (input6[i] & ((1u << width) - 1)));
+            }
+        }
+    }
+    printf("Test 10 Passed (Chunked write_fields / read_fields)!\n\n");
+
+    printf("ALL TESTS PASSED SUCCESSFULLY\n");
+    return 0;
+}
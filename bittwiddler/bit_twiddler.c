@@ -14,21 +14,10 @@ Efficiency: Use bitwise shifts, masks, and logical operators.
 Avoid for loops to ensure constant-time O(1) execution.
 */
 
-#include <stdio.h>
-#include <stdint.h>
-#include <stdbool.h>
-
-/**
- * @brief Reverses the byte order of a 32-bit unsigned integer.
- * Example: 0x12345678 -> 0x78563412
- */
-uint32_t swap_endian32(uint32_t val);
-
-/**
- * @brief Calculates the Hamming Weight (number of set bits).
- * Implementation: Use a variable-precision SWAR (SIMD Within A Register) algorithm.
- */
-int count_set_bits(uint32_t val);
+#include <string.h>
+#include <stdatomic.h>
+#include "bit_twiddler.h"
+#include "bit_twiddler_simd.h"
 
 // --- Implementation Placeholders ---
 uint32_t swap_endian32(uint32_t val) {
@@ -42,44 +31,141 @@ int count_set_bits(uint32_t val) {
     return __builtin_popcount(val);
 }
 
-// --- Test Harness ---
+// --- Scalar array kernels ---
 
-static int total_failures = 0;
+// Classic SWAR: 2-bit, 4-bit, then 8-bit partial sums, bytes added by a multiply
+static inline uint64_t popcount64_swar(uint64_t x) {
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (x * 0x0101010101010101ULL) >> 56;
+}
+
+static void swap16_scalar(uint16_t *dst, const uint16_t *src, size_t count) {
+    for (size_t i = 0; i < count; i++) dst[i] = __builtin_bswap16(src[i]);
+}
+
+static void swap32_scalar(uint32_t *dst, const uint32_t *src, size_t count) {
+    for (size_t i = 0; i < count; i++) dst[i] = __builtin_bswap32(src[i]);
+}
+
+static void swap64_scalar(uint64_t *dst, const uint64_t *src, size_t count) {
+    for (size_t i = 0; i < count; i++) dst[i] = __builtin_bswap64(src[i]);
+}
+
+static uint64_t popcount_scalar(const uint8_t *data, size_t len) {
+    uint64_t total = 0;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, data + i, 8);
+        total += popcount64_swar(w);
+    }
+    for (; i < len; i++) total += popcount64_swar(data[i]);
+    return total;
+}
+
+static uint64_t hamming_scalar(const uint8_t *a, const uint8_t *b, size_t len) {
+    uint64_t total = 0;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t wa, wb;
+        memcpy(&wa, a + i, 8);
+        memcpy(&wb, b + i, 8);
+        total += popcount64_swar(wa ^ wb);
+    }
+    for (; i < len; i++) total += popcount64_swar((uint8_t)(a[i] ^ b[i]));
+    return total;
+}
+
+const twiddle_kernels_t twiddle_kernels_scalar = {
+    swap16_scalar, swap32_scalar, swap64_scalar, popcount_scalar, hamming_scalar
+};
+
+// --- Backend selection ---
+
+static const twiddle_kernels_t *backend_kernels(twiddle_backend_t backend) {
+    switch (backend) {
+#ifdef TWIDDLE_HAVE_X86
+        case TWIDDLE_SSSE3:  return &twiddle_kernels_ssse3;
+        case TWIDDLE_POPCNT: return &twiddle_kernels_popcnt;
+        case TWIDDLE_AVX2:   return &twiddle_kernels_avx2;
+#endif
+        default:             return &twiddle_kernels_scalar;
+    }
+}
 
-void run_test(int num, const char* desc, bool passed) {
-    if (passed) {
-        printf("[PASS] Test %d: %s\n", num, desc);
-    } else {
-        printf("[FAIL] Test %d: %s\n", num, desc);
-        total_failures++;
+bool twiddle_supported(twiddle_backend_t backend) {
+    switch (backend) {
+        case TWIDDLE_SCALAR: return true;
+#ifdef TWIDDLE_HAVE_X86
+        case TWIDDLE_SSSE3:  return __builtin_cpu_supports("ssse3");
+        case TWIDDLE_POPCNT: return __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("popcnt");
+        case TWIDDLE_AVX2:   return __builtin_cpu_supports("avx2");
+#endif
+        default:             return false;
     }
 }
 
-int main() {
-    printf("--- Running Bit Twiddler Validation ---\n");
+twiddle_backend_t twiddle_best(void) {
+    static const twiddle_backend_t order[] = { TWIDDLE_AVX2, TWIDDLE_POPCNT, TWIDDLE_SSSE3 };
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        if (twiddle_supported(order[i])) return order[i];
+    }
+    return TWIDDLE_SCALAR;
+}
 
-    // Test 1: Endian Swap
-    uint32_t original = 0x12345678;
-    uint32_t swapped  = swap_endian32(original);
-    run_test(1, "32-bit Endian Swap", (swapped == 0x78563412));
+// Set by the first array call that needs it (-1 before). Two threads racing
+// there both store twiddle_best(), so relaxed ordering is enough.
+static _Atomic int selected_backend = -1;
 
-    // Test 2: Hamming Weight (Set Bits)
-    uint32_t bit_pattern = 0xEA; // 1110 1010 (5 bits set)
-    int count = count_set_bits(bit_pattern);
-    run_test(2, "Hamming Weight Calculation", (count == 5));
+twiddle_backend_t twiddle_selected(void) {
+    int backend = atomic_load_explicit(&selected_backend, memory_order_relaxed);
+    if (backend < 0) {
+        backend = (int)twiddle_best();
+        atomic_store_explicit(&selected_backend, backend, memory_order_relaxed);
+    }
+    return (twiddle_backend_t)backend;
+}
 
-    // Test 3: Edge Case (Zero)
-    run_test(3, "Zero Value Check", (count_set_bits(0) == 0 && swap_endian32(0) == 0));
+bool twiddle_select(twiddle_backend_t backend) {
+    if (!twiddle_supported(backend)) {
+        return false;
+    }
+    atomic_store_explicit(&selected_backend, (int)backend, memory_order_relaxed);
+    return true;
+}
 
-    printf("\n---------------------------------------\n");
-    if (total_failures == 0) {
-        printf("RESULT: ALL TESTS PASSED ✅\n");
-    } else {
-        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
+const char *twiddle_name(twiddle_backend_t backend) {
+    switch (backend) {
+        case TWIDDLE_SCALAR: return "scalar";
+        case TWIDDLE_SSSE3:  return "ssse3";
+        case TWIDDLE_POPCNT: return "popcnt";
+        case TWIDDLE_AVX2:   return "avx2";
+        default:             return "?";
     }
-    printf("---------------------------------------\n");
+}
+
+// --- Array API ---
+
+void swap_endian16_array(uint16_t *dst, const uint16_t *src, size_t count) {
+    backend_kernels(twiddle_selected())->swap16(dst, src, count);
+}
+
+void swap_endian32_array(uint32_t *dst, const uint32_t *src, size_t count) {
+    backend_kernels(twiddle_selected())->swap32(dst, src, count);
+}
+
+void swap_endian64_array(uint64_t *dst, const uint64_t *src, size_t count) {
+    backend_kernels(twiddle_selected())->swap64(dst, src, count);
+}
+
+uint64_t popcount_array(const uint8_t *data, size_t len) {
+    return backend_kernels(twiddle_selected())->popcount(data, len);
+}
 
-    return (total_failures == 0) ? 0 : 1;
+uint64_t hamming_distance_array(const uint8_t *a, const uint8_t *b, size_t len) {
+    return backend_kernels(twiddle_selected())->hamming(a, b, len);
 }
 
 /*
@@ -87,6 +173,8 @@ Key Interviewer Follow-up Questions:
 Compiler Intrinsics: Why might you use __builtin_bswap32 or __builtin_popcount 
 instead of writing your own logic? (Hint: Most modern CPUs have dedicated hardware 
 instructions like POPCNT that do this in a single clock cycle).
+(For whole arrays see bit_twiddler_simd.c: PSHUFB byte swaps, and
+Harley-Seal popcount, which beats one POPCNT per word.)
 
 The "Branchless" Advantage: Why is avoiding if statements or loops beneficial for 
 a CPU's instruction pipeline? (Look up "Branch Misprediction").
@@ -0,0 +1,58 @@
+#ifndef BIT_TWIDDLER_H
+#define BIT_TWIDDLER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Reverses the byte order of a 32-bit unsigned integer.
+ * Example: 0x12345678 -> 0x78563412
+ */
+uint32_t swap_endian32(uint32_t val);
+
+/**
+ * @brief Calculates the Hamming Weight (number of set bits).
+ * Implementation: Use a variable-precision SWAR (SIMD Within A Register) algorithm.
+ */
+int count_set_bits(uint32_t val);
+
+/*
+ * Array versions, for converting whole captures and counting bits in
+ * large bitsets. dst and src may be the same array (in-place swap) but
+ * must not otherwise overlap.
+ */
+void swap_endian16_array(uint16_t *dst, const uint16_t *src, size_t count);
+void swap_endian32_array(uint32_t *dst, const uint32_t *src, size_t count);
+void swap_endian64_array(uint64_t *dst, const uint64_t *src, size_t count);
+
+// Set bits in data[0 .. len)
+uint64_t popcount_array(const uint8_t *data, size_t len);
+
+// Bits that differ between a[0 .. len) and b[0 .. len)
+uint64_t hamming_distance_array(const uint8_t *a, const uint8_t *b, size_t len);
+
+/*
+ * Kernel sets for the *_array functions above, slowest first. Until
+ * twiddle_select() pins one, they use twiddle_best(): the last entry
+ * here that twiddle_supported() accepts on this machine.
+ */
+typedef enum {
+    TWIDDLE_SCALAR,             // bswap builtins, 64-bit SWAR popcount
+    TWIDDLE_SSSE3,              // PSHUFB swaps, nibble-LUT popcount
+    TWIDDLE_POPCNT,             // PSHUFB swaps, POPCNT per 64-bit word
+    TWIDDLE_AVX2,               // VPSHUFB swaps, Harley-Seal popcount
+    TWIDDLE_BACKEND_COUNT
+} twiddle_backend_t;
+
+bool twiddle_supported(twiddle_backend_t backend);
+twiddle_backend_t twiddle_best(void);
+
+// Pins the swap / popcount kernels, e.g. to TWIDDLE_SCALAR as a reference.
+// Refused on a CPU without the instructions; the previous choice stays.
+bool twiddle_select(twiddle_backend_t backend);
+twiddle_backend_t twiddle_selected(void);
+
+const char *twiddle_name(twiddle_backend_t backend);
+
+#endif // BIT_TWIDDLER_H
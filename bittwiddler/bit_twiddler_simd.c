@@ -0,0 +1,251 @@
+/*
+ * x86 array kernels (SSSE3, POPCNT, AVX2)
+ *
+ * The SSSE3 / POPCNT / AVX2 code is enabled per function with
+ * __attribute__((target)), not per file, so the whole program still runs
+ * on a baseline x86-64; twiddle_supported() gates every call into here.
+ *
+ * Byte swap: one PSHUFB per 16 bytes (VPSHUFB per 32) with index
+ *            k ^ (size - 1), i.e. reverse every 2, 4 or 8-byte group.
+ * Popcount:
+ *   SSSE3   nibble lookup: PSHUFB maps each 4-bit half of a byte to its
+ *           bit count; byte counts are summed with PSADBW.
+ *   POPCNT  one instruction per 64-bit word, 4 independent sums.
+ *   AVX2    Harley-Seal: carry-save adders fold 16 vectors into
+ *           ones/twos/fours/eights/sixteens, so only one vector in 16 goes
+ *           through the (VPSHUFB nibble) counter.
+ * Popcount and Hamming distance share one kernel per ISA; Hamming just
+ * XORs the two inputs on load.
+ */
+
+#include <string.h>
+#include "bit_twiddler_simd.h"
+
+#ifdef TWIDDLE_HAVE_X86
+
+#include <immintrin.h>
+
+#define TARGET_SSSE3  __attribute__((target("ssse3")))
+#define TARGET_POPCNT __attribute__((target("popcnt")))
+#define TARGET_AVX2   __attribute__((target("avx2")))
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+
+// --- Byte swaps ---
+
+// PSHUFB indices that reverse every group of 'size' bytes
+static ALWAYS_INLINE TARGET_SSSE3 __m128i swap_order(const int size) {
+    uint8_t idx[16];
+    for (int k = 0; k < 16; k++) idx[k] = (uint8_t)(k ^ (size - 1));
+    return _mm_loadu_si128((const __m128i *)idx);
+}
+
+/*
+ * SWAP_KERNELS(BITS) defines swap<BITS>_ssse3() and swap<BITS>_avx2().
+ * Whole vectors first, then the builtin for the last few elements.
+ */
+#define SWAP_KERNELS(BITS)                                                                   \
+static TARGET_SSSE3 void swap##BITS##_ssse3(uint##BITS##_t *dst, const uint##BITS##_t *src,  \
+                                            size_t count) {                                  \
+    const __m128i order = swap_order(BITS / 8);                                              \
+    const size_t per = 16 / (BITS / 8);                                                      \
+    size_t i = 0;                                                                            \
+    for (; i + per <= count; i += per) {                                                     \
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));                             \
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_shuffle_epi8(v, order));                  \
+    }                                                                                        \
+    for (; i < count; i++) dst[i] = __builtin_bswap##BITS(src[i]);                           \
+}                                                                                            \
+static TARGET_AVX2 void swap##BITS##_avx2(uint##BITS##_t *dst, const uint##BITS##_t *src,    \
+                                          size_t count) {                                    \
+    const __m256i order = _mm256_broadcastsi128_si256(swap_order(BITS / 8));                 \
+    const size_t per = 32 / (BITS / 8);                                                      \
+    size_t i = 0;                                                                            \
+    for (; i + 2 * per <= count; i += 2 * per) {                                             \
+        __m256i v0 = _mm256_loadu_si256((const __m256i *)(src + i));                         \
+        __m256i v1 = _mm256_loadu_si256((const __m256i *)(src + i + per));                   \
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_shuffle_epi8(v0, order));           \
+        _mm256_storeu_si256((__m256i *)(dst + i + per), _mm256_shuffle_epi8(v1, order));     \
+    }                                                                                        \
+    for (; i < count; i++) dst[i] = __builtin_bswap##BITS(src[i]);                           \
+}
+
+SWAP_KERNELS(16)
+SWAP_KERNELS(32)
+SWAP_KERNELS(64)
+
+// --- SSSE3 nibble-lookup popcount ---
+
+// Bit count of every byte of v
+static ALWAYS_INLINE TARGET_SSSE3 __m128i popcount_bytes_ssse3(__m128i v) {
+    const __m128i lut = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m128i low = _mm_set1_epi8(0x0F);
+    __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, low));
+    __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), low));
+    return _mm_add_epi8(lo, hi);
+}
+
+static ALWAYS_INLINE TARGET_SSSE3 uint64_t count_ssse3(const uint8_t *a, const uint8_t *b,
+                                                       size_t len, const int use_b) {
+    __m128i total = _mm_setzero_si128();
+    size_t i = 0;
+    while (len - i >= 16) {
+        // A byte counter gains at most 8 per step: widen every 31 steps
+        size_t steps = (len - i) / 16;
+        if (steps > 31) steps = 31;
+        __m128i acc = _mm_setzero_si128();
+        for (size_t s = 0; s < steps; s++, i += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)(a + i));
+            if (use_b) v = _mm_xor_si128(v, _mm_loadu_si128((const __m128i *)(b + i)));
+            acc = _mm_add_epi8(acc, popcount_bytes_ssse3(v));
+        }
+        total = _mm_add_epi64(total, _mm_sad_epu8(acc, _mm_setzero_si128()));
+    }
+    uint64_t sum = (uint64_t)_mm_cvtsi128_si64(total) +
+                   (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(total, total));
+    return sum + (use_b ? twiddle_kernels_scalar.hamming(a + i, b + i, len - i)
+                        : twiddle_kernels_scalar.popcount(a + i, len - i));
+}
+
+static TARGET_SSSE3 uint64_t popcount_ssse3(const uint8_t *data, size_t len) {
+    return count_ssse3(data, NULL, len, 0);
+}
+
+static TARGET_SSSE3 uint64_t hamming_ssse3(const uint8_t *a, const uint8_t *b, size_t len) {
+    return count_ssse3(a, b, len, 1);
+}
+
+// --- POPCNT ---
+
+static ALWAYS_INLINE TARGET_POPCNT uint64_t load_word(const uint8_t *a, const uint8_t *b,
+                                                      size_t i, const int use_b) {
+    uint64_t w, x;
+    memcpy(&w, a + i, 8);
+    if (use_b) {
+        memcpy(&x, b + i, 8);
+        w ^= x;
+    }
+    return w;
+}
+
+static ALWAYS_INLINE TARGET_POPCNT uint64_t count_popcnt(const uint8_t *a, const uint8_t *b,
+                                                         size_t len, const int use_b) {
+    // Four sums, so consecutive POPCNTs do not wait on one another
+    uint64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        c0 += (uint64_t)_mm_popcnt_u64(load_word(a, b, i, use_b));
+        c1 += (uint64_t)_mm_popcnt_u64(load_word(a, b, i + 8, use_b));
+        c2 += (uint64_t)_mm_popcnt_u64(load_word(a, b, i + 16, use_b));
+        c3 += (uint64_t)_mm_popcnt_u64(load_word(a, b, i + 24, use_b));
+    }
+    for (; i + 8 <= len; i += 8) {
+        c0 += (uint64_t)_mm_popcnt_u64(load_word(a, b, i, use_b));
+    }
+    for (; i < len; i++) {
+        c0 += (uint64_t)_mm_popcnt_u32(use_b ? (uint32_t)(a[i] ^ b[i]) : a[i]);
+    }
+    return c0 + c1 + c2 + c3;
+}
+
+static TARGET_POPCNT uint64_t popcount_popcnt(const uint8_t *data, size_t len) {
+    return count_popcnt(data, NULL, len, 0);
+}
+
+static TARGET_POPCNT uint64_t hamming_popcnt(const uint8_t *a, const uint8_t *b, size_t len) {
+    return count_popcnt(a, b, len, 1);
+}
+
+// --- AVX2 Harley-Seal ---
+
+// Bit counts of v summed per 64-bit lane
+static ALWAYS_INLINE TARGET_AVX2 __m256i popcount256(__m256i v) {
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, low));
+    __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+}
+
+// Carry-save adder: a + b + c = 2 * high + low, per bit
+#define CSA(high, low, a, b, c) do {                                                         \
+        __m256i u_ = _mm256_xor_si256((a), (b));                                             \
+        (high) = _mm256_or_si256(_mm256_and_si256((a), (b)), _mm256_and_si256(u_, (c)));     \
+        (low) = _mm256_xor_si256(u_, (c));                                                   \
+    } while (0)
+
+static ALWAYS_INLINE TARGET_AVX2 __m256i load256(const uint8_t *a, const uint8_t *b,
+                                                 size_t i, const int use_b) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(a + i));
+    if (use_b) v = _mm256_xor_si256(v, _mm256_loadu_si256((const __m256i *)(b + i)));
+    return v;
+}
+
+static ALWAYS_INLINE TARGET_AVX2 uint64_t count_avx2(const uint8_t *a, const uint8_t *b,
+                                                     size_t len, const int use_b) {
+    __m256i total = _mm256_setzero_si256();
+    __m256i ones = _mm256_setzero_si256(), twos = ones, fours = ones, eights = ones;
+    __m256i twos_a, twos_b, fours_a, fours_b, eights_a, eights_b, sixteens;
+    size_t i = 0;
+
+#define LD(k) load256(a, b, i + 32 * (k), use_b)
+    for (; i + 16 * 32 <= len; i += 16 * 32) {
+        CSA(twos_a, ones, ones, LD(0), LD(1));
+        CSA(twos_b, ones, ones, LD(2), LD(3));
+        CSA(fours_a, twos, twos, twos_a, twos_b);
+        CSA(twos_a, ones, ones, LD(4), LD(5));
+        CSA(twos_b, ones, ones, LD(6), LD(7));
+        CSA(fours_b, twos, twos, twos_a, twos_b);
+        CSA(eights_a, fours, fours, fours_a, fours_b);
+        CSA(twos_a, ones, ones, LD(8), LD(9));
+        CSA(twos_b, ones, ones, LD(10), LD(11));
+        CSA(fours_a, twos, twos, twos_a, twos_b);
+        CSA(twos_a, ones, ones, LD(12), LD(13));
+        CSA(twos_b, ones, ones, LD(14), LD(15));
+        CSA(fours_b, twos, twos, twos_a, twos_b);
+        CSA(eights_b, fours, fours, fours_a, fours_b);
+        CSA(sixteens, eights, eights, eights_a, eights_b);
+        total = _mm256_add_epi64(total, popcount256(sixteens));
+    }
+#undef LD
+
+    total = _mm256_slli_epi64(total, 4);
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(eights), 3));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(fours), 2));
+    total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(twos), 1));
+    total = _mm256_add_epi64(total, popcount256(ones));
+
+    for (; i + 32 <= len; i += 32) {
+        total = _mm256_add_epi64(total, popcount256(load256(a, b, i, use_b)));
+    }
+
+    __m128i sum128 = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    uint64_t sum = (uint64_t)_mm_cvtsi128_si64(sum128) +
+                   (uint64_t)_mm_cvtsi128_si64(_mm_unpackhi_epi64(sum128, sum128));
+    return sum + (use_b ? twiddle_kernels_scalar.hamming(a + i, b + i, len - i)
+                        : twiddle_kernels_scalar.popcount(a + i, len - i));
+}
+
+static TARGET_AVX2 uint64_t popcount_avx2(const uint8_t *data, size_t len) {
+    return count_avx2(data, NULL, len, 0);
+}
+
+static TARGET_AVX2 uint64_t hamming_avx2(const uint8_t *a, const uint8_t *b, size_t len) {
+    return count_avx2(a, b, len, 1);
+}
+
+// --- Tables ---
+
+const twiddle_kernels_t twiddle_kernels_ssse3 = {
+    swap16_ssse3, swap32_ssse3, swap64_ssse3, popcount_ssse3, hamming_ssse3
+};
+
+const twiddle_kernels_t twiddle_kernels_popcnt = {
+    swap16_ssse3, swap32_ssse3, swap64_ssse3, popcount_popcnt, hamming_popcnt
+};
+
+const twiddle_kernels_t twiddle_kernels_avx2 = {
+    swap16_avx2, swap32_avx2, swap64_avx2, popcount_avx2, hamming_avx2
+};
+
+#endif // TWIDDLE_HAVE_X86
@@ -0,0 +1,30 @@
+#ifndef BIT_TWIDDLER_SIMD_H
+#define BIT_TWIDDLER_SIMD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * One table of swap / popcount / Hamming kernels per twiddle_backend_t.
+ * The scalar table lives in bit_twiddler.c next to the dispatch, the x86
+ * ones in bit_twiddler_simd.c. Every kernel takes the full array,
+ * including the bytes that do not fill a vector.
+ */
+typedef struct {
+    void (*swap16)(uint16_t *dst, const uint16_t *src, size_t count);
+    void (*swap32)(uint32_t *dst, const uint32_t *src, size_t count);
+    void (*swap64)(uint64_t *dst, const uint64_t *src, size_t count);
+    uint64_t (*popcount)(const uint8_t *data, size_t len);
+    uint64_t (*hamming)(const uint8_t *a, const uint8_t *b, size_t len);
+} twiddle_kernels_t;
+
+extern const twiddle_kernels_t twiddle_kernels_scalar;
+
+#if defined(__x86_64__)
+#define TWIDDLE_HAVE_X86 1
+extern const twiddle_kernels_t twiddle_kernels_ssse3;
+extern const twiddle_kernels_t twiddle_kernels_popcnt;
+extern const twiddle_kernels_t twiddle_kernels_avx2;
+#endif
+
+#endif // BIT_TWIDDLER_SIMD_H
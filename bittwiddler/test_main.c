@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bit_twiddler.h"
+
+// --- Test Harness ---
+
+static int total_failures = 0;
+
+void run_test(int num, const char* desc, bool passed) {
+    if (passed) {
+        printf("[PASS] Test %d: %s\n", num, desc);
+    } else {
+        printf("[FAIL] Test %d: %s\n", num, desc);
+        total_failures++;
+    }
+}
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// --- Array Checks (against one element at a time) ---
+
+// Lengths around every vector width and Harley-Seal block (16 x 32 bytes)
+static const size_t test_lengths[] = {
+    0, 1, 2, 3, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 255, 256,
+    511, 512, 513, 1023, 1024, 1537, 4096, 8191, 16 * 31 + 5, 16 * 31 * 3 + 17
+};
+#define NUM_LENGTHS (sizeof(test_lengths) / sizeof(test_lengths[0]))
+
+// Random bytes in an exact-size heap block, so an overrun shows up under ASan
+static uint8_t* random_bytes(size_t len) {
+    uint8_t* p = malloc(len ? len : 1);
+    for (size_t i = 0; i < len; i++) p[i] = (uint8_t)xorshift32();
+    return p;
+}
+
+/*
+ * SWAP_CHECK(BITS, REF) compares swap_endian<BITS>_array() with REF on
+ * exact-size heap arrays, out of place and in place.
+ */
+#define SWAP_CHECK(BITS, REF)                                                   \
+static bool check_swap##BITS(size_t count) {                                    \
+    size_t bytes = count * sizeof(uint##BITS##_t);                              \
+    uint##BITS##_t* in = (uint##BITS##_t*)(void*)random_bytes(bytes);           \
+    uint##BITS##_t* out = malloc(bytes ? bytes : 1);                            \
+    bool ok = true;                                                             \
+    swap_endian##BITS##_array(out, in, count);                                  \
+    for (size_t i = 0; i < count; i++) ok &= (out[i] == REF(in[i]));            \
+    swap_endian##BITS##_array(in, in, count);                                   \
+    ok &= (memcmp(in, out, bytes) == 0);                                        \
+    free(in);                                                                   \
+    free(out);                                                                  \
+    return ok;                                                                  \
+}
+
+SWAP_CHECK(16, __builtin_bswap16)
+SWAP_CHECK(32, swap_endian32)
+SWAP_CHECK(64, __builtin_bswap64)
+
+static bool check_swaps(void) {
+    for (size_t n = 0; n < NUM_LENGTHS; n++) {
+        size_t count = test_lengths[n];
+        if (!check_swap16(count) || !check_swap32(count) || !check_swap64(count)) return false;
+    }
+    return true;
+}
+
+static bool check_counts(void) {
+    for (size_t n = 0; n < NUM_LENGTHS; n++) {
+        size_t len = test_lengths[n];
+        for (size_t offset = 0; offset < 3; offset++) {
+            uint8_t* a = random_bytes(len + offset);
+            uint8_t* b = random_bytes(len + offset);
+            uint64_t ones = 0, diff = 0;
+            for (size_t i = offset; i < len + offset; i++) {
+                ones += (uint64_t)count_set_bits(a[i]);
+                diff += (uint64_t)count_set_bits((uint32_t)(a[i] ^ b[i]));
+            }
+            bool ok = popcount_array(a + offset, len) == ones &&
+                      hamming_distance_array(a + offset, b + offset, len) == diff;
+            free(a);
+            free(b);
+            if (!ok) return false;
+        }
+    }
+
+    // All ones: every Harley-Seal counter carries at once
+    size_t len = 16 * 32 * 5 + 40;
+    uint8_t* full = malloc(len);
+    uint8_t* zero = calloc(len, 1);
+    memset(full, 0xFF, len);
+    bool ok = popcount_array(full, len) == len * 8 &&
+              hamming_distance_array(full, zero, len) == len * 8 &&
+              hamming_distance_array(full, full, len) == 0;
+    free(full);
+    free(zero);
+    return ok;
+}
+
+int main() {
+    printf("--- Running Bit Twiddler Validation ---\n");
+
+    // Test 1: Endian Swap
+    uint32_t original = 0x12345678;
+    uint32_t swapped  = swap_endian32(original);
+    run_test(1, "32-bit Endian Swap", (swapped == 0x78563412));
+
+    // Test 2: Hamming Weight (Set Bits)
+    uint32_t bit_pattern = 0xEA; // 1110 1010 (5 bits set)
+    int count = count_set_bits(bit_pattern);
+    run_test(2, "Hamming Weight Calculation", (count == 5));
+
+    // Test 3: Edge Case (Zero)
+    run_test(3, "Zero Value Check", (count_set_bits(0) == 0 && swap_endian32(0) == 0));
+
+    // Test 4+: array kernels, once per backend this CPU supports
+    int num = 4;
+    twiddle_backend_t best = twiddle_best();
+    for (int b = 0; b < TWIDDLE_BACKEND_COUNT; b++) {
+        char desc[64];
+        if (!twiddle_select((twiddle_backend_t)b)) {
+            printf("[SKIP] %s not supported\n", twiddle_name((twiddle_backend_t)b));
+            continue;
+        }
+        snprintf(desc, sizeof(desc), "%s array byte swaps", twiddle_name((twiddle_backend_t)b));
+        run_test(num++, desc, check_swaps());
+        snprintf(desc, sizeof(desc), "%s popcount / hamming distance", twiddle_name((twiddle_backend_t)b));
+        run_test(num++, desc, check_counts());
+    }
+    twiddle_select(best);
+
+    printf("\n---------------------------------------\n");
+    if (total_failures == 0) {
+        printf("RESULT: ALL TESTS PASSED ✅\n");
+    } else {
+        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
+    }
+    printf("---------------------------------------\n");
+
+    return (total_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,446 @@
+/*
+Ring Buffer Benchmarks
+1. Compares the original volatile circ_buf_t against the lock-free SPSC variant
+   with one producer thread and one consumer thread.
+2. Compares per-byte circ_buf_push/pop loops against circ_buf_push_n/pop_n and
+   reserve/commit + peek/release at several chunk sizes (single thread).
+3. Compares the lock-free MPMC queue against a mutex-guarded circ_buf_t
+   with 1/2/4/8/16 producer threads feeding one consumer thread.
+4. Measures log_ring_write throughput with and without a reader thread
+   taking snapshots in a tight loop.
+
+Reports for (1):
+- Throughput in ops/sec (one op = one byte pushed AND popped)
+- p99 latency from push to pop, sampled every LAT_SAMPLE_EVERY bytes
+- Sequence errors seen by the consumer (bytes lost/reordered/torn)
+
+Note: circ_buf_t across two threads is a data race (volatile is not a
+memory barrier). It usually "works" on x86 (strong ordering), but on ARM
+the consumer can see the new tail before the byte it covers.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include "circular_buffer.h"
+#include "circular_buffer_spsc.h"
+#include "circular_buffer_mpmc.h"
+#include "circular_buffer_log.h"
+
+#define BENCH_BUF_SIZE   1024
+#define LAT_SAMPLE_EVERY 1024
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct {
+    void *cb;
+    size_t items;
+    uint64_t *send_ns;   // Written by producer before the sampled push
+    uint64_t *lat_ns;    // Written by consumer after the sampled pop
+    size_t errors;
+} bench_ctx_t;
+
+// Generates a producer/consumer pair for one buffer type, so the hot loop
+// calls push/pop directly instead of through a function pointer.
+#define DEFINE_BENCH_THREADS(name, type, push_fn, pop_fn)                     \
+static void *name##_producer(void *arg) {                                     \
+    bench_ctx_t *ctx = (bench_ctx_t *)arg;                                    \
+    type *cb = (type *)ctx->cb;                                               \
+    for (size_t i = 0; i < ctx->items; i++) {                                 \
+        if ((i % LAT_SAMPLE_EVERY) == 0) {                                    \
+            ctx->send_ns[i / LAT_SAMPLE_EVERY] = now_ns();                    \
+        }                                                                     \
+        while (push_fn(cb, (uint8_t)i) == CB_FULL) {                          \
+            sched_yield();                                                    \
+        }                                                                     \
+    }                                                                         \
+    return NULL;                                                              \
+}                                                                             \
+static void *name##_consumer(void *arg) {                                     \
+    bench_ctx_t *ctx = (bench_ctx_t *)arg;                                    \
+    type *cb = (type *)ctx->cb;                                               \
+    uint8_t val;                                                              \
+    for (size_t i = 0; i < ctx->items; i++) {                                 \
+        while (pop_fn(cb, &val) == CB_EMPTY) {                                \
+            sched_yield();                                                    \
+        }                                                                     \
+        if ((i % LAT_SAMPLE_EVERY) == 0) {                                    \
+            ctx->lat_ns[i / LAT_SAMPLE_EVERY] =                               \
+                now_ns() - ctx->send_ns[i / LAT_SAMPLE_EVERY];                \
+        }                                                                     \
+        if (val != (uint8_t)i) ctx->errors++;                                 \
+    }                                                                         \
+    return NULL;                                                              \
+}
+
+DEFINE_BENCH_THREADS(legacy, circ_buf_t, circ_buf_push, circ_buf_pop)
+DEFINE_BENCH_THREADS(spsc, spsc_buf_t, spsc_buf_push, spsc_buf_pop)
+
+static void run_bench(const char *label, void *cb, size_t items,
+                      void *(*producer)(void *), void *(*consumer)(void *)) {
+    size_t samples = (items + LAT_SAMPLE_EVERY - 1) / LAT_SAMPLE_EVERY;
+    bench_ctx_t ctx = { cb, items, calloc(samples, sizeof(uint64_t)),
+                        calloc(samples, sizeof(uint64_t)), 0 };
+    if (ctx.send_ns == NULL || ctx.lat_ns == NULL) {
+        printf("%-22s | allocation failed\n", label);
+        return;
+    }
+
+    pthread_t prod, cons;
+    uint64_t start = now_ns();
+    pthread_create(&cons, NULL, consumer, &ctx);
+    pthread_create(&prod, NULL, producer, &ctx);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    uint64_t elapsed = now_ns() - start;
+
+    qsort(ctx.lat_ns, samples, sizeof(uint64_t), cmp_u64);
+    uint64_t p50 = ctx.lat_ns[samples / 2];
+    uint64_t p99 = ctx.lat_ns[(samples * 99) / 100];
+
+    printf("%-22s | %8.2f Mops/s | p50 %8llu ns | p99 %8llu ns | seq errors %zu\n",
+           label, (double)items * 1e3 / (double)elapsed,
+           (unsigned long long)p50, (unsigned long long)p99, ctx.errors);
+
+    free(ctx.send_ns);
+    free(ctx.lat_ns);
+}
+
+// --- Bulk vs Per-Byte ---
+
+typedef enum { XFER_PER_BYTE, XFER_BULK, XFER_ZERO_COPY } xfer_mode_t;
+
+// Streams total bytes through cb in chunks, like a UART RX handler filling
+// the buffer and a parser draining it. Returns a checksum so nothing is
+// optimized away.
+static uint32_t stream_chunks(circ_buf_t *cb, xfer_mode_t mode, size_t chunk,
+                              size_t total, const uint8_t *src, uint8_t *dst) {
+    uint32_t sum = 0;
+    for (size_t done = 0; done < total; done += chunk) {
+        switch (mode) {
+            case XFER_PER_BYTE:
+                for (size_t i = 0; i < chunk; i++) circ_buf_push(cb, src[i]);
+                for (size_t i = 0; i < chunk; i++) circ_buf_pop(cb, &dst[i]);
+                break;
+
+            case XFER_BULK:
+                circ_buf_push_n(cb, src, chunk);
+                circ_buf_pop_n(cb, dst, chunk);
+                break;
+
+            case XFER_ZERO_COPY: {
+                // Writer fills the buffer in place (what a DMA/read() would do)
+                size_t left = chunk;
+                while (left > 0) {
+                    size_t span;
+                    uint8_t *wr = circ_buf_reserve(cb, &span);
+                    if (span > left) span = left;
+                    memcpy(wr, src + (chunk - left), span);
+                    circ_buf_commit(cb, span);
+                    left -= span;
+                }
+                // Reader consumes in place
+                left = chunk;
+                while (left > 0) {
+                    size_t span;
+                    const uint8_t *rd = circ_buf_peek(cb, &span);
+                    if (span > left) span = left;
+                    memcpy(dst + (chunk - left), rd, span);
+                    circ_buf_release(cb, span);
+                    left -= span;
+                }
+                break;
+            }
+        }
+        sum += dst[chunk - 1];
+    }
+    return sum;
+}
+
+static void run_bulk_bench(size_t total) {
+    static const size_t chunks[] = { 1, 8, 64, 256, 1000 };
+    static const char *names[] = { "per-byte", "push_n/pop_n", "reserve/peek" };
+
+    static uint8_t mem[BENCH_BUF_SIZE];
+    static uint8_t src[BENCH_BUF_SIZE];
+    static uint8_t dst[BENCH_BUF_SIZE];
+    for (size_t i = 0; i < sizeof(src); i++) src[i] = (uint8_t)(i * 31);
+
+    printf("\n--- Bulk Transfer: %zu bytes, %d-byte buffer ---\n", total, BENCH_BUF_SIZE);
+    printf("%-8s", "chunk");
+    for (int m = 0; m < 3; m++) printf(" | %14s", names[m]);
+    printf("\n");
+
+    for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+        size_t chunk = chunks[c];
+        size_t rounds = total / chunk;
+        if (rounds == 0) rounds = 1;
+
+        printf("%-8zu", chunk);
+        for (int m = 0; m < 3; m++) {
+            circ_buf_t cb;
+            circ_buf_init(&cb, mem, BENCH_BUF_SIZE);
+            // Start mid-buffer so chunks keep straddling the wrap point
+            circ_buf_push_n(&cb, src, BENCH_BUF_SIZE / 2 + 3);
+            circ_buf_pop_n(&cb, NULL, BENCH_BUF_SIZE / 2 + 3);
+
+            uint64_t start = now_ns();
+            volatile uint32_t sink = stream_chunks(&cb, (xfer_mode_t)m, chunk,
+                                                   rounds * chunk, src, dst);
+            uint64_t elapsed = now_ns() - start;
+            (void)sink;
+
+            printf(" | %9.1f MB/s", (double)(rounds * chunk) * 1e3 / (double)elapsed);
+        }
+        printf("\n");
+    }
+}
+
+// --- MPMC Contention ---
+
+#define MPMC_BENCH_CAP 1024
+
+// Baseline: the original buffer with a mutex around every access,
+// as the closing notes in circular_buffer.c suggest.
+typedef struct {
+    pthread_mutex_t lock;
+    circ_buf_t cb;
+} locked_buf_t;
+
+static cb_status_t locked_push(locked_buf_t *lb, uint32_t value) {
+    cb_status_t status = CB_FULL;
+    pthread_mutex_lock(&lb->lock);
+    if (circ_buf_space(&lb->cb) >= sizeof(value)) {
+        circ_buf_push_n(&lb->cb, (const uint8_t *)&value, sizeof(value));
+        status = CB_OK;
+    }
+    pthread_mutex_unlock(&lb->lock);
+    return status;
+}
+
+static cb_status_t locked_pop(locked_buf_t *lb, uint32_t *value) {
+    cb_status_t status = CB_EMPTY;
+    pthread_mutex_lock(&lb->lock);
+    if (circ_buf_count(&lb->cb) >= sizeof(*value)) {
+        circ_buf_pop_n(&lb->cb, (uint8_t *)value, sizeof(*value));
+        status = CB_OK;
+    }
+    pthread_mutex_unlock(&lb->lock);
+    return status;
+}
+
+static cb_status_t mpmc_push_u32(mpmc_queue_t *q, uint32_t value) {
+    return mpmc_queue_push(q, &value);
+}
+
+static cb_status_t mpmc_pop_u32(mpmc_queue_t *q, uint32_t *value) {
+    return mpmc_queue_pop(q, value);
+}
+
+typedef struct {
+    void *queue;
+    size_t items;     // Per producer, or total for the consumer
+    uint64_t sum;     // Consumer checksum
+} contention_ctx_t;
+
+#define DEFINE_CONTENTION_THREADS(name, type, push_fn, pop_fn)                \
+static void *name##_mp_producer(void *arg) {                                  \
+    contention_ctx_t *ctx = (contention_ctx_t *)arg;                          \
+    for (size_t i = 0; i < ctx->items; i++) {                                 \
+        while (push_fn((type *)ctx->queue, (uint32_t)i) == CB_FULL) {         \
+            sched_yield();                                                    \
+        }                                                                     \
+    }                                                                         \
+    return NULL;                                                              \
+}                                                                             \
+static void *name##_mp_consumer(void *arg) {                                  \
+    contention_ctx_t *ctx = (contention_ctx_t *)arg;                          \
+    uint32_t val;                                                             \
+    for (size_t i = 0; i < ctx->items; i++) {                                 \
+        while (pop_fn((type *)ctx->queue, &val) == CB_EMPTY) {                \
+            sched_yield();                                                    \
+        }                                                                     \
+        ctx->sum += val;                                                      \
+    }                                                                         \
+    return NULL;                                                              \
+}
+
+DEFINE_CONTENTION_THREADS(locked, locked_buf_t, locked_push, locked_pop)
+DEFINE_CONTENTION_THREADS(mpmc, mpmc_queue_t, mpmc_push_u32, mpmc_pop_u32)
+
+// Returns Mops/s; sets *ok if the consumer checksum matches what was sent
+static double run_contention(void *queue, int producers, size_t per_producer,
+                             void *(*producer)(void *), void *(*consumer)(void *),
+                             bool *ok) {
+    contention_ctx_t pctx[16];
+    pthread_t pth[16], cth;
+    contention_ctx_t cctx = { queue, per_producer * (size_t)producers, 0 };
+
+    uint64_t start = now_ns();
+    pthread_create(&cth, NULL, consumer, &cctx);
+    for (int i = 0; i < producers; i++) {
+        pctx[i] = (contention_ctx_t){ queue, per_producer, 0 };
+        pthread_create(&pth[i], NULL, producer, &pctx[i]);
+    }
+    for (int i = 0; i < producers; i++) pthread_join(pth[i], NULL);
+    pthread_join(cth, NULL);
+    uint64_t elapsed = now_ns() - start;
+
+    // Each producer sends 0 .. per_producer-1 (truncated to 32 bits)
+    uint64_t expected = 0;
+    for (size_t i = 0; i < per_producer; i++) expected += (uint32_t)i;
+    *ok = (cctx.sum == expected * (uint64_t)producers);
+
+    return (double)cctx.items * 1e3 / (double)elapsed;
+}
+
+static void run_mpmc_bench(size_t total) {
+    static const int producer_counts[] = { 1, 2, 4, 8, 16 };
+
+    static locked_buf_t locked;
+    static uint8_t locked_mem[MPMC_BENCH_CAP * sizeof(uint32_t)];
+    static _Alignas(max_align_t) uint8_t mpmc_mem[MPMC_QUEUE_MEM_SIZE(MPMC_BENCH_CAP, sizeof(uint32_t))];
+    static mpmc_queue_t mpmc;
+
+    printf("\n--- MPMC Contention: %zu x uint32_t, N producers -> 1 consumer ---\n", total);
+    printf("%-9s | %22s | %22s\n", "producers", "mutex + circ_buf", "mpmc_queue (lock-free)");
+
+    for (size_t p = 0; p < sizeof(producer_counts) / sizeof(producer_counts[0]); p++) {
+        int producers = producer_counts[p];
+        size_t per_producer = total / (size_t)producers;
+        bool ok_locked, ok_mpmc;
+
+        pthread_mutex_init(&locked.lock, NULL);
+        circ_buf_init(&locked.cb, locked_mem, sizeof(locked_mem));
+        double locked_rate = run_contention(&locked, producers, per_producer,
+                                            locked_mp_producer, locked_mp_consumer, &ok_locked);
+        pthread_mutex_destroy(&locked.lock);
+
+        mpmc_queue_init(&mpmc, mpmc_mem, sizeof(mpmc_mem), sizeof(uint32_t));
+        double mpmc_rate = run_contention(&mpmc, producers, per_producer,
+                                          mpmc_mp_producer, mpmc_mp_consumer, &ok_mpmc);
+
+        printf("%-9d | %12.2f Mops/s %s | %12.2f Mops/s %s\n", producers,
+               locked_rate, ok_locked ? "ok " : "BAD",
+               mpmc_rate, ok_mpmc ? "ok " : "BAD");
+    }
+}
+
+// --- Log Ring Writer vs Snapshot Reader ---
+
+#define LOG_BENCH_CAP     4096
+#define LOG_SNAPSHOT_SIZE 256
+
+typedef struct {
+    uint32_t timestamp;
+    uint16_t channel;
+    int16_t value;
+    uint32_t flags[2];
+} telemetry_t;
+
+typedef struct {
+    log_ring_t *r;
+    size_t writes;
+    atomic_bool done;
+    uint64_t writer_cpu_ns;  // CPU time of the writer thread alone
+    size_t snapshots;
+    size_t records_read;
+} log_bench_ctx_t;
+
+static uint64_t thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void *log_bench_writer(void *arg) {
+    log_bench_ctx_t *ctx = (log_bench_ctx_t *)arg;
+    telemetry_t rec = { 0, 3, 0, { 0, 0 } };
+    uint64_t start = thread_cpu_ns();
+    for (size_t i = 0; i < ctx->writes; i++) {
+        rec.timestamp = (uint32_t)i;
+        rec.value = (int16_t)i;
+        log_ring_write(ctx->r, &rec);
+    }
+    ctx->writer_cpu_ns = thread_cpu_ns() - start;
+    atomic_store(&ctx->done, true);
+    return NULL;
+}
+
+static void *log_bench_reader(void *arg) {
+    log_bench_ctx_t *ctx = (log_bench_ctx_t *)arg;
+    static telemetry_t snap[LOG_SNAPSHOT_SIZE];
+    while (!atomic_load_explicit(&ctx->done, memory_order_relaxed)) {
+        ctx->records_read += log_ring_snapshot(ctx->r, snap, LOG_SNAPSHOT_SIZE, NULL);
+        ctx->snapshots++;
+    }
+    return NULL;
+}
+
+static void run_log_bench(size_t writes) {
+    static _Alignas(max_align_t) uint8_t mem[LOG_RING_MEM_SIZE(LOG_BENCH_CAP, sizeof(telemetry_t))];
+    static log_ring_t ring;
+
+    printf("\n--- Log Ring: %zu x %zu-byte records, snapshots of %d ---\n",
+           writes, sizeof(telemetry_t), LOG_SNAPSHOT_SIZE);
+
+    for (int with_reader = 0; with_reader <= 1; with_reader++) {
+        log_ring_init(&ring, mem, sizeof(mem), sizeof(telemetry_t));
+        log_bench_ctx_t ctx = { &ring, writes, false, 0, 0, 0 };
+
+        pthread_t wth, rth;
+        uint64_t start = now_ns();
+        if (with_reader) pthread_create(&rth, NULL, log_bench_reader, &ctx);
+        pthread_create(&wth, NULL, log_bench_writer, &ctx);
+        pthread_join(wth, NULL);
+        uint64_t elapsed = now_ns() - start;
+        if (with_reader) pthread_join(rth, NULL);
+
+        // Writer CPU time is what matters for "is the writer slowed down";
+        // wall time also includes the reader when both share one core.
+        printf("%-16s | writer %7.2f Mrec/s (CPU) %7.2f Mrec/s (wall) | %zu snapshots, %zu records read\n",
+               with_reader ? "with reader" : "writer alone",
+               (double)writes * 1e3 / (double)ctx.writer_cpu_ns,
+               (double)writes * 1e3 / (double)elapsed,
+               ctx.snapshots, ctx.records_read);
+    }
+}
+
+int main(int argc, char **argv) {
+    size_t items = (argc > 1) ? strtoull(argv[1], NULL, 10) : 20000000UL;
+    if (items == 0) items = 1;
+
+    printf("--- Ring Buffer Benchmark: %zu bytes, %d-byte buffer ---\n",
+           items, BENCH_BUF_SIZE);
+
+    static uint8_t legacy_mem[BENCH_BUF_SIZE];
+    circ_buf_t legacy;
+    circ_buf_init(&legacy, legacy_mem, BENCH_BUF_SIZE);
+    run_bench("circ_buf (volatile, %)", &legacy, items, legacy_producer, legacy_consumer);
+
+    static uint8_t spsc_mem[BENCH_BUF_SIZE];
+    static spsc_buf_t spsc;
+    spsc_buf_init(&spsc, spsc_mem, BENCH_BUF_SIZE);
+    run_bench("spsc_buf (atomic, &)", &spsc, items, spsc_producer, spsc_consumer);
+
+    run_bulk_bench(items * 10);
+
+    run_mpmc_bench(items / 4);
+
+    run_log_bench(items * 2);
+
+    return 0;
+}
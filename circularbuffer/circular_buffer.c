@@ -12,44 +12,8 @@ Note: In a real firmware environment, this would often be used to bridge an ISR
 and a main loop.
 */
 
-#include <stdio.h>
-#include <stdint.h>
-#include <stdbool.h>
-#include <stddef.h>
-
-typedef struct {
-    uint8_t *buffer;    // Pointer to the data array
-    volatile size_t head;        // Index of the oldest element (to pop)
-    volatile size_t tail;        // Index of the next available slot (to push)
-    size_t capacity;    // Maximum capacity
-} circ_buf_t;
-
-typedef enum {
-    CB_OK = 0,
-    CB_EMPTY,
-    CB_FULL,
-    CB_INVALID
-} cb_status_t;
-
-/**
- * @param cb        Pointer to the handle
- * @param raw_mem   Pre-allocated memory block
- * @param cap       Size of raw_mem
- */
-void circ_buf_init(circ_buf_t *cb, uint8_t *raw_mem, size_t cap);
-
-/**
- * @brief Adds an element to the buffer
- * @return CB_OK on success, CB_FULL if no space
- */
-cb_status_t circ_buf_push(circ_buf_t *cb, uint8_t data);
-
-/**
- * @brief Removes an element from the buffer
- * @param data      Pointer to store the retrieved byte
- * @return CB_OK on success, CB_EMPTY if no data
- */
-cb_status_t circ_buf_pop(circ_buf_t *cb, uint8_t *data);
+#include <string.h>
+#include "circular_buffer.h"
 
 // --- Implementation Placeholders ---
 
@@ -92,49 +56,100 @@ cb_status_t circ_buf_pop(circ_buf_t *cb, uint8_t *data) {
     return CB_OK;
 }
 
-// --- Test Harness ---
+size_t circ_buf_count(const circ_buf_t *cb) {
+    size_t head = cb->head;
+    size_t tail = cb->tail;
+    return (tail >= head) ? (tail - head) : (cb->capacity - head + tail);
+}
+
+size_t circ_buf_space(const circ_buf_t *cb) {
+    // One slot always stays empty to tell Full from Empty
+    return cb->capacity - 1 - circ_buf_count(cb);
+}
+
+// --- Bulk Implementation ---
+
+size_t circ_buf_push_n(circ_buf_t *cb, const uint8_t *data, size_t len) {
+    size_t space = circ_buf_space(cb);
+    if (len > space) len = space;
+    if (len == 0) return 0;
+
+    size_t tail = cb->tail;
+
+    // Span 1: from tail up to the end of the array
+    size_t first = cb->capacity - tail;
+    if (first > len) first = len;
+    memcpy(&cb->buffer[tail], data, first);
 
-static int total_failures = 0;
+    // Span 2: the remainder wraps around to index 0
+    memcpy(&cb->buffer[0], data + first, len - first);
 
-void run_test(int num, const char* desc, bool passed) {
-    if (passed) {
-        printf("[PASS] Test %d: %s\n", num, desc);
-    } else {
-        printf("[FAIL] Test %d: %s\n", num, desc);
-        total_failures++;
+    cb->tail = (tail + len) % cb->capacity;
+    return len;
+}
+
+size_t circ_buf_pop_n(circ_buf_t *cb, uint8_t *data, size_t len) {
+    size_t count = circ_buf_count(cb);
+    if (len > count) len = count;
+    if (len == 0) return 0;
+
+    size_t head = cb->head;
+
+    if (data != NULL) {
+        size_t first = cb->capacity - head;
+        if (first > len) first = len;
+        memcpy(data, &cb->buffer[head], first);
+        memcpy(data + first, &cb->buffer[0], len - first);
     }
+
+    cb->head = (head + len) % cb->capacity;
+    return len;
 }
 
-int main() {
-    printf("--- Running Circular Buffer Validation ---\n");
-
-    uint8_t memory[4];
-    circ_buf_t cb;
-    circ_buf_init(&cb, memory, 4);
-
-    // Test 1: Basic Push/Pop
-    circ_buf_push(&cb, 0xA);
-    uint8_t val;
-    cb_status_t s1 = circ_buf_pop(&cb, &val);
-    run_test(1, "Basic Push/Pop", (s1 == CB_OK && val == 0xA));
-
-    // Test 2: Full Buffer Condition
-    circ_buf_push(&cb, 1);
-    circ_buf_push(&cb, 2);
-    circ_buf_push(&cb, 3);
-    circ_buf_push(&cb, 4);
-    cb_status_t s2 = circ_buf_push(&cb, 5); // Should be full
-    run_test(2, "Buffer Full Detection", (s2 == CB_FULL));
-
-    printf("\n---------------------------------------\n");
-    if (total_failures == 0) {
-        printf("RESULT: ALL TESTS PASSED ✅\n");
-    } else {
-        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
+// --- Zero-Copy Implementation ---
+
+// Largest run of free slots starting at tail without crossing the wrap
+static size_t circ_buf_contig_space(const circ_buf_t *cb) {
+    size_t head = cb->head;
+    size_t tail = cb->tail;
+
+    if (tail >= head) {
+        // Free region is [tail, capacity) + [0, head - 1).
+        // If head == 0 the last slot must stay empty.
+        return (head == 0) ? (cb->capacity - 1 - tail) : (cb->capacity - tail);
     }
-    printf("---------------------------------------\n");
+    return head - 1 - tail;
+}
+
+// Largest run of stored bytes starting at head without crossing the wrap
+static size_t circ_buf_contig_count(const circ_buf_t *cb) {
+    size_t head = cb->head;
+    size_t tail = cb->tail;
+    return (tail >= head) ? (tail - head) : (cb->capacity - head);
+}
+
+uint8_t *circ_buf_reserve(circ_buf_t *cb, size_t *len) {
+    size_t span = circ_buf_contig_space(cb);
+    if (len != NULL) *len = span;
+    return (span == 0) ? NULL : &cb->buffer[cb->tail];
+}
 
-    return (total_failures == 0) ? 0 : 1;
+cb_status_t circ_buf_commit(circ_buf_t *cb, size_t len) {
+    if (len > circ_buf_contig_space(cb)) return CB_INVALID;
+    cb->tail = (cb->tail + len) % cb->capacity;
+    return CB_OK;
+}
+
+const uint8_t *circ_buf_peek(const circ_buf_t *cb, size_t *len) {
+    size_t span = circ_buf_contig_count(cb);
+    if (len != NULL) *len = span;
+    return (span == 0) ? NULL : &cb->buffer[cb->head];
+}
+
+cb_status_t circ_buf_release(circ_buf_t *cb, size_t len) {
+    if (len > circ_buf_contig_count(cb)) return CB_INVALID;
+    cb->head = (cb->head + len) % cb->capacity;
+    return CB_OK;
 }
 
 /*
@@ -162,4 +177,5 @@ Closing Comments:
   you must use a mutex or a critical section to prevent two tasks from grabbing the same tail index.
 - Overwrite Policy: Ask the interviewer: "Should I drop the new data when full, or overwrite the oldest data?" 
   Overwriting is common in logging (keep the most recent data), while dropping is common in command processing (ensure every command is processed).
+  (See circular_buffer_spsc.c, circular_buffer_mpmc.c and circular_buffer_log.c for each of these models.)
 */
\ No newline at end of file
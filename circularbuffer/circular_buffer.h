@@ -0,0 +1,109 @@
+#ifndef CIRCULAR_BUFFER_H
+#define CIRCULAR_BUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct {
+    uint8_t *buffer;    // Pointer to the data array
+    volatile size_t head;        // Index of the oldest element (to pop)
+    volatile size_t tail;        // Index of the next available slot (to push)
+    size_t capacity;    // Maximum capacity
+} circ_buf_t;
+
+/**
+ * @brief Largest power of two <= n (n > 0). The lock-free rings round their
+ *        slot count down with it so that wrapping an index is one AND.
+ */
+static inline size_t cb_pow2_floor(size_t n) {
+    size_t pow2 = 1;
+    while ((pow2 << 1) != 0 && (pow2 << 1) <= n) {
+        pow2 <<= 1;
+    }
+    return pow2;
+}
+
+typedef enum {
+    CB_OK = 0,
+    CB_EMPTY,
+    CB_FULL,
+    CB_INVALID
+} cb_status_t;
+
+/**
+ * @param cb        Pointer to the handle
+ * @param raw_mem   Pre-allocated memory block
+ * @param cap       Size of raw_mem
+ */
+void circ_buf_init(circ_buf_t *cb, uint8_t *raw_mem, size_t cap);
+
+/**
+ * @brief Adds an element to the buffer
+ * @return CB_OK on success, CB_FULL if no space
+ */
+cb_status_t circ_buf_push(circ_buf_t *cb, uint8_t data);
+
+/**
+ * @brief Removes an element from the buffer
+ * @param data      Pointer to store the retrieved byte
+ * @return CB_OK on success, CB_EMPTY if no data
+ */
+cb_status_t circ_buf_pop(circ_buf_t *cb, uint8_t *data);
+
+/**
+ * @brief Number of bytes currently stored
+ */
+size_t circ_buf_count(const circ_buf_t *cb);
+
+/**
+ * @brief Number of bytes that can still be pushed (capacity - 1 - count)
+ */
+size_t circ_buf_space(const circ_buf_t *cb);
+
+// --- Bulk API ---
+
+/**
+ * @brief Copies up to len bytes in, using at most two memcpy spans
+ * @return Number of bytes actually pushed (0 if full)
+ */
+size_t circ_buf_push_n(circ_buf_t *cb, const uint8_t *data, size_t len);
+
+/**
+ * @brief Copies up to len bytes out, using at most two memcpy spans
+ * @param data      Destination, or NULL to just discard the bytes
+ * @return Number of bytes actually popped (0 if empty)
+ */
+size_t circ_buf_pop_n(circ_buf_t *cb, uint8_t *data, size_t len);
+
+// --- Zero-Copy API ---
+// The returned region stays valid until the matching commit/release.
+// Only one reservation and one peek may be outstanding at a time.
+
+/**
+ * @brief Hands out the largest contiguous writable region (stops at the wrap)
+ * @param len       Out: size of the region in bytes
+ * @return Pointer to the region, or NULL if the buffer is full
+ */
+uint8_t *circ_buf_reserve(circ_buf_t *cb, size_t *len);
+
+/**
+ * @brief Publishes len bytes written into the region from circ_buf_reserve
+ * @return CB_OK on success, CB_INVALID if len exceeds the reserved region
+ */
+cb_status_t circ_buf_commit(circ_buf_t *cb, size_t len);
+
+/**
+ * @brief Hands out the largest contiguous readable region (stops at the wrap)
+ * @param len       Out: size of the region in bytes
+ * @return Pointer to the region, or NULL if the buffer is empty
+ */
+const uint8_t *circ_buf_peek(const circ_buf_t *cb, size_t *len);
+
+/**
+ * @brief Drops len bytes from the head after a circ_buf_peek
+ * @return CB_OK on success, CB_INVALID if len exceeds the peeked region
+ */
+cb_status_t circ_buf_release(circ_buf_t *cb, size_t len);
+
+#endif // CIRCULAR_BUFFER_H
@@ -0,0 +1,99 @@
+#include <stdint.h>
+#include <string.h>
+#include "circular_buffer_log.h"
+
+static inline atomic_size_t *slot_seq(const log_ring_t *r, size_t pos) {
+    return (atomic_size_t *)(r->slots + (pos & r->mask) * r->slot_size);
+}
+
+static inline uint8_t *slot_data(const log_ring_t *r, size_t pos) {
+    return r->slots + (pos & r->mask) * r->slot_size + sizeof(atomic_size_t);
+}
+
+cb_status_t log_ring_init(log_ring_t *r, void *raw_mem, size_t mem_size, size_t record_size) {
+    if (r == NULL || raw_mem == NULL || record_size == 0) return CB_INVALID;
+    if (((uintptr_t)raw_mem % _Alignof(max_align_t)) != 0) return CB_INVALID;
+
+    size_t slot_size = LOG_RING_SLOT_SIZE(record_size);
+    size_t slots = mem_size / slot_size;
+    if (slots == 0) return CB_INVALID;
+
+    size_t cap = cb_pow2_floor(slots);
+
+    r->slots = (uint8_t *)raw_mem;
+    r->slot_size = slot_size;
+    r->record_size = record_size;
+    r->mask = cap - 1;
+
+    // seq 0 never matches a completed record (those are 2n + 2)
+    for (size_t i = 0; i < cap; i++) {
+        atomic_init(slot_seq(r, i), 0);
+    }
+    atomic_init(&r->head, 0);
+    return CB_OK;
+}
+
+void log_ring_write(log_ring_t *r, const void *record) {
+    // Single writer: nobody else touches head
+    size_t pos = atomic_load_explicit(&r->head, memory_order_relaxed);
+    atomic_size_t *seq = slot_seq(r, pos);
+
+    // Mark busy, and keep the data writes below from moving above it
+    atomic_store_explicit(seq, 2 * pos + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    memcpy(slot_data(r, pos), record, r->record_size);
+
+    // Mark complete, then advertise the new record to readers
+    atomic_store_explicit(seq, 2 * pos + 2, memory_order_release);
+    atomic_store_explicit(&r->head, pos + 1, memory_order_release);
+}
+
+size_t log_ring_snapshot(const log_ring_t *r, void *out, size_t max_records, size_t *first_seq) {
+    size_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    size_t cap = r->mask + 1;
+
+    size_t want = max_records;
+    if (want > cap) want = cap;
+    if (want > head) want = head;
+
+    size_t start = head - want;
+    uint8_t *dst = (uint8_t *)out;
+
+    // Walk newest -> oldest. The first slot the writer has touched since we
+    // read head ends the snapshot: everything older has been overwritten too.
+    size_t valid_from = start;
+    for (size_t pos = head; pos-- > start; ) {
+        atomic_size_t *seq = slot_seq(r, pos);
+        size_t expected = 2 * pos + 2;
+
+        size_t s1 = atomic_load_explicit(seq, memory_order_acquire);
+        if (s1 != expected) {
+            valid_from = pos + 1;
+            break;
+        }
+
+        memcpy(dst + (pos - start) * r->record_size, slot_data(r, pos), r->record_size);
+
+        // Keep the copy above from moving below the re-check
+        atomic_thread_fence(memory_order_acquire);
+        size_t s2 = atomic_load_explicit(seq, memory_order_relaxed);
+        if (s2 != expected) {
+            valid_from = pos + 1;
+            break;
+        }
+    }
+
+    size_t copied = head - valid_from;
+    if (valid_from != start && copied > 0) {
+        // Slide the surviving (newest) records to the front
+        memmove(dst, dst + (valid_from - start) * r->record_size, copied * r->record_size);
+    }
+
+    if (first_seq != NULL) *first_seq = valid_from;
+    return copied;
+}
+
+size_t log_ring_capacity(const log_ring_t *r) {
+    return r->mask + 1;
+}
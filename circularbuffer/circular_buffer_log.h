@@ -0,0 +1,76 @@
+#ifndef CIRCULAR_BUFFER_LOG_H
+#define CIRCULAR_BUFFER_LOG_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "circular_buffer.h"
+#include "circular_buffer_spsc.h" // CB_CACHE_LINE
+
+/*
+ * Overwrite-Oldest Logging Ring
+ *
+ * The "overwrite" policy from the closing notes in circular_buffer.c:
+ * a single writer never blocks and never fails, it just overwrites the
+ * oldest record once the ring is full. Good for telemetry/trace logs
+ * where the most recent history matters more than completeness.
+ *
+ * Readers take snapshots without stopping the writer. Every slot is a
+ * tiny seqlock:
+ * - Before writing record #n the writer stores seq = 2n + 1 (odd = busy)
+ * - After writing it stores seq = 2n + 2 (even = record #n is complete)
+ * A reader copies the slot and re-checks seq. If it changed, or is not
+ * 2n + 2, the writer lapped us and that record is dropped from the
+ * snapshot. The snapshot is always a contiguous run of the newest records.
+ */
+
+// Bytes one slot occupies: sequence number + record, padded for alignment
+#define LOG_RING_SLOT_SIZE(record_size) \
+    ((sizeof(atomic_size_t) + (record_size) + _Alignof(max_align_t) - 1) & \
+     ~(_Alignof(max_align_t) - 1))
+
+// Bytes of raw memory needed for 'cap' records (cap must be a power of two)
+#define LOG_RING_MEM_SIZE(cap, record_size) ((cap) * LOG_RING_SLOT_SIZE(record_size))
+
+typedef struct {
+    _Alignas(CB_CACHE_LINE) atomic_size_t head; // Total records ever written
+
+    // Read-only after init
+    _Alignas(CB_CACHE_LINE) uint8_t *slots;
+    size_t slot_size;
+    size_t record_size;
+    size_t mask;                                // capacity - 1
+} log_ring_t;
+
+/**
+ * @brief Initializes the ring over caller-provided memory.
+ * @param r           Pointer to the handle
+ * @param raw_mem     Memory block, aligned to _Alignof(max_align_t)
+ * @param mem_size    Size of raw_mem in bytes
+ * @param record_size Size of one log record in bytes
+ * @return CB_OK on success, CB_INVALID on bad arguments or misaligned memory.
+ *         The capacity is the largest power of two that fits in mem_size.
+ */
+cb_status_t log_ring_init(log_ring_t *r, void *raw_mem, size_t mem_size, size_t record_size);
+
+/**
+ * @brief Appends one record, overwriting the oldest one if the ring is full.
+ *        Never blocks, never fails. Must only be called from ONE writer.
+ */
+void log_ring_write(log_ring_t *r, const void *record);
+
+/**
+ * @brief Copies up to max_records of the newest records into out, oldest first.
+ *        Lock-free; safe from any number of reader threads while the writer runs.
+ * @param out         Destination for max_records * record_size bytes
+ * @param first_seq   Out (may be NULL): sequence number of out[0], so the
+ *                    caller can tell which records it has already seen
+ * @return Number of records copied (0 if nothing was written yet)
+ */
+size_t log_ring_snapshot(const log_ring_t *r, void *out, size_t max_records, size_t *first_seq);
+
+/**
+ * @brief Records kept before log_ring_write() starts overwriting the oldest
+ */
+size_t log_ring_capacity(const log_ring_t *r);
+
+#endif // CIRCULAR_BUFFER_LOG_H
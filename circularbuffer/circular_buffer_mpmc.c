@@ -0,0 +1,100 @@
+#include <stdint.h>
+#include <string.h>
+#include "circular_buffer_mpmc.h"
+
+static inline atomic_size_t *slot_seq(const mpmc_queue_t *q, size_t pos) {
+    return (atomic_size_t *)(q->slots + (pos & q->mask) * q->slot_size);
+}
+
+static inline uint8_t *slot_data(const mpmc_queue_t *q, size_t pos) {
+    return q->slots + (pos & q->mask) * q->slot_size + sizeof(atomic_size_t);
+}
+
+cb_status_t mpmc_queue_init(mpmc_queue_t *q, void *raw_mem, size_t mem_size, size_t elem_size) {
+    if (q == NULL || raw_mem == NULL || elem_size == 0) return CB_INVALID;
+    if (((uintptr_t)raw_mem % _Alignof(max_align_t)) != 0) return CB_INVALID;
+
+    size_t slot_size = MPMC_SLOT_SIZE(elem_size);
+    size_t slots = mem_size / slot_size;
+    if (slots == 0) return CB_INVALID;
+
+    size_t cap = cb_pow2_floor(slots);
+
+    q->slots = (uint8_t *)raw_mem;
+    q->slot_size = slot_size;
+    q->elem_size = elem_size;
+    q->mask = cap - 1;
+
+    // Slot i is free for the producer that claims position i
+    for (size_t i = 0; i < cap; i++) {
+        atomic_init(slot_seq(q, i), i);
+    }
+    atomic_init(&q->enqueue_pos, 0);
+    atomic_init(&q->dequeue_pos, 0);
+    return CB_OK;
+}
+
+cb_status_t mpmc_queue_push(mpmc_queue_t *q, const void *data) {
+    size_t pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+
+    for (;;) {
+        size_t seq = atomic_load_explicit(slot_seq(q, pos), memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+        if (diff == 0) {
+            // Slot is free: try to claim position 'pos'
+            if (atomic_compare_exchange_weak_explicit(&q->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+            // CAS failed: 'pos' was reloaded with the winner's value, retry
+        } else if (diff < 0) {
+            // Slot still holds data from the previous lap
+            return CB_FULL;
+        } else {
+            // Another producer claimed it first; catch up
+            pos = atomic_load_explicit(&q->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    memcpy(slot_data(q, pos), data, q->elem_size);
+
+    // Publish: consumers waiting for seq == pos + 1 may now read it
+    atomic_store_explicit(slot_seq(q, pos), pos + 1, memory_order_release);
+    return CB_OK;
+}
+
+cb_status_t mpmc_queue_pop(mpmc_queue_t *q, void *data) {
+    size_t pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+
+    for (;;) {
+        size_t seq = atomic_load_explicit(slot_seq(q, pos), memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&q->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Producer has not published this slot yet
+            return CB_EMPTY;
+        } else {
+            pos = atomic_load_explicit(&q->dequeue_pos, memory_order_relaxed);
+        }
+    }
+
+    if (data != NULL) {
+        memcpy(data, slot_data(q, pos), q->elem_size);
+    }
+
+    // Hand the slot back to the producer one lap ahead
+    atomic_store_explicit(slot_seq(q, pos), pos + q->mask + 1, memory_order_release);
+    return CB_OK;
+}
+
+size_t mpmc_queue_capacity(const mpmc_queue_t *q) {
+    return q->mask + 1;
+}
@@ -0,0 +1,73 @@
+#ifndef CIRCULAR_BUFFER_MPMC_H
+#define CIRCULAR_BUFFER_MPMC_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "circular_buffer.h"
+#include "circular_buffer_spsc.h" // CB_CACHE_LINE
+
+/*
+ * Multi-Producer / Multi-Consumer bounded queue (Dmitry Vyukov's design).
+ *
+ * Every slot carries a sequence number next to its payload:
+ * - seq == pos          -> slot is free for the producer that claims 'pos'
+ * - seq == pos + 1      -> slot holds data for the consumer that claims 'pos'
+ * - seq == pos + cap    -> slot was consumed, free again one lap later
+ *
+ * Producers race on enqueue_pos with a CAS, consumers race on dequeue_pos.
+ * The winner owns the slot exclusively and publishes it with a release store
+ * to seq, so producers never touch the same slot and nobody takes a lock.
+ *
+ * Elements are copied by value and can be any size (elem_size bytes).
+ */
+
+// Bytes one slot occupies: sequence number + payload, padded so the next
+// slot's sequence number stays naturally aligned.
+#define MPMC_SLOT_SIZE(elem_size) \
+    ((sizeof(atomic_size_t) + (elem_size) + _Alignof(max_align_t) - 1) & \
+     ~(_Alignof(max_align_t) - 1))
+
+// Bytes of raw memory needed for 'cap' slots (cap must be a power of two)
+#define MPMC_QUEUE_MEM_SIZE(cap, elem_size) ((cap) * MPMC_SLOT_SIZE(elem_size))
+
+typedef struct {
+    _Alignas(CB_CACHE_LINE) atomic_size_t enqueue_pos; // Producers' cursor
+    _Alignas(CB_CACHE_LINE) atomic_size_t dequeue_pos; // Consumers' cursor
+
+    // Read-only after init
+    _Alignas(CB_CACHE_LINE) uint8_t *slots;
+    size_t slot_size;
+    size_t elem_size;
+    size_t mask;                                       // capacity - 1
+} mpmc_queue_t;
+
+/**
+ * @brief Initializes the queue over caller-provided memory.
+ * @param q         Pointer to the handle
+ * @param raw_mem   Memory block, aligned to _Alignof(max_align_t)
+ * @param mem_size  Size of raw_mem in bytes
+ * @param elem_size Size of one element in bytes
+ * @return CB_OK on success, CB_INVALID on bad arguments or misaligned memory.
+ *         The capacity is the largest power of two that fits in mem_size.
+ */
+cb_status_t mpmc_queue_init(mpmc_queue_t *q, void *raw_mem, size_t mem_size, size_t elem_size);
+
+/**
+ * @brief Copies elem_size bytes from data into the queue. Safe from any thread.
+ * @return CB_OK on success, CB_FULL if no space
+ */
+cb_status_t mpmc_queue_push(mpmc_queue_t *q, const void *data);
+
+/**
+ * @brief Copies the oldest element out into data. Safe from any thread.
+ * @param data      Destination of elem_size bytes (may be NULL to discard)
+ * @return CB_OK on success, CB_EMPTY if no data
+ */
+cb_status_t mpmc_queue_pop(mpmc_queue_t *q, void *data);
+
+/**
+ * @brief Elements the queue holds when full, i.e. its slot count
+ */
+size_t mpmc_queue_capacity(const mpmc_queue_t *q);
+
+#endif // CIRCULAR_BUFFER_MPMC_H
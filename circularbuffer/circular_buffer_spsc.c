@@ -0,0 +1,57 @@
+#include "circular_buffer_spsc.h"
+
+cb_status_t spsc_buf_init(spsc_buf_t *cb, uint8_t *raw_mem, size_t cap) {
+    if (cb == NULL || raw_mem == NULL || cap == 0) return CB_INVALID;
+
+    cb->buffer = raw_mem;
+    cb->mask = cb_pow2_floor(cap) - 1;
+    cb->head_cache = 0;
+    cb->tail_cache = 0;
+    atomic_init(&cb->head, 0);
+    atomic_init(&cb->tail, 0);
+    return CB_OK;
+}
+
+cb_status_t spsc_buf_push(spsc_buf_t *cb, uint8_t data) {
+    // We are the only writer of tail, so a relaxed load is enough
+    size_t tail = atomic_load_explicit(&cb->tail, memory_order_relaxed);
+
+    if (tail - cb->head_cache > cb->mask) {
+        // Looks full: refresh our copy of head from the consumer
+        cb->head_cache = atomic_load_explicit(&cb->head, memory_order_acquire);
+        if (tail - cb->head_cache > cb->mask) {
+            return CB_FULL;
+        }
+    }
+
+    cb->buffer[tail & cb->mask] = data;
+
+    // Release: the byte above is visible before the new tail is
+    atomic_store_explicit(&cb->tail, tail + 1, memory_order_release);
+    return CB_OK;
+}
+
+cb_status_t spsc_buf_pop(spsc_buf_t *cb, uint8_t *data) {
+    // We are the only writer of head, so a relaxed load is enough
+    size_t head = atomic_load_explicit(&cb->head, memory_order_relaxed);
+
+    if (head == cb->tail_cache) {
+        // Looks empty: refresh our copy of tail from the producer
+        cb->tail_cache = atomic_load_explicit(&cb->tail, memory_order_acquire);
+        if (head == cb->tail_cache) {
+            return CB_EMPTY;
+        }
+    }
+
+    if (data != NULL) {
+        *data = cb->buffer[head & cb->mask];
+    }
+
+    // Release: we are done reading the slot before the producer may reuse it
+    atomic_store_explicit(&cb->head, head + 1, memory_order_release);
+    return CB_OK;
+}
+
+size_t spsc_buf_capacity(const spsc_buf_t *cb) {
+    return cb->mask + 1;
+}
@@ -0,0 +1,64 @@
+#ifndef CIRCULAR_BUFFER_SPSC_H
+#define CIRCULAR_BUFFER_SPSC_H
+
+#include <stdatomic.h>
+#include "circular_buffer.h"
+
+// Size of one cache line. 64 bytes on x86 and most Cortex-A parts
+// (Apple M-series uses 128, which only costs us a little false sharing).
+#define CB_CACHE_LINE 64
+
+/*
+ * Single-Producer / Single-Consumer ring buffer.
+ *
+ * - head/tail are free-running counters; the slot is (index & mask), so the
+ *   capacity must be a power of two and every slot is usable (no one-slot gap).
+ * - tail is only written by the producer, head only by the consumer.
+ *   Each side publishes its index with a release store and reads the other
+ *   side's index with an acquire load.
+ * - Each side keeps a cached copy of the other side's index and only reloads
+ *   it when the cached value says "full" / "empty". This keeps the shared
+ *   cache line from bouncing between cores on every call.
+ */
+typedef struct {
+    // Producer's cache line
+    _Alignas(CB_CACHE_LINE) atomic_size_t tail; // Next slot to write
+    size_t head_cache;                          // Producer's view of head
+
+    // Consumer's cache line
+    _Alignas(CB_CACHE_LINE) atomic_size_t head; // Next slot to read
+    size_t tail_cache;                          // Consumer's view of tail
+
+    // Read-only after init, shared by both sides
+    _Alignas(CB_CACHE_LINE) uint8_t *buffer;
+    size_t mask;                                // capacity - 1
+} spsc_buf_t;
+
+/**
+ * @brief Initializes the SPSC buffer.
+ * @param cb        Pointer to the handle
+ * @param raw_mem   Pre-allocated memory block
+ * @param cap       Size of raw_mem. Rounded DOWN to a power of two.
+ * @return CB_OK on success, CB_INVALID on NULL pointers or cap == 0
+ */
+cb_status_t spsc_buf_init(spsc_buf_t *cb, uint8_t *raw_mem, size_t cap);
+
+/**
+ * @brief Adds an element. Must only be called from the producer thread.
+ * @return CB_OK on success, CB_FULL if no space
+ */
+cb_status_t spsc_buf_push(spsc_buf_t *cb, uint8_t data);
+
+/**
+ * @brief Removes an element. Must only be called from the consumer thread.
+ * @param data      Pointer to store the retrieved byte (may be NULL)
+ * @return CB_OK on success, CB_EMPTY if no data
+ */
+cb_status_t spsc_buf_pop(spsc_buf_t *cb, uint8_t *data);
+
+/**
+ * @brief Bytes the buffer holds when full (mask + 1, no slot kept empty)
+ */
+size_t spsc_buf_capacity(const spsc_buf_t *cb);
+
+#endif // CIRCULAR_BUFFER_SPSC_H
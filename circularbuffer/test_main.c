@@ -0,0 +1,325 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "circular_buffer.h"
+#include "circular_buffer_spsc.h"
+#include "circular_buffer_mpmc.h"
+#include "circular_buffer_log.h"
+
+// --- Test Harness ---
+
+static int total_failures = 0;
+
+void run_test(int num, const char* desc, bool passed) {
+    if (passed) {
+        printf("[PASS] Test %d: %s\n", num, desc);
+    } else {
+        printf("[FAIL] Test %d: %s\n", num, desc);
+        total_failures++;
+    }
+}
+
+// --- SPSC Stress Helpers ---
+
+#define STRESS_ITEMS 2000000UL
+
+typedef struct {
+    spsc_buf_t *cb;
+    size_t errors;
+} stress_ctx_t;
+
+static void *stress_producer(void *arg) {
+    stress_ctx_t *ctx = (stress_ctx_t *)arg;
+    for (size_t i = 0; i < STRESS_ITEMS; i++) {
+        while (spsc_buf_push(ctx->cb, (uint8_t)i) == CB_FULL) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *stress_consumer(void *arg) {
+    stress_ctx_t *ctx = (stress_ctx_t *)arg;
+    uint8_t val;
+    for (size_t i = 0; i < STRESS_ITEMS; i++) {
+        while (spsc_buf_pop(ctx->cb, &val) == CB_EMPTY) {
+            sched_yield();
+        }
+        // Bytes must come out in exactly the order they went in
+        if (val != (uint8_t)i) ctx->errors++;
+    }
+    return NULL;
+}
+
+// --- MPMC Stress Helpers ---
+
+#define MPMC_PRODUCERS      4
+#define MPMC_CONSUMERS      2
+#define MPMC_ITEMS_PER_PROD 100000UL
+#define MPMC_TOTAL          (MPMC_PRODUCERS * MPMC_ITEMS_PER_PROD)
+
+typedef struct {
+    mpmc_queue_t *q;
+    uint32_t id;            // Producer index
+    uint8_t *seen;          // Consumer: one counter per item id
+    atomic_size_t *popped;  // Consumers: shared progress counter
+} mpmc_ctx_t;
+
+static void *mpmc_producer(void *arg) {
+    mpmc_ctx_t *ctx = (mpmc_ctx_t *)arg;
+    for (uint32_t i = 0; i < MPMC_ITEMS_PER_PROD; i++) {
+        uint32_t item = ctx->id * MPMC_ITEMS_PER_PROD + i;
+        while (mpmc_queue_push(ctx->q, &item) == CB_FULL) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *mpmc_consumer(void *arg) {
+    mpmc_ctx_t *ctx = (mpmc_ctx_t *)arg;
+    uint32_t item;
+    while (atomic_load(ctx->popped) < MPMC_TOTAL) {
+        if (mpmc_queue_pop(ctx->q, &item) == CB_OK) {
+            if (item < MPMC_TOTAL) ctx->seen[item]++;
+            atomic_fetch_add(ctx->popped, 1);
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+// --- Log Ring Snapshot Helpers ---
+
+#define LOG_WRITES 2000000UL
+
+typedef struct { size_t seq; size_t check; size_t inv; } log_rec_t;
+
+typedef struct {
+    log_ring_t *r;
+    atomic_bool done;
+    size_t torn;       // Records whose fields disagree
+    size_t gaps;       // Snapshots that were not a contiguous run
+    size_t snapshots;
+} log_ctx_t;
+
+static void *log_writer(void *arg) {
+    log_ctx_t *ctx = (log_ctx_t *)arg;
+    for (size_t i = 0; i < LOG_WRITES; i++) {
+        log_rec_t rec = { i, i * 3, ~i };
+        log_ring_write(ctx->r, &rec);
+        if ((i & 0xFFF) == 0) sched_yield();
+    }
+    atomic_store(&ctx->done, true);
+    return NULL;
+}
+
+static void *log_reader(void *arg) {
+    log_ctx_t *ctx = (log_ctx_t *)arg;
+    log_rec_t snap[32];
+    while (!atomic_load(&ctx->done)) {
+        size_t first;
+        size_t n = log_ring_snapshot(ctx->r, snap, 32, &first);
+        for (size_t i = 0; i < n; i++) {
+            if (snap[i].check != snap[i].seq * 3 || snap[i].inv != ~snap[i].seq) ctx->torn++;
+            if (snap[i].seq != first + i) ctx->gaps++;
+        }
+        ctx->snapshots++;
+    }
+    return NULL;
+}
+
+int main() {
+    printf("--- Running Circular Buffer Validation ---\n");
+
+    uint8_t memory[4];
+    circ_buf_t cb;
+    circ_buf_init(&cb, memory, 4);
+
+    // Test 1: Basic Push/Pop
+    circ_buf_push(&cb, 0xA);
+    uint8_t val;
+    cb_status_t s1 = circ_buf_pop(&cb, &val);
+    run_test(1, "Basic Push/Pop", (s1 == CB_OK && val == 0xA));
+
+    // Test 2: Full Buffer Condition
+    circ_buf_push(&cb, 1);
+    circ_buf_push(&cb, 2);
+    circ_buf_push(&cb, 3);
+    circ_buf_push(&cb, 4);
+    cb_status_t s2 = circ_buf_push(&cb, 5); // Should be full
+    run_test(2, "Buffer Full Detection", (s2 == CB_FULL));
+
+    // Test 3: SPSC capacity is forced to a power of two
+    uint8_t spsc_mem[100];
+    spsc_buf_t spsc;
+    cb_status_t s3 = spsc_buf_init(&spsc, spsc_mem, sizeof(spsc_mem));
+    run_test(3, "SPSC Power-of-Two Rounding", (s3 == CB_OK && spsc_buf_capacity(&spsc) == 64));
+
+    // Test 4: SPSC uses every slot (no one-slot gap), then reports full
+    bool all_ok = true;
+    for (int i = 0; i < 64; i++) {
+        if (spsc_buf_push(&spsc, (uint8_t)i) != CB_OK) all_ok = false;
+    }
+    run_test(4, "SPSC Full Detection", (all_ok && spsc_buf_push(&spsc, 0xFF) == CB_FULL));
+
+    // Test 5: SPSC FIFO order across the wrap point, then empty
+    for (int i = 0; i < 64; i++) {
+        if (spsc_buf_pop(&spsc, &val) != CB_OK || val != (uint8_t)i) all_ok = false;
+    }
+    for (int i = 0; i < 40; i++) spsc_buf_push(&spsc, (uint8_t)(i + 1));
+    for (int i = 0; i < 40; i++) {
+        if (spsc_buf_pop(&spsc, &val) != CB_OK || val != (uint8_t)(i + 1)) all_ok = false;
+    }
+    run_test(5, "SPSC Wrap + Empty Detection", (all_ok && spsc_buf_pop(&spsc, &val) == CB_EMPTY));
+
+    // Test 6: Two-thread stress, small buffer so both sides hit full/empty often
+    uint8_t stress_mem[16];
+    spsc_buf_t stress_cb;
+    spsc_buf_init(&stress_cb, stress_mem, sizeof(stress_mem));
+    stress_ctx_t ctx = { &stress_cb, 0 };
+    pthread_t prod, cons;
+    pthread_create(&cons, NULL, stress_consumer, &ctx);
+    pthread_create(&prod, NULL, stress_producer, &ctx);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    run_test(6, "SPSC Two-Thread Stress (2M bytes, in order)", (ctx.errors == 0));
+
+    // Test 7: Bulk push/pop across the wrap point (two memcpy spans)
+    uint8_t bulk_mem[8];
+    circ_buf_t bulk;
+    circ_buf_init(&bulk, bulk_mem, sizeof(bulk_mem));
+    const uint8_t src[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    uint8_t dst[10] = {0};
+    circ_buf_push_n(&bulk, src, 6);
+    circ_buf_pop_n(&bulk, dst, 6);               // head = tail = 6, two slots before the end
+    size_t pushed = circ_buf_push_n(&bulk, src, 5);  // [6, 8) then [0, 3)
+    bool spans_ok = (pushed == 5 && bulk.tail == 3 &&
+                     bulk_mem[6] == 1 && bulk_mem[7] == 2 &&
+                     bulk_mem[0] == 3 && bulk_mem[1] == 4 && bulk_mem[2] == 5);
+    memset(dst, 0, sizeof(dst));
+    size_t popped = circ_buf_pop_n(&bulk, dst, 5);   // Reads back across the same wrap
+    spans_ok = spans_ok && popped == 5 && bulk.head == 3 && memcmp(dst, src, 5) == 0;
+    pushed = circ_buf_push_n(&bulk, src, 10);        // Only 7 fit: [3, 8) then [0, 2)
+    memset(dst, 0, sizeof(dst));
+    popped = circ_buf_pop_n(&bulk, dst, 10);
+    run_test(7, "Bulk Push/Pop Wrap + Partial",
+             (spans_ok && pushed == 7 && popped == 7 && memcmp(dst, src, 7) == 0 &&
+              circ_buf_count(&bulk) == 0));
+    circ_buf_push_n(&bulk, src, 2);
+    circ_buf_pop_n(&bulk, dst, 2);               // head = tail = 4 for Test 8
+
+    // Test 8: Reserve/Commit hands out a contiguous region up to the wrap
+    size_t span = 0;
+    uint8_t *wr = circ_buf_reserve(&bulk, &span);  // tail = 4, head = 4
+    bool zc_ok = (wr == &bulk_mem[4] && span == 4);
+    memcpy(wr, src, span);
+    zc_ok = zc_ok && (circ_buf_commit(&bulk, span) == CB_OK);
+    wr = circ_buf_reserve(&bulk, &span);           // Wrapped: [0, head - 1)
+    zc_ok = zc_ok && (wr == &bulk_mem[0] && span == 3);
+    zc_ok = zc_ok && (circ_buf_commit(&bulk, span + 1) == CB_INVALID);
+    memcpy(wr, src + 4, span);
+    circ_buf_commit(&bulk, span);
+    zc_ok = zc_ok && (circ_buf_reserve(&bulk, &span) == NULL && span == 0);
+    run_test(8, "Reserve/Commit Contiguous Regions", zc_ok);
+
+    // Test 9: Peek/Release reads the same bytes back in place
+    const uint8_t *rd = circ_buf_peek(&bulk, &span);
+    zc_ok = (rd == &bulk_mem[4] && span == 4 && memcmp(rd, src, 4) == 0);
+    circ_buf_release(&bulk, span);
+    rd = circ_buf_peek(&bulk, &span);
+    zc_ok = zc_ok && (rd == &bulk_mem[0] && span == 3 && memcmp(rd, src + 4, 3) == 0);
+    circ_buf_release(&bulk, span);
+    zc_ok = zc_ok && (circ_buf_peek(&bulk, &span) == NULL && circ_buf_pop(&bulk, &val) == CB_EMPTY);
+    run_test(9, "Peek/Release In-Place Reads", zc_ok);
+
+    // Test 10: MPMC queue with multi-byte elements, full and empty detection
+    typedef struct { uint16_t id; int32_t reading; } sample_t;
+    static _Alignas(max_align_t) uint8_t mpmc_mem[MPMC_QUEUE_MEM_SIZE(8, sizeof(sample_t))];
+    mpmc_queue_t mq;
+    bool mq_ok = (mpmc_queue_init(&mq, mpmc_mem, sizeof(mpmc_mem), sizeof(sample_t)) == CB_OK &&
+                  mpmc_queue_capacity(&mq) == 8);
+    for (int lap = 0; lap < 3; lap++) {
+        for (int i = 0; i < 8; i++) {
+            sample_t s = { (uint16_t)i, -1000 * i };
+            if (mpmc_queue_push(&mq, &s) != CB_OK) mq_ok = false;
+        }
+        sample_t extra = { 99, 99 };
+        if (mpmc_queue_push(&mq, &extra) != CB_FULL) mq_ok = false;
+        for (int i = 0; i < 8; i++) {
+            sample_t s;
+            if (mpmc_queue_pop(&mq, &s) != CB_OK || s.id != i || s.reading != -1000 * i) mq_ok = false;
+        }
+        if (mpmc_queue_pop(&mq, NULL) != CB_EMPTY) mq_ok = false;
+    }
+    run_test(10, "MPMC Generic Elements + Full/Empty", mq_ok);
+
+    // Test 11: 4 producers / 2 consumers, every item delivered exactly once
+    static _Alignas(max_align_t) uint8_t stress_mpmc_mem[MPMC_QUEUE_MEM_SIZE(64, sizeof(uint32_t))];
+    mpmc_queue_t smq;
+    mpmc_queue_init(&smq, stress_mpmc_mem, sizeof(stress_mpmc_mem), sizeof(uint32_t));
+    atomic_size_t mpmc_popped = 0;
+    mpmc_ctx_t pctx[MPMC_PRODUCERS], cctx[MPMC_CONSUMERS];
+    pthread_t pth[MPMC_PRODUCERS], cth[MPMC_CONSUMERS];
+    for (int i = 0; i < MPMC_CONSUMERS; i++) {
+        cctx[i] = (mpmc_ctx_t){ &smq, 0, calloc(MPMC_TOTAL, 1), &mpmc_popped };
+        pthread_create(&cth[i], NULL, mpmc_consumer, &cctx[i]);
+    }
+    for (int i = 0; i < MPMC_PRODUCERS; i++) {
+        pctx[i] = (mpmc_ctx_t){ &smq, (uint32_t)i, NULL, NULL };
+        pthread_create(&pth[i], NULL, mpmc_producer, &pctx[i]);
+    }
+    for (int i = 0; i < MPMC_PRODUCERS; i++) pthread_join(pth[i], NULL);
+    for (int i = 0; i < MPMC_CONSUMERS; i++) pthread_join(cth[i], NULL);
+    bool exactly_once = true;
+    for (size_t id = 0; id < MPMC_TOTAL; id++) {
+        int hits = 0;
+        for (int i = 0; i < MPMC_CONSUMERS; i++) hits += cctx[i].seen[id];
+        if (hits != 1) exactly_once = false;
+    }
+    for (int i = 0; i < MPMC_CONSUMERS; i++) free(cctx[i].seen);
+    run_test(11, "MPMC 4P/2C Stress (each item exactly once)", exactly_once);
+
+    // Test 12: Overwrite-oldest keeps only the newest 'capacity' records
+    static _Alignas(max_align_t) uint8_t log_mem[LOG_RING_MEM_SIZE(8, sizeof(log_rec_t))];
+    log_ring_t lr;
+    log_rec_t snap[16];
+    size_t first = 99;
+    bool lr_ok = (log_ring_init(&lr, log_mem, sizeof(log_mem), sizeof(log_rec_t)) == CB_OK &&
+                  log_ring_snapshot(&lr, snap, 16, &first) == 0);
+    for (size_t i = 0; i < 20; i++) {
+        log_rec_t rec = { i, i * 3, ~i };
+        log_ring_write(&lr, &rec);
+    }
+    size_t n = log_ring_snapshot(&lr, snap, 16, &first);
+    lr_ok = lr_ok && (n == 8 && first == 12 && snap[0].seq == 12 && snap[7].seq == 19);
+    n = log_ring_snapshot(&lr, snap, 3, &first);
+    lr_ok = lr_ok && (n == 3 && first == 17 && snap[2].seq == 19);
+    run_test(12, "Log Ring Overwrite-Oldest + Last-N Snapshot", lr_ok);
+
+    // Test 13: Snapshots taken while the writer runs are never torn or gapped
+    static _Alignas(max_align_t) uint8_t log_stress_mem[LOG_RING_MEM_SIZE(64, sizeof(log_rec_t))];
+    log_ring_t lrs;
+    log_ring_init(&lrs, log_stress_mem, sizeof(log_stress_mem), sizeof(log_rec_t));
+    log_ctx_t lctx = { &lrs, false, 0, 0, 0 };
+    pthread_t wth, rth;
+    pthread_create(&rth, NULL, log_reader, &lctx);
+    pthread_create(&wth, NULL, log_writer, &lctx);
+    pthread_join(wth, NULL);
+    pthread_join(rth, NULL);
+    run_test(13, "Log Ring Concurrent Snapshots (no torn records)",
+             (lctx.torn == 0 && lctx.gaps == 0 && lctx.snapshots > 0));
+
+    printf("\n---------------------------------------\n");
+    if (total_failures == 0) {
+        printf("RESULT: ALL TESTS PASSED ✅\n");
+    } else {
+        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
+    }
+    printf("---------------------------------------\n");
+
+    return (total_failures == 0) ? 0 : 1;
+}
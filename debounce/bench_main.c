@@ -0,0 +1,244 @@
+/*
+Debouncer Benchmarks
+Throughput in inputs/second (one input sampled once = one input):
+- FSM         : update_debounce() called once per input per tick
+- Vertical    : vdebounce_update_*() once per tick for the whole bank,
+                scalar (64 inputs per op), SSE2 (128) and AVX2 (256)
+
+Raw levels bounce at random so both sides take their busy paths.
+Build with -mavx2 to include the AVX2 kernel.
+
+Polling vs event-driven on a simulated 10k-input bank (CPU time):
+- Each input is pressed about once every 10 s; every press and release
+  bounces for a few ms. Some presses are held long enough to repeat.
+- Polling : update_debounce() + gesture timeout check for every input,
+            every 1 ms tick (what the original loop has to do)
+- Event   : edb_edge() for each recorded edge, edb_advance() per tick
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "debounce.h"
+#include "debounce_vertical.h"
+#include "debounce_event.h"
+
+#define NUM_INPUTS  8192
+#define NUM_TICKS   2000
+#define NUM_TRACES  64     // Pre-generated raw samples, reused cyclically
+
+#define EDGE_INPUTS      10000
+#define EDGE_SIM_MS      10000
+#define EDGE_PRESS_EVERY 10000   // Mean ms between presses per input
+
+typedef void (*vdb_kernel_fn)(vdebounce_t *, const uint64_t *, uint64_t *, uint64_t *);
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static _Alignas(32) uint64_t traces[NUM_TRACES][VDB_WORDS(NUM_INPUTS)];
+static _Alignas(32) uint64_t bank_mem[VDB_MEM_WORDS(NUM_INPUTS)];
+static uint64_t rising[VDB_WORDS(NUM_INPUTS)];
+static uint64_t falling[VDB_WORDS(NUM_INPUTS)];
+static debouncer_t fsm[NUM_INPUTS];
+
+static volatile uint64_t sink;
+
+static void build_traces(void) {
+    uint64_t level[VDB_WORDS(NUM_INPUTS)] = {0};
+    for (int t = 0; t < NUM_TRACES; t++) {
+        for (size_t i = 0; i < NUM_INPUTS; i++) {
+            if (xorshift32() % 8 == 0) level[i >> 6] ^= 1ULL << (i & 63);
+        }
+        for (size_t w = 0; w < VDB_WORDS(NUM_INPUTS); w++) traces[t][w] = level[w];
+    }
+}
+
+static uint64_t cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void report(const char *name, uint64_t ns) {
+    double inputs = (double)NUM_INPUTS * NUM_TICKS;
+    printf("  %-10s %10.2f ms  %12.1f M inputs/s\n",
+           name, (double)ns / 1e6, inputs / ((double)ns / 1e9) / 1e6);
+}
+
+static void bench_fsm(void) {
+    uint64_t edges = 0;
+    uint64_t start = now_ns();
+    for (uint32_t t = 0; t < NUM_TICKS; t++) {
+        system_millis = t;
+        const uint64_t *raw = traces[t % NUM_TRACES];
+        for (size_t i = 0; i < NUM_INPUTS; i++) {
+            edges += update_debounce(&fsm[i], (int)((raw[i >> 6] >> (i & 63)) & 1ULL));
+        }
+    }
+    report("FSM", now_ns() - start);
+    sink = edges;
+}
+
+static void bench_vertical(const char *name, vdb_kernel_fn kernel) {
+    vdebounce_t bank;
+    vdebounce_init(&bank, bank_mem, NUM_INPUTS, DEBOUNCE_THRESHOLD_MS + 1);
+
+    uint64_t edges = 0;
+    uint64_t start = now_ns();
+    for (uint32_t t = 0; t < NUM_TICKS; t++) {
+        kernel(&bank, traces[t % NUM_TRACES], rising, falling);
+        edges += rising[0] | falling[0];
+    }
+    report(name, now_ns() - start);
+    sink = edges;
+}
+
+// --- Polling vs Event-Driven ---
+
+typedef struct {
+    uint32_t time;
+    uint32_t input;
+} edge_t;
+
+static edge_t *edges;
+static size_t num_edges;
+static uint64_t gesture_count;
+
+static int compare_edges(const void *a, const void *b) {
+    const edge_t *x = a, *y = b;
+    if (x->time != y->time) return (x->time < y->time) ? -1 : 1;
+    return (x->input < y->input) ? -1 : (x->input > y->input);
+}
+
+// Appends a bouncy transition: a burst of toggles ending on the new level
+static void add_bounce(size_t *count, size_t cap, uint32_t input, uint32_t t) {
+    uint32_t bounces = 1 + 2 * (xorshift32() % 3);      // 1, 3 or 5 toggles
+    for (uint32_t b = 0; b < bounces && *count < cap; b++) {
+        edges[(*count)++] = (edge_t){ t + b, input };
+    }
+}
+
+static void build_edge_trace(void) {
+    size_t cap = (size_t)EDGE_INPUTS * 64;
+    edges = malloc(cap * sizeof(edge_t));
+    num_edges = 0;
+
+    for (uint32_t i = 0; i < EDGE_INPUTS; i++) {
+        uint32_t t = 1 + xorshift32() % EDGE_PRESS_EVERY;
+        while (t + 4000 < EDGE_SIM_MS) {
+            // Mostly clicks, sometimes a long hold
+            uint32_t hold = (xorshift32() % 8 == 0) ? 3000 + xorshift32() % 1000 : 80 + xorshift32() % 200;
+            add_bounce(&num_edges, cap, i, t);
+            add_bounce(&num_edges, cap, i, t + hold);
+            t += hold + 1 + xorshift32() % (2 * EDGE_PRESS_EVERY);
+        }
+    }
+    qsort(edges, num_edges, sizeof(edge_t), compare_edges);
+}
+
+static void count_gesture(void *ctx, uint32_t input, gesture_event_t event) {
+    (void)ctx;
+    (void)input;
+    (void)event;
+    gesture_count++;
+}
+
+static void bench_polling(void) {
+    debouncer_t *db = calloc(EDGE_INPUTS, sizeof(debouncer_t));
+    gesture_t *g = calloc(EDGE_INPUTS, sizeof(gesture_t));
+    uint8_t *level = calloc(EDGE_INPUTS, 1);
+    for (uint32_t i = 0; i < EDGE_INPUTS; i++) gesture_init(&g[i]);
+
+    gesture_count = 0;
+    size_t e = 0;
+    uint64_t start = cpu_ns();
+    for (uint32_t t = 1; t <= EDGE_SIM_MS; t++) {
+        system_millis = t;
+        // Polling still has to sample the pins; the trace stands in for them
+        for (; e < num_edges && edges[e].time == t; e++) level[edges[e].input] ^= 1;
+
+        for (uint32_t i = 0; i < EDGE_INPUTS; i++) {
+            bool was = (db[i].state == STATE_PRESSED || db[i].state == STATE_MAYBE_RELEASED);
+            update_debounce(&db[i], level[i]);
+            bool now = (db[i].state == STATE_PRESSED || db[i].state == STATE_MAYBE_RELEASED);
+            if (now != was) {
+                gesture_count += gesture_feed(&g[i], now ? GESTURE_IN_PRESS : GESTURE_IN_RELEASE, t) != GESTURE_NONE;
+            }
+            if (g[i].armed && gesture_time_reached(t, g[i].deadline)) {
+                gesture_count += gesture_feed(&g[i], GESTURE_IN_TIMEOUT, t) != GESTURE_NONE;
+            }
+        }
+    }
+    uint64_t ns = cpu_ns() - start;
+    printf("  %-10s %10.2f ms CPU  %8.1f ns/tick  %8llu gestures\n", "Polling",
+           (double)ns / 1e6, (double)ns / EDGE_SIM_MS, (unsigned long long)gesture_count);
+
+    free(db);
+    free(g);
+    free(level);
+}
+
+static void bench_event(void) {
+    edb_input_t *inputs = malloc(EDGE_INPUTS * sizeof(edb_input_t));
+    edb_heap_entry_t *heap = malloc(EDGE_INPUTS * sizeof(edb_heap_entry_t));
+    uint8_t *level = calloc(EDGE_INPUTS, 1);
+    edb_bank_t bank;
+    edb_init(&bank, inputs, heap, EDGE_INPUTS, count_gesture, NULL);
+
+    gesture_count = 0;
+    size_t e = 0;
+    uint64_t start = cpu_ns();
+    for (uint32_t t = 1; t <= EDGE_SIM_MS; t++) {
+        for (; e < num_edges && edges[e].time == t; e++) {
+            uint32_t i = edges[e].input;
+            level[i] ^= 1;
+            edb_edge(&bank, i, level[i], t);
+        }
+        edb_advance(&bank, t);
+    }
+    uint64_t ns = cpu_ns() - start;
+    printf("  %-10s %10.2f ms CPU  %8.1f ns/tick  %8llu gestures\n", "Event",
+           (double)ns / 1e6, (double)ns / EDGE_SIM_MS, (unsigned long long)gesture_count);
+
+    free(inputs);
+    free(heap);
+    free(level);
+}
+
+int main() {
+    build_traces();
+
+    printf("--- Debouncer Throughput (%d inputs x %d ticks) ---\n", NUM_INPUTS, NUM_TICKS);
+    bench_fsm();
+    bench_vertical("scalar", vdebounce_update_scalar);
+#if defined(__SSE2__)
+    bench_vertical("SSE2", vdebounce_update_sse2);
+#endif
+#if defined(__AVX2__)
+    bench_vertical("AVX2", vdebounce_update_avx2);
+#else
+    printf("  AVX2       (not compiled, build with -mavx2)\n");
+#endif
+
+    build_edge_trace();
+    printf("\n--- Polling vs Event-Driven (%d inputs, %d ms, %zu edges) ---\n",
+           EDGE_INPUTS, EDGE_SIM_MS, num_edges);
+    bench_polling();
+    bench_event();
+    free(edges);
+    return 0;
+}
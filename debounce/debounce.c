@@ -18,38 +18,11 @@ Logic Flow:
 4. If the state changes again before the timer expires, reset the timer.
 */
 
-#include <stdio.h>
-#include <stdint.h>
-#include <stdbool.h>
+#include "debounce.h"
 
 // Simulated System Time (incremented in test harness)
 uint32_t system_millis = 0;
 
-// Configuration
-#define DEBOUNCE_THRESHOLD_MS 50
-#define BUTTON_PIN_LOW  0
-#define BUTTON_PIN_HIGH 1
-
-typedef enum {
-    STATE_RELEASED,
-    STATE_MAYBE_PRESSED,
-    STATE_PRESSED,
-    STATE_MAYBE_RELEASED
-} button_state_t;
-
-typedef struct {
-    button_state_t state;
-    uint32_t last_tick;
-    bool stable_output;
-} debouncer_t;
-
-/**
- * @brief Processes the raw GPIO input and updates the debouncer state.
- * @param raw_level The current physical level of the GPIO (0 or 1).
- * @return true if the button is considered "stable pressed".
- */
-bool update_debounce(debouncer_t *db, int raw_level);
-
 // --- Implementation Placeholder ---
 
 bool update_debounce(debouncer_t *db, int raw_level) {
@@ -94,70 +67,21 @@ bool update_debounce(debouncer_t *db, int raw_level) {
     return (db->state == STATE_PRESSED);
 }
 
-// --- Test Harness ---
-
-static int total_failures = 0;
-
-void verify(const char* desc, bool condition) {
-    if (condition) {
-        printf("[PASS] %s\n", desc);
-    } else {
-        printf("[FAIL] %s\n", desc);
-        total_failures++;
-    }
-}
-
-int main() {
-    printf("--- Running Debouncer Validation ---\n");
-
-    debouncer_t my_button = { STATE_RELEASED, 0, false };
-
-    // Scenario 1: Quick Noise (Should NOT trigger)
-    system_millis = 10;
-    update_debounce(&my_button, BUTTON_PIN_HIGH); // Initial noise
-    system_millis = 20;
-    bool noise_result = update_debounce(&my_button, BUTTON_PIN_LOW); // Drops back down
-    verify("Ignore noise shorter than threshold", noise_result == false);
-
-    // Scenario 2: Valid Press (Stable high for > threshold)
-    system_millis = 100;
-    update_debounce(&my_button, BUTTON_PIN_HIGH); // Start press
-    system_millis = 160; // 60ms have passed (Threshold is 50)
-    bool press_result = update_debounce(&my_button, BUTTON_PIN_HIGH);
-    verify("Confirm stable press after threshold", press_result == true);
-
-    // Scenario 3: Contact Bounce during Release
-    system_millis = 200;
-    update_debounce(&my_button, BUTTON_PIN_LOW); // Starts releasing
-    system_millis = 210;
-    update_debounce(&my_button, BUTTON_PIN_HIGH); // Bounces back high
-    system_millis = 270;
-    bool release_result = update_debounce(&my_button, BUTTON_PIN_LOW);
-    verify("Stay 'pressed' if release bounces", my_button.state != STATE_RELEASED);
-
-    printf("\n---------------------------------------\n");
-    if (total_failures == 0) {
-        printf("RESULT: ALL TESTS PASSED ✅\n");
-    } else {
-        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
-    }
-    printf("---------------------------------------\n");
-
-    return (total_failures == 0) ? 0 : 1;
-}
-
 /*
 Key Interviewer Follow-up Questions:
 1. Interrupts vs. Polling: If you used an Interrupt (ISR) to detect the 
    button edge, how would you handle the fact that the interrupt might 
    fire 100 times in 5ms due to bouncing?
+   (See debounce_event.c: each edge only restarts one deadline.)
 
 2. Vertical Counter Debouncing: How can you use bitwise math (a "vertical counter") 
    to debounce 8 or 16 buttons simultaneously in a single register?
+   (See debounce_vertical.c: 64 buttons per uint64_t, 256 per AVX2 register.)
 
 3. Active Low vs. Active High: If your button has a pull-up resistor, 
    what is the GPIO level when the button is NOT pressed?
 
 4. The "Long Press": How would you modify your FSM to distinguish 
    between a "short click" and a "3-second long press"?
+   (See debounce_gesture.c: click / double-click / long-press / repeat.)
 */
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Simulated System Time (incremented in test harness)
+extern uint32_t system_millis;
+
+// Configuration
+#define DEBOUNCE_THRESHOLD_MS 50
+#define BUTTON_PIN_LOW  0
+#define BUTTON_PIN_HIGH 1
+
+typedef enum {
+    STATE_RELEASED,
+    STATE_MAYBE_PRESSED,
+    STATE_PRESSED,
+    STATE_MAYBE_RELEASED
+} button_state_t;
+
+typedef struct {
+    button_state_t state;
+    uint32_t last_tick;
+    bool stable_output;
+} debouncer_t;
+
+/**
+ * @brief Processes the raw GPIO input and updates the debouncer state.
+ * @param raw_level The current physical level of the GPIO (0 or 1).
+ * @return true if the button is considered "stable pressed".
+ */
+bool update_debounce(debouncer_t *db, int raw_level);
+
+#endif // DEBOUNCE_H
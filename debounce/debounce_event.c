@@ -0,0 +1,177 @@
+#include <stddef.h>
+#include "debounce_event.h"
+
+// --- Deadline Heap (min-heap on deadline, wrap-safe) ---
+
+static inline bool deadline_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static void heap_place(edb_bank_t *bank, uint32_t pos, edb_heap_entry_t e) {
+    bank->heap[pos] = e;
+    bank->inputs[e.input].heap_pos = pos;
+}
+
+static void heap_sift_up(edb_bank_t *bank, uint32_t pos) {
+    edb_heap_entry_t e = bank->heap[pos];
+    while (pos > 0) {
+        uint32_t parent = (pos - 1) / 2;
+        if (!deadline_before(e.deadline, bank->heap[parent].deadline)) break;
+        heap_place(bank, pos, bank->heap[parent]);
+        pos = parent;
+    }
+    heap_place(bank, pos, e);
+}
+
+static void heap_sift_down(edb_bank_t *bank, uint32_t pos) {
+    edb_heap_entry_t e = bank->heap[pos];
+    for (;;) {
+        uint32_t child = pos * 2 + 1;
+        if (child >= bank->heap_len) break;
+        if (child + 1 < bank->heap_len &&
+            deadline_before(bank->heap[child + 1].deadline, bank->heap[child].deadline)) {
+            child++;
+        }
+        if (!deadline_before(bank->heap[child].deadline, e.deadline)) break;
+        heap_place(bank, pos, bank->heap[child]);
+        pos = child;
+    }
+    heap_place(bank, pos, e);
+}
+
+static void heap_remove(edb_bank_t *bank, uint32_t pos) {
+    bank->inputs[bank->heap[pos].input].heap_pos = EDB_NOT_QUEUED;
+    bank->heap_len--;
+    if (pos == bank->heap_len) return;
+
+    // Fill the hole with the last entry, which may belong above or below it
+    edb_heap_entry_t last = bank->heap[bank->heap_len];
+    heap_place(bank, pos, last);
+    heap_sift_down(bank, pos);
+    if (bank->inputs[last.input].heap_pos == pos) heap_sift_up(bank, pos);
+}
+
+// Re-keys one input after its deadlines changed
+static void schedule(edb_bank_t *bank, uint32_t input) {
+    edb_input_t *in = &bank->inputs[input];
+    bool debouncing = (in->state == STATE_MAYBE_PRESSED || in->state == STATE_MAYBE_RELEASED);
+
+    if (!debouncing && !in->gesture.armed) {
+        if (in->heap_pos != EDB_NOT_QUEUED) heap_remove(bank, in->heap_pos);
+        return;
+    }
+
+    uint32_t deadline = debouncing ? in->debounce_deadline : in->gesture.deadline;
+    if (debouncing && in->gesture.armed && deadline_before(in->gesture.deadline, deadline)) {
+        deadline = in->gesture.deadline;
+    }
+
+    edb_heap_entry_t e = { deadline, input };
+    if (in->heap_pos == EDB_NOT_QUEUED) {
+        heap_place(bank, bank->heap_len++, e);
+        heap_sift_up(bank, in->heap_pos);
+    } else {
+        uint32_t pos = in->heap_pos;
+        bool earlier = deadline_before(deadline, bank->heap[pos].deadline);
+        bank->heap[pos] = e;
+        if (earlier) heap_sift_up(bank, pos);
+        else heap_sift_down(bank, pos);
+    }
+}
+
+static void emit(edb_bank_t *bank, uint32_t input, gesture_input_t what, uint32_t now) {
+    gesture_event_t ev = gesture_feed(&bank->inputs[input].gesture, what, now);
+    if (ev != GESTURE_NONE && bank->on_event != NULL) {
+        bank->on_event(bank->ctx, input, ev);
+    }
+}
+
+// --- Public API ---
+
+int edb_init(edb_bank_t *bank, edb_input_t *inputs, edb_heap_entry_t *heap,
+             uint32_t num_inputs, edb_event_cb on_event, void *ctx) {
+    if (bank == NULL || inputs == NULL || heap == NULL || num_inputs == 0 ||
+        num_inputs == EDB_NOT_QUEUED) {
+        return -1;
+    }
+
+    bank->inputs = inputs;
+    bank->heap = heap;
+    bank->num_inputs = num_inputs;
+    bank->heap_len = 0;
+    bank->on_event = on_event;
+    bank->ctx = ctx;
+
+    for (uint32_t i = 0; i < num_inputs; i++) {
+        inputs[i].state = STATE_RELEASED;
+        inputs[i].debounce_deadline = 0;
+        inputs[i].heap_pos = EDB_NOT_QUEUED;
+        gesture_init(&inputs[i].gesture);
+    }
+    return 0;
+}
+
+void edb_edge(edb_bank_t *bank, uint32_t input, int raw_level, uint32_t now) {
+    if (input >= bank->num_inputs) return;
+
+    edb_input_t *in = &bank->inputs[input];
+    bool is_active = (raw_level == BUTTON_PIN_HIGH);
+
+    // Same transitions as update_debounce(), minus the timeout checks
+    switch (in->state) {
+        case STATE_RELEASED:
+            if (!is_active) return;
+            in->state = STATE_MAYBE_PRESSED;
+            in->debounce_deadline = now + DEBOUNCE_THRESHOLD_MS;
+            break;
+
+        case STATE_MAYBE_PRESSED:
+            if (is_active) return;
+            in->state = STATE_RELEASED;
+            break;
+
+        case STATE_PRESSED:
+            if (is_active) return;
+            in->state = STATE_MAYBE_RELEASED;
+            in->debounce_deadline = now + DEBOUNCE_THRESHOLD_MS;
+            break;
+
+        case STATE_MAYBE_RELEASED:
+            if (!is_active) return;
+            in->state = STATE_PRESSED;
+            break;
+    }
+    schedule(bank, input);
+}
+
+uint32_t edb_advance(edb_bank_t *bank, uint32_t now) {
+    uint32_t fired = 0;
+
+    while (bank->heap_len > 0 && !deadline_before(now, bank->heap[0].deadline)) {
+        uint32_t input = bank->heap[0].input;
+        edb_input_t *in = &bank->inputs[input];
+
+        // Debounce first, as update_debounce() runs before gesture timeouts
+        if (in->state == STATE_MAYBE_PRESSED && gesture_time_reached(now, in->debounce_deadline)) {
+            in->state = STATE_PRESSED;
+            emit(bank, input, GESTURE_IN_PRESS, now);
+        } else if (in->state == STATE_MAYBE_RELEASED && gesture_time_reached(now, in->debounce_deadline)) {
+            in->state = STATE_RELEASED;
+            emit(bank, input, GESTURE_IN_RELEASE, now);
+        }
+
+        if (in->gesture.armed && gesture_time_reached(now, in->gesture.deadline)) {
+            emit(bank, input, GESTURE_IN_TIMEOUT, now);
+        }
+
+        schedule(bank, input);
+        fired++;
+    }
+    return fired;
+}
+
+bool edb_next_deadline(const edb_bank_t *bank, uint32_t *deadline) {
+    if (bank->heap_len == 0) return false;
+    if (deadline != NULL) *deadline = bank->heap[0].deadline;
+    return true;
+}
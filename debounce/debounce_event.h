@@ -0,0 +1,90 @@
+#ifndef DEBOUNCE_EVENT_H
+#define DEBOUNCE_EVENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "debounce.h"
+#include "debounce_gesture.h"
+
+/*
+ * Event-Driven Debouncer (answer to follow-up question 1)
+ *
+ * update_debounce() must be polled every tick for every button. Here the
+ * same STATE_* machine only runs when something happens:
+ *
+ *   - edb_edge():    an input changed level (GPIO interrupt, edge capture)
+ *   - edb_advance(): time moved on; fires every deadline that is now due
+ *
+ * A deadline exists only while an input is in a MAYBE_* state or its
+ * gesture recognizer has a timer armed. Armed inputs sit in a binary
+ * min-heap keyed by their earliest deadline, so:
+ *
+ *   - an idle input costs nothing per tick
+ *   - an edge or a deadline costs O(log armed inputs)
+ *   - edb_next_deadline() tells a tickless system how long it may sleep
+ *
+ * An interrupt storm from a bouncing contact just restarts the same
+ * deadline; no extra work is queued per bounce.
+ *
+ * Driven with one sample per ms (edges applied before edb_advance()), the
+ * debounced state follows update_debounce() tick for tick.
+ */
+
+#define EDB_NOT_QUEUED UINT32_MAX
+
+typedef struct {
+    uint32_t deadline;      // Absolute ms
+    uint32_t input;         // Index into edb_bank_t.inputs
+} edb_heap_entry_t;
+
+typedef struct {
+    button_state_t state;
+    uint32_t debounce_deadline;   // Valid in STATE_MAYBE_* only
+    gesture_t gesture;
+    uint32_t heap_pos;            // EDB_NOT_QUEUED when nothing is armed
+} edb_input_t;
+
+typedef void (*edb_event_cb)(void *ctx, uint32_t input, gesture_event_t event);
+
+typedef struct {
+    edb_input_t *inputs;
+    edb_heap_entry_t *heap;
+    uint32_t num_inputs;
+    uint32_t heap_len;
+    edb_event_cb on_event;        // May be NULL
+    void *ctx;
+} edb_bank_t;
+
+/**
+ * @param inputs   num_inputs elements of caller-provided storage
+ * @param heap     num_inputs elements of caller-provided storage
+ * @param on_event Called for every gesture (may be NULL)
+ * @return 0 on success, -1 on bad arguments
+ */
+int edb_init(edb_bank_t *bank, edb_input_t *inputs, edb_heap_entry_t *heap,
+             uint32_t num_inputs, edb_event_cb on_event, void *ctx);
+
+/**
+ * @brief Reports a raw level change of one input at time 'now'. O(log n)
+ *        Repeated reports of the same level are harmless.
+ */
+void edb_edge(edb_bank_t *bank, uint32_t input, int raw_level, uint32_t now);
+
+/**
+ * @brief Fires every deadline due at or before 'now'.
+ * @return Number of deadlines processed (0 when nothing was due)
+ */
+uint32_t edb_advance(edb_bank_t *bank, uint32_t now);
+
+/**
+ * @brief Earliest armed deadline, for sleeping until it.
+ * @return false if nothing is armed (sleep until the next edge)
+ */
+bool edb_next_deadline(const edb_bank_t *bank, uint32_t *deadline);
+
+static inline bool edb_is_pressed(const edb_bank_t *bank, uint32_t input) {
+    button_state_t s = bank->inputs[input].state;
+    return s == STATE_PRESSED || s == STATE_MAYBE_RELEASED;
+}
+
+#endif // DEBOUNCE_EVENT_H
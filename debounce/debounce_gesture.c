@@ -0,0 +1,78 @@
+#include "debounce_gesture.h"
+
+// What to do with the deadline on a transition
+typedef enum {
+    TIMER_KEEP,             // Leave it as it is
+    TIMER_STOP,
+    TIMER_LONG_PRESS,
+    TIMER_DOUBLE_CLICK,
+    TIMER_REPEAT
+} gesture_timer_t;
+
+typedef struct {
+    uint8_t next;           // gesture_state_t
+    uint8_t event;          // gesture_event_t
+    uint8_t timer;          // gesture_timer_t
+} gesture_transition_t;
+
+#define STAY(s) { (s), GESTURE_NONE, TIMER_KEEP }
+
+// [state][input] -> transition. Combinations that cannot happen (e.g. a
+// press while already down) leave everything untouched.
+static const gesture_transition_t gesture_table[GSTATE_COUNT][GESTURE_IN_COUNT] = {
+    [GSTATE_IDLE] = {
+        [GESTURE_IN_PRESS]   = { GSTATE_DOWN, GESTURE_NONE, TIMER_LONG_PRESS },
+        [GESTURE_IN_RELEASE] = STAY(GSTATE_IDLE),
+        [GESTURE_IN_TIMEOUT] = STAY(GSTATE_IDLE),
+    },
+    [GSTATE_DOWN] = {
+        [GESTURE_IN_PRESS]   = STAY(GSTATE_DOWN),
+        [GESTURE_IN_RELEASE] = { GSTATE_CLICK_WAIT, GESTURE_NONE, TIMER_DOUBLE_CLICK },
+        [GESTURE_IN_TIMEOUT] = { GSTATE_HELD, GESTURE_LONG_PRESS, TIMER_REPEAT },
+    },
+    [GSTATE_CLICK_WAIT] = {
+        [GESTURE_IN_PRESS]   = { GSTATE_DOWN2, GESTURE_DOUBLE_CLICK, TIMER_STOP },
+        [GESTURE_IN_RELEASE] = STAY(GSTATE_CLICK_WAIT),
+        [GESTURE_IN_TIMEOUT] = { GSTATE_IDLE, GESTURE_CLICK, TIMER_STOP },
+    },
+    [GSTATE_DOWN2] = {
+        [GESTURE_IN_PRESS]   = STAY(GSTATE_DOWN2),
+        [GESTURE_IN_RELEASE] = { GSTATE_IDLE, GESTURE_NONE, TIMER_STOP },
+        [GESTURE_IN_TIMEOUT] = STAY(GSTATE_DOWN2),
+    },
+    [GSTATE_HELD] = {
+        [GESTURE_IN_PRESS]   = STAY(GSTATE_HELD),
+        [GESTURE_IN_RELEASE] = { GSTATE_IDLE, GESTURE_NONE, TIMER_STOP },
+        [GESTURE_IN_TIMEOUT] = { GSTATE_HELD, GESTURE_REPEAT, TIMER_REPEAT },
+    },
+};
+
+static const uint32_t gesture_timer_ms[] = {
+    [TIMER_LONG_PRESS]   = GESTURE_LONG_PRESS_MS,
+    [TIMER_DOUBLE_CLICK] = GESTURE_DOUBLE_CLICK_MS,
+    [TIMER_REPEAT]       = GESTURE_REPEAT_MS,
+};
+
+void gesture_init(gesture_t *g) {
+    g->state = GSTATE_IDLE;
+    g->armed = false;
+    g->deadline = 0;
+}
+
+gesture_event_t gesture_feed(gesture_t *g, gesture_input_t in, uint32_t now) {
+    const gesture_transition_t *tr = &gesture_table[g->state][in];
+
+    g->state = tr->next;
+    switch (tr->timer) {
+        case TIMER_KEEP:
+            break;
+        case TIMER_STOP:
+            g->armed = false;
+            break;
+        default:
+            g->armed = true;
+            g->deadline = now + gesture_timer_ms[tr->timer];
+            break;
+    }
+    return (gesture_event_t)tr->event;
+}
@@ -0,0 +1,75 @@
+#ifndef DEBOUNCE_GESTURE_H
+#define DEBOUNCE_GESTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Gesture Recognizer (answer to follow-up question 4)
+ *
+ * Runs on the DEBOUNCED press / release edges, never on raw levels, so it
+ * never sees bounce. A small table maps (state, input) to the next state,
+ * the event to emit and the timer to arm:
+ *
+ *   IDLE       --press-->    DOWN        arm long-press timer
+ *   DOWN       --release-->  CLICK_WAIT  arm double-click window
+ *   DOWN       --timeout-->  HELD        LONG_PRESS, arm repeat timer
+ *   HELD       --timeout-->  HELD        REPEAT, re-arm repeat timer
+ *   HELD       --release-->  IDLE
+ *   CLICK_WAIT --timeout-->  IDLE        CLICK (no second press came)
+ *   CLICK_WAIT --press-->    DOWN2       DOUBLE_CLICK
+ *   DOWN2      --release-->  IDLE
+ *
+ * A single click is only reported once the double-click window closes;
+ * otherwise the first half of every double click would also be a click.
+ */
+
+#define GESTURE_DOUBLE_CLICK_MS 250   // Max gap between release and 2nd press
+#define GESTURE_LONG_PRESS_MS   3000  // Hold time before LONG_PRESS
+#define GESTURE_REPEAT_MS       200   // REPEAT period while still held
+
+typedef enum {
+    GESTURE_NONE,
+    GESTURE_CLICK,
+    GESTURE_DOUBLE_CLICK,
+    GESTURE_LONG_PRESS,
+    GESTURE_REPEAT
+} gesture_event_t;
+
+typedef enum {
+    GESTURE_IN_PRESS,       // Debouncer confirmed a press
+    GESTURE_IN_RELEASE,     // Debouncer confirmed a release
+    GESTURE_IN_TIMEOUT,     // The armed deadline was reached
+    GESTURE_IN_COUNT
+} gesture_input_t;
+
+typedef enum {
+    GSTATE_IDLE,
+    GSTATE_DOWN,
+    GSTATE_CLICK_WAIT,
+    GSTATE_DOWN2,
+    GSTATE_HELD,
+    GSTATE_COUNT
+} gesture_state_t;
+
+typedef struct {
+    uint8_t state;          // gesture_state_t
+    bool armed;             // deadline is valid
+    uint32_t deadline;      // Absolute ms
+} gesture_t;
+
+void gesture_init(gesture_t *g);
+
+/**
+ * @brief Advances the recognizer by one input. O(1), one table lookup.
+ * @param now   Current time in ms (the deadline is armed relative to it)
+ * @return The event produced by this step, or GESTURE_NONE
+ */
+gesture_event_t gesture_feed(gesture_t *g, gesture_input_t in, uint32_t now);
+
+// Wrap-safe "has 'deadline' been reached at 'now'" for 32-bit ms clocks
+static inline bool gesture_time_reached(uint32_t now, uint32_t deadline) {
+    return (int32_t)(now - deadline) >= 0;
+}
+
+#endif // DEBOUNCE_GESTURE_H
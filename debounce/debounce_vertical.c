@@ -0,0 +1,112 @@
+#include <stdint.h>
+#include <string.h>
+#include "debounce_vertical.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+int vdebounce_init(vdebounce_t *db, uint64_t *mem, size_t num_inputs, uint32_t threshold) {
+    if (db == NULL || mem == NULL || num_inputs == 0) return -1;
+    if (threshold == 0 || threshold > VDB_MAX_THRESHOLD) return -1;
+    if (((uintptr_t)mem & 31) != 0) return -1;
+
+    db->num_inputs = num_inputs;
+    db->words = VDB_WORDS(num_inputs);
+    db->threshold = threshold;
+    db->state = mem;
+    for (int p = 0; p < VDB_COUNTER_BITS; p++) {
+        db->plane[p] = mem + db->words * (size_t)(p + 1);
+    }
+
+    // All inputs start released with a zero counter
+    memset(mem, 0, VDB_MEM_WORDS(num_inputs) * sizeof(uint64_t));
+    return 0;
+}
+
+/*
+ * One kernel body, instantiated for each register width.
+ *
+ *   delta  = raw ^ state                 (inputs that disagree with state)
+ *   plane += delta  (ripple-carry add, one plane at a time),
+ *            and lanes with delta == 0 are cleared (counter reset)
+ *   eq     = lanes where counter == threshold
+ *   state ^= eq, and those counters restart at 0
+ */
+#define VDB_KERNEL(VEC, STEP, LOAD, LOADU, STORE, STOREU, XOR, AND, ANDNOT)      \
+    uint32_t thr = db->threshold;                                             \
+    for (size_t w = 0; w < db->words; w += (STEP)) {                          \
+        VEC st = LOAD(db->state + w);                                         \
+        VEC delta = XOR(LOADU(raw + w), st);                                  \
+        VEC carry = delta;                                                    \
+        VEC eq = delta;                                                       \
+        VEC cnt[VDB_COUNTER_BITS];                                            \
+        for (int p = 0; p < VDB_COUNTER_BITS; p++) {                          \
+            VEC c = LOAD(db->plane[p] + w);                                   \
+            VEC sum = AND(XOR(c, carry), delta);                              \
+            carry = AND(c, carry);                                            \
+            eq = ((thr >> p) & 1u) ? AND(eq, sum) : ANDNOT(sum, eq);          \
+            cnt[p] = sum;                                                     \
+        }                                                                     \
+        for (int p = 0; p < VDB_COUNTER_BITS; p++) {                          \
+            STORE(db->plane[p] + w, ANDNOT(eq, cnt[p]));                      \
+        }                                                                     \
+        st = XOR(st, eq);                                                     \
+        STORE(db->state + w, st);                                             \
+        if (rising != NULL)  STOREU(rising + w, AND(eq, st));                 \
+        if (falling != NULL) STOREU(falling + w, ANDNOT(st, eq));             \
+    }
+
+// --- Scalar: 64 inputs per step ---
+
+#define U64_LOAD(p)       (*(p))
+#define U64_STORE(p, v)   (*(p) = (v))
+#define U64_XOR(a, b)     ((a) ^ (b))
+#define U64_AND(a, b)     ((a) & (b))
+#define U64_ANDNOT(a, b)  (~(a) & (b))
+
+void vdebounce_update_scalar(vdebounce_t *db, const uint64_t *raw, uint64_t *rising, uint64_t *falling) {
+    VDB_KERNEL(uint64_t, 1, U64_LOAD, U64_LOAD, U64_STORE, U64_STORE,
+               U64_XOR, U64_AND, U64_ANDNOT)
+}
+
+// --- SSE2: 128 inputs per step ---
+
+#if defined(__SSE2__)
+#define SSE_LOAD(p)       _mm_load_si128((const __m128i *)(p))
+#define SSE_LOADU(p)      _mm_loadu_si128((const __m128i *)(p))
+#define SSE_STORE(p, v)   _mm_store_si128((__m128i *)(p), (v))
+#define SSE_STOREU(p, v)  _mm_storeu_si128((__m128i *)(p), (v))
+
+void vdebounce_update_sse2(vdebounce_t *db, const uint64_t *raw, uint64_t *rising, uint64_t *falling) {
+    VDB_KERNEL(__m128i, 2, SSE_LOAD, SSE_LOADU, SSE_STORE, SSE_STOREU,
+               _mm_xor_si128, _mm_and_si128, _mm_andnot_si128)
+}
+#endif
+
+// --- AVX2: 256 inputs per step ---
+
+#if defined(__AVX2__)
+#define AVX_LOAD(p)       _mm256_load_si256((const __m256i *)(p))
+#define AVX_LOADU(p)      _mm256_loadu_si256((const __m256i *)(p))
+#define AVX_STORE(p, v)   _mm256_store_si256((__m256i *)(p), (v))
+#define AVX_STOREU(p, v)  _mm256_storeu_si256((__m256i *)(p), (v))
+
+void vdebounce_update_avx2(vdebounce_t *db, const uint64_t *raw, uint64_t *rising, uint64_t *falling) {
+    VDB_KERNEL(__m256i, 4, AVX_LOAD, AVX_LOADU, AVX_STORE, AVX_STOREU,
+               _mm256_xor_si256, _mm256_and_si256, _mm256_andnot_si256)
+}
+#endif
+
+void vdebounce_update(vdebounce_t *db, const uint64_t *raw, uint64_t *rising, uint64_t *falling) {
+#if defined(__AVX2__)
+    vdebounce_update_avx2(db, raw, rising, falling);
+#elif defined(__SSE2__)
+    vdebounce_update_sse2(db, raw, rising, falling);
+#else
+    vdebounce_update_scalar(db, raw, rising, falling);
+#endif
+}
@@ -0,0 +1,75 @@
+#ifndef DEBOUNCE_VERTICAL_H
+#define DEBOUNCE_VERTICAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Vertical-Counter Debouncer (answer to follow-up question 2)
+ *
+ * Instead of one counter per button, each BIT of a counter lives in its own
+ * word ("bit-plane"). Bit i of plane[0..N-1] together form input i's counter.
+ * One set of AND/XOR/OR operations then updates 64 counters per uint64_t,
+ * 128 per SSE2 register or 256 per AVX2 register.
+ *
+ * Per input, every sample:
+ *   - raw == stable state   -> counter = 0
+ *   - raw != stable state   -> counter++
+ *   - counter == threshold  -> flip the stable state, counter = 0
+ *
+ * This is exactly what update_debounce() does when it is called once per
+ * millisecond: an input must differ for DEBOUNCE_THRESHOLD_MS + 1 samples
+ * in a row (the first sample starts the timer, the last one sees >= 50 ms).
+ */
+
+#define VDB_COUNTER_BITS  6                             // Counter planes
+#define VDB_MAX_THRESHOLD ((1u << VDB_COUNTER_BITS) - 1) // 63 samples
+
+// Words per bank, padded to a whole AVX2 register (4 x 64 inputs)
+#define VDB_WORDS(num_inputs)     ((((num_inputs) + 255) / 256) * 4)
+
+// uint64_t words of memory needed: stable state + counter planes
+#define VDB_MEM_WORDS(num_inputs) (VDB_WORDS(num_inputs) * (VDB_COUNTER_BITS + 1))
+
+typedef struct {
+    size_t num_inputs;
+    size_t words;                            // VDB_WORDS(num_inputs)
+    uint32_t threshold;                      // Samples needed to flip
+    uint64_t *state;                         // Debounced level, 1 bit per input
+    uint64_t *plane[VDB_COUNTER_BITS];       // Counter bit-planes
+} vdebounce_t;
+
+/**
+ * @param db          Pointer to the handle
+ * @param mem         VDB_MEM_WORDS(num_inputs) words, 32-byte aligned
+ * @param num_inputs  Number of digital inputs in the bank
+ * @param threshold   Consecutive differing samples before a flip (1..63).
+ *                    Use DEBOUNCE_THRESHOLD_MS / tick_ms + 1 to match
+ *                    update_debounce().
+ * @return 0 on success, -1 on bad arguments or misaligned memory
+ */
+int vdebounce_init(vdebounce_t *db, uint64_t *mem, size_t num_inputs, uint32_t threshold);
+
+/**
+ * @brief Feeds one sample of every input. Uses the widest SIMD compiled in.
+ * @param raw       VDB_WORDS(num_inputs) words of raw levels (bit i = input i)
+ * @param rising    Out (may be NULL): bit set where the input became pressed
+ * @param falling   Out (may be NULL): bit set where the input became released
+ */
+void vdebounce_update(vdebounce_t *db, const uint64_t *raw, uint64_t *rising, uint64_t *falling);
+
+// Fixed-width kernels, exposed for benchmarking and cross-checking
+void vdebounce_update_scalar(vdebounce_t *db, const uint64_t *raw, uint64_t *rising, uint64_t *falling);
+#if defined(__SSE2__)
+void vdebounce_update_sse2(vdebounce_t *db, const uint64_t *raw, uint64_t *rising, uint64_t *falling);
+#endif
+#if defined(__AVX2__)
+void vdebounce_update_avx2(vdebounce_t *db, const uint64_t *raw, uint64_t *rising, uint64_t *falling);
+#endif
+
+static inline bool vdebounce_get(const vdebounce_t *db, size_t input) {
+    return (db->state[input >> 6] >> (input & 63)) & 1ULL;
+}
+
+#endif // DEBOUNCE_VERTICAL_H
@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "debounce.h"
+#include "debounce_vertical.h"
+#include "debounce_event.h"
+
+// --- Test Harness ---
+
+static int total_failures = 0;
+
+void verify(const char* desc, bool condition) {
+    if (condition) {
+        printf("[PASS] %s\n", desc);
+    } else {
+        printf("[FAIL] %s\n", desc);
+        total_failures++;
+    }
+}
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Runs one FSM per input and one vertical bank side by side at a 1 ms tick,
+// on raw levels that bounce at random. Returns true if the debounced level
+// and every edge match on every tick.
+static bool vertical_matches_fsm(size_t n, uint32_t ticks) {
+    size_t words = VDB_WORDS(n);
+    uint64_t *mem = aligned_alloc(32, VDB_MEM_WORDS(n) * sizeof(uint64_t));
+    uint64_t *raw = calloc(words, sizeof(uint64_t));
+    uint64_t *rise = calloc(words, sizeof(uint64_t));
+    uint64_t *fall = calloc(words, sizeof(uint64_t));
+    debouncer_t *fsm = calloc(n, sizeof(debouncer_t));
+    bool ok = (mem != NULL && raw != NULL && rise != NULL && fall != NULL && fsm != NULL);
+
+    vdebounce_t bank;
+    ok = ok && vdebounce_init(&bank, mem, n, DEBOUNCE_THRESHOLD_MS + 1) == 0;
+
+    for (uint32_t t = 1; ok && t <= ticks; t++) {
+        system_millis = t;
+        for (size_t i = 0; i < n; i++) {
+            // Each input flips with its own odds: 1/2 (pure bounce) ... 1/256
+            uint32_t odds = 2u << (i % 8);
+            if (xorshift32() % odds == 0) raw[i >> 6] ^= 1ULL << (i & 63);
+        }
+        vdebounce_update(&bank, raw, rise, fall);
+
+        for (size_t i = 0; i < n; i++) {
+            bool was = (fsm[i].state == STATE_PRESSED || fsm[i].state == STATE_MAYBE_RELEASED);
+            update_debounce(&fsm[i], (int)((raw[i >> 6] >> (i & 63)) & 1ULL));
+            bool now = (fsm[i].state == STATE_PRESSED || fsm[i].state == STATE_MAYBE_RELEASED);
+
+            bool v_rise = (rise[i >> 6] >> (i & 63)) & 1ULL;
+            bool v_fall = (fall[i >> 6] >> (i & 63)) & 1ULL;
+            if (vdebounce_get(&bank, i) != now || v_rise != (!was && now) || v_fall != (was && !now)) {
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    free(mem);
+    free(raw);
+    free(rise);
+    free(fall);
+    free(fsm);
+    return ok;
+}
+
+#if defined(__SSE2__)
+static uint64_t rand64(void) {
+    return ((uint64_t)xorshift32() << 32) | xorshift32();
+}
+
+// Feeds the same random samples to two banks through two kernels
+static bool kernels_match(void (*a)(vdebounce_t *, const uint64_t *, uint64_t *, uint64_t *),
+                          void (*b)(vdebounce_t *, const uint64_t *, uint64_t *, uint64_t *)) {
+    enum { N = 1000, TICKS = 3000 };
+    size_t words = VDB_WORDS(N);
+    static _Alignas(32) uint64_t mem_a[VDB_MEM_WORDS(N)], mem_b[VDB_MEM_WORDS(N)];
+    uint64_t raw[VDB_WORDS(N)] = {0};
+    uint64_t rise_a[VDB_WORDS(N)], fall_a[VDB_WORDS(N)];
+    uint64_t rise_b[VDB_WORDS(N)], fall_b[VDB_WORDS(N)];
+    vdebounce_t da, dbk;
+
+    if (vdebounce_init(&da, mem_a, N, 20) != 0 || vdebounce_init(&dbk, mem_b, N, 20) != 0) return false;
+
+    for (int t = 0; t < TICKS; t++) {
+        for (size_t w = 0; w < (N / 64); w++) {
+            // Sparse flips so some counters actually reach the threshold
+            raw[w] ^= rand64() & rand64() & rand64() & rand64();
+        }
+        a(&da, raw, rise_a, fall_a);
+        b(&dbk, raw, rise_b, fall_b);
+        if (memcmp(rise_a, rise_b, sizeof(rise_a)) != 0 || memcmp(fall_a, fall_b, sizeof(fall_a)) != 0 ||
+            memcmp(da.state, dbk.state, words * sizeof(uint64_t)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+// --- Event-Driven Debouncer Helpers ---
+
+typedef struct {
+    uint32_t time;
+    uint32_t input;
+    uint32_t event;
+} event_record_t;
+
+typedef struct {
+    event_record_t *log;
+    size_t count;
+    size_t cap;
+} event_log_t;
+
+static void log_event(event_log_t *log, uint32_t input, gesture_event_t event) {
+    if (log->count < log->cap) {
+        log->log[log->count++] = (event_record_t){ system_millis, input, (uint32_t)event };
+    }
+}
+
+static void on_gesture(void *ctx, uint32_t input, gesture_event_t event) {
+    log_event((event_log_t *)ctx, input, event);
+}
+
+static int compare_records(const void *a, const void *b) {
+    const event_record_t *x = a, *y = b;
+    if (x->time != y->time) return (x->time < y->time) ? -1 : 1;
+    if (x->input != y->input) return (x->input < y->input) ? -1 : 1;
+    return (int)x->event - (int)y->event;
+}
+
+// Single input: drives 'level' changes at the given times, then runs the
+// clock to 'end'. Returns the gesture events in order.
+static size_t run_single(const uint32_t *edge_times, size_t num_edges, uint32_t end,
+                         event_record_t *out, size_t cap) {
+    edb_input_t input;
+    edb_heap_entry_t heap[1];
+    edb_bank_t bank;
+    event_log_t log = { out, 0, cap };
+    edb_init(&bank, &input, heap, 1, on_gesture, &log);
+
+    int level = BUTTON_PIN_LOW;
+    size_t e = 0;
+    for (uint32_t t = 1; t <= end; t++) {
+        system_millis = t;
+        while (e < num_edges && edge_times[e] == t) {
+            level = !level;
+            edb_edge(&bank, 0, level, t);
+            e++;
+        }
+        edb_advance(&bank, t);
+    }
+    return log.count;
+}
+
+// Polls update_debounce() + gesture_feed() every ms for every input and
+// runs the event-driven bank on the same edges. Both must produce the same
+// debounced levels and the same gestures at the same times.
+static bool events_match_polling(uint32_t n, uint32_t ticks, uint32_t kinds_seen[5]) {
+    debouncer_t *fsm = calloc(n, sizeof(debouncer_t));
+    gesture_t *gest = calloc(n, sizeof(gesture_t));
+    uint8_t *level = calloc(n, 1);
+    edb_input_t *inputs = calloc(n, sizeof(edb_input_t));
+    edb_heap_entry_t *heap = calloc(n, sizeof(edb_heap_entry_t));
+    size_t cap = (size_t)n * ticks / 50 + 1024;
+    event_log_t polled = { calloc(cap, sizeof(event_record_t)), 0, cap };
+    event_log_t evented = { calloc(cap, sizeof(event_record_t)), 0, cap };
+    edb_bank_t bank;
+
+    bool ok = (fsm != NULL && gest != NULL && level != NULL && inputs != NULL && heap != NULL &&
+               polled.log != NULL && evented.log != NULL);
+    ok = ok && edb_init(&bank, inputs, heap, n, on_gesture, &evented) == 0;
+    for (uint32_t i = 0; ok && i < n; i++) gesture_init(&gest[i]);
+
+    for (uint32_t t = 1; ok && t <= ticks; t++) {
+        system_millis = t;
+
+        // Event-driven side only hears about inputs that changed
+        for (uint32_t i = 0; i < n; i++) {
+            // Odds per ms range from 1/2 (bounce) to 1/8192 (long holds)
+            uint32_t odds = 2u << (i % 13);
+            if (xorshift32() % odds == 0) {
+                level[i] ^= 1;
+                edb_edge(&bank, i, level[i], t);
+            }
+        }
+        edb_advance(&bank, t);
+
+        // Polling side looks at everything
+        for (uint32_t i = 0; i < n; i++) {
+            bool was = (fsm[i].state == STATE_PRESSED || fsm[i].state == STATE_MAYBE_RELEASED);
+            update_debounce(&fsm[i], level[i]);
+            bool now = (fsm[i].state == STATE_PRESSED || fsm[i].state == STATE_MAYBE_RELEASED);
+
+            gesture_event_t ev = GESTURE_NONE;
+            if (now != was) {
+                ev = gesture_feed(&gest[i], now ? GESTURE_IN_PRESS : GESTURE_IN_RELEASE, t);
+                if (ev != GESTURE_NONE) log_event(&polled, i, ev);
+            }
+            if (gest[i].armed && gesture_time_reached(t, gest[i].deadline)) {
+                ev = gesture_feed(&gest[i], GESTURE_IN_TIMEOUT, t);
+                if (ev != GESTURE_NONE) log_event(&polled, i, ev);
+            }
+
+            if (edb_is_pressed(&bank, i) != now) ok = false;
+        }
+    }
+
+    ok = ok && polled.count == evented.count && polled.count < cap;
+    if (ok) {
+        qsort(polled.log, polled.count, sizeof(event_record_t), compare_records);
+        qsort(evented.log, evented.count, sizeof(event_record_t), compare_records);
+        ok = memcmp(polled.log, evented.log, polled.count * sizeof(event_record_t)) == 0;
+        for (size_t k = 0; k < polled.count; k++) kinds_seen[polled.log[k].event]++;
+    }
+
+    free(fsm);
+    free(gest);
+    free(level);
+    free(inputs);
+    free(heap);
+    free(polled.log);
+    free(evented.log);
+    return ok;
+}
+
+int main() {
+    printf("--- Running Debouncer Validation ---\n");
+
+    debouncer_t my_button = { STATE_RELEASED, 0, false };
+
+    // Scenario 1: Quick Noise (Should NOT trigger)
+    system_millis = 10;
+    update_debounce(&my_button, BUTTON_PIN_HIGH); // Initial noise
+    system_millis = 20;
+    bool noise_result = update_debounce(&my_button, BUTTON_PIN_LOW); // Drops back down
+    verify("Ignore noise shorter than threshold", noise_result == false);
+
+    // Scenario 2: Valid Press (Stable high for > threshold)
+    system_millis = 100;
+    update_debounce(&my_button, BUTTON_PIN_HIGH); // Start press
+    system_millis = 160; // 60ms have passed (Threshold is 50)
+    bool press_result = update_debounce(&my_button, BUTTON_PIN_HIGH);
+    verify("Confirm stable press after threshold", press_result == true);
+
+    // Scenario 3: Contact Bounce during Release
+    system_millis = 200;
+    update_debounce(&my_button, BUTTON_PIN_LOW); // Starts releasing
+    system_millis = 210;
+    update_debounce(&my_button, BUTTON_PIN_HIGH); // Bounces back high
+    system_millis = 270;
+    bool release_result = update_debounce(&my_button, BUTTON_PIN_LOW);
+    verify("Stay 'pressed' if release bounces", my_button.state != STATE_RELEASED);
+
+    // Scenario 4: Vertical counters behave exactly like the FSM at a 1 ms tick
+    {
+        vdebounce_t bank;
+        static _Alignas(32) uint64_t mem[VDB_MEM_WORDS(64)];
+        verify("Vertical bank rejects threshold 0 and > 63",
+               vdebounce_init(&bank, mem, 64, 0) != 0 && vdebounce_init(&bank, mem, 64, 64) != 0);
+        verify("Vertical bank rejects memory that is not 32-byte aligned",
+               vdebounce_init(&bank, mem + 1, 64, 10) != 0);
+    }
+    verify("Vertical bank matches update_debounce on 300 bouncing inputs", vertical_matches_fsm(300, 5000));
+    verify("Vertical bank matches update_debounce on 5000 bouncing inputs", vertical_matches_fsm(5000, 500));
+
+    // Scenario 5: Every compiled SIMD kernel equals the scalar one
+#if defined(__SSE2__)
+    verify("SSE2 kernel matches scalar kernel", kernels_match(vdebounce_update_scalar, vdebounce_update_sse2));
+#endif
+#if defined(__AVX2__)
+    verify("AVX2 kernel matches scalar kernel", kernels_match(vdebounce_update_scalar, vdebounce_update_avx2));
+#endif
+
+    // Scenario 6: Event-driven gestures
+    {
+        event_record_t ev[16];
+
+        // Press at 1000, release at 1200: debounced 1050 / 1250, click once
+        // the double-click window closes at 1500
+        uint32_t click[] = { 1000, 1200 };
+        size_t n = run_single(click, 2, 2000, ev, 16);
+        verify("Short press yields one CLICK after the double-click window",
+               n == 1 && ev[0].event == GESTURE_CLICK && ev[0].time == 1250 + GESTURE_DOUBLE_CLICK_MS);
+
+        // Second press 100 ms after the first release
+        uint32_t dbl[] = { 1000, 1200, 1300, 1400 };
+        n = run_single(dbl, 4, 2000, ev, 16);
+        verify("Two quick presses yield one DOUBLE_CLICK and no CLICK",
+               n == 1 && ev[0].event == GESTURE_DOUBLE_CLICK && ev[0].time == 1350);
+
+        // Bouncy press held for 3.5 s: LONG_PRESS at +3000, REPEAT every 200 ms
+        uint32_t hold[] = { 1000, 1002, 1003, 1010, 1011, 4511 };
+        n = run_single(hold, 6, 6000, ev, 16);
+        verify("Long hold yields LONG_PRESS then REPEATs until release",
+               n == 3 && ev[0].event == GESTURE_LONG_PRESS && ev[0].time == 1061 + GESTURE_LONG_PRESS_MS &&
+               ev[1].event == GESTURE_REPEAT && ev[1].time == ev[0].time + GESTURE_REPEAT_MS &&
+               ev[2].event == GESTURE_REPEAT && ev[2].time == ev[1].time + GESTURE_REPEAT_MS);
+
+        // Nothing armed once everything has settled
+        edb_input_t input;
+        edb_heap_entry_t heap[1];
+        edb_bank_t bank;
+        uint32_t deadline = 0;
+        edb_init(&bank, &input, heap, 1, NULL, NULL);
+        edb_edge(&bank, 0, BUTTON_PIN_HIGH, 10);
+        bool armed = edb_next_deadline(&bank, &deadline) && deadline == 10 + DEBOUNCE_THRESHOLD_MS;
+        edb_edge(&bank, 0, BUTTON_PIN_LOW, 20);
+        verify("Idle input has no deadline and costs nothing per tick",
+               armed && !edb_next_deadline(&bank, NULL) && edb_advance(&bank, 1000) == 0);
+    }
+
+    uint32_t kinds[5] = {0};
+    verify("Event-driven bank matches polled FSM + gestures on 500 inputs",
+           events_match_polling(500, 20000, kinds));
+    verify("Cross-check saw clicks, double-clicks, long presses and repeats",
+           kinds[GESTURE_CLICK] > 0 && kinds[GESTURE_DOUBLE_CLICK] > 0 &&
+           kinds[GESTURE_LONG_PRESS] > 0 && kinds[GESTURE_REPEAT] > 0);
+
+    printf("\n---------------------------------------\n");
+    if (total_failures == 0) {
+        printf("RESULT: ALL TESTS PASSED ✅\n");
+    } else {
+        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
+    }
+    printf("---------------------------------------\n");
+
+    return (total_failures == 0) ? 0 : 1;
+}
@@ -1,3 +1,5 @@
+#include "../memmanage/mem_arena.h"
+
 // DO NOT DO THIS IN PRODUCTION
 void process_sensor_data(int size) {
     uint8_t *buffer = (uint8_t *)malloc(size * sizeof(uint8_t));
@@ -9,4 +11,23 @@ void process_sensor_data(int size) {
 
     // Do work...
     free(buffer);
-}
\ No newline at end of file
+}
+
+// DO THIS INSTEAD: per-call scratch memory from a bump arena
+// (memmanage/mem_arena.h). Reserved once at build time, O(1) to take,
+// O(1) to give back, and running out is a handled error, not a reboot.
+static uint8_t scratch_region[2048];
+static arena_t scratch = ARENA_INITIALIZER(scratch_region, sizeof(scratch_region));
+
+void process_sensor_data_arena(int size) {
+    arena_mark_t frame = arena_mark(&scratch);
+    uint8_t *buffer = arena_alloc(&scratch, (size_t)size);
+
+    if (buffer == NULL) {
+        // Request larger than the frame budget: drop this frame
+        return;
+    }
+
+    // Do work...
+    arena_rewind(&scratch, frame);
+}
@@ -0,0 +1,280 @@
+/*
+Memory Pool Benchmarks
+ns per alloc + free pair, pool sizes 10 .. 100k blocks of 64 bytes:
+- Free list : msg_pool_alloc() / msg_pool_free()         O(1)
+- Scan      : the original allocate_block(), scanning for
+              !is_used; free clears the flag               O(n) alloc
+- malloc    : malloc(64) / free()
+
+Workloads:
+- fill/drain: allocate every block, then free them in random order
+- churn     : pool kept half full; each step frees a random live block
+              and allocates a new one (the scan's worst realistic case,
+              since free blocks end up scattered)
+
+Multi-threaded (1 .. 16 threads), M alloc+free pairs per second:
+- Each thread keeps 64 live blocks and replaces a random one per step
+- Magazine : mt_pool_alloc() / mt_pool_free(), one cache per thread
+- Mutex    : msg_pool_t behind one pthread mutex
+- malloc   : glibc malloc(64) / free()
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "mem_pools.h"
+#include "mem_pools_mt.h"
+
+#define MAX_BLOCKS   100000
+#define CHURN_STEPS  200000
+
+#define MT_MAX_THREADS  16
+#define MT_LIVE         64
+#define MT_STEPS        200000
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// --- Baseline: The Original Linear Scan ---
+
+typedef struct {
+    uint8_t data[64];
+    bool is_used;
+} ScanBlock;
+
+static ScanBlock scan_pool[MAX_BLOCKS];
+static size_t scan_size;
+
+static void *scan_alloc(void) {
+    for (size_t i = 0; i < scan_size; i++) {
+        if (!scan_pool[i].is_used) {
+            scan_pool[i].is_used = true;
+            return &scan_pool[i];
+        }
+    }
+    return NULL;
+}
+
+static void scan_free(void *p) {
+    ((ScanBlock *)p)->is_used = false;
+}
+
+// --- Free List ---
+
+static msg_slot_t list_storage[MAX_BLOCKS];
+static msg_pool_t list_pool;
+
+static void *list_alloc(void) { return msg_pool_alloc(&list_pool); }
+static void list_free(void *p) { msg_pool_free(&list_pool, (MessageBlock *)p); }
+
+// --- malloc ---
+
+static void *heap_alloc(void) { return malloc(64); }
+static void heap_free(void *p) { free(p); }
+
+typedef struct {
+    const char *name;
+    void *(*alloc)(void);
+    void (*release)(void *);
+} allocator_t;
+
+static void *live[MAX_BLOCKS];
+
+static void reset(size_t n) {
+    scan_size = n;
+    for (size_t i = 0; i < n; i++) scan_pool[i].is_used = false;
+    msg_pool_init(&list_pool, list_storage, n);
+}
+
+static double bench_fill_drain(const allocator_t *a, size_t n) {
+    int rounds = (int)(1000000 / n) + 1;
+    if (a->alloc == scan_alloc && n >= 10000) rounds = 1;   // O(n^2) per round
+
+    uint64_t start = now_ns();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t i = 0; i < n; i++) live[i] = a->alloc();
+
+        // Free in a random order (Fisher-Yates over the live array)
+        for (size_t i = n; i > 0; i--) {
+            size_t j = xorshift32() % i;
+            a->release(live[j]);
+            live[j] = live[i - 1];
+        }
+    }
+    return (double)(now_ns() - start) / ((double)rounds * n);
+}
+
+static double bench_churn(const allocator_t *a, size_t n) {
+    size_t half = (n + 1) / 2;
+    for (size_t i = 0; i < half; i++) live[i] = a->alloc();
+
+    // The scan is O(n) per step; keep its total run time bounded
+    int steps = (a->alloc == scan_alloc) ? (int)(CHURN_STEPS / (n / 100 + 1)) + 100 : CHURN_STEPS;
+
+    uint64_t start = now_ns();
+    for (int s = 0; s < steps; s++) {
+        size_t k = xorshift32() % half;
+        a->release(live[k]);
+        live[k] = a->alloc();
+    }
+    double ns = (double)(now_ns() - start) / steps;
+
+    for (size_t i = 0; i < half; i++) a->release(live[i]);
+    return ns;
+}
+
+// --- Multi-Threaded ---
+
+typedef enum { MT_MAGAZINE, MT_MUTEX, MT_MALLOC } mt_kind_t;
+
+static MessageBlock mt_blocks[MAX_BLOCKS];
+static mt_link_t mt_links[MAX_BLOCKS];
+static mt_pool_t mt_pool;
+static pthread_mutex_t mutex_lock = PTHREAD_MUTEX_INITIALIZER;
+static _Atomic int mt_ready;
+static _Atomic bool mt_go;
+
+typedef struct {
+    mt_kind_t kind;
+    uint32_t seed;
+} mt_arg_t;
+
+static void *mt_alloc(mt_kind_t kind, mt_cache_t *cache) {
+    switch (kind) {
+        case MT_MAGAZINE:
+            return mt_pool_alloc(&mt_pool, cache);
+        case MT_MUTEX: {
+            pthread_mutex_lock(&mutex_lock);
+            void *p = msg_pool_alloc(&list_pool);
+            pthread_mutex_unlock(&mutex_lock);
+            return p;
+        }
+        default:
+            return malloc(64);
+    }
+}
+
+static void mt_release(mt_kind_t kind, mt_cache_t *cache, void *p) {
+    switch (kind) {
+        case MT_MAGAZINE:
+            mt_pool_free(&mt_pool, cache, p);
+            break;
+        case MT_MUTEX:
+            pthread_mutex_lock(&mutex_lock);
+            msg_pool_free(&list_pool, p);
+            pthread_mutex_unlock(&mutex_lock);
+            break;
+        default:
+            free(p);
+            break;
+    }
+}
+
+static void *mt_worker(void *arg) {
+    mt_arg_t *a = (mt_arg_t *)arg;
+    mt_cache_t cache;
+    void *held[MT_LIVE];
+    uint32_t rng = a->seed;
+
+    mt_cache_init(&cache);
+    for (int i = 0; i < MT_LIVE; i++) held[i] = mt_alloc(a->kind, &cache);
+
+    atomic_fetch_add(&mt_ready, 1);
+    while (!atomic_load_explicit(&mt_go, memory_order_acquire)) sched_yield();
+
+    for (int s = 0; s < MT_STEPS; s++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        int k = (int)(rng % MT_LIVE);
+        mt_release(a->kind, &cache, held[k]);
+        held[k] = mt_alloc(a->kind, &cache);
+    }
+
+    for (int i = 0; i < MT_LIVE; i++) mt_release(a->kind, &cache, held[i]);
+    mt_cache_flush(&mt_pool, &cache);
+    return NULL;
+}
+
+static double bench_threads(mt_kind_t kind, int threads) {
+    pthread_t tid[MT_MAX_THREADS];
+    mt_arg_t args[MT_MAX_THREADS];
+
+    mt_pool_init(&mt_pool, mt_blocks, mt_links, MAX_BLOCKS);
+    msg_pool_init(&list_pool, list_storage, MAX_BLOCKS);
+    atomic_store(&mt_ready, 0);
+    atomic_store(&mt_go, false);
+
+    for (int t = 0; t < threads; t++) {
+        args[t].kind = kind;
+        args[t].seed = 0x9E3779B9u * (uint32_t)(t + 1);
+        pthread_create(&tid[t], NULL, mt_worker, &args[t]);
+    }
+    while (atomic_load(&mt_ready) < threads) sched_yield();
+
+    uint64_t start = now_ns();
+    atomic_store_explicit(&mt_go, true, memory_order_release);
+    for (int t = 0; t < threads; t++) pthread_join(tid[t], NULL);
+    double secs = (double)(now_ns() - start) / 1e9;
+
+    return (double)threads * MT_STEPS / secs / 1e6;
+}
+
+int main() {
+    static const size_t sizes[] = { 10, 100, 1000, 10000, 100000 };
+    static const allocator_t allocators[] = {
+        { "Free list", list_alloc, list_free },
+        { "Scan",      scan_alloc, scan_free },
+        { "malloc",    heap_alloc, heap_free },
+    };
+
+#ifdef MEM_POOL_DEBUG
+    printf("(MEM_POOL_DEBUG build: free list includes canary + double-free checks)\n\n");
+#endif
+
+    for (int w = 0; w < 2; w++) {
+        printf("--- %s: ns per alloc + free ---\n", w == 0 ? "Fill / Drain" : "Churn (half full)");
+        printf("  %8s", "blocks");
+        for (size_t a = 0; a < 3; a++) printf("  %12s", allocators[a].name);
+        printf("\n");
+
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            printf("  %8zu", sizes[s]);
+            for (size_t a = 0; a < 3; a++) {
+                reset(sizes[s]);
+                double ns = (w == 0) ? bench_fill_drain(&allocators[a], sizes[s])
+                                     : bench_churn(&allocators[a], sizes[s]);
+                printf("  %12.1f", ns);
+            }
+            printf("\n");
+        }
+        printf("\n");
+    }
+
+    printf("--- Multi-Threaded: M alloc + free per second ---\n");
+    printf("  %8s  %12s  %12s  %12s\n", "threads", "Magazine", "Mutex", "malloc");
+    for (int threads = 1; threads <= MT_MAX_THREADS; threads *= 2) {
+        printf("  %8d  %12.1f  %12.1f  %12.1f\n", threads,
+               bench_threads(MT_MAGAZINE, threads),
+               bench_threads(MT_MUTEX, threads),
+               bench_threads(MT_MALLOC, threads));
+    }
+    return 0;
+}
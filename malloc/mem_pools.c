@@ -1,17 +1,91 @@
-typedef struct {
-    uint8_t data[64];
-    bool is_used;
-} MessageBlock;
+#include <string.h>
+#include "mem_pools.h"
 
 #define POOL_SIZE 10
-static MessageBlock msg_pool[POOL_SIZE];
-
-MessageBlock* allocate_block() {
-    for (int i = 0; i < POOL_SIZE; i++) {
-        if (!msg_pool[i].is_used) {
-            msg_pool[i].is_used = true;
-            return &msg_pool[i];
-        }
+static msg_slot_t msg_pool_storage[POOL_SIZE];
+static msg_pool_t msg_pool = MSG_POOL_INITIALIZER(msg_pool_storage, POOL_SIZE);
+
+pool_status_t msg_pool_init(msg_pool_t *pool, msg_slot_t *slots, size_t num_blocks) {
+    if (pool == NULL || slots == NULL || num_blocks == 0) return POOL_INVALID;
+
+    pool->slots = slots;
+    pool->num_blocks = num_blocks;
+    pool->next_unused = 0;
+    pool->free_count = num_blocks;
+    pool->free_head = NULL;
+
+#ifdef MEM_POOL_DEBUG
+    for (size_t i = 0; i < num_blocks; i++) slots[i].is_used = false;
+#endif
+    return POOL_OK;
+}
+
+// The link lives in the first bytes of a free block's payload. memcpy
+// keeps this free of aliasing issues and compiles to a single move.
+static inline MessageBlock *next_free(const MessageBlock *block) {
+    MessageBlock *next;
+    memcpy(&next, block->data, sizeof(next));
+    return next;
+}
+
+static inline void set_next_free(MessageBlock *block, MessageBlock *next) {
+    memcpy(block->data, &next, sizeof(next));
+}
+
+// msg_slot_t starts with its block, so a block pointer is a slot pointer
+static inline msg_slot_t *slot_of(MessageBlock *block) {
+    return (msg_slot_t *)block;
+}
+
+MessageBlock *msg_pool_alloc(msg_pool_t *pool) {
+    MessageBlock *block = pool->free_head;
+
+    if (block != NULL) {
+        pool->free_head = next_free(block);
+    } else if (pool->next_unused < pool->num_blocks) {
+        block = &pool->slots[pool->next_unused++].block;
+    } else {
+        return NULL; // Predictable failure
     }
-    return NULL; // Predictable failure
-}
\ No newline at end of file
+    pool->free_count--;
+
+#ifdef MEM_POOL_DEBUG
+    slot_of(block)->is_used = true;
+    slot_of(block)->canary = MSG_POOL_CANARY;
+#endif
+    return block;
+}
+
+pool_status_t msg_pool_free(msg_pool_t *pool, MessageBlock *block) {
+    if (block == NULL) return POOL_INVALID;
+
+    pool_status_t status = POOL_OK;
+
+#ifdef MEM_POOL_DEBUG
+    // Must point at the start of one of our slots
+    uintptr_t base = (uintptr_t)pool->slots;
+    uintptr_t addr = (uintptr_t)block;
+    if (addr < base || addr >= base + pool->num_blocks * sizeof(msg_slot_t) ||
+        (addr - base) % sizeof(msg_slot_t) != 0) {
+        return POOL_INVALID;
+    }
+
+    msg_slot_t *slot = slot_of(block);
+    if (!slot->is_used) return POOL_DOUBLE_FREE;
+    if (slot->canary != MSG_POOL_CANARY) status = POOL_CORRUPTED;
+    slot->is_used = false;
+#endif
+
+    set_next_free(block, pool->free_head);
+    pool->free_head = block;
+    pool->free_count++;
+    return status;
+}
+
+MessageBlock *allocate_block(void) {
+    return msg_pool_alloc(&msg_pool);
+}
+
+pool_status_t free_block(MessageBlock *block) {
+    return msg_pool_free(&msg_pool, block);
+}
@@ -0,0 +1,81 @@
+#ifndef MEM_POOLS_H
+#define MEM_POOLS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Fixed-Block Memory Pool
+ *
+ * Every free block stores a pointer to the next free block in its own
+ * (unused) payload: an intrusive free list. Alloc pops the head, free
+ * pushes onto it, both O(1) with no per-block "is_used" flag to scan.
+ *
+ * Blocks that were never handed out are not threaded up front: the pool
+ * bump-allocates from 'next_unused' until it reaches the end, so a pool
+ * can be initialized statically and never needs an O(n) init loop.
+ *
+ * Build with -DMEM_POOL_DEBUG to add, per block, a tail canary and a used
+ * flag. msg_pool_free() then rejects double frees and foreign pointers and
+ * reports blocks whose canary was overwritten.
+ */
+
+#define MSG_BLOCK_SIZE   64
+#define MSG_POOL_CANARY  0xC0FFEE42u
+
+typedef struct {
+    uint8_t data[MSG_BLOCK_SIZE];
+} MessageBlock;
+
+typedef struct {
+    MessageBlock block;
+#ifdef MEM_POOL_DEBUG
+    uint32_t canary;        // MSG_POOL_CANARY while the block is allocated
+    bool is_used;           // Debug only: never read on the release path
+#endif
+} msg_slot_t;
+
+typedef enum {
+    POOL_OK,
+    POOL_INVALID,           // NULL or not a block of this pool
+    POOL_DOUBLE_FREE,       // Debug: block was already free (ignored)
+    POOL_CORRUPTED          // Debug: canary overwritten (block still freed)
+} pool_status_t;
+
+typedef struct {
+    msg_slot_t *slots;
+    size_t num_blocks;
+    size_t next_unused;     // Blocks [next_unused, num_blocks) never used yet
+    size_t free_count;
+    MessageBlock *free_head;
+} msg_pool_t;
+
+// Static initializer: msg_pool_t pool = MSG_POOL_INITIALIZER(storage, n);
+#define MSG_POOL_INITIALIZER(storage, n) { (storage), (n), 0, (n), NULL }
+
+/**
+ * @param slots       Caller-provided storage for num_blocks slots
+ */
+pool_status_t msg_pool_init(msg_pool_t *pool, msg_slot_t *slots, size_t num_blocks);
+
+/**
+ * @brief Takes one block. O(1)
+ * @return The block, or NULL if the pool is exhausted (predictable failure)
+ */
+MessageBlock *msg_pool_alloc(msg_pool_t *pool);
+
+/**
+ * @brief Returns a block to the pool. O(1)
+ */
+pool_status_t msg_pool_free(msg_pool_t *pool, MessageBlock *block);
+
+static inline size_t msg_pool_available(const msg_pool_t *pool) {
+    return pool->free_count;
+}
+
+// The application-wide pool of POOL_SIZE blocks
+MessageBlock *allocate_block(void);
+pool_status_t free_block(MessageBlock *block);
+
+#endif // MEM_POOLS_H
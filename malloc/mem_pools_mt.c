@@ -0,0 +1,120 @@
+#include <stddef.h>
+#include "mem_pools_mt.h"
+
+#define HEAD_INDEX(h)   ((uint32_t)(h) - 1u)        // MT_POOL_NONE when empty
+#define HEAD_TAG(h)     ((uint32_t)((h) >> 32))
+#define MAKE_HEAD(tag, index) (((uint64_t)(tag) << 32) | (uint64_t)((index) + 1u))
+
+pool_status_t mt_pool_init(mt_pool_t *pool, MessageBlock *blocks, mt_link_t *links, uint32_t num_blocks) {
+    if (pool == NULL || blocks == NULL || links == NULL || num_blocks == 0 || num_blocks == MT_POOL_NONE) {
+        return POOL_INVALID;
+    }
+
+    pool->blocks = blocks;
+    pool->links = links;
+    pool->num_blocks = num_blocks;
+    atomic_init(&pool->stack_head, 0);
+    atomic_init(&pool->next_unused, 0);
+    return POOL_OK;
+}
+
+// --- Global Batch Stack (Treiber stack with tagged head) ---
+
+static void stack_push(mt_pool_t *pool, uint32_t first) {
+    uint64_t head = atomic_load_explicit(&pool->stack_head, memory_order_relaxed);
+    uint64_t next;
+    do {
+        atomic_store_explicit(&pool->links[first].next_batch, HEAD_INDEX(head), memory_order_relaxed);
+        next = MAKE_HEAD(HEAD_TAG(head) + 1u, first);
+    } while (!atomic_compare_exchange_weak_explicit(&pool->stack_head, &head, next,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+// Returns the first block of a batch, or MT_POOL_NONE if the stack is empty
+static uint32_t stack_pop(mt_pool_t *pool) {
+    uint64_t head = atomic_load_explicit(&pool->stack_head, memory_order_acquire);
+    for (;;) {
+        uint32_t first = HEAD_INDEX(head);
+        if (first == MT_POOL_NONE) return MT_POOL_NONE;
+
+        // May read a link that another thread is rewriting right now; the
+        // tag makes the CAS below fail in that case, so the value is unused
+        uint32_t next = atomic_load_explicit(&pool->links[first].next_batch, memory_order_relaxed);
+        uint64_t new_head = MAKE_HEAD(HEAD_TAG(head), next);
+
+        if (atomic_compare_exchange_weak_explicit(&pool->stack_head, &head, new_head,
+                                                  memory_order_acquire,
+                                                  memory_order_acquire)) {
+            return first;
+        }
+    }
+}
+
+// --- Magazine Refill / Drain ---
+
+static bool cache_refill(mt_pool_t *pool, mt_cache_t *cache) {
+    uint32_t idx = stack_pop(pool);
+    if (idx != MT_POOL_NONE) {
+        while (idx != MT_POOL_NONE) {
+            cache->slots[cache->count++] = idx;
+            idx = pool->links[idx].next_in_batch;
+        }
+        return true;
+    }
+
+    // Global stack empty: carve a batch of never-used blocks
+    uint32_t start = atomic_load_explicit(&pool->next_unused, memory_order_relaxed);
+    uint32_t end;
+    do {
+        if (start >= pool->num_blocks) return false;
+        end = (pool->num_blocks - start > MT_POOL_BATCH) ? start + MT_POOL_BATCH : pool->num_blocks;
+    } while (!atomic_compare_exchange_weak_explicit(&pool->next_unused, &start, end,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed));
+
+    // Hand them out lowest index first
+    for (uint32_t i = end; i > start; i--) {
+        cache->slots[cache->count++] = i - 1;
+    }
+    return true;
+}
+
+// Chains the 'n' most recently cached blocks into one batch and pushes it
+static void cache_drain(mt_pool_t *pool, mt_cache_t *cache, uint32_t n) {
+    uint32_t first = cache->slots[cache->count - n];
+    for (uint32_t i = cache->count - n; i < cache->count - 1; i++) {
+        pool->links[cache->slots[i]].next_in_batch = cache->slots[i + 1];
+    }
+    pool->links[cache->slots[cache->count - 1]].next_in_batch = MT_POOL_NONE;
+    cache->count -= n;
+    stack_push(pool, first);
+}
+
+// --- Public API ---
+
+MessageBlock *mt_pool_alloc(mt_pool_t *pool, mt_cache_t *cache) {
+    if (cache->count == 0 && !cache_refill(pool, cache)) {
+        return NULL; // Predictable failure
+    }
+    return &pool->blocks[cache->slots[--cache->count]];
+}
+
+pool_status_t mt_pool_free(mt_pool_t *pool, mt_cache_t *cache, MessageBlock *block) {
+    if (block == NULL || block < pool->blocks || block >= pool->blocks + pool->num_blocks) {
+        return POOL_INVALID;
+    }
+
+    if (cache->count == MT_POOL_CACHE_CAP) {
+        // Keep half so an alloc right after this does not refill at once
+        cache_drain(pool, cache, MT_POOL_BATCH);
+    }
+    cache->slots[cache->count++] = (uint32_t)(block - pool->blocks);
+    return POOL_OK;
+}
+
+void mt_cache_flush(mt_pool_t *pool, mt_cache_t *cache) {
+    while (cache->count > 0) {
+        cache_drain(pool, cache, (cache->count > MT_POOL_BATCH) ? MT_POOL_BATCH : cache->count);
+    }
+}
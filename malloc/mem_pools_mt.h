@@ -0,0 +1,85 @@
+#ifndef MEM_POOLS_MT_H
+#define MEM_POOLS_MT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "mem_pools.h"
+
+/*
+ * Multi-Core MessageBlock Pool
+ *
+ * msg_pool_t (mem_pools.c) is single-threaded: two cores calling
+ * allocate_block() at once can get the same block. This pool is safe to
+ * share between threads:
+ *
+ *   - Every thread owns an mt_cache_t, a "magazine" of up to
+ *     2 * MT_POOL_BATCH free blocks. Alloc and free hit only the
+ *     magazine, with no atomics at all, in the common case.
+ *   - An empty magazine pops one whole batch of MT_POOL_BATCH blocks from
+ *     the global stack; a full one pushes MT_POOL_BATCH blocks back.
+ *     One CAS moves a whole batch.
+ *   - The global stack is a Treiber stack of batches. Its head packs a
+ *     32-bit block index with a 32-bit tag that changes on every push, so
+ *     a stale CAS (the ABA problem) fails instead of corrupting the list.
+ *     Index + tag fit in one 64-bit word: no double-width CAS needed.
+ *
+ * Blocks are handed out in block-index order at first (bump allocation),
+ * so the pool needs no O(n) init. A block may be freed by a different
+ * thread than the one that allocated it.
+ */
+
+#define MT_POOL_BATCH      32
+#define MT_POOL_CACHE_CAP  (2 * MT_POOL_BATCH)
+#define MT_POOL_NONE       UINT32_MAX
+
+// Per-block bookkeeping, kept out of the payload
+typedef struct {
+    _Atomic uint32_t next_batch;    // Batch heads on the global stack only
+    uint32_t next_in_batch;         // Chain inside one batch
+} mt_link_t;
+
+typedef struct {
+    MessageBlock *blocks;
+    mt_link_t *links;
+    uint32_t num_blocks;
+
+    _Alignas(64) _Atomic uint64_t stack_head;   // (tag << 32) | (index + 1)
+    _Alignas(64) _Atomic uint32_t next_unused;  // Bump allocation cursor
+} mt_pool_t;
+
+// One per thread (per pool). Not shared.
+typedef struct {
+    uint32_t count;
+    uint32_t slots[MT_POOL_CACHE_CAP];          // Block indices
+} mt_cache_t;
+
+/**
+ * @param blocks      Caller-provided storage for num_blocks blocks
+ * @param links       Caller-provided storage for num_blocks links
+ * @return POOL_OK, or POOL_INVALID on bad arguments
+ */
+pool_status_t mt_pool_init(mt_pool_t *pool, MessageBlock *blocks, mt_link_t *links, uint32_t num_blocks);
+
+static inline void mt_cache_init(mt_cache_t *cache) {
+    cache->count = 0;
+}
+
+/**
+ * @brief Takes one block. Lock-free; usually touches only the cache.
+ * @return The block, or NULL when the pool and the cache are both empty
+ */
+MessageBlock *mt_pool_alloc(mt_pool_t *pool, mt_cache_t *cache);
+
+/**
+ * @brief Returns a block, possibly allocated by another thread. Lock-free.
+ */
+pool_status_t mt_pool_free(mt_pool_t *pool, mt_cache_t *cache, MessageBlock *block);
+
+/**
+ * @brief Gives every cached block back to the global stack. Call before
+ *        a thread exits, or its cached blocks are lost to the others.
+ */
+void mt_cache_flush(mt_pool_t *pool, mt_cache_t *cache);
+
+#endif // MEM_POOLS_MT_H
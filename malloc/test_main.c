@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "mem_pools.h"
+#include "mem_pools_mt.h"
+
+#ifndef MEM_POOL_DEBUG
+#error "the pool tests check the debug checks: build with -DMEM_POOL_DEBUG"
+#endif
+
+// --- Test Harness ---
+
+static int total_failures = 0;
+
+void run_test(int num, const char* desc, bool passed) {
+    if (passed) {
+        printf("[PASS] Test %d: %s\n", num, desc);
+    } else {
+        printf("[FAIL] Test %d: %s\n", num, desc);
+        total_failures++;
+    }
+}
+
+// --- Multi-Threaded Pool Helpers ---
+
+#define MT_THREADS 4
+#define MT_BLOCKS  1000         // Not a multiple of MT_POOL_BATCH
+
+static MessageBlock mt_blocks[MT_BLOCKS];
+static mt_link_t mt_links[MT_BLOCKS];
+static mt_pool_t mt_pool;
+static pthread_barrier_t mt_start;
+
+typedef struct {
+    MessageBlock *got[MT_BLOCKS];
+    uint32_t count;
+    const MessageBlock *const *to_free;  // Another thread's blocks
+    uint32_t free_count;
+    uint32_t free_errors;
+} mt_ctx_t;
+
+static mt_ctx_t mt_ctx[MT_THREADS];
+
+// Allocates until the pool is empty
+static void *mt_drain(void *arg) {
+    mt_ctx_t *ctx = (mt_ctx_t *)arg;
+    mt_cache_t cache;
+    mt_cache_init(&cache);
+    pthread_barrier_wait(&mt_start);
+    MessageBlock *b;
+    // A pool that hands out duplicates would run past MT_BLOCKS
+    while (ctx->count < MT_BLOCKS && (b = mt_pool_alloc(&mt_pool, &cache)) != NULL) {
+        ctx->got[ctx->count++] = b;
+    }
+    return NULL;
+}
+
+// Frees the blocks some other thread allocated
+static void *mt_give_back(void *arg) {
+    mt_ctx_t *ctx = (mt_ctx_t *)arg;
+    mt_cache_t cache;
+    mt_cache_init(&cache);
+    pthread_barrier_wait(&mt_start);
+    for (uint32_t i = 0; i < ctx->free_count; i++) {
+        ctx->free_errors += mt_pool_free(&mt_pool, &cache, (MessageBlock *)ctx->to_free[i]) != POOL_OK;
+    }
+    mt_cache_flush(&mt_pool, &cache);
+    return NULL;
+}
+
+static void run_threads(void *(*fn)(void *)) {
+    pthread_t tid[MT_THREADS];
+    pthread_barrier_init(&mt_start, NULL, MT_THREADS);
+    for (int t = 0; t < MT_THREADS; t++) pthread_create(&tid[t], NULL, fn, &mt_ctx[t]);
+    for (int t = 0; t < MT_THREADS; t++) pthread_join(tid[t], NULL);
+    pthread_barrier_destroy(&mt_start);
+}
+
+// --- Main Test Suite ---
+
+#define TEST_BLOCKS 4
+
+int main() {
+    printf("--- Starting Memory Pool Test Suite ---\n");
+
+    static msg_slot_t storage[TEST_BLOCKS];
+    msg_pool_t pool;
+    MessageBlock *b[TEST_BLOCKS + 1];
+
+    // Test 1: Every block once, then predictable failure
+    msg_pool_init(&pool, storage, TEST_BLOCKS);
+    bool distinct = true;
+    for (int i = 0; i < TEST_BLOCKS; i++) {
+        b[i] = msg_pool_alloc(&pool);
+        distinct &= b[i] == &storage[i].block;
+    }
+    b[TEST_BLOCKS] = msg_pool_alloc(&pool);
+    run_test(1, "Exhausted pool returns NULL",
+             distinct && b[TEST_BLOCKS] == NULL && msg_pool_available(&pool) == 0);
+
+    // Test 2: A freed block is the next one handed out
+    bool freed = msg_pool_free(&pool, b[2]) == POOL_OK && msg_pool_available(&pool) == 1;
+    MessageBlock *again = msg_pool_alloc(&pool);
+    run_test(2, "Pool recovers after a free",
+             freed && again == b[2] && msg_pool_alloc(&pool) == NULL);
+
+    // Test 3: Second free of the same block is refused and not re-linked
+    msg_pool_free(&pool, b[0]);
+    pool_status_t st = msg_pool_free(&pool, b[0]);
+    bool once = msg_pool_alloc(&pool) == b[0] && msg_pool_alloc(&pool) == NULL;
+    run_test(3, "Double free returns POOL_DOUBLE_FREE",
+             st == POOL_DOUBLE_FREE && once);
+
+    // Test 4: An overrun of the payload clobbers the tail canary
+    memset(b[1]->data, 0xAB, MSG_BLOCK_SIZE);
+    storage[1].canary ^= 1;
+    st = msg_pool_free(&pool, b[1]);
+    run_test(4, "Broken canary returns POOL_CORRUPTED (block still freed)",
+             st == POOL_CORRUPTED && msg_pool_available(&pool) == 1 && msg_pool_alloc(&pool) == b[1]);
+
+    // Test 5: Pointers that are not the start of one of our blocks
+    MessageBlock foreign;
+    size_t before = msg_pool_available(&pool);
+    bool invalid = msg_pool_free(&pool, NULL) == POOL_INVALID &&
+                   msg_pool_free(&pool, &foreign) == POOL_INVALID &&
+                   msg_pool_free(&pool, (MessageBlock *)(b[3]->data + 8)) == POOL_INVALID &&
+                   msg_pool_free(&pool, (MessageBlock *)(storage + TEST_BLOCKS)) == POOL_INVALID;
+    run_test(5, "Foreign or misaligned pointer returns POOL_INVALID",
+             invalid && msg_pool_available(&pool) == before);
+
+    // Test 6: The application-wide pool
+    MessageBlock *app[11];
+    int got = 0;
+    while (got < 11 && (app[got] = allocate_block()) != NULL) got++;
+    bool app_ok = got == 10;
+    for (int i = 0; i < got; i++) app_ok &= free_block(app[i]) == POOL_OK;
+    run_test(6, "allocate_block / free_block hand out 10 blocks", app_ok && allocate_block() != NULL);
+
+    // Test 7: Threads racing to empty the pool get every block exactly once
+    mt_pool_init(&mt_pool, mt_blocks, mt_links, MT_BLOCKS);
+    run_threads(mt_drain);
+    static uint8_t seen[MT_BLOCKS];
+    uint32_t total = 0;
+    bool unique = true;
+    for (int t = 0; t < MT_THREADS; t++) {
+        total += mt_ctx[t].count;
+        for (uint32_t i = 0; i < mt_ctx[t].count; i++) {
+            const MessageBlock *blk = mt_ctx[t].got[i];
+            if (blk < mt_blocks || blk >= mt_blocks + MT_BLOCKS) {
+                unique = false;
+                continue;
+            }
+            unique &= seen[blk - mt_blocks]++ == 0;
+        }
+    }
+    bool drained = unique && total == MT_BLOCKS;
+    run_test(7, "MT pool: every block handed out once, all inside the pool", drained);
+
+    // Test 8+: freeing duplicates would corrupt the free stack, so only
+    // after a clean drain
+    if (!drained) {
+        run_test(8, "MT pool: frees from other threads succeed", false);
+        run_test(9, "MT pool: free count back to capacity", false);
+    } else {
+        // Test 8: Each thread frees its neighbour's blocks
+        for (int t = 0; t < MT_THREADS; t++) {
+            const mt_ctx_t *owner = &mt_ctx[(t + 1) % MT_THREADS];
+            mt_ctx[t].to_free = (const MessageBlock *const *)owner->got;
+            mt_ctx[t].free_count = owner->count;
+        }
+        run_threads(mt_give_back);
+        uint32_t free_errors = 0;
+        for (int t = 0; t < MT_THREADS; t++) free_errors += mt_ctx[t].free_errors;
+        run_test(8, "MT pool: frees from other threads succeed", free_errors == 0);
+
+        // Test 9: All of them are free again
+        mt_cache_t cache;
+        mt_cache_init(&cache);
+        memset(seen, 0, sizeof(seen));
+        uint32_t back = 0;
+        bool back_unique = true;
+        MessageBlock *blk;
+        while (back <= MT_BLOCKS && (blk = mt_pool_alloc(&mt_pool, &cache)) != NULL) {
+            back_unique &= seen[blk - mt_blocks]++ == 0;
+            back++;
+        }
+        run_test(9, "MT pool: free count back to capacity", back == MT_BLOCKS && back_unique &&
+                 mt_pool_free(&mt_pool, &cache, &foreign) == POOL_INVALID);
+    }
+
+    printf("\n------------------------------------------\n");
+    if (total_failures == 0) {
+        printf("RESULT: ALL TESTS PASSED ✅\n");
+    } else {
+        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
+    }
+    printf("------------------------------------------\n");
+
+    return (total_failures > 0) ? 1 : 0;
+}
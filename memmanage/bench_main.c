@@ -0,0 +1,175 @@
+/*
+Arena / Slab Benchmarks (ns per allocation, free included)
+- Frame scratch : 256 allocations of 16..512 bytes per frame, all
+                  dropped at the end of the frame.
+                  arena_alloc + arena_reset  vs  malloc + free each
+- Small objects : 1M sizeof(int) objects, allocated then freed
+                  (the create_integer_on_stack pattern)
+                  slab_alloc / slab_free     vs  malloc / free
+- Mixed churn   : 20k live objects of 8..1024 bytes, random replace
+                  slab_alloc / slab_free     vs  malloc / free
+Slab stats (peak, fragmentation) are printed after each slab run.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "mem_arena.h"
+#include "mem_slab.h"
+
+#define FRAMES          20000
+#define FRAME_ALLOCS    256
+#define SMALL_OBJECTS   1000000
+#define CHURN_LIVE      20000
+#define CHURN_STEPS     2000000
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static volatile uintptr_t sink;
+static void *ptrs[SMALL_OBJECTS];
+static size_t sizes[CHURN_LIVE];
+
+// Prints a copy of the slab taken while the workload's objects were live
+static void print_stats(const slab_allocator_t *snapshot) {
+    printf("      slab: peak live %zu KB, reserved %zu KB, internal waste %zu KB, fragmentation %.1f%%\n",
+           snapshot->stats.peak_live_bytes / 1024, snapshot->stats.reserved_bytes / 1024,
+           slab_internal_waste(snapshot) / 1024, 100.0 * slab_fragmentation(snapshot));
+}
+
+static void bench_frames(arena_t *arena) {
+    uint32_t seed = rng_state;
+
+    uint64_t start = now_ns();
+    for (int f = 0; f < FRAMES; f++) {
+        for (int i = 0; i < FRAME_ALLOCS; i++) {
+            uint8_t *p = arena_alloc(arena, 16 + xorshift32() % 497);
+            p[0] = (uint8_t)i;
+            sink += (uintptr_t)p;
+        }
+        arena_reset(arena);
+    }
+    double arena_ns = (double)(now_ns() - start) / ((double)FRAMES * FRAME_ALLOCS);
+
+    rng_state = seed;
+    start = now_ns();
+    for (int f = 0; f < FRAMES; f++) {
+        for (int i = 0; i < FRAME_ALLOCS; i++) {
+            uint8_t *p = malloc(16 + xorshift32() % 497);
+            p[0] = (uint8_t)i;
+            sink += (uintptr_t)p;
+            ptrs[i] = p;
+        }
+        for (int i = 0; i < FRAME_ALLOCS; i++) free(ptrs[i]);
+    }
+    double malloc_ns = (double)(now_ns() - start) / ((double)FRAMES * FRAME_ALLOCS);
+
+    printf("  %-14s %8.1f ns (arena)  %8.1f ns (malloc)   peak %zu KB\n",
+           "Frame scratch", arena_ns, malloc_ns, arena->peak / 1024);
+}
+
+static void bench_small(slab_allocator_t *slab) {
+    uint64_t start = now_ns();
+    for (int i = 0; i < SMALL_OBJECTS; i++) {
+        int *p = slab_alloc(slab, sizeof(int));
+        *p = i;
+        ptrs[i] = p;
+    }
+    slab_allocator_t snapshot = *slab;
+    for (int i = 0; i < SMALL_OBJECTS; i++) slab_free(slab, ptrs[i], sizeof(int));
+    double slab_ns = (double)(now_ns() - start) / SMALL_OBJECTS;
+
+    start = now_ns();
+    for (int i = 0; i < SMALL_OBJECTS; i++) {
+        int *p = malloc(sizeof(int));
+        *p = i;
+        ptrs[i] = p;
+    }
+    for (int i = 0; i < SMALL_OBJECTS; i++) free(ptrs[i]);
+    double malloc_ns = (double)(now_ns() - start) / SMALL_OBJECTS;
+
+    printf("  %-14s %8.1f ns (slab)   %8.1f ns (malloc)\n", "Small objects", slab_ns, malloc_ns);
+    print_stats(&snapshot);
+}
+
+static size_t random_size(void) {
+    // Skewed toward small objects, like typical message/node mixes
+    uint32_t r = xorshift32();
+    return 8 + (r % (1u << (3 + (r >> 28) % 8))) % (SLAB_MAX_SIZE - 7);
+}
+
+static void bench_churn(slab_allocator_t *slab) {
+    uint32_t seed = rng_state;
+
+    uint64_t start = now_ns();
+    for (int i = 0; i < CHURN_LIVE; i++) {
+        sizes[i] = random_size();
+        ptrs[i] = slab_alloc(slab, sizes[i]);
+    }
+    for (int s = 0; s < CHURN_STEPS; s++) {
+        int k = (int)(xorshift32() % CHURN_LIVE);
+        slab_free(slab, ptrs[k], sizes[k]);
+        sizes[k] = random_size();
+        ptrs[k] = slab_alloc(slab, sizes[k]);
+    }
+    double slab_ns = (double)(now_ns() - start) / (CHURN_LIVE + CHURN_STEPS);
+    slab_allocator_t snapshot = *slab;
+    for (int i = 0; i < CHURN_LIVE; i++) slab_free(slab, ptrs[i], sizes[i]);
+
+    rng_state = seed;
+    start = now_ns();
+    for (int i = 0; i < CHURN_LIVE; i++) {
+        sizes[i] = random_size();
+        ptrs[i] = malloc(sizes[i]);
+    }
+    for (int s = 0; s < CHURN_STEPS; s++) {
+        int k = (int)(xorshift32() % CHURN_LIVE);
+        free(ptrs[k]);
+        sizes[k] = random_size();
+        ptrs[k] = malloc(sizes[k]);
+    }
+    double malloc_ns = (double)(now_ns() - start) / (CHURN_LIVE + CHURN_STEPS);
+    for (int i = 0; i < CHURN_LIVE; i++) free(ptrs[i]);
+
+    printf("  %-14s %8.1f ns (slab)   %8.1f ns (malloc)\n", "Mixed churn", slab_ns, malloc_ns);
+    print_stats(&snapshot);
+}
+
+int main() {
+    static uint8_t frame_region[256 * 1024];
+    size_t slab_region_size = 64u * 1024 * 1024;
+    uint8_t *slab_region = malloc(slab_region_size);   // Reserved once up front
+    if (slab_region == NULL) return 1;
+
+    arena_t frame_arena, slab_arena;
+    slab_allocator_t slab;
+
+    printf("--- Arena / Slab vs glibc malloc ---\n");
+
+    arena_init(&frame_arena, frame_region, sizeof(frame_region));
+    bench_frames(&frame_arena);
+
+    arena_init(&slab_arena, slab_region, slab_region_size);
+    slab_init(&slab, &slab_arena);
+    bench_small(&slab);
+
+    arena_init(&slab_arena, slab_region, slab_region_size);
+    slab_init(&slab, &slab_arena);
+    bench_churn(&slab);
+
+    free(slab_region);
+    return 0;
+}
@@ -0,0 +1,29 @@
+#include "mem_arena.h"
+
+void arena_init(arena_t *arena, void *buffer, size_t capacity) {
+    arena->base = (uint8_t *)buffer;
+    arena->capacity = (buffer != NULL) ? capacity : 0;
+    arena->offset = 0;
+    arena->peak = 0;
+    arena->failed = 0;
+}
+
+void *arena_alloc_aligned(arena_t *arena, size_t size, size_t align) {
+    if (align == 0 || (align & (align - 1)) != 0) return NULL;
+
+    // Align the address, not just the offset: the buffer itself may be
+    // less aligned than 'align'
+    uintptr_t cur = (uintptr_t)(arena->base + arena->offset);
+    size_t padding = (size_t)(-cur & (align - 1));
+
+    if (padding > arena->capacity - arena->offset ||
+        size > arena->capacity - arena->offset - padding) {
+        arena->failed++;
+        return NULL;
+    }
+
+    void *ptr = arena->base + arena->offset + padding;
+    arena->offset += padding + size;
+    if (arena->offset > arena->peak) arena->peak = arena->offset;
+    return ptr;
+}
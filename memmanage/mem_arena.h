@@ -0,0 +1,72 @@
+#ifndef MEM_ARENA_H
+#define MEM_ARENA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Bump-Pointer Arena
+ *
+ * One contiguous region and an offset. Allocating moves the offset
+ * forward (O(1), no header, no free list). Nothing is freed one by one:
+ * arena_reset() drops everything at once, arena_rewind() drops everything
+ * allocated after a mark.
+ *
+ * Ideal for per-frame / per-request scratch data: allocate freely while
+ * handling one sensor frame, reset when the frame is done.
+ */
+
+#define ARENA_DEFAULT_ALIGN _Alignof(max_align_t)
+
+typedef struct {
+    uint8_t *base;
+    size_t capacity;
+    size_t offset;          // Bytes in use, including alignment padding
+    size_t peak;            // High-water mark of offset
+    size_t failed;          // Allocations refused for lack of space
+} arena_t;
+
+typedef size_t arena_mark_t;
+
+// Static initializer: arena_t arena = ARENA_INITIALIZER(buffer, capacity);
+#define ARENA_INITIALIZER(buffer, cap) { .base = (uint8_t *)(buffer), .capacity = (cap) }
+
+/**
+ * @param buffer    Caller-provided backing memory (static, stack or heap)
+ */
+void arena_init(arena_t *arena, void *buffer, size_t capacity);
+
+/**
+ * @brief Allocates 'size' bytes aligned to 'align' (a power of two). O(1)
+ * @return The memory, or NULL if the arena is full
+ */
+void *arena_alloc_aligned(arena_t *arena, size_t size, size_t align);
+
+static inline void *arena_alloc(arena_t *arena, size_t size) {
+    return arena_alloc_aligned(arena, size, ARENA_DEFAULT_ALIGN);
+}
+
+// Frees everything in the arena. O(1)
+static inline void arena_reset(arena_t *arena) {
+    arena->offset = 0;
+}
+
+static inline arena_mark_t arena_mark(const arena_t *arena) {
+    return arena->offset;
+}
+
+// Frees everything allocated since 'mark' was taken. O(1)
+static inline void arena_rewind(arena_t *arena, arena_mark_t mark) {
+    if (mark <= arena->offset) arena->offset = mark;
+}
+
+static inline size_t arena_used(const arena_t *arena) {
+    return arena->offset;
+}
+
+static inline size_t arena_remaining(const arena_t *arena) {
+    return arena->capacity - arena->offset;
+}
+
+#endif // MEM_ARENA_H
@@ -0,0 +1,83 @@
+#include <string.h>
+#include "mem_slab.h"
+
+// Smallest class that fits 'size' (size must be 1 .. SLAB_MAX_SIZE)
+static inline unsigned size_class(size_t size) {
+    if (size <= (1u << SLAB_MIN_SHIFT)) return 0;
+    unsigned shift = 64 - (unsigned)__builtin_clzll((unsigned long long)(size - 1));
+    return shift - SLAB_MIN_SHIFT;
+}
+
+static inline size_t class_size(unsigned cls) {
+    return (size_t)1 << (cls + SLAB_MIN_SHIFT);
+}
+
+// The free-list link lives in the first bytes of a freed object
+static inline void *next_free(const void *obj) {
+    void *next;
+    memcpy(&next, obj, sizeof(next));
+    return next;
+}
+
+static inline void set_next_free(void *obj, void *next) {
+    memcpy(obj, &next, sizeof(next));
+}
+
+void slab_init(slab_allocator_t *slab, arena_t *backing) {
+    memset(slab, 0, sizeof(*slab));
+    slab->backing = backing;
+}
+
+void *slab_alloc(slab_allocator_t *slab, size_t size) {
+    if (size == 0 || size > SLAB_MAX_SIZE) {
+        slab->stats.failed_allocs++;
+        return NULL;
+    }
+
+    unsigned cls = size_class(size);
+    size_t csize = class_size(cls);
+    slab_class_t *c = &slab->classes[cls];
+    void *obj = c->free_head;
+
+    if (obj != NULL) {
+        c->free_head = next_free(obj);
+    } else {
+        if (c->bump == NULL || (size_t)(c->bump_end - c->bump) < csize) {
+            // Current page used up: take a fresh one (its tail, if any, is
+            // too small for this class and stays unused)
+            uint8_t *page = arena_alloc_aligned(slab->backing, SLAB_PAGE_SIZE, 64);
+            if (page == NULL) {
+                slab->stats.failed_allocs++;
+                return NULL;
+            }
+            slab->stats.reserved_bytes += SLAB_PAGE_SIZE;
+            c->bump = page;
+            c->bump_end = page + SLAB_PAGE_SIZE;
+        }
+        obj = c->bump;
+        c->bump += csize;
+    }
+
+    slab->stats.live_bytes += size;
+    slab->stats.live_class_bytes += csize;
+    slab->stats.live_objects++;
+    slab->stats.total_allocs++;
+    if (slab->stats.live_bytes > slab->stats.peak_live_bytes) {
+        slab->stats.peak_live_bytes = slab->stats.live_bytes;
+    }
+    return obj;
+}
+
+void slab_free(slab_allocator_t *slab, void *ptr, size_t size) {
+    if (ptr == NULL || size == 0 || size > SLAB_MAX_SIZE) return;
+
+    unsigned cls = size_class(size);
+    slab_class_t *c = &slab->classes[cls];
+
+    set_next_free(ptr, c->free_head);
+    c->free_head = ptr;
+
+    slab->stats.live_bytes -= size;
+    slab->stats.live_class_bytes -= class_size(cls);
+    slab->stats.live_objects--;
+}
@@ -0,0 +1,88 @@
+#ifndef MEM_SLAB_H
+#define MEM_SLAB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "mem_arena.h"
+
+/*
+ * Size-Class Slab Allocator
+ *
+ * For objects that outlive a frame but are small and numerous (the
+ * malloc-per-integer pattern). Requests are rounded up to a power-of-two
+ * size class, 8 .. 1024 bytes. Each class owns:
+ *
+ *   - a free list threaded through its freed objects (intrusive, O(1))
+ *   - a "current page" it bump-allocates from when the free list is empty
+ *
+ * Pages of SLAB_PAGE_SIZE bytes are taken from a backing arena and are
+ * never returned to it, so memory stays reserved for the size class that
+ * first used it. A freed object is only reused by its own class.
+ *
+ * slab_free() takes the size that was allocated (a "sized free"), so
+ * objects carry no header and stats are exact.
+ */
+
+#define SLAB_MIN_SHIFT    3                             // 8 bytes
+#define SLAB_MAX_SHIFT    10                            // 1024 bytes
+#define SLAB_NUM_CLASSES  (SLAB_MAX_SHIFT - SLAB_MIN_SHIFT + 1)
+#define SLAB_MAX_SIZE     (1u << SLAB_MAX_SHIFT)
+#define SLAB_PAGE_SIZE    4096
+
+typedef struct {
+    size_t live_bytes;        // Requested bytes currently allocated
+    size_t live_class_bytes;  // Same objects, rounded up to their classes
+    size_t peak_live_bytes;   // High-water mark of live_bytes
+    size_t reserved_bytes;    // Page bytes taken from the backing arena
+    size_t live_objects;
+    size_t total_allocs;
+    size_t failed_allocs;     // Too big, or the backing arena ran out
+} slab_stats_t;
+
+typedef struct {
+    void *free_head;
+    uint8_t *bump;            // Next unused byte of the current page
+    uint8_t *bump_end;
+} slab_class_t;
+
+typedef struct {
+    arena_t *backing;
+    slab_class_t classes[SLAB_NUM_CLASSES];
+    slab_stats_t stats;
+} slab_allocator_t;
+
+/**
+ * @param backing   Arena that pages are carved from. Must not be reset
+ *                  while any slab object is alive.
+ */
+void slab_init(slab_allocator_t *slab, arena_t *backing);
+
+/**
+ * @brief Allocates 'size' bytes (1 .. SLAB_MAX_SIZE). O(1)
+ * @return The memory (aligned to its size class, at most 64), or NULL
+ */
+void *slab_alloc(slab_allocator_t *slab, size_t size);
+
+/**
+ * @brief Frees an object. 'size' must be the size passed to slab_alloc(). O(1)
+ */
+void slab_free(slab_allocator_t *slab, void *ptr, size_t size);
+
+/**
+ * @brief Internal fragmentation: bytes lost to rounding up to a class.
+ */
+static inline size_t slab_internal_waste(const slab_allocator_t *slab) {
+    return slab->stats.live_class_bytes - slab->stats.live_bytes;
+}
+
+/**
+ * @brief Fraction of reserved page memory not holding live data
+ *        (rounding + free-list slots + unused page tails). 0.0 .. 1.0
+ */
+static inline double slab_fragmentation(const slab_allocator_t *slab) {
+    if (slab->stats.reserved_bytes == 0) return 0.0;
+    return 1.0 - (double)slab->stats.live_bytes / (double)slab->stats.reserved_bytes;
+}
+
+#endif // MEM_SLAB_H
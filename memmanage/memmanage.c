@@ -6,6 +6,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "mem_arena.h"
+#include "mem_slab.h"
 
 // --- Segment Identification Part ---
 
@@ -15,6 +17,13 @@ int global_initialized = 42;          // 2. Where does this live? (Static, .data
 static int static_var = 100;          // 3. Where does this live? (Static, .data)
 const char* text_ptr = "Hello World"; // 4. Where does the STRING LITERAL live? (Static, .rodata)
 
+// Backing memory for Exercises A and B. Objects come from a size-class
+// slab instead of malloc(): O(1), no system heap fragmentation, and
+// running out is a predictable NULL.
+static uint8_t object_region[16 * 1024];
+static arena_t object_arena = ARENA_INITIALIZER(object_region, sizeof(object_region));
+static slab_allocator_t object_slab = { .backing = &object_arena };
+
 // --- Functional Exercises ---
 
 /**
@@ -23,21 +32,50 @@ const char* text_ptr = "Hello World"; // 4. Where does the STRING LITERAL live?
  * TODO: Fix the bug and explain why the original approach fails in the memory model.
  */
 int* create_integer_on_stack(int value) {
-    int* out_value = malloc(sizeof(int));
+    int* out_value = slab_alloc(&object_slab, sizeof(int));
+    if (out_value == NULL) {
+        return NULL;
+    }
     *out_value = value;
     return out_value;
 }
 
+void release_integer(int* value) {
+    slab_free(&object_slab, value, sizeof(int));
+}
+
 /**
  * Exercise B: The Heap
  * TODO: Allocate memory for an array of 'n' integers, initialize them to zero, 
  * and return the pointer. Ensure the candidate handles potential allocation failure.
  */
+// Arrays up to the largest slab class come from the slab; bigger ones
+// from calloc(), which zeroes them and checks n * sizeof(int) for overflow
+#define SLAB_MAX_INTS (SLAB_MAX_SIZE / sizeof(int))
+
 int* create_array_on_heap(int n) {
-    int* array = calloc(n, sizeof(int));
+    if (n <= 0) {
+        return NULL;
+    }
+    if ((size_t)n > SLAB_MAX_INTS) {
+        return calloc((size_t)n, sizeof(int));
+    }
+    int* array = slab_alloc(&object_slab, (size_t)n * sizeof(int));
+    if (array != NULL) {
+        memset(array, 0, (size_t)n * sizeof(int));
+    }
     return array;
 }
 
+// 'n' must be the count passed to create_array_on_heap()
+void release_array(int* array, int n) {
+    if (n > 0 && (size_t)n > SLAB_MAX_INTS) {
+        free(array);
+    } else {
+        slab_free(&object_slab, array, (size_t)n * sizeof(int));
+    }
+}
+
 /**
  * Exercise C: .bss vs .data Persistence
  * Increment a counter that persists across function calls
@@ -65,13 +103,14 @@ int main() {
     // Test 1: Stack Persistence (The candidate must solve Exercise A properly)
     // Note: A correct implementation would likely use heap or static memory.
     int* p_stack = create_integer_on_stack(10);
-    // run_test("Stack address validity", p_stack != NULL); 
+    run_test("Stack address validity", p_stack != NULL && *p_stack == 10);
+    release_integer(p_stack);
 
     // Test 2: Heap Allocation
     int* heap_array = create_array_on_heap(5);
     if (heap_array != NULL) {
         run_test("Heap Allocation", heap_array[0] == 0);
-        free(heap_array); // Memory management check
+        release_array(heap_array, 5); // Memory management check
     } else {
         run_test("Heap Allocation", 0);
     }
@@ -82,7 +121,87 @@ int main() {
     int count = increment_counter();
     run_test("Static Variable Persistence", count == 3);
 
-    // Test 4: Segment Knowledge Question (Interview Check)
+    // Test 4: Allocator bookkeeping after cleanup
+    run_test("Slab has no live objects after release",
+             object_slab.stats.live_objects == 0 && object_slab.stats.live_bytes == 0);
+
+    // Test 5: Arrays past the largest slab class still work (calloc fallback)
+    int* big_array = create_array_on_heap(100000);
+    run_test("Large array is allocated and zeroed",
+             big_array != NULL && big_array[0] == 0 && big_array[99999] == 0 &&
+             object_slab.stats.live_objects == 0);
+    release_array(big_array, 100000);
+    run_test("Non-positive array size is refused", create_array_on_heap(0) == NULL);
+
+    // Test 6: Arena alignment, from a deliberately odd base address
+    static _Alignas(64) uint8_t scratch[1024];
+    arena_t arena;
+    arena_init(&arena, scratch + 1, sizeof(scratch) - 1);
+    int aligned = 1;
+    for (size_t align = 1; align <= 64; align <<= 1) {
+        arena_alloc_aligned(&arena, 1, 1);  // Knock the offset off again
+        void* p = arena_alloc_aligned(&arena, 3, align);
+        aligned &= p != NULL && (uintptr_t)p % align == 0;
+    }
+    void* dflt = arena_alloc(&arena, 1);
+    aligned &= dflt != NULL && (uintptr_t)dflt % ARENA_DEFAULT_ALIGN == 0;
+    run_test("Arena honours every requested alignment",
+             aligned && arena_alloc_aligned(&arena, 1, 24) == NULL);
+
+    // Test 7: Rewind and reset hand back the same addresses
+    arena_mark_t mark = arena_mark(&arena);
+    void* after_mark = arena_alloc_aligned(&arena, 40, 8);
+    arena_alloc_aligned(&arena, 40, 8);
+    arena_rewind(&arena, mark);
+    int same = arena_alloc_aligned(&arena, 40, 8) == after_mark;
+    arena_reset(&arena);
+    same &= arena_alloc_aligned(&arena, 1, 1) == scratch + 1 && arena_used(&arena) == 1;
+    run_test("Arena rewind / reset reuse the same addresses", same);
+
+    // Test 8: A class's free list hands back the last freed slot first
+    static _Alignas(64) uint8_t slab_region[4 * SLAB_PAGE_SIZE];
+    arena_t slab_arena;
+    slab_allocator_t slab;
+    arena_init(&slab_arena, slab_region, sizeof(slab_region));
+    slab_init(&slab, &slab_arena);
+    void* a = slab_alloc(&slab, 16);
+    void* b = slab_alloc(&slab, 16);
+    void* c = slab_alloc(&slab, 16);
+    slab_free(&slab, a, 16);
+    slab_free(&slab, c, 16);
+    void* first = slab_alloc(&slab, 16);
+    void* second = slab_alloc(&slab, 16);
+    void* fresh = slab_alloc(&slab, 16);
+    run_test("Slab free list is LIFO",
+             first == c && second == a && fresh == (uint8_t*)c + 16 && b == (uint8_t*)a + 16);
+    slab_free(&slab, first, 16);
+    slab_free(&slab, second, 16);
+    slab_free(&slab, fresh, 16);
+    slab_free(&slab, b, 16);
+
+    // Test 9: Exact stats after a known sequence (on top of Test 8's page)
+    void* p5 = slab_alloc(&slab, 5);        // Class 8
+    void* p24 = slab_alloc(&slab, 24);      // Class 32
+    void* p100 = slab_alloc(&slab, 100);    // Class 128
+    slab_alloc(&slab, 3);                   // Class 8, same page as p5
+    slab_alloc(&slab, 0);
+    slab_alloc(&slab, SLAB_MAX_SIZE + 1);
+    int stats_ok = p5 != NULL && p24 != NULL && p100 != NULL &&
+                   slab.stats.live_bytes == 132 && slab.stats.live_class_bytes == 176 &&
+                   slab_internal_waste(&slab) == 44 && slab.stats.peak_live_bytes == 132 &&
+                   slab.stats.reserved_bytes == 4 * SLAB_PAGE_SIZE &&
+                   slab.stats.total_allocs == 10 && slab.stats.failed_allocs == 2 &&
+                   slab_arena.peak == 4 * SLAB_PAGE_SIZE;
+    slab_free(&slab, p100, 100);
+    stats_ok &= slab.stats.live_bytes == 32 && slab.stats.peak_live_bytes == 132 &&
+                slab.stats.live_objects == 3 &&
+                slab_fragmentation(&slab) == 1.0 - 32.0 / (4 * SLAB_PAGE_SIZE);
+    // Class 64 has no page yet and the backing arena is full
+    stats_ok &= slab_alloc(&slab, 64) == NULL && slab_alloc(&slab, 100) == p100 &&
+                slab.stats.failed_allocs == 3 && slab_arena.failed == 1;
+    run_test("Slab peak / waste / fragmentation stats are exact", stats_ok);
+
+    // Test 10: Segment Knowledge Question (Interview Check)
     printf("\n--- Oral/Written Follow-up ---\n");
     printf("1. If I change 'text_ptr[0] = 'h'', why does the program crash?\n");
     printf("2. What is the difference between malloc() and calloc() regarding the .bss segment logic?\n");
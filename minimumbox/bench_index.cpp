@@ -0,0 +1,142 @@
+/*
+Rotated Boundary Index Benchmark
+- 10^6 static rectangles (random coordinates as in bench_main.cpp) and a
+  boundary that moves every frame: the data's MBB, pulled in on each side
+  by a margin that sweeps 0 .. 5% of its size, so the number of
+  violations k goes from ~0.3% to ~20% of the rects.
+- Reported per frame in microseconds (mean and worst) for:
+    rescan   count_out_of_bounds over the Rect[]
+    index    rect_index_count_out_of_bounds
+    churn    100 removes + 100 inserts, then the index query
+  plus what building the index costs once.
+Every index result is checked against the rescan.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+#include "rotated_boundary.h"
+#include "rect_index.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static volatile int sink;
+
+static float coord(float range) {
+    return (float)(xorshift32() % 1000000) / 1000000.0f * range;
+}
+
+static Rect random_rect(void) {
+    float x = coord(1000.0f), y = coord(1000.0f);
+    return { x, y, x + coord(20.0f), y + coord(20.0f) };
+}
+
+// Frame 'f' of the sweep: the MBB pulled in by 0 .. 5% on every side
+static Rect frame_box(Rect mbb, int f) {
+    float t = (float)(f % 200) / 200.0f;
+    float margin = (t < 0.5f ? t : 1.0f - t) * 0.1f;
+    float dx = (mbb.x2 - mbb.x1) * margin, dy = (mbb.y2 - mbb.y1) * margin;
+    return { mbb.x1 + dx, mbb.y1 + dy, mbb.x2 - dx, mbb.y2 - dy };
+}
+
+static void report(const char* label, uint64_t total_ns, uint64_t worst_ns, int frames, const char* note) {
+    printf("    %-8s mean %9.1f us  worst %9.1f us%s\n", label, total_ns / 1e3 / frames, worst_ns / 1e3, note);
+}
+
+int main() {
+    const size_t count = 1000000;
+    const int frames = 1000;
+    std::vector<Rect> rects(count);
+    for (Rect& r : rects) r = random_rect();
+    Rect mbb = find_global_mbb(rects.data(), count);
+
+    uint64_t start = now_ns();
+    RectIndex* index = rect_index_create(rects.data(), count);
+    double build_ms = (now_ns() - start) / 1e6;
+    if (index == NULL) {
+        printf("Not enough memory for %zu rectangles\n", count);
+        return 1;
+    }
+
+    printf("--- Rotated boundary: rescan vs index, %zu rects, %d frames ---\n", count, frames);
+    printf("  index build %.1f ms\n", build_ms);
+
+    uint64_t scan_total = 0, scan_worst = 0, index_total = 0, index_worst = 0;
+    long long k_total = 0;
+    bool same = true;
+    for (int f = 0; f < frames; f++) {
+        Rect box = frame_box(mbb, f);
+        start = now_ns();
+        int expected = count_out_of_bounds(box, rects.data(), count);
+        uint64_t t = now_ns() - start;
+        scan_total += t;
+        if (t > scan_worst) scan_worst = t;
+
+        start = now_ns();
+        int violations = rect_index_count_out_of_bounds(index, box);
+        t = now_ns() - start;
+        index_total += t;
+        if (t > index_worst) index_worst = t;
+
+        same &= violations == expected;
+        k_total += expected;
+        sink = violations;
+    }
+    printf("  static rects, mean k = %lld\n", k_total / frames);
+    report("rescan", scan_total, scan_worst, frames, "");
+    report("index", index_total, index_worst, frames, same ? "" : "  MISMATCH");
+
+    // Rects by id, to check the churned index against a rescan
+    std::vector<bool> live(count, true);
+    uint64_t churn_total = 0, churn_worst = 0;
+    same = true;
+    for (int f = 0; f < frames; f++) {
+        Rect box = frame_box(mbb, f);
+        start = now_ns();
+        for (int i = 0; i < 100; i++) {
+            uint32_t victim = xorshift32() % (uint32_t)rects.size();
+            if (!rect_index_remove(index, victim)) continue;
+            live[victim] = false;
+            Rect r = random_rect();
+            uint32_t id = rect_index_insert(index, r);
+            if (id >= rects.size()) {
+                rects.resize(id + 1);
+                live.resize(id + 1, false);
+            }
+            rects[id] = r;
+            live[id] = true;
+        }
+        int violations = rect_index_count_out_of_bounds(index, box);
+        uint64_t t = now_ns() - start;
+        churn_total += t;
+        if (t > churn_worst) churn_worst = t;
+
+        if (f % 100 == 99) {
+            std::vector<Rect> current;
+            for (size_t id = 0; id < rects.size(); id++) {
+                if (live[id]) current.push_back(rects[id]);
+            }
+            same &= violations == count_out_of_bounds(box, current.data(), current.size());
+        }
+        sink = violations;
+    }
+    report("churn", churn_total, churn_worst, frames, same ? "" : "  MISMATCH");
+
+    rect_index_destroy(index);
+    return 0;
+}
@@ -0,0 +1,110 @@
+/*
+Rotated Boundary Benchmark
+- Rect[] (the original branchy loops) vs RectSoA on every backend,
+  10^3 .. 10^8 rectangles, random coordinates (roughly 1 in 3 rotated
+  rectangles sticks out).
+- Reported per pass in millions of rectangles per second:
+    mbb    find_global_mbb / find_global_mbb_soa
+    count  count_out_of_bounds / count_out_of_bounds_soa
+  plus one frame (both passes) in milliseconds, and what converting the
+  Rect[] into the SoA store costs once.
+Every SoA result is checked against the Rect[] result.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include "rotated_boundary.h"
+#include "rect_soa.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static volatile int sink;
+
+static float coord(float range) {
+    return (float)(xorshift32() % 1000000) / 1000000.0f * range;
+}
+
+static void bench_size(Rect* rects, RectSoA* soa, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        float x = coord(1000.0f), y = coord(1000.0f);
+        rects[i] = { x, y, x + coord(20.0f), y + coord(20.0f) };
+    }
+    // About 3 * 10^8 rectangles per measurement, at least one pass
+    int reps = (int)(300000000 / count);
+    if (reps < 1) reps = 1;
+
+    uint64_t start = now_ns();
+    rect_soa_assign(soa, rects, count);
+    double convert_ms = (now_ns() - start) / 1e6;
+
+    start = now_ns();
+    Rect mbb = {0, 0, 0, 0};
+    for (int r = 0; r < reps; r++) mbb = find_global_mbb(rects, count);
+    uint64_t mbb_ns = now_ns() - start;
+    start = now_ns();
+    int expected = 0;
+    for (int r = 0; r < reps; r++) expected = count_out_of_bounds(mbb, rects, count);
+    uint64_t count_ns = now_ns() - start;
+
+    printf("  %9zu rects (%d reps)  Rect[] -> SoA %.2f ms, %d out of bounds\n",
+           count, reps, convert_ms, expected);
+    printf("    %-8s mbb %8.0f M/s  count %8.0f M/s  frame %9.3f ms\n", "Rect[]",
+           count * (double)reps / (mbb_ns / 1e3), count * (double)reps / (count_ns / 1e3),
+           (mbb_ns + count_ns) / 1e6 / reps);
+
+    for (int b = 0; b < RECT_BACKEND_COUNT; b++) {
+        if (!rect_select((rect_backend_t)b)) continue;
+        Rect soa_mbb = {0, 0, 0, 0};
+        int violations = 0;
+
+        start = now_ns();
+        for (int r = 0; r < reps; r++) soa_mbb = find_global_mbb_soa(soa);
+        mbb_ns = now_ns() - start;
+        start = now_ns();
+        for (int r = 0; r < reps; r++) violations = count_out_of_bounds_soa(soa_mbb, soa);
+        count_ns = now_ns() - start;
+
+        bool same = memcmp(&soa_mbb, &mbb, sizeof(Rect)) == 0 && violations == expected;
+        printf("    %-8s mbb %8.0f M/s  count %8.0f M/s  frame %9.3f ms%s\n",
+               rect_name((rect_backend_t)b),
+               count * (double)reps / (mbb_ns / 1e3), count * (double)reps / (count_ns / 1e3),
+               (mbb_ns + count_ns) / 1e6 / reps, same ? "" : "  MISMATCH");
+        sink = violations;
+    }
+    rect_select(rect_best());
+}
+
+int main() {
+    const size_t max_count = 100000000;
+    Rect* rects = (Rect*)malloc(max_count * sizeof(Rect));
+    RectSoA soa;
+    if (rects == NULL || !rect_soa_init(&soa, max_count)) {
+        printf("Not enough memory for %zu rectangles\n", max_count);
+        return 1;
+    }
+
+    printf("--- Rotated boundary: Rect[] vs SoA (default: %s) ---\n", rect_name(rect_best()));
+    for (size_t count = 1000; count <= max_count; count *= 10) {
+        bench_size(rects, &soa, count);
+    }
+
+    rect_soa_free(&soa);
+    free(rects);
+    return 0;
+}
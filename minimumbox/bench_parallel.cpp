@@ -0,0 +1,114 @@
+/*
+Rotated Boundary Strong-Scaling Benchmark
+- The same Rect[] at 10^6, 10^7 and 10^8 rectangles (random coordinates as
+  in bench_main.cpp), on pools of 1, 2, 4 .. threads up to the core count
+  (at least 4; rows past the core count are marked oversubscribed).
+- Reported per plan as one frame (MBB + violation count) in milliseconds
+  and speedup over the 1-thread pool:
+    original   find_global_mbb + count_out_of_bounds
+    two-pass   find_global_mbb_parallel + count_out_of_bounds_parallel
+    streamed   rotated_boundary_streamed
+Every parallel result is checked against the original.
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include "rotated_boundary.h"
+#include "rect_parallel.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static volatile int sink;
+
+static float coord(float range) {
+    return (float)(xorshift32() % 1000000) / 1000000.0f * range;
+}
+
+static void bench_size(const Rect* rects, size_t count, int max_threads, int cores) {
+    // About 3 * 10^8 rectangles per measurement, at least one frame
+    int reps = (int)(300000000 / count);
+    if (reps < 1) reps = 1;
+
+    uint64_t start = now_ns();
+    Rect mbb = {0, 0, 0, 0};
+    int expected = 0;
+    for (int r = 0; r < reps; r++) {
+        mbb = find_global_mbb(rects, count);
+        expected = count_out_of_bounds(mbb, rects, count);
+    }
+    double original_ms = (now_ns() - start) / 1e6 / reps;
+    printf("  %9zu rects (%d reps)  original %9.3f ms, %d out of bounds\n",
+           count, reps, original_ms, expected);
+
+    double two_pass_base = 0, streamed_base = 0;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        RectPool* pool = rect_pool_create(threads);
+        if (pool == NULL) break;
+        Rect par_mbb = {0, 0, 0, 0}, str_mbb = {0, 0, 0, 0};
+        int par = 0, str = 0;
+
+        start = now_ns();
+        for (int r = 0; r < reps; r++) {
+            par_mbb = find_global_mbb_parallel(pool, rects, count);
+            par = count_out_of_bounds_parallel(pool, par_mbb, rects, count);
+        }
+        double two_pass_ms = (now_ns() - start) / 1e6 / reps;
+        start = now_ns();
+        for (int r = 0; r < reps; r++) str = rotated_boundary_streamed(pool, rects, count, &str_mbb);
+        double streamed_ms = (now_ns() - start) / 1e6 / reps;
+        rect_pool_destroy(pool);
+
+        if (threads == 1) {
+            two_pass_base = two_pass_ms;
+            streamed_base = streamed_ms;
+        }
+        bool same = memcmp(&par_mbb, &mbb, sizeof(Rect)) == 0 && memcmp(&str_mbb, &mbb, sizeof(Rect)) == 0 &&
+                    par == expected && str == expected;
+        printf("    %3d threads  two-pass %9.3f ms (%5.2fx)  streamed %9.3f ms (%5.2fx)%s%s\n",
+               threads, two_pass_ms, two_pass_base / two_pass_ms, streamed_ms, streamed_base / streamed_ms,
+               threads > cores ? "  oversubscribed" : "", same ? "" : "  MISMATCH");
+        sink = par + str;
+    }
+}
+
+int main() {
+    const size_t max_count = 100000000;
+    Rect* rects = (Rect*)malloc(max_count * sizeof(Rect));
+    if (rects == NULL) {
+        printf("Not enough memory for %zu rectangles\n", max_count);
+        return 1;
+    }
+    for (size_t i = 0; i < max_count; i++) {
+        float x = coord(1000.0f), y = coord(1000.0f);
+        rects[i] = { x, y, x + coord(20.0f), y + coord(20.0f) };
+    }
+
+    int cores = (int)std::thread::hardware_concurrency();
+    if (cores <= 0) cores = 1;
+    int max_threads = cores < 4 ? 4 : cores;
+
+    printf("--- Rotated boundary: strong scaling (%d cores) ---\n", cores);
+    for (size_t count = 1000000; count <= max_count; count *= 10) {
+        bench_size(rects, count, max_threads, cores);
+    }
+
+    free(rects);
+    return 0;
+}
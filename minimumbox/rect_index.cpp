@@ -0,0 +1,295 @@
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <vector>
+#include "rect_index.h"
+
+// One list per extent; lo lists count a prefix, hi lists a suffix
+enum { LO_X, HI_X, LO_Y, HI_Y, AXES };
+
+// Keys per block when built. Blocks split above 2 * BLOCK and join a
+// neighbour when a remove leaves them under BLOCK / 2.
+static const size_t BLOCK = 512;
+
+typedef struct {
+    float v[AXES];
+} Extent;
+
+// A list entry carries the whole extent, so a query never looks it up by id
+typedef struct {
+    Extent e;
+    uint32_t id;
+} Key;
+
+// A sorted list split into sorted blocks, so an update moves at most one
+// block's worth of keys
+typedef std::vector<std::vector<Key>> List;
+
+struct RectIndex {
+    std::vector<Extent> extents;        // By id
+    std::vector<uint8_t> live;          // By id
+    std::vector<uint32_t> free_ids;     // Dead, in no list
+    List lists[AXES];                   // Sorted by (e.v[axis], id)
+    size_t size;
+};
+
+// Same expressions as count_out_of_bounds(), so the same roundings
+static Extent extent(const Rect& r) {
+    float cx = (r.x1 + r.x2) / 2.0f;
+    float cy = (r.y1 + r.y2) / 2.0f;
+    float half_w = (r.y2 - r.y1) / 2.0f;
+    float half_h = (r.x2 - r.x1) / 2.0f;
+    return {{cx - half_w, cx + half_w, cy - half_h, cy + half_h}};
+}
+
+static inline bool beyond(const Extent& e, const float* bound, int axis) {
+    return (axis & 1) ? e.v[axis] > bound[axis] : e.v[axis] < bound[axis];
+}
+
+// True if 'e' meets any of the first 'axes' conditions
+static inline bool beyond_any(const Extent& e, const float* bound, int axes) {
+    for (int a = 0; a < axes; a++) {
+        if (beyond(e, bound, a)) return true;
+    }
+    return false;
+}
+
+// The id breaks ties, so every key has one exact place to be removed from
+static inline bool key_less(const Key& a, const Key& b, int axis) {
+    return a.e.v[axis] < b.e.v[axis] || (a.e.v[axis] == b.e.v[axis] && a.id < b.id);
+}
+
+template <int A>
+static void sort_keys(std::vector<Key>& keys) {
+    std::sort(keys.begin(), keys.end(), [](const Key& a, const Key& b) { return key_less(a, b, A); });
+}
+
+// Sorts 'keys' by extent 'axis' and cuts them into blocks of BLOCK
+static void build_list(List& list, std::vector<Key>& keys, int axis) {
+    switch (axis) {
+        case LO_X: sort_keys<LO_X>(keys); break;
+        case HI_X: sort_keys<HI_X>(keys); break;
+        case LO_Y: sort_keys<LO_Y>(keys); break;
+        default:   sort_keys<HI_Y>(keys); break;
+    }
+    list.reserve((keys.size() + BLOCK - 1) / BLOCK);
+    for (size_t i = 0; i < keys.size(); i += BLOCK) {
+        list.emplace_back(keys.begin() + i, keys.begin() + std::min(keys.size(), i + BLOCK));
+    }
+}
+
+// Block that holds (or would hold) 'k': the first whose last key is not
+// below it, else the last block
+static size_t find_block(const List& list, const Key& k, int axis) {
+    size_t b = std::partition_point(list.begin(), list.end(),
+                                    [&](const std::vector<Key>& blk) { return key_less(blk.back(), k, axis); }) -
+               list.begin();
+    return (b == list.size()) ? b - 1 : b;
+}
+
+// Halves block 'b' once it is over 2 * BLOCK. Only costs speed if the
+// allocation fails, so that is ignored.
+static void split_block(List& list, size_t b) {
+    if (list[b].size() <= 2 * BLOCK) return;
+    try {
+        std::vector<Key>& blk = list[b];
+        size_t half = blk.size() / 2;
+        std::vector<Key> upper(blk.begin() + half, blk.end());
+        list.insert(list.begin() + b + 1, std::move(upper));
+        list[b].resize(half);
+    } catch (const std::bad_alloc&) {
+    }
+}
+
+static void list_insert(List& list, const Key& k, int axis) {
+    if (list.empty()) {
+        list.emplace_back(1, k);
+        return;
+    }
+    size_t b = find_block(list, k, axis);
+    std::vector<Key>& blk = list[b];
+    blk.insert(std::lower_bound(blk.begin(), blk.end(), k,
+                                [&](const Key& x, const Key& y) { return key_less(x, y, axis); }),
+               k);
+    split_block(list, b);
+}
+
+// Never throws. With 'rebalance', a block under BLOCK / 2 joins a neighbour.
+static void list_erase(List& list, const Key& k, int axis, bool rebalance) {
+    size_t b = find_block(list, k, axis);
+    std::vector<Key>& blk = list[b];
+    std::vector<Key>::iterator it = std::lower_bound(blk.begin(), blk.end(), k,
+                                                     [&](const Key& x, const Key& y) { return key_less(x, y, axis); });
+    if (it == blk.end() || it->id != k.id) return;
+    blk.erase(it);
+
+    if (blk.empty()) {
+        list.erase(list.begin() + b);
+    } else if (rebalance && blk.size() < BLOCK / 2 && list.size() > 1) {
+        size_t left = (b + 1 < list.size()) ? b : b - 1;
+        try {
+            list[left].insert(list[left].end(), list[left + 1].begin(), list[left + 1].end());
+            list.erase(list.begin() + left + 1);
+            split_block(list, left);
+        } catch (const std::bad_alloc&) {
+        }
+    }
+}
+
+/*
+ * Calls f(id) once per live rect beyond 'box'. List 'a' holds the ids
+ * whose condition 'a' holds in one contiguous range; an id is reported
+ * by the first list whose condition it meets, so it is skipped when an
+ * earlier condition also holds. NaN keys are never in a list, and with a
+ * NaN bound both ranges come out empty, like the comparisons themselves.
+ * With 'first_count' set, the first list is only counted.
+ */
+template <typename F>
+static void visit(const RectIndex* index, Rect box, int* first_count, F&& f) {
+    const float bound[AXES] = {box.x1, box.x2, box.y1, box.y2};
+    for (int a = 0; a < AXES; a++) {
+        const List& list = index->lists[a];
+        auto outside = [&](const Key& k) { return beyond(k.e, bound, a); };
+        auto report = [&](std::vector<Key>::const_iterator it, std::vector<Key>::const_iterator end) {
+            if (a == 0 && first_count != nullptr) {
+                *first_count += (int)(end - it);
+                return;
+            }
+            for (; it != end; ++it) {
+                if (!beyond_any(it->e, bound, a)) f(it->id);
+            }
+        };
+
+        if (a & 1) {
+            // Suffix: from the first block that ends outside
+            size_t b = std::partition_point(list.begin(), list.end(),
+                                            [&](const std::vector<Key>& blk) { return !outside(blk.back()); }) -
+                       list.begin();
+            for (size_t i = b; i < list.size(); i++) {
+                const std::vector<Key>& blk = list[i];
+                report(i == b ? std::partition_point(blk.begin(), blk.end(), [&](const Key& k) { return !outside(k); })
+                              : blk.begin(),
+                       blk.end());
+            }
+        } else {
+            // Prefix: up to the first block that ends inside
+            for (const std::vector<Key>& blk : list) {
+                bool whole = outside(blk.back());
+                report(blk.begin(), whole ? blk.end() : std::partition_point(blk.begin(), blk.end(), outside));
+                if (!whole) break;
+            }
+        }
+    }
+}
+
+RectIndex* rect_index_create(const Rect* rects, size_t count) {
+    if (count >= RECT_INDEX_NONE) {
+        return nullptr;
+    }
+    RectIndex* index = new (std::nothrow) RectIndex();
+    if (index == nullptr) {
+        return nullptr;
+    }
+    index->size = count;
+    try {
+        index->extents.resize(count);
+        index->live.assign(count, 1);
+        for (size_t i = 0; i < count; i++) index->extents[i] = extent(rects[i]);
+        std::vector<Key> keys;
+        keys.reserve(count);
+        for (int a = 0; a < AXES; a++) {
+            keys.clear();
+            for (size_t i = 0; i < count; i++) {
+                const Extent& e = index->extents[i];
+                if (!std::isnan(e.v[a])) keys.push_back({e, (uint32_t)i});
+            }
+            build_list(index->lists[a], keys, a);
+        }
+    } catch (const std::bad_alloc&) {
+        delete index;
+        return nullptr;
+    }
+    return index;
+}
+
+void rect_index_destroy(RectIndex* index) {
+    delete index;
+}
+
+size_t rect_index_size(const RectIndex* index) {
+    return index->size;
+}
+
+// Room for one more push_back (growing geometrically), so it cannot throw
+template <typename T>
+static void reserve_one(std::vector<T>& v) {
+    if (v.size() == v.capacity()) v.reserve(v.size() * 2 + 16);
+}
+
+uint32_t rect_index_insert(RectIndex* index, Rect r) {
+    uint32_t id;
+    try {
+        reserve_one(index->free_ids);   // To hand the id back on failure
+        if (!index->free_ids.empty()) {
+            id = index->free_ids.back();
+            index->free_ids.pop_back();
+        } else {
+            if (index->extents.size() >= RECT_INDEX_NONE) return RECT_INDEX_NONE;
+            reserve_one(index->live);
+            id = (uint32_t)index->extents.size();
+            index->extents.push_back(extent(r));
+            index->live.push_back(0);
+        }
+    } catch (const std::bad_alloc&) {
+        return RECT_INDEX_NONE;
+    }
+
+    const Key key = {extent(r), id};
+    int a = 0;
+    try {
+        for (; a < AXES; a++) {
+            if (!std::isnan(key.e.v[a])) list_insert(index->lists[a], key, a);
+        }
+    } catch (const std::bad_alloc&) {
+        // Take it back out of the lists it made it into
+        while (a-- > 0) {
+            if (!std::isnan(key.e.v[a])) list_erase(index->lists[a], key, a, false);
+        }
+        index->free_ids.push_back(id);
+        return RECT_INDEX_NONE;
+    }
+    index->extents[id] = key.e;
+    index->live[id] = 1;
+    index->size++;
+    return id;
+}
+
+bool rect_index_remove(RectIndex* index, uint32_t id) {
+    if (id >= index->extents.size() || !index->live[id]) {
+        return false;
+    }
+    const Key key = {index->extents[id], id};
+    for (int a = 0; a < AXES; a++) {
+        if (!std::isnan(key.e.v[a])) list_erase(index->lists[a], key, a, true);
+    }
+    index->live[id] = 0;
+    index->size--;
+    try {
+        index->free_ids.push_back(id);
+    } catch (const std::bad_alloc&) {
+        // The id is just not reused
+    }
+    return true;
+}
+
+int rect_index_count_out_of_bounds(const RectIndex* index, Rect global_mbb) {
+    int violations = 0;
+    int first_count = 0;
+    visit(index, global_mbb, &first_count, [&](uint32_t) { violations++; });
+    return violations + first_count;
+}
+
+void rect_index_for_each_out_of_bounds(const RectIndex* index, Rect global_mbb,
+                                       void (*fn)(uint32_t id, void* ctx), void* ctx) {
+    visit(index, global_mbb, nullptr, [&](uint32_t id) { fn(id, ctx); });
+}
@@ -0,0 +1,68 @@
+#ifndef RECT_INDEX_H
+#define RECT_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include "rotated_boundary.h"
+
+/*
+ * Static Rectangles, Moving Boundary
+ *
+ * Prebuilt index over the rotated extents (lo_x, hi_x, lo_y, hi_y) of each
+ * rectangle, for answering count_out_of_bounds() against a new boundary
+ * every frame without rescanning everything.
+ *
+ * A rectangle sticks out when lo_x < box.x1 OR hi_x > box.x2 OR
+ * lo_y < box.y1 OR hi_y > box.y2. With one sorted list per extent, each
+ * condition holds for a prefix (or suffix) found by binary search, so a
+ * query walks only those ranges: a rect already counted by an earlier
+ * list is skipped by re-testing the earlier conditions on its extents.
+ * Cost: O(log n + k), k = rects that match at least one condition
+ * (each visited at most 4 times), instead of O(n). List entries carry
+ * all four extents, so that re-test never chases an id (4 x 20 bytes
+ * per rect).
+ *
+ * Each list is kept as a run of sorted blocks of at most 1024 entries,
+ * so inserts and removes go straight to their place: O(log n) to find
+ * the block plus one block's memmove per list, with no buffer for
+ * queries to scan and no periodic rebuild.
+ *
+ * Results equal count_out_of_bounds() over the live rects exactly: the
+ * extents are computed with the same expressions, and a NaN extent is
+ * kept out of its list since it never compares outside.
+ */
+
+typedef struct RectIndex RectIndex;
+
+/**
+ * @brief Builds the index over rects[0 .. count); they get ids 0 .. count - 1.
+ * @return NULL if out of memory
+ */
+RectIndex* rect_index_create(const Rect* rects, size_t count);
+void rect_index_destroy(RectIndex* index);
+
+// Live rectangles in the index
+size_t rect_index_size(const RectIndex* index);
+
+/**
+ * @brief Adds one rectangle. Ids of removed rects may be reused.
+ * @return Its id, or RECT_INDEX_NONE if out of memory
+ */
+uint32_t rect_index_insert(RectIndex* index, Rect r);
+
+// Returns false if 'id' is not a live rectangle
+bool rect_index_remove(RectIndex* index, uint32_t id);
+
+#define RECT_INDEX_NONE UINT32_MAX
+
+// count_out_of_bounds(global_mbb, <live rects>)
+int rect_index_count_out_of_bounds(const RectIndex* index, Rect global_mbb);
+
+/**
+ * @brief Calls fn(id, ctx) once for every live rectangle that sticks out
+ *        of 'global_mbb' after rotation (in no particular order).
+ */
+void rect_index_for_each_out_of_bounds(const RectIndex* index, Rect global_mbb,
+                                       void (*fn)(uint32_t id, void* ctx), void* ctx);
+
+#endif // RECT_INDEX_H
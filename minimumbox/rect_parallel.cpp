@@ -0,0 +1,314 @@
+#include <limits>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "rect_parallel.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define RECT_HAVE_SSE 1
+#endif
+
+static const float FMAX = std::numeric_limits<float>::max();
+
+// Rotated extents of one rectangle, as count_out_of_bounds() computes them
+typedef struct {
+    float lo_x, hi_x, lo_y, hi_y;
+} Extent;
+
+// Per-thread results, one cache line apart
+struct alignas(64) ThreadState {
+    Rect mbb;
+    int violations;
+    std::vector<Extent> candidates;     // Streamed plan: may stick out
+    std::vector<size_t> recount;        // Streamed plan: chunks to scan again
+};
+
+struct RectPool {
+    int threads;
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable wake;       // New job, or stop
+    std::condition_variable done;       // Last worker finished the job
+    const std::function<void(int)>* job;
+    uint64_t generation;
+    int running;                        // Workers still on the current job
+    bool stop;
+    std::vector<ThreadState> state;
+};
+
+// --- Pool ---
+
+static void worker_main(RectPool* pool, int id) {
+    uint64_t seen = 0;
+    for (;;) {
+        const std::function<void(int)>* job;
+        {
+            std::unique_lock<std::mutex> g(pool->lock);
+            pool->wake.wait(g, [&] { return pool->stop || pool->generation != seen; });
+            if (pool->stop) return;
+            seen = pool->generation;
+            job = pool->job;
+        }
+        (*job)(id);
+        std::lock_guard<std::mutex> g(pool->lock);
+        if (--pool->running == 0) pool->done.notify_one();
+    }
+}
+
+// Runs job(0) .. job(threads - 1) in parallel, job(0) on the calling thread
+static void run(RectPool* pool, const std::function<void(int)>& job) {
+    if (pool->threads == 1) {
+        job(0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> g(pool->lock);
+        pool->job = &job;
+        pool->running = pool->threads - 1;
+        pool->generation++;
+    }
+    pool->wake.notify_all();
+    job(0);
+    std::unique_lock<std::mutex> g(pool->lock);
+    pool->done.wait(g, [&] { return pool->running == 0; });
+}
+
+RectPool* rect_pool_create(int threads) {
+    if (threads <= 0) {
+        threads = (int)std::thread::hardware_concurrency();
+        if (threads <= 0) threads = 1;
+    }
+    RectPool* pool = new RectPool();
+    pool->threads = threads;
+    pool->job = nullptr;
+    pool->generation = 0;
+    pool->running = 0;
+    pool->stop = false;
+    pool->state.resize(threads);
+    try {
+        for (int i = 1; i < threads; i++) pool->workers.emplace_back(worker_main, pool, i);
+    } catch (...) {
+        rect_pool_destroy(pool);
+        return nullptr;
+    }
+    return pool;
+}
+
+void rect_pool_destroy(RectPool* pool) {
+    if (pool == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> g(pool->lock);
+        pool->stop = true;
+    }
+    pool->wake.notify_all();
+    for (std::thread& t : pool->workers) t.join();
+    delete pool;
+}
+
+int rect_pool_threads(const RectPool* pool) {
+    return pool->threads;
+}
+
+// Rectangles [*begin, *end) of thread 'id': a contiguous run of whole chunks,
+// the same run for every pass over the same count
+static void thread_range(const RectPool* pool, int id, size_t count, size_t* begin, size_t* end) {
+    size_t chunks = (count + RECT_CHUNK - 1) / RECT_CHUNK;
+    size_t c0 = chunks * (size_t)id / (size_t)pool->threads;
+    size_t c1 = chunks * (size_t)(id + 1) / (size_t)pool->threads;
+    *begin = c0 * RECT_CHUNK;
+    *end = c1 * RECT_CHUNK < count ? c1 * RECT_CHUNK : count;
+}
+
+// --- Chunk kernels ---
+
+// Folds 'part' into 'acc' the way find_global_mbb() folds one more rect:
+// acc comes first in array order, so ties keep acc's value
+static inline void merge_mbb(Rect* acc, Rect part) {
+    if (part.x1 < acc->x1) acc->x1 = part.x1;
+    if (part.y1 < acc->y1) acc->y1 = part.y1;
+    if (part.x2 > acc->x2) acc->x2 = part.x2;
+    if (part.y2 > acc->y2) acc->y2 = part.y2;
+}
+
+/*
+ * MBB of r[0 .. n), starting from FLT_MAX / -FLT_MAX like the original.
+ * With SSE a whole Rect is one vector: lanes 0-1 of MINPS track x1 / y1,
+ * lanes 2-3 of MAXPS track x2 / y2. One accumulator keeps every lane in
+ * array order, so NaN and +0 / -0 come out exactly as in the scalar loop.
+ */
+static Rect mbb_range(const Rect* r, size_t n) {
+#ifdef RECT_HAVE_SSE
+    __m128 lo = _mm_set1_ps(FMAX), hi = _mm_set1_ps(-FMAX);
+    for (size_t i = 0; i < n; i++) {
+        __m128 v = _mm_loadu_ps(&r[i].x1);
+        lo = _mm_min_ps(v, lo);
+        hi = _mm_max_ps(v, hi);
+    }
+    float l[4], h[4];
+    _mm_storeu_ps(l, lo);
+    _mm_storeu_ps(h, hi);
+    return {l[0], l[1], h[2], h[3]};
+#else
+    Rect m = {FMAX, FMAX, -FMAX, -FMAX};
+    for (size_t i = 0; i < n; i++) merge_mbb(&m, r[i]);
+    return m;
+#endif
+}
+
+static inline Extent extent(const Rect& r) {
+    float cx = (r.x1 + r.x2) / 2.0f;
+    float cy = (r.y1 + r.y2) / 2.0f;
+    float half_w = (r.y2 - r.y1) / 2.0f;
+    float half_h = (r.x2 - r.x1) / 2.0f;
+    return {cx - half_w, cx + half_w, cy - half_h, cy + half_h};
+}
+
+static inline bool outside(const Extent& e, const Rect& box) {
+    return (e.lo_x < box.x1) | (e.hi_x > box.x2) | (e.lo_y < box.y1) | (e.hi_y > box.y2);
+}
+
+#ifdef RECT_HAVE_SSE
+// Extents of r[0 .. 4) with the same operations as extent(), 4 at a time
+static inline void extent4(const Rect* r, __m128* lo_x, __m128* hi_x, __m128* lo_y, __m128* hi_y) {
+    __m128 x1 = _mm_loadu_ps(&r[0].x1), y1 = _mm_loadu_ps(&r[1].x1);
+    __m128 x2 = _mm_loadu_ps(&r[2].x1), y2 = _mm_loadu_ps(&r[3].x1);
+    _MM_TRANSPOSE4_PS(x1, y1, x2, y2);
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128 cx = _mm_mul_ps(_mm_add_ps(x1, x2), half);
+    __m128 cy = _mm_mul_ps(_mm_add_ps(y1, y2), half);
+    __m128 half_w = _mm_mul_ps(_mm_sub_ps(y2, y1), half);
+    __m128 half_h = _mm_mul_ps(_mm_sub_ps(x2, x1), half);
+    *lo_x = _mm_sub_ps(cx, half_w);
+    *hi_x = _mm_add_ps(cx, half_w);
+    *lo_y = _mm_sub_ps(cy, half_h);
+    *hi_y = _mm_add_ps(cy, half_h);
+}
+
+// Lane mask of the 4 extents that stick out of 'box'
+static inline __m128 outside4(__m128 lo_x, __m128 hi_x, __m128 lo_y, __m128 hi_y, const Rect& box) {
+    return _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(lo_x, _mm_set1_ps(box.x1)), _mm_cmpgt_ps(hi_x, _mm_set1_ps(box.x2))),
+                     _mm_or_ps(_mm_cmplt_ps(lo_y, _mm_set1_ps(box.y1)), _mm_cmpgt_ps(hi_y, _mm_set1_ps(box.y2))));
+}
+#endif
+
+// count_out_of_bounds(box, r, n)
+static int count_range(Rect box, const Rect* r, size_t n) {
+    int violations = 0;
+    size_t i = 0;
+#ifdef RECT_HAVE_SSE
+    __m128i counts = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        __m128 lo_x, hi_x, lo_y, hi_y;
+        extent4(r + i, &lo_x, &hi_x, &lo_y, &hi_y);
+        counts = _mm_sub_epi32(counts, _mm_castps_si128(outside4(lo_x, hi_x, lo_y, hi_y, box)));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, counts);
+    violations = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < n; i++) violations += outside(extent(r[i]), box);
+    return violations;
+}
+
+// Appends the extents of the rects in r[0 .. n) that stick out of 'box'
+static void collect_range(const Rect* r, size_t n, Rect box, std::vector<Extent>* out) {
+    size_t i = 0;
+#ifdef RECT_HAVE_SSE
+    for (; i + 4 <= n; i += 4) {
+        __m128 lo_x, hi_x, lo_y, hi_y;
+        extent4(r + i, &lo_x, &hi_x, &lo_y, &hi_y);
+        int mask = _mm_movemask_ps(outside4(lo_x, hi_x, lo_y, hi_y, box));
+        if (mask == 0) continue;
+        float e[4][4];
+        _mm_storeu_ps(e[0], lo_x);
+        _mm_storeu_ps(e[1], hi_x);
+        _mm_storeu_ps(e[2], lo_y);
+        _mm_storeu_ps(e[3], hi_y);
+        for (int k = 0; k < 4; k++) {
+            if (mask & (1 << k)) out->push_back({e[0][k], e[1][k], e[2][k], e[3][k]});
+        }
+    }
+#endif
+    for (; i < n; i++) {
+        Extent e = extent(r[i]);
+        if (outside(e, box)) out->push_back(e);
+    }
+}
+
+// --- Two passes ---
+
+// Merges the per-thread MBBs in thread (= array) order
+static Rect merge_threads(const RectPool* pool, size_t count) {
+    if (count == 0) return {0, 0, 0, 0};
+    Rect m = {FMAX, FMAX, -FMAX, -FMAX};
+    for (int t = 0; t < pool->threads; t++) merge_mbb(&m, pool->state[t].mbb);
+    return m;
+}
+
+Rect find_global_mbb_parallel(RectPool* pool, const Rect* rects, size_t count) {
+    run(pool, [&](int id) {
+        size_t begin, end;
+        thread_range(pool, id, count, &begin, &end);
+        pool->state[id].mbb = mbb_range(rects + begin, end - begin);
+    });
+    return merge_threads(pool, count);
+}
+
+int count_out_of_bounds_parallel(RectPool* pool, Rect global_mbb, const Rect* rects, size_t count) {
+    run(pool, [&](int id) {
+        size_t begin, end;
+        thread_range(pool, id, count, &begin, &end);
+        pool->state[id].violations = count_range(global_mbb, rects + begin, end - begin);
+    });
+    int violations = 0;
+    for (int t = 0; t < pool->threads; t++) violations += pool->state[t].violations;
+    return violations;
+}
+
+// --- Streamed ---
+
+int rotated_boundary_streamed(RectPool* pool, const Rect* rects, size_t count, Rect* global_mbb) {
+    // Pass 1: each chunk's MBB, then its candidates while it is still in cache
+    run(pool, [&](int id) {
+        ThreadState& s = pool->state[id];
+        size_t begin, end;
+        thread_range(pool, id, count, &begin, &end);
+        s.mbb = {FMAX, FMAX, -FMAX, -FMAX};
+        s.candidates.clear();
+        s.recount.clear();
+        for (size_t c = begin; c < end; c += RECT_CHUNK) {
+            size_t n = end - c < RECT_CHUNK ? end - c : RECT_CHUNK;
+            merge_mbb(&s.mbb, mbb_range(rects + c, n));
+
+            // The final MBB contains s.mbb, so anything inside s.mbb is safe
+            size_t before = s.candidates.size();
+            collect_range(rects + c, n, s.mbb, &s.candidates);
+            if (s.candidates.size() - before > RECT_CHUNK / 8) {
+                s.candidates.resize(before);
+                s.recount.push_back(c);
+            }
+        }
+    });
+    *global_mbb = merge_threads(pool, count);
+
+    // Pass 2: candidates against the final box, plus the chunks that spilled
+    const Rect box = *global_mbb;
+    run(pool, [&](int id) {
+        ThreadState& s = pool->state[id];
+        int violations = 0;
+        for (const Extent& e : s.candidates) violations += outside(e, box);
+        for (size_t c : s.recount) {
+            size_t n = count - c < RECT_CHUNK ? count - c : RECT_CHUNK;
+            violations += count_range(box, rects + c, n);
+        }
+        s.violations = violations;
+    });
+    int violations = 0;
+    for (int t = 0; t < pool->threads; t++) violations += pool->state[t].violations;
+    return violations;
+}
@@ -0,0 +1,58 @@
+#ifndef RECT_PARALLEL_H
+#define RECT_PARALLEL_H
+
+#include <cstddef>
+#include "rotated_boundary.h"
+
+/*
+ * Multi-threaded MBB / Violation Count over a Rect[]
+ *
+ * The array is cut into cache-sized chunks of RECT_CHUNK rectangles, and
+ * each thread always gets the same contiguous run of chunks, so a
+ * thread's second pass reads what its own first pass brought into its
+ * own cache. Per-thread results are merged in array order with the same
+ * strict '<' / '>' as find_global_mbb(), so every function here returns
+ * exactly what the single-threaded functions return.
+ *
+ * Two plans:
+ *
+ * 1. Two passes (find_global_mbb_parallel, then count_out_of_bounds_parallel)
+ *    Both passes stream the whole array. Scales with cores until memory
+ *    bandwidth runs out, then the second pass costs as much as the first.
+ *
+ * 2. Streamed (rotated_boundary_streamed)
+ *    The global MBB is only known at the end, but it can only be larger
+ *    than the MBB of what a thread has seen so far. A rectangle that
+ *    fits in that running box after rotation fits in the final box too.
+ *    So while a chunk is hot, each thread computes its MBB and keeps
+ *    only the rotated extents of rectangles that stick out of the running
+ *    box (usually a handful). The second pass checks those candidates
+ *    against the final MBB and never touches the array again. A chunk
+ *    with too many candidates (e.g. data sorted so the box keeps moving)
+ *    is marked and re-counted in the second pass instead.
+ */
+
+#define RECT_CHUNK 16384            // 256 KB of Rect: about one L2
+
+typedef struct RectPool RectPool;
+
+/**
+ * @brief Starts a pool of 'threads' workers (the calling thread is one of
+ *        them, so threads - 1 are created). threads <= 0 means one per core.
+ * @return NULL if the threads could not be started
+ */
+RectPool* rect_pool_create(int threads);
+void rect_pool_destroy(RectPool* pool);
+int rect_pool_threads(const RectPool* pool);
+
+Rect find_global_mbb_parallel(RectPool* pool, const Rect* rects, size_t count);
+int count_out_of_bounds_parallel(RectPool* pool, Rect global_mbb, const Rect* rects, size_t count);
+
+/**
+ * @brief Both answers with one pass over 'rects' (plus re-counted chunks).
+ * @param global_mbb  Receives find_global_mbb(rects, count)
+ * @return            count_out_of_bounds(*global_mbb, rects, count)
+ */
+int rotated_boundary_streamed(RectPool* pool, const Rect* rects, size_t count, Rect* global_mbb);
+
+#endif // RECT_PARALLEL_H
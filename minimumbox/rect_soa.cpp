@@ -0,0 +1,309 @@
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <atomic>
+#include "rect_soa.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define RECT_HAVE_X86 1
+#endif
+
+/*
+ * Exactness notes (the SIMD passes must match the Rect[] loops):
+ * - min/max: MINPS/MAXPS return their second operand when the first is
+ *   NaN, so with the accumulator second a NaN coordinate is skipped, the
+ *   same as 'if (x < min_x)' being false. Equal values only differ in
+ *   bits for +0 / -0; the sequential loop keeps the first one it saw,
+ *   so a zero result is re-read from the first zero in the stream.
+ * - count: the same adds and subtracts as the scalar code; '/ 2.0f' and
+ *   '* 0.5f' are the same exact operation. Ordered compares are false
+ *   for NaN, like '<' and '>'. No FMA target, so nothing gets contracted.
+ * - Every slot past 'count' is NaN, which neither pass counts, so whole
+ *   vectors run to the end with no scalar tail.
+ */
+
+static const float PAD = std::numeric_limits<float>::quiet_NaN();
+static const float FMAX = std::numeric_limits<float>::max();
+
+// Floats to allocate for n rectangles: a whole number of 8-lane vectors
+static inline size_t padded(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+static float* alloc_stream(size_t capacity) {
+    float* p = (float*)aligned_alloc(32, capacity * sizeof(float));
+    if (p != NULL) {
+        for (size_t i = 0; i < capacity; i++) p[i] = PAD;
+    }
+    return p;
+}
+
+// Moves the streams to new blocks of 'capacity' (a multiple of 8) floats
+static bool reallocate(RectSoA* soa, size_t capacity) {
+    float* s[4] = { alloc_stream(capacity), alloc_stream(capacity),
+                    alloc_stream(capacity), alloc_stream(capacity) };
+    if (s[0] == NULL || s[1] == NULL || s[2] == NULL || s[3] == NULL) {
+        for (int k = 0; k < 4; k++) free(s[k]);
+        return false;
+    }
+    float* old[4] = { soa->x1, soa->y1, soa->x2, soa->y2 };
+    for (int k = 0; k < 4; k++) {
+        if (soa->count > 0) memcpy(s[k], old[k], soa->count * sizeof(float));
+        free(old[k]);
+    }
+    soa->x1 = s[0];
+    soa->y1 = s[1];
+    soa->x2 = s[2];
+    soa->y2 = s[3];
+    soa->capacity = capacity;
+    return true;
+}
+
+bool rect_soa_init(RectSoA* soa, size_t capacity) {
+    memset(soa, 0, sizeof(*soa));
+    return reallocate(soa, padded(capacity > 0 ? capacity : 8));
+}
+
+void rect_soa_free(RectSoA* soa) {
+    free(soa->x1);
+    free(soa->y1);
+    free(soa->x2);
+    free(soa->y2);
+    memset(soa, 0, sizeof(*soa));
+}
+
+bool rect_soa_push(RectSoA* soa, Rect r) {
+    if (soa->count == soa->capacity && !reallocate(soa, soa->capacity * 2)) {
+        return false;
+    }
+    size_t i = soa->count++;
+    soa->x1[i] = r.x1;
+    soa->y1[i] = r.y1;
+    soa->x2[i] = r.x2;
+    soa->y2[i] = r.y2;
+    return true;
+}
+
+bool rect_soa_assign(RectSoA* soa, const Rect* rects, size_t count) {
+    size_t old_count = soa->count;
+    if (count > soa->capacity) {
+        // Everything gets overwritten: don't copy the old rectangles over
+        soa->count = 0;
+        if (!reallocate(soa, padded(count))) {
+            // The old streams are untouched and still padded past old_count
+            soa->count = old_count;
+            return false;
+        }
+    }
+    for (size_t i = 0; i < count; i++) {
+        soa->x1[i] = rects[i].x1;
+        soa->y1[i] = rects[i].y1;
+        soa->x2[i] = rects[i].x2;
+        soa->y2[i] = rects[i].y2;
+    }
+    // Every slot past 'count' stays NaN, so later pushes keep the padding
+    for (size_t i = count; i < old_count; i++) {
+        soa->x1[i] = soa->y1[i] = soa->x2[i] = soa->y2[i] = PAD;
+    }
+    soa->count = count;
+    return true;
+}
+
+// --- Scalar ---
+
+static Rect mbb_scalar(const RectSoA* s) {
+    if (s->count == 0) return {0, 0, 0, 0};
+
+    float min_x = FMAX, min_y = FMAX, max_x = -FMAX, max_y = -FMAX;
+    for (size_t i = 0; i < s->count; i++) {
+        if (s->x1[i] < min_x) min_x = s->x1[i];
+        if (s->y1[i] < min_y) min_y = s->y1[i];
+        if (s->x2[i] > max_x) max_x = s->x2[i];
+        if (s->y2[i] > max_y) max_y = s->y2[i];
+    }
+    return {min_x, min_y, max_x, max_y};
+}
+
+static int count_scalar(Rect b, const RectSoA* s) {
+    int violations = 0;
+    for (size_t i = 0; i < s->count; i++) {
+        float cx = (s->x1[i] + s->x2[i]) / 2.0f;
+        float cy = (s->y1[i] + s->y2[i]) / 2.0f;
+        float half_w = (s->y2[i] - s->y1[i]) / 2.0f;
+        float half_h = (s->x2[i] - s->x1[i]) / 2.0f;
+
+        // '|' rather than '||': all four compares, no branches
+        violations += ((cx - half_w) < b.x1) | ((cx + half_w) > b.x2) |
+                      ((cy - half_h) < b.y1) | ((cy + half_h) > b.y2);
+    }
+    return violations;
+}
+
+#ifdef RECT_HAVE_X86
+
+// First stream value equal to zero (+0 or -0). SSE2 is always there on
+// x86-64, and the NaN padding never compares equal, so no tail loop.
+static float first_zero(const float* v, size_t count) {
+    const __m128 zero = _mm_setzero_ps();
+    for (size_t i = 0; i < padded(count); i += 4) {
+        int hits = _mm_movemask_ps(_mm_cmpeq_ps(_mm_load_ps(v + i), zero));
+        if (hits != 0) return v[i + (size_t)__builtin_ctz((unsigned)hits)];
+    }
+    return 0.0f;
+}
+
+// Folds per-lane results in lane order, then fixes up the sign of a zero
+static Rect finish_mbb(const RectSoA* s, const float* min_x, const float* min_y,
+                       const float* max_x, const float* max_y, int lanes) {
+    if (s->count == 0) return {0, 0, 0, 0};
+
+    Rect m = {FMAX, FMAX, -FMAX, -FMAX};
+    for (int k = 0; k < lanes; k++) {
+        if (min_x[k] < m.x1) m.x1 = min_x[k];
+        if (min_y[k] < m.y1) m.y1 = min_y[k];
+        if (max_x[k] > m.x2) m.x2 = max_x[k];
+        if (max_y[k] > m.y2) m.y2 = max_y[k];
+    }
+    if (m.x1 == 0.0f) m.x1 = first_zero(s->x1, s->count);
+    if (m.y1 == 0.0f) m.y1 = first_zero(s->y1, s->count);
+    if (m.x2 == 0.0f) m.x2 = first_zero(s->x2, s->count);
+    if (m.y2 == 0.0f) m.y2 = first_zero(s->y2, s->count);
+    return m;
+}
+
+#define TARGET_sse
+#define TARGET_avx2 __attribute__((target("avx2")))
+
+static inline __m128 lt_sse(__m128 a, __m128 b) { return _mm_cmplt_ps(a, b); }
+static inline __m128 gt_sse(__m128 a, __m128 b) { return _mm_cmpgt_ps(a, b); }
+static inline TARGET_avx2 __m256 lt_avx2(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+static inline TARGET_avx2 __m256 gt_avx2(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+
+/*
+ * RECT_KERNELS(ISA, W, SI, VF, VI, LANES) defines mbb_<ISA>() and
+ * count_<ISA>(). W is the intrinsic width prefix (empty for _mm_, 256
+ * for _mm256_) and SI the integer vector suffix (si128 / si256).
+ * Violations are counted per lane: a true compare is all ones (-1), so
+ * subtracting the mask adds one.
+ */
+#define RECT_KERNELS(ISA, W, SI, VF, VI, LANES)                                          \
+static TARGET_##ISA Rect mbb_##ISA(const RectSoA* s) {                                   \
+    VF min_x = _mm##W##_set1_ps(FMAX), min_y = min_x;                                    \
+    VF max_x = _mm##W##_set1_ps(-FMAX), max_y = max_x;                                   \
+    for (size_t i = 0; i < padded(s->count); i += LANES) {                               \
+        min_x = _mm##W##_min_ps(_mm##W##_load_ps(s->x1 + i), min_x);                     \
+        min_y = _mm##W##_min_ps(_mm##W##_load_ps(s->y1 + i), min_y);                     \
+        max_x = _mm##W##_max_ps(_mm##W##_load_ps(s->x2 + i), max_x);                     \
+        max_y = _mm##W##_max_ps(_mm##W##_load_ps(s->y2 + i), max_y);                     \
+    }                                                                                    \
+    float lx1[LANES], ly1[LANES], lx2[LANES], ly2[LANES];                                \
+    _mm##W##_storeu_ps(lx1, min_x);                                                      \
+    _mm##W##_storeu_ps(ly1, min_y);                                                      \
+    _mm##W##_storeu_ps(lx2, max_x);                                                      \
+    _mm##W##_storeu_ps(ly2, max_y);                                                      \
+    return finish_mbb(s, lx1, ly1, lx2, ly2, LANES);                                     \
+}                                                                                        \
+static TARGET_##ISA int count_##ISA(Rect b, const RectSoA* s) {                          \
+    const VF half = _mm##W##_set1_ps(0.5f);                                              \
+    const VF bx1 = _mm##W##_set1_ps(b.x1), by1 = _mm##W##_set1_ps(b.y1);                 \
+    const VF bx2 = _mm##W##_set1_ps(b.x2), by2 = _mm##W##_set1_ps(b.y2);                 \
+    VI counts = _mm##W##_setzero_##SI();                                                 \
+    for (size_t i = 0; i < padded(s->count); i += LANES) {                               \
+        VF x1 = _mm##W##_load_ps(s->x1 + i), y1 = _mm##W##_load_ps(s->y1 + i);           \
+        VF x2 = _mm##W##_load_ps(s->x2 + i), y2 = _mm##W##_load_ps(s->y2 + i);           \
+        VF cx = _mm##W##_mul_ps(_mm##W##_add_ps(x1, x2), half);                          \
+        VF cy = _mm##W##_mul_ps(_mm##W##_add_ps(y1, y2), half);                          \
+        VF half_w = _mm##W##_mul_ps(_mm##W##_sub_ps(y2, y1), half);                      \
+        VF half_h = _mm##W##_mul_ps(_mm##W##_sub_ps(x2, x1), half);                      \
+        VF out = _mm##W##_or_ps(                                                         \
+            _mm##W##_or_ps(lt_##ISA(_mm##W##_sub_ps(cx, half_w), bx1),                   \
+                           gt_##ISA(_mm##W##_add_ps(cx, half_w), bx2)),                  \
+            _mm##W##_or_ps(lt_##ISA(_mm##W##_sub_ps(cy, half_h), by1),                   \
+                           gt_##ISA(_mm##W##_add_ps(cy, half_h), by2)));                 \
+        counts = _mm##W##_sub_epi32(counts, _mm##W##_castps_##SI(out));                  \
+    }                                                                                    \
+    int lanes[LANES];                                                                    \
+    _mm##W##_storeu_##SI((VI*)lanes, counts);                                            \
+    int violations = 0;                                                                  \
+    for (int k = 0; k < LANES; k++) violations += lanes[k];                              \
+    return violations;                                                                   \
+}
+
+RECT_KERNELS(sse, , si128, __m128, __m128i, 4)
+RECT_KERNELS(avx2, 256, si256, __m256, __m256i, 8)
+
+#endif // RECT_HAVE_X86
+
+// --- Backend selection ---
+
+typedef struct {
+    Rect (*mbb)(const RectSoA* s);
+    int (*count)(Rect b, const RectSoA* s);
+} rect_kernels_t;
+
+static const rect_kernels_t kernels[RECT_BACKEND_COUNT] = {
+    { mbb_scalar, count_scalar },
+#ifdef RECT_HAVE_X86
+    { mbb_sse, count_sse },
+    { mbb_avx2, count_avx2 },
+#else
+    { mbb_scalar, count_scalar },
+    { mbb_scalar, count_scalar },
+#endif
+};
+
+bool rect_supported(rect_backend_t backend) {
+    switch (backend) {
+        case RECT_SCALAR: return true;
+#ifdef RECT_HAVE_X86
+        case RECT_SSE:    return true;
+        case RECT_AVX2:   return __builtin_cpu_supports("avx2");
+#endif
+        default:          return false;
+    }
+}
+
+rect_backend_t rect_best(void) {
+    if (rect_supported(RECT_AVX2)) return RECT_AVX2;
+    if (rect_supported(RECT_SSE)) return RECT_SSE;
+    return RECT_SCALAR;
+}
+
+// Kernel set for the *_soa entry points, -1 until one of them first runs.
+// Pool workers can get there together; all of them store rect_best().
+static std::atomic<int> selected_backend(-1);
+
+rect_backend_t rect_selected(void) {
+    int backend = selected_backend.load(std::memory_order_relaxed);
+    if (backend < 0) {
+        backend = (int)rect_best();
+        selected_backend.store(backend, std::memory_order_relaxed);
+    }
+    return (rect_backend_t)backend;
+}
+
+bool rect_select(rect_backend_t backend) {
+    if (!rect_supported(backend)) {
+        return false;
+    }
+    selected_backend.store((int)backend, std::memory_order_relaxed);
+    return true;
+}
+
+const char* rect_name(rect_backend_t backend) {
+    switch (backend) {
+        case RECT_SCALAR: return "scalar";
+        case RECT_SSE:    return "sse";
+        case RECT_AVX2:   return "avx2";
+        default:          return "?";
+    }
+}
+
+Rect find_global_mbb_soa(const RectSoA* soa) {
+    return kernels[rect_selected()].mbb(soa);
+}
+
+int count_out_of_bounds_soa(Rect global_mbb, const RectSoA* soa) {
+    return kernels[rect_selected()].count(global_mbb, soa);
+}
@@ -0,0 +1,66 @@
+#ifndef RECT_SOA_H
+#define RECT_SOA_H
+
+#include <cstddef>
+#include "rotated_boundary.h"
+
+/*
+ * Structure-of-Arrays Rectangle Store
+ *
+ * The same rectangles as a Rect[] but with each coordinate in its own
+ * stream, so one SIMD load fetches 8 (AVX2) or 4 (SSE) x1 values and no
+ * lane is wasted on fields a pass does not need. Streams are 32-byte
+ * aligned and padded to a multiple of 8 floats with NaN, which neither
+ * pass counts.
+ *
+ * find_global_mbb_soa() / count_out_of_bounds_soa() return exactly what
+ * find_global_mbb() / count_out_of_bounds() return for the same
+ * rectangles in the same order, bit for bit (NaN coordinates and +0 / -0
+ * included), on every backend.
+ */
+
+typedef struct {
+    float* x1;
+    float* y1;
+    float* x2;
+    float* y2;
+    size_t count;
+    size_t capacity;
+} RectSoA;
+
+// Returns false if out of memory
+bool rect_soa_init(RectSoA* soa, size_t capacity);
+void rect_soa_free(RectSoA* soa);
+
+// Appends one rectangle, growing the streams as needed
+bool rect_soa_push(RectSoA* soa, Rect r);
+
+// Replaces the contents with rects[0 .. count)
+bool rect_soa_assign(RectSoA* soa, const Rect* rects, size_t count);
+
+Rect find_global_mbb_soa(const RectSoA* soa);
+int count_out_of_bounds_soa(Rect global_mbb, const RectSoA* soa);
+
+/*
+ * Lane widths for find_global_mbb_soa() / count_out_of_bounds_soa().
+ * rect_best() (AVX2 if the machine has it, else SSE, else scalar) is
+ * used unless rect_select() chose otherwise.
+ */
+typedef enum {
+    RECT_SCALAR,            // Branchless loops over the streams
+    RECT_SSE,               // 4 lanes (SSE2, always there on x86-64)
+    RECT_AVX2,              // 8 lanes
+    RECT_BACKEND_COUNT
+} rect_backend_t;
+
+bool rect_supported(rect_backend_t backend);
+rect_backend_t rect_best(void);
+
+// Forces the MBB / violation-count kernels to 'backend'. AVX2 on an older
+// CPU, or any SIMD backend off x86, is refused and the current one kept.
+bool rect_select(rect_backend_t backend);
+rect_backend_t rect_selected(void);
+
+const char* rect_name(rect_backend_t backend);
+
+#endif // RECT_SOA_H
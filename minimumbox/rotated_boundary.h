@@ -0,0 +1,28 @@
+#ifndef ROTATED_BOUNDARY_H
+#define ROTATED_BOUNDARY_H
+
+#include <cstddef>
+
+typedef struct {
+    float x1; // Lower-left X
+    float y1; // Lower-left Y
+    float x2; // Upper-right X
+    float y2; // Upper-right Y
+} Rect;
+
+/**
+ * @param rects       Input array of rectangles
+ * @param count       Number of rectangles
+ * @return            The global MBB encompassing all rects
+ */
+Rect find_global_mbb(const Rect* rects, size_t count);
+
+/**
+ * @param global_mbb  The original boundary
+ * @param rects       The rectangles to rotate and check
+ * @param count       Number of rectangles
+ * @return            The number of rectangles that exceed the global_mbb after 90 deg rotation
+ */
+int count_out_of_bounds(Rect global_mbb, const Rect* rects, size_t count);
+
+#endif // ROTATED_BOUNDARY_H
@@ -0,0 +1,300 @@
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include "rotated_boundary.h"
+#include "rect_soa.h"
+#include "rect_parallel.h"
+#include "rect_index.h"
+
+void print_rect(const char* label, Rect r) {
+    printf("%s: LL(%.2f, %.2f) UR(%.2f, %.2f)\n", label, r.x1, r.y1, r.x2, r.y2);
+}
+
+// Global failure tracking for CI/CD style reporting
+static int total_failures = 0;
+
+void run_test(int num, const char* desc, Rect* rects, size_t count, int expected) {
+    Rect mbb = find_global_mbb(rects, count);
+    int actual = count_out_of_bounds(mbb, rects, count);
+
+    if (actual == expected) {
+        printf("[PASS] Test %d: %s\n", num, desc);
+    } else {
+        printf("[FAIL] Test %d: %s (Expected %d, got %d)\n", num, desc, expected, actual);
+        total_failures++;
+    }
+}
+
+void run_check(int num, const char* desc, bool passed) {
+    if (passed) {
+        printf("[PASS] Test %d: %s\n", num, desc);
+    } else {
+        printf("[FAIL] Test %d: %s\n", num, desc);
+        total_failures++;
+    }
+}
+
+// --- SoA vs Rect[] ---
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Mostly ordinary coordinates, sometimes a value that trips up SIMD min/max
+static float random_coord(bool with_specials, bool non_negative) {
+    static const float specials[] = {
+        0.0f, -0.0f, std::numeric_limits<float>::quiet_NaN(),
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::max(), std::numeric_limits<float>::denorm_min(),
+    };
+    if (with_specials && xorshift32() % 16 == 0) {
+        float v = specials[xorshift32() % (sizeof(specials) / sizeof(specials[0]))];
+        return non_negative && v < 0 ? -v : v;
+    }
+    float v = (float)(int32_t)xorshift32() / 1048576.0f;
+    return non_negative ? std::fabs(v) : v;
+}
+
+static bool same_bits(Rect a, Rect b) {
+    return memcmp(&a, &b, sizeof(Rect)) == 0;
+}
+
+// Every backend against the Rect[] functions, for one set of rectangles
+static bool soa_matches(const std::vector<Rect>& rects) {
+    RectSoA soa;
+    if (!rect_soa_init(&soa, 0) || !rect_soa_assign(&soa, rects.data(), rects.size())) return false;
+
+    Rect mbb = find_global_mbb(rects.data(), rects.size());
+    int expected = count_out_of_bounds(mbb, rects.data(), rects.size());
+    bool ok = true;
+    for (int b = 0; b < RECT_BACKEND_COUNT; b++) {
+        if (!rect_select((rect_backend_t)b)) continue;
+        ok &= same_bits(find_global_mbb_soa(&soa), mbb);
+        ok &= count_out_of_bounds_soa(mbb, &soa) == expected;
+    }
+    rect_select(rect_best());
+    rect_soa_free(&soa);
+    return ok;
+}
+
+static bool random_sets(bool with_specials, bool non_negative) {
+    for (size_t count = 0; count <= 70; count++) {
+        for (int rep = 0; rep < 20; rep++) {
+            std::vector<Rect> rects(count);
+            for (Rect& r : rects) {
+                r = { random_coord(with_specials, non_negative), random_coord(with_specials, non_negative),
+                      random_coord(with_specials, non_negative), random_coord(with_specials, non_negative) };
+            }
+            if (!soa_matches(rects)) return false;
+        }
+    }
+    return true;
+}
+
+// --- Thread pool vs Rect[] ---
+
+// Both parallel plans against the Rect[] functions, on pools of several sizes
+static bool parallel_matches(RectPool** pools, int npools, const std::vector<Rect>& rects) {
+    Rect mbb = find_global_mbb(rects.data(), rects.size());
+    int expected = count_out_of_bounds(mbb, rects.data(), rects.size());
+    bool ok = true;
+    for (int p = 0; p < npools; p++) {
+        ok &= same_bits(find_global_mbb_parallel(pools[p], rects.data(), rects.size()), mbb);
+        ok &= count_out_of_bounds_parallel(pools[p], mbb, rects.data(), rects.size()) == expected;
+        Rect streamed_mbb = {0, 0, 0, 0};
+        ok &= rotated_boundary_streamed(pools[p], rects.data(), rects.size(), &streamed_mbb) == expected;
+        ok &= same_bits(streamed_mbb, mbb);
+    }
+    return ok;
+}
+
+// Sizes around chunk and thread boundaries
+static bool parallel_random(RectPool** pools, int npools, bool with_specials) {
+    const size_t sizes[] = { 0, 1, 3, 4, 5, RECT_CHUNK - 1, RECT_CHUNK, RECT_CHUNK + 1,
+                             2 * RECT_CHUNK + 3, 7 * RECT_CHUNK - 5, 7 * RECT_CHUNK + 9 };
+    for (size_t count : sizes) {
+        std::vector<Rect> rects(count);
+        for (Rect& r : rects) {
+            r = { random_coord(with_specials, false), random_coord(with_specials, false),
+                  random_coord(with_specials, false), random_coord(with_specials, false) };
+        }
+        if (!parallel_matches(pools, npools, rects)) return false;
+    }
+    return true;
+}
+
+// --- Index vs Rect[] ---
+
+// A boundary somewhere around 'mbb', or a random one
+static Rect moving_box(Rect mbb, bool with_specials) {
+    if (xorshift32() % 4 == 0) {
+        return { random_coord(with_specials, false), random_coord(with_specials, false),
+                 random_coord(with_specials, false), random_coord(with_specials, false) };
+    }
+    float w = mbb.x2 - mbb.x1, h = mbb.y2 - mbb.y1;
+    float f[4];
+    for (float& v : f) v = (float)(xorshift32() % 1000) / 2000.0f - 0.1f;
+    return { mbb.x1 + f[0] * w, mbb.y1 + f[1] * h, mbb.x2 - f[2] * w, mbb.y2 - f[3] * h };
+}
+
+static void collect_id(uint32_t id, void* ctx) {
+    ((std::vector<uint32_t>*)ctx)->push_back(id);
+}
+
+// Count and visited ids against count_out_of_bounds over the live rects
+static bool index_matches(const RectIndex* index, const std::vector<Rect>& by_id,
+                          const std::vector<bool>& live, Rect box) {
+    std::vector<Rect> rects;
+    std::vector<uint32_t> expected_ids;
+    for (uint32_t id = 0; id < by_id.size(); id++) {
+        if (!live[id]) continue;
+        rects.push_back(by_id[id]);
+        if (count_out_of_bounds(box, &by_id[id], 1)) expected_ids.push_back(id);
+    }
+    std::vector<uint32_t> ids;
+    rect_index_for_each_out_of_bounds(index, box, collect_id, &ids);
+    std::sort(ids.begin(), ids.end());
+    return rect_index_size(index) == rects.size() && ids == expected_ids &&
+           rect_index_count_out_of_bounds(index, box) == count_out_of_bounds(box, rects.data(), rects.size());
+}
+
+// Random inserts / removes between queries: mostly inserts for the first
+// half of the steps, then mostly removes, so lists both grow and shrink
+static bool index_churn(size_t count, int steps, bool with_specials) {
+    std::vector<Rect> by_id(count);
+    for (Rect& r : by_id) {
+        r = { random_coord(with_specials, false), random_coord(with_specials, false),
+              random_coord(with_specials, false), random_coord(with_specials, false) };
+    }
+    std::vector<bool> live(by_id.size(), true);
+    RectIndex* index = rect_index_create(by_id.data(), by_id.size());
+    if (index == NULL) return false;
+
+    bool ok = true;
+    for (int step = 0; step < steps && ok; step++) {
+        uint32_t op = xorshift32() % 8;
+        if (op < (step < steps / 2 ? 4u : 1u)) {
+            Rect r = { random_coord(with_specials, false), random_coord(with_specials, false),
+                       random_coord(with_specials, false), random_coord(with_specials, false) };
+            uint32_t id = rect_index_insert(index, r);
+            ok &= id != RECT_INDEX_NONE && (id >= by_id.size() || !live[id]);
+            if (id >= by_id.size()) {
+                by_id.resize(id + 1);
+                live.resize(id + 1, false);
+            }
+            by_id[id] = r;
+            live[id] = true;
+        } else if (op < 6) {
+            uint32_t id = xorshift32() % (uint32_t)(by_id.size() + 10);
+            bool was_live = id < by_id.size() && live[id];
+            ok &= rect_index_remove(index, id) == was_live;
+            if (was_live) live[id] = false;
+        } else {
+            ok &= index_matches(index, by_id, live, moving_box(find_global_mbb(by_id.data(), by_id.size()), with_specials));
+        }
+    }
+    rect_index_destroy(index);
+    return ok;
+}
+
+int main() {
+    printf("--- Running Geometry Validation Suite ---\n");
+
+    Rect t1[] = { {0, 0, 2, 10} };
+    run_test(1, "Self-violation on tall rect", t1, 1, 1);
+
+    Rect t2[] = { {0, 0, 5, 5}, {10, 10, 12, 12} };
+    run_test(2, "Perfect squares (invariant)", t2, 2, 0);
+
+    Rect t3[] = { {-10, -5, -8, 5}, {8, -5, 10, 5} };
+    run_test(3, "Negative symmetry violations", t3, 2, 2);
+
+    // Test 4+: the SoA engine gives the same bits on every backend
+    run_check(4, "SoA matches on tests 1-3",
+              soa_matches({ t1, t1 + 1 }) && soa_matches({ t2, t2 + 2 }) && soa_matches({ t3, t3 + 2 }));
+    run_check(5, "SoA matches on random sets (0..70 rects)", random_sets(false, false));
+    run_check(6, "SoA matches with NaN / inf / +-0 coordinates", random_sets(true, false));
+    run_check(7, "SoA keeps the first zero's sign (+0 vs -0 minimum)", random_sets(true, true));
+
+    // Test 8: shrinking then pushing must not expose old values as padding
+    RectSoA soa;
+    std::vector<Rect> big(40, Rect{-100, -100, 100, 100});
+    rect_soa_init(&soa, 0);
+    rect_soa_assign(&soa, big.data(), big.size());
+    rect_soa_assign(&soa, t2, 2);
+    for (int i = 0; i < 5; i++) rect_soa_push(&soa, t2[i % 2]);
+    Rect grown[7] = { t2[0], t2[1], t2[0], t2[1], t2[0], t2[1], t2[0] };
+    Rect mbb = find_global_mbb(grown, 7);
+    // An assign that cannot get memory leaves the SoA as it was
+    bool refused = !rect_soa_assign(&soa, grown, SIZE_MAX / 16) && soa.count == 7;
+    run_check(8, "SoA assign / push keep NaN padding",
+              refused && same_bits(find_global_mbb_soa(&soa), mbb) &&
+              count_out_of_bounds_soa(mbb, &soa) == count_out_of_bounds(mbb, grown, 7));
+    rect_soa_free(&soa);
+
+    // Test 9+: the thread pool gives the same answers for any thread count
+    RectPool* pools[] = { rect_pool_create(1), rect_pool_create(2), rect_pool_create(3), rect_pool_create(7) };
+    const int npools = sizeof(pools) / sizeof(pools[0]);
+    bool started = true;
+    for (RectPool* p : pools) started &= p != NULL;
+    run_check(9, "Pools of 1, 2, 3 and 7 threads start", started);
+    if (started) {
+        run_check(10, "Parallel matches on tests 1-3",
+                  parallel_matches(pools, npools, { t1, t1 + 1 }) && parallel_matches(pools, npools, { t2, t2 + 2 }) &&
+                  parallel_matches(pools, npools, { t3, t3 + 2 }));
+        run_check(11, "Parallel matches around chunk boundaries", parallel_random(pools, npools, false));
+        run_check(12, "Parallel matches with NaN / inf / +-0 coordinates", parallel_random(pools, npools, true));
+
+        // Test 13: the box grows with every rect, so chunks spill and get re-counted
+        std::vector<Rect> moving(5 * RECT_CHUNK);
+        for (size_t i = 0; i < moving.size(); i++) {
+            float x = -(float)i;
+            moving[i] = { x, 0, x + 1, (float)(i % 7) };
+        }
+        run_check(13, "Streamed plan re-counts spilled chunks", parallel_matches(pools, npools, moving));
+    }
+    for (RectPool* p : pools) rect_pool_destroy(p);
+
+    // Test 14+: the index answers like a full rescan for any boundary
+    bool index_ok = true;
+    for (int rep = 0; rep < 40 && index_ok; rep++) {
+        bool with_specials = rep % 2 == 1;
+        std::vector<Rect> rects(xorshift32() % 300);
+        for (Rect& r : rects) {
+            r = { random_coord(with_specials, false), random_coord(with_specials, false),
+                  random_coord(with_specials, false), random_coord(with_specials, false) };
+        }
+        RectIndex* index = rect_index_create(rects.data(), rects.size());
+        std::vector<bool> live(rects.size(), true);
+        index_ok = index != NULL;
+        Rect set_mbb = find_global_mbb(rects.data(), rects.size());
+        for (int q = 0; q < 50 && index_ok; q++) {
+            index_ok = index_matches(index, rects, live, q == 0 ? set_mbb : moving_box(set_mbb, with_specials));
+        }
+        rect_index_destroy(index);
+    }
+    run_check(14, "Index matches a rescan for moving boundaries", index_ok);
+    run_check(15, "Index matches after inserts / removes", index_churn(500, 3000, false));
+    run_check(16, "Index matches with NaN / inf / +-0 and churn", index_churn(500, 3000, true));
+    run_check(17, "Index matches while blocks split and join", index_churn(1500, 12000, true));
+
+    // Final Reporting Logic
+    printf("\n---------------------------------------\n");
+    if (total_failures == 0) {
+        printf("RESULT: ALL TESTS PASSED ✅\n");
+    } else {
+        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
+    }
+    printf("---------------------------------------\n");
+
+    return (total_failures == 0) ? 0 : 1; // Return non-zero for script automation
+}
@@ -0,0 +1,112 @@
+/*
+Map Parser Benchmark
+Writes synthetic GNU ld map files shaped like a -ffunction-sections
+build (one input section per symbol, long section names wrapped onto a
+second line, object paths on every line) and times map_parse_map_file().
+The parse must stay well under a second at 100k+ symbols.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include "map_parser.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Emits one output section holding 'count' symbols. Returns bytes used.
+static uint64_t write_section(FILE *f, const char *name, const char *prefix, uint64_t base,
+                              size_t count, const char *load) {
+    // Sizes first, so the output section header can carry the total
+    uint32_t *sizes = malloc(count * sizeof(uint32_t));
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        sizes[i] = 4 + (xorshift32() % 64) * 4;
+        total += sizes[i];
+    }
+
+    fprintf(f, "\n%-15s 0x%08llx %#10llx%s\n", name, (unsigned long long)base, (unsigned long long)total, load);
+    fprintf(f, " *(%s %s.*)\n", name, name);
+
+    uint64_t addr = base;
+    for (size_t i = 0; i < count; i++) {
+        const char *obj = "/home/build/firmware/out/obj/src/subsystem/module_with_long_path.o";
+        if (i % 2 == 0) {
+            // Long name: ld wraps address and size onto the next line
+            fprintf(f, " %s.%s_%zu_with_a_long_name\n", name, prefix, i);
+            fprintf(f, "                0x%08llx %#10x %s\n", (unsigned long long)addr, sizes[i], obj);
+        } else {
+            fprintf(f, " %-14s 0x%08llx %#10x %s\n", name, (unsigned long long)addr, sizes[i], obj);
+        }
+        fprintf(f, "                0x%08llx                %s_%zu\n", (unsigned long long)addr, prefix, i);
+        addr += sizes[i];
+    }
+    free(sizes);
+    return total;
+}
+
+static void write_map(const char *path, size_t symbols) {
+    FILE *f = fopen(path, "w");
+    fprintf(f, "Archive member included to satisfy reference by file (symbol)\n\n");
+    fprintf(f, "Memory Configuration\n\n");
+    fprintf(f, "Name             Origin             Length             Attributes\n");
+    fprintf(f, "FLASH            0x08000000         0x01000000         xr\n");
+    fprintf(f, "RAM              0x20000000         0x01000000         xrw\n");
+    fprintf(f, "*default*        0x00000000         0xffffffff\n\n");
+    fprintf(f, "Linker script and memory map\n\n");
+
+    size_t text = symbols * 6 / 10, data = symbols / 10, bss = symbols - text - data;
+    uint64_t text_size = write_section(f, ".text", "func", 0x08000000, text, "");
+    char load[64];
+    snprintf(load, sizeof(load), " load address 0x%08llx", (unsigned long long)(0x08000000 + text_size));
+    uint64_t data_size = write_section(f, ".data", "var", 0x20000000, data, load);
+    write_section(f, ".bss", "buf", 0x20000000 + data_size, bss, "");
+    fprintf(f, "OUTPUT(firmware.elf elf32-littlearm)\n");
+    fclose(f);
+}
+
+int main() {
+    static const size_t counts[] = { 10000, 100000, 250000, 500000 };
+    char path[] = "/tmp/mapbench_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return 1;
+    close(fd);
+
+    printf("--- map_parse_map_file() on synthetic maps ---\n");
+    printf("  %8s %10s %10s %10s %10s\n", "symbols", "MB", "ms", "MB/s", "parsed");
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        write_map(path, counts[i]);
+
+        FILE *f = fopen(path, "r");
+        fseek(f, 0, SEEK_END);
+        double mb = (double)ftell(f) / (1024.0 * 1024.0);
+        fclose(f);
+
+        map_image_t img;
+        map_image_init(&img);
+        uint64_t start = now_ns();
+        map_status_t st = map_parse_map_file(&img, path);
+        double ms = (double)(now_ns() - start) / 1e6;
+
+        printf("  %8zu %10.1f %10.1f %10.1f %10zu%s\n", counts[i], mb, ms, mb / (ms / 1000.0),
+               img.num_symbols, st == MAP_OK ? "" : "  (parse error)");
+        map_image_free(&img);
+    }
+
+    remove(path);
+    return 0;
+}
@@ -0,0 +1,597 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "map_parser.h"
+
+#define LINE_MAX_LEN   4096
+#define ELF_SYM_CHUNK  1024      // Symbols read per fread()
+
+void map_image_init(map_image_t *img) {
+    memset(img, 0, sizeof(*img));
+}
+
+void map_image_free(map_image_t *img) {
+    free(img->sections);
+    free(img->symbols);
+    free(img->names);
+    map_image_init(img);
+}
+
+const char *map_status_str(map_status_t status) {
+    switch (status) {
+        case MAP_OK:         return "ok";
+        case MAP_ERR_IO:     return "cannot read file";
+        case MAP_ERR_FORMAT: return "unrecognized file format";
+        case MAP_ERR_NOMEM:  return "out of memory";
+    }
+    return "unknown error";
+}
+
+int map_find_region(const map_image_t *img, uint64_t addr) {
+    for (int i = 0; i < img->num_regions; i++) {
+        const mem_region_t *r = &img->regions[i];
+        if (addr >= r->origin && addr - r->origin < r->length) return i;
+    }
+    return -1;
+}
+
+// --- Record Storage ---
+
+static void copy_name(char *dst, const char *src, size_t len) {
+    size_t n = strlen(src);
+    if (n >= len) n = len - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+}
+
+static void add_region(map_image_t *img, const char *name, uint64_t origin, uint64_t length) {
+    // "*default*" is ld's catch-all for everything outside MEMORY
+    if (strcmp(name, "*default*") == 0) return;
+
+    int slot = -1;
+    for (int i = 0; i < img->num_regions; i++) {
+        if (strcmp(img->regions[i].name, name) == 0) slot = i;
+    }
+    if (slot < 0) {
+        if (img->num_regions == MAP_MAX_REGIONS) return;
+        slot = img->num_regions++;
+    }
+    copy_name(img->regions[slot].name, name, MAP_NAME_LEN);
+    img->regions[slot].origin = origin;
+    img->regions[slot].length = length;
+}
+
+static int add_section(map_image_t *img, const char *name, uint64_t vma, uint64_t lma,
+                       uint64_t size, bool nobits) {
+    if (img->num_sections == img->sections_cap) {
+        uint32_t cap = img->sections_cap ? img->sections_cap * 2 : 32;
+        out_section_t *s = realloc(img->sections, cap * sizeof(out_section_t));
+        if (s == NULL) return -1;
+        img->sections = s;
+        img->sections_cap = cap;
+    }
+    out_section_t *s = &img->sections[img->num_sections];
+    copy_name(s->name, name, MAP_NAME_LEN);
+    s->vma = vma;
+    s->lma = lma;
+    s->size = size;
+    s->nobits = nobits;
+    return (int)img->num_sections++;
+}
+
+static bool add_symbol(map_image_t *img, const char *name, size_t name_len,
+                       uint64_t addr, uint64_t size, uint32_t section) {
+    if (img->num_symbols == img->symbols_cap) {
+        size_t cap = img->symbols_cap ? img->symbols_cap * 2 : 1024;
+        map_symbol_t *s = realloc(img->symbols, cap * sizeof(map_symbol_t));
+        if (s == NULL) return false;
+        img->symbols = s;
+        img->symbols_cap = cap;
+    }
+    if (img->names_len + name_len + 1 > img->names_cap) {
+        size_t cap = img->names_cap ? img->names_cap * 2 : 16384;
+        while (cap < img->names_len + name_len + 1) cap *= 2;
+        char *n = realloc(img->names, cap);
+        if (n == NULL) return false;
+        img->names = n;
+        img->names_cap = cap;
+    }
+
+    map_symbol_t *sym = &img->symbols[img->num_symbols++];
+    sym->addr = addr;
+    sym->size = size;
+    sym->section = section;
+    sym->name = (uint32_t)img->names_len;
+    memcpy(img->names + img->names_len, name, name_len);
+    img->names_len += name_len;
+    img->names[img->names_len++] = '\0';
+    return true;
+}
+
+// --- Line Helpers ---
+
+// Reads one line without its newline. Overlong lines are truncated (the
+// tail is skipped), which only ever cuts off object file paths.
+static bool read_line(FILE *f, char *buf, size_t size) {
+    if (fgets(buf, (int)size, f) == NULL) return false;
+
+    size_t len = strlen(buf);
+    if (len > 0 && buf[len - 1] == '\n') {
+        buf[--len] = '\0';
+    } else if (!feof(f)) {
+        int c;
+        while ((c = fgetc(f)) != EOF && c != '\n') { }
+    }
+    if (len > 0 && buf[len - 1] == '\r') buf[--len] = '\0';
+    return true;
+}
+
+static char *skip_spaces(char *p) {
+    while (*p == ' ' || *p == '\t') p++;
+    return p;
+}
+
+// Splits off the next whitespace-delimited token (NUL-terminates it)
+static char *next_token(char **cursor) {
+    char *p = skip_spaces(*cursor);
+    if (*p == '\0') return NULL;
+
+    char *start = p;
+    while (*p != '\0' && *p != ' ' && *p != '\t') p++;
+    if (*p != '\0') *p++ = '\0';
+    *cursor = p;
+    return start;
+}
+
+static bool parse_hex(const char *tok, uint64_t *out) {
+    if (tok == NULL || tok[0] != '0' || (tok[1] != 'x' && tok[1] != 'X')) return false;
+    char *end;
+    *out = strtoull(tok, &end, 16);
+    return *end == '\0';
+}
+
+// --- GNU ld Map Files ---
+
+typedef struct {
+    map_image_t *img;
+    int cur_out;                // Output section being listed, -1 if none
+    bool in_active;             // Inside an input section
+    uint64_t in_start, in_end;
+    size_t in_first_sym;        // First symbol of the current input section
+    char pending_out[MAP_NAME_LEN];   // Wrapped output section name
+    bool pending_in;                  // Wrapped input section name
+} map_ctx_t;
+
+// Gives each symbol of the finished input section its size
+static void close_input_section(map_ctx_t *ctx) {
+    map_image_t *img = ctx->img;
+    for (size_t i = ctx->in_first_sym; i < img->num_symbols; i++) {
+        uint64_t next = (i + 1 < img->num_symbols) ? img->symbols[i + 1].addr : ctx->in_end;
+        if (next > ctx->in_end) next = ctx->in_end;
+        img->symbols[i].size = (next > img->symbols[i].addr) ? next - img->symbols[i].addr : 0;
+    }
+    ctx->in_active = false;
+    ctx->in_first_sym = img->num_symbols;
+}
+
+static void open_input_section(map_ctx_t *ctx, uint64_t addr, uint64_t size) {
+    close_input_section(ctx);
+    if (ctx->cur_out < 0) return;
+    ctx->in_active = true;
+    ctx->in_start = addr;
+    ctx->in_end = addr + size;
+}
+
+// "<vma> <size> [load address <lma>]" for an output section
+static map_status_t finish_output_section(map_ctx_t *ctx, const char *name, char *rest) {
+    uint64_t vma, size, lma;
+    if (!parse_hex(next_token(&rest), &vma) || !parse_hex(next_token(&rest), &size)) {
+        ctx->cur_out = -1;
+        return MAP_OK;
+    }
+
+    lma = vma;
+    char *t1 = next_token(&rest);
+    char *t2 = next_token(&rest);
+    if (t1 != NULL && t2 != NULL && strcmp(t1, "load") == 0 && strcmp(t2, "address") == 0) {
+        parse_hex(next_token(&rest), &lma);
+    }
+
+    // Maps do not say which sections are NOBITS; ld prints a "load
+    // address" even for .bss. Go by the conventional names.
+    bool nobits = strncmp(name, ".bss", 4) == 0 || strncmp(name, ".noinit", 7) == 0 ||
+                  strstr(name, "stack") != NULL || strstr(name, "heap") != NULL;
+
+    close_input_section(ctx);
+    ctx->cur_out = add_section(ctx->img, name, vma, lma, size, nobits);
+    return (ctx->cur_out < 0) ? MAP_ERR_NOMEM : MAP_OK;
+}
+
+static map_status_t parse_section_line(map_ctx_t *ctx, char *line) {
+    // Output section: name in column 0
+    if (line[0] == '.') {
+        char *cursor = line;
+        char *name = next_token(&cursor);
+        if (*skip_spaces(cursor) == '\0') {
+            // Name too long: address and size follow on the next line
+            copy_name(ctx->pending_out, name, MAP_NAME_LEN);
+            close_input_section(ctx);
+            ctx->cur_out = -1;
+            return MAP_OK;
+        }
+        char saved[MAP_NAME_LEN];
+        copy_name(saved, name, MAP_NAME_LEN);
+        return finish_output_section(ctx, saved, cursor);
+    }
+
+    // Input section: one space, then the name ("*(...)" patterns and
+    // "*fill*" padding are skipped, padding is already in the sizes)
+    if (line[0] == ' ' && line[1] != ' ' && line[1] != '*' && line[1] != '\0') {
+        char *cursor = line;
+        next_token(&cursor);
+        uint64_t addr, size;
+        if (*skip_spaces(cursor) == '\0') {
+            close_input_section(ctx);
+            ctx->pending_in = true;
+            return MAP_OK;
+        }
+        if (parse_hex(next_token(&cursor), &addr) && parse_hex(next_token(&cursor), &size)) {
+            open_input_section(ctx, addr, size);
+        }
+        return MAP_OK;
+    }
+
+    if (line[0] != ' ') {
+        // LOAD, OUTPUT(...), START GROUP, ...
+        close_input_section(ctx);
+        ctx->cur_out = -1;
+        ctx->pending_out[0] = '\0';
+        return MAP_OK;
+    }
+
+    // Indented line starting with an address
+    char *cursor = line;
+    uint64_t addr, size;
+    if (!parse_hex(next_token(&cursor), &addr)) return MAP_OK;
+
+    if (ctx->pending_out[0] != '\0') {
+        char name[MAP_NAME_LEN];
+        copy_name(name, ctx->pending_out, MAP_NAME_LEN);
+        ctx->pending_out[0] = '\0';
+
+        // Re-assemble "<vma> <size> ..." for the shared parser
+        char buf[LINE_MAX_LEN];
+        snprintf(buf, sizeof(buf), "0x%llx %s", (unsigned long long)addr, cursor);
+        return finish_output_section(ctx, name, buf);
+    }
+
+    char *rest = skip_spaces(cursor);
+    if (ctx->pending_in) {
+        ctx->pending_in = false;
+        if (parse_hex(next_token(&rest), &size)) open_input_section(ctx, addr, size);
+        return MAP_OK;
+    }
+
+    // "<addr>  <symbol>". Skip "(size before relaxing)", script
+    // assignments ("_sdata = .") and PROVIDE(...) lines.
+    if (!ctx->in_active || *rest == '\0' || *rest == '(' || strchr(rest, '=') != NULL ||
+        strncmp(rest, "PROVIDE", 7) == 0 || (rest[0] == '0' && rest[1] == 'x')) {
+        return MAP_OK;
+    }
+    if (addr < ctx->in_start || addr >= ctx->in_end) return MAP_OK;
+
+    size_t len = strlen(rest);
+    while (len > 0 && isspace((unsigned char)rest[len - 1])) len--;
+    return add_symbol(ctx->img, rest, len, addr, 0, (uint32_t)ctx->cur_out) ? MAP_OK : MAP_ERR_NOMEM;
+}
+
+map_status_t map_parse_map_file(map_image_t *img, const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return MAP_ERR_IO;
+
+    enum { PREAMBLE, MEMORY, SECTIONS } state = PREAMBLE;
+    map_ctx_t ctx = { .img = img, .cur_out = -1, .in_first_sym = img->num_symbols };
+    map_status_t status = MAP_OK;
+    bool seen_memory = false;
+    char line[LINE_MAX_LEN];
+
+    while (status == MAP_OK && read_line(f, line, sizeof(line))) {
+        switch (state) {
+            case PREAMBLE:
+                if (strncmp(line, "Memory Configuration", 20) == 0) {
+                    state = MEMORY;
+                    seen_memory = true;
+                }
+                break;
+
+            case MEMORY: {
+                if (strncmp(line, "Linker script and memory map", 28) == 0) {
+                    state = SECTIONS;
+                    break;
+                }
+                char *cursor = line;
+                char *name = next_token(&cursor);
+                uint64_t origin, length;
+                if (name != NULL && parse_hex(next_token(&cursor), &origin) &&
+                    parse_hex(next_token(&cursor), &length)) {
+                    add_region(img, name, origin, length);
+                }
+                break;
+            }
+
+            case SECTIONS:
+                status = parse_section_line(&ctx, line);
+                break;
+        }
+    }
+    close_input_section(&ctx);
+
+    if (ferror(f)) status = MAP_ERR_IO;
+    fclose(f);
+    if (status == MAP_OK && !seen_memory) status = MAP_ERR_FORMAT;
+    return status;
+}
+
+// --- ELF ---
+
+typedef struct {
+    bool is64;
+} elf_t;
+
+static uint16_t rd16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t rd32(const uint8_t *p) { return (uint32_t)rd16(p) | ((uint32_t)rd16(p + 2) << 16); }
+static uint64_t rd64(const uint8_t *p) { return (uint64_t)rd32(p) | ((uint64_t)rd32(p + 4) << 32); }
+
+static uint64_t rd_addr(const elf_t *e, const uint8_t *p) {
+    return e->is64 ? rd64(p) : rd32(p);
+}
+
+static bool read_at(FILE *f, uint64_t offset, void *buf, size_t len) {
+    return fseek(f, (long)offset, SEEK_SET) == 0 && fread(buf, 1, len, f) == len;
+}
+
+// [offset, offset + len) lies inside a file of 'file_size' bytes
+static bool in_file(uint64_t offset, uint64_t len, uint64_t file_size) {
+    return offset <= file_size && len <= file_size - offset;
+}
+
+#define SHT_SYMTAB_   2
+#define SHT_NOBITS_   8
+#define SHF_ALLOC_    0x2
+#define PT_LOAD_      1
+#define STT_SECTION_  3
+#define STT_FILE_     4
+
+map_status_t map_parse_elf(map_image_t *img, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return MAP_ERR_IO;
+
+    map_status_t status = MAP_ERR_FORMAT;
+    uint8_t *shdrs = NULL, *phdrs = NULL, *strtab = NULL;
+    char *shstr = NULL;
+    int32_t *sec_map = NULL;
+    uint8_t *chunk = NULL;
+
+    uint8_t eh[64];
+    if (!read_at(f, 0, eh, 52) || memcmp(eh, "\x7f" "ELF", 4) != 0 || eh[5] != 1 /* LE */) goto done;
+
+    elf_t e = { .is64 = (eh[4] == 2) };
+    if (e.is64 && !read_at(f, 0, eh, 64)) goto done;
+
+    uint64_t phoff = e.is64 ? rd64(eh + 32) : rd32(eh + 28);
+    uint64_t shoff = e.is64 ? rd64(eh + 40) : rd32(eh + 32);
+    uint16_t phentsize = rd16(eh + (e.is64 ? 54 : 42));
+    uint16_t phnum     = rd16(eh + (e.is64 ? 56 : 44));
+    uint16_t shentsize = rd16(eh + (e.is64 ? 58 : 46));
+    uint16_t shnum     = rd16(eh + (e.is64 ? 60 : 48));
+    uint16_t shstrndx  = rd16(eh + (e.is64 ? 62 : 50));
+
+    // Entries are read at fixed field offsets, so they must be at least
+    // the standard size, and every table must lie inside the file.
+    // shnum == 0 with a section table means extended numbering (65280+
+    // sections), which no firmware image needs: rejected like no table.
+    if (fseek(f, 0, SEEK_END) != 0) { status = MAP_ERR_IO; goto done; }
+    long file_len = ftell(f);
+    if (file_len < 0) { status = MAP_ERR_IO; goto done; }
+    uint64_t file_size = (uint64_t)file_len;
+    if (shnum == 0 || shstrndx >= shnum || shentsize < (e.is64 ? 64 : 40)) goto done;
+    if (!in_file(shoff, (uint64_t)shnum * shentsize, file_size)) goto done;
+    if (phnum > 0 && (phentsize < (e.is64 ? 56 : 32) || !in_file(phoff, (uint64_t)phnum * phentsize, file_size))) {
+        goto done;
+    }
+
+    status = MAP_ERR_NOMEM;
+    shdrs = malloc((size_t)shnum * shentsize);
+    phdrs = malloc((size_t)phnum * phentsize + 1);
+    sec_map = malloc(shnum * sizeof(int32_t));
+    if (shdrs == NULL || phdrs == NULL || sec_map == NULL) goto done;
+
+    status = MAP_ERR_IO;
+    if (!read_at(f, shoff, shdrs, (size_t)shnum * shentsize)) goto done;
+    if (phnum > 0 && !read_at(f, phoff, phdrs, (size_t)phnum * phentsize)) goto done;
+
+    // Section header field offsets (32-bit / 64-bit)
+    #define SH(i)          (shdrs + (size_t)(i) * shentsize)
+    #define SH_NAME(p)     rd32(p)
+    #define SH_TYPE(p)     rd32((p) + 4)
+    #define SH_FLAGS(p)    (e.is64 ? rd64((p) + 8) : rd32((p) + 8))
+    #define SH_ADDR(p)     rd_addr(&e, (p) + (e.is64 ? 16 : 12))
+    #define SH_OFFSET(p)   rd_addr(&e, (p) + (e.is64 ? 24 : 16))
+    #define SH_SIZE(p)     rd_addr(&e, (p) + (e.is64 ? 32 : 20))
+    #define SH_LINK(p)     rd32((p) + (e.is64 ? 40 : 24))
+    #define SH_ENTSIZE(p)  rd_addr(&e, (p) + (e.is64 ? 56 : 36))
+
+    uint64_t shstr_size = SH_SIZE(SH(shstrndx));
+    if (!in_file(SH_OFFSET(SH(shstrndx)), shstr_size, file_size)) { status = MAP_ERR_FORMAT; goto done; }
+    shstr = malloc(shstr_size + 1);
+    if (shstr == NULL) { status = MAP_ERR_NOMEM; goto done; }
+    if (!read_at(f, SH_OFFSET(SH(shstrndx)), shstr, shstr_size)) goto done;
+    shstr[shstr_size] = '\0';
+
+    // Allocated sections become output sections; LMA comes from the
+    // PT_LOAD segment that holds the section
+    int symtab = -1;
+    for (uint16_t i = 0; i < shnum; i++) {
+        const uint8_t *sh = SH(i);
+        sec_map[i] = -1;
+        if (SH_TYPE(sh) == SHT_SYMTAB_) symtab = i;
+        if ((SH_FLAGS(sh) & SHF_ALLOC_) == 0 || SH_SIZE(sh) == 0) continue;
+
+        uint64_t vma = SH_ADDR(sh), lma = vma;
+        for (uint16_t p = 0; p < phnum; p++) {
+            const uint8_t *ph = phdrs + (size_t)p * phentsize;
+            if (rd32(ph) != PT_LOAD_) continue;
+            uint64_t vaddr = rd_addr(&e, ph + (e.is64 ? 16 : 8));
+            uint64_t paddr = rd_addr(&e, ph + (e.is64 ? 24 : 12));
+            uint64_t memsz = rd_addr(&e, ph + (e.is64 ? 40 : 20));
+            if (vma >= vaddr && vma < vaddr + memsz) {
+                lma = paddr + (vma - vaddr);
+                break;
+            }
+        }
+
+        uint32_t name_off = SH_NAME(sh);
+        const char *name = (name_off < shstr_size) ? shstr + name_off : "?";
+        sec_map[i] = add_section(img, name, vma, lma, SH_SIZE(sh), SH_TYPE(sh) == SHT_NOBITS_);
+        if (sec_map[i] < 0) { status = MAP_ERR_NOMEM; goto done; }
+    }
+
+    if (symtab >= 0) {
+        const uint8_t *sh = SH(symtab);
+        uint32_t strndx = SH_LINK(sh);
+        uint64_t entsize = SH_ENTSIZE(sh);
+        if (strndx >= shnum || entsize < (e.is64 ? 24u : 16u) ||
+            !in_file(SH_OFFSET(sh), SH_SIZE(sh), file_size) ||
+            !in_file(SH_OFFSET(SH(strndx)), SH_SIZE(SH(strndx)), file_size)) {
+            status = MAP_ERR_FORMAT;
+            goto done;
+        }
+
+        uint64_t str_size = SH_SIZE(SH(strndx));
+        strtab = malloc(str_size + 1);
+        chunk = malloc(ELF_SYM_CHUNK * entsize);
+        if (strtab == NULL || chunk == NULL) { status = MAP_ERR_NOMEM; goto done; }
+        if (!read_at(f, SH_OFFSET(SH(strndx)), strtab, str_size)) goto done;
+        strtab[str_size] = '\0';
+
+        // Stream the symbol table in fixed-size chunks
+        uint64_t count = SH_SIZE(sh) / entsize;
+        uint64_t offset = SH_OFFSET(sh);
+        for (uint64_t base = 0; base < count; base += ELF_SYM_CHUNK) {
+            uint64_t n = (count - base < ELF_SYM_CHUNK) ? count - base : ELF_SYM_CHUNK;
+            if (!read_at(f, offset + base * entsize, chunk, n * entsize)) goto done;
+
+            for (uint64_t k = 0; k < n; k++) {
+                const uint8_t *s = chunk + k * entsize;
+                uint32_t name = rd32(s);
+                uint8_t info  = e.is64 ? s[4] : s[12];
+                uint16_t ndx  = rd16(s + (e.is64 ? 6 : 14));
+                uint64_t addr = e.is64 ? rd64(s + 8) : rd32(s + 4);
+                uint64_t size = e.is64 ? rd64(s + 16) : rd32(s + 8);
+                uint8_t type = info & 0xF;
+
+                if (size == 0 || type == STT_SECTION_ || type == STT_FILE_) continue;
+                if (ndx >= shnum || sec_map[ndx] < 0 || name >= str_size) continue;
+
+                const char *sym_name = (const char *)strtab + name;
+                if (!add_symbol(img, sym_name, strlen(sym_name), addr, size, (uint32_t)sec_map[ndx])) {
+                    status = MAP_ERR_NOMEM;
+                    goto done;
+                }
+            }
+        }
+    }
+    status = MAP_OK;
+
+done:
+    free(shdrs);
+    free(phdrs);
+    free(shstr);
+    free(sec_map);
+    free(strtab);
+    free(chunk);
+    fclose(f);
+    return status;
+}
+
+// --- Linker Script MEMORY Block ---
+
+// Parses "0x20000000", "20K", "128K", "1M"
+static uint64_t parse_size(const char *p) {
+    char *end;
+    uint64_t v = strtoull(p, &end, 0);
+    if (*end == 'K' || *end == 'k') v *= 1024;
+    else if (*end == 'M' || *end == 'm') v *= 1024 * 1024;
+    return v;
+}
+
+map_status_t map_parse_linker_script(map_image_t *img, const char *path) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) return MAP_ERR_IO;
+
+    bool in_comment = false, in_memory = false, seen_memory = false;
+    char line[LINE_MAX_LEN];
+
+    while (read_line(f, line, sizeof(line))) {
+        // Blank out /* ... */ comments, which may span lines
+        for (char *p = line; *p != '\0'; p++) {
+            if (!in_comment && p[0] == '/' && p[1] == '*') {
+                in_comment = true;
+                *p++ = ' ';
+                *p = ' ';
+            } else if (in_comment && p[0] == '*' && p[1] == '/') {
+                in_comment = false;
+                *p++ = ' ';
+                *p = ' ';
+            } else if (in_comment) {
+                *p = ' ';
+            }
+        }
+
+        char *p = skip_spaces(line);
+        if (!in_memory) {
+            if (strncmp(p, "MEMORY", 6) == 0) {
+                in_memory = true;
+                seen_memory = true;
+            }
+            continue;
+        }
+        if (strchr(p, '}') != NULL) break;
+
+        // NAME (attrs) : ORIGIN = <origin>, LENGTH = <length>
+        char *colon = strchr(p, ':');
+        char *eq1 = colon ? strchr(colon, '=') : NULL;
+        char *eq2 = eq1 ? strchr(eq1 + 1, '=') : NULL;
+        if (eq2 == NULL) continue;
+
+        char name[MAP_NAME_LEN];
+        size_t n = strcspn(p, " \t(:");
+        if (n >= MAP_NAME_LEN) n = MAP_NAME_LEN - 1;
+        memcpy(name, p, n);
+        name[n] = '\0';
+
+        add_region(img, name, parse_size(skip_spaces(eq1 + 1)), parse_size(skip_spaces(eq2 + 1)));
+    }
+
+    fclose(f);
+    return seen_memory ? MAP_OK : MAP_ERR_FORMAT;
+}
+
+// --- Format Detection ---
+
+map_status_t map_load(map_image_t *img, const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) return MAP_ERR_IO;
+    uint8_t magic[4] = {0};
+    size_t got = fread(magic, 1, sizeof(magic), f);
+    fclose(f);
+
+    if (got == 4 && memcmp(magic, "\x7f" "ELF", 4) == 0) return map_parse_elf(img, path);
+
+    const char *dot = strrchr(path, '.');
+    if (dot != NULL && (strcmp(dot, ".ld") == 0 || strcmp(dot, ".lds") == 0)) {
+        return map_parse_linker_script(img, path);
+    }
+    return map_parse_map_file(img, path);
+}
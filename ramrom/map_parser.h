@@ -0,0 +1,101 @@
+#ifndef MAP_PARSER_H
+#define MAP_PARSER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Memory Map Parser (host tool library)
+ *
+ * Reads what the linker tells us about a build:
+ *   - GNU ld map files (-Wl,-Map,output.map): MEMORY regions, output
+ *     sections with VMA / LMA / size, and the symbols inside them
+ *   - ELF files: allocated sections and the symbol table (with sizes)
+ *   - Linker scripts: just the MEMORY { ... } block
+ *
+ * Files are read line by line (maps) or in fixed-size chunks (ELF
+ * symbol tables), never loaded whole, so a 100k-symbol map costs one
+ * pass and only the parsed records stay in memory.
+ *
+ * Map files list symbol addresses but not sizes. A symbol's size is
+ * taken as the distance to the next symbol in the same input section
+ * (or to the end of that input section).
+ */
+
+#define MAP_MAX_REGIONS   16
+#define MAP_NAME_LEN      48
+
+typedef struct {
+    char name[MAP_NAME_LEN];
+    uint64_t origin;
+    uint64_t length;
+} mem_region_t;
+
+typedef struct {
+    char name[MAP_NAME_LEN];
+    uint64_t vma;               // Run address
+    uint64_t lma;               // Load address (== vma unless "AT >")
+    uint64_t size;
+    bool nobits;                // Takes no space in the load image (.bss)
+} out_section_t;
+
+typedef struct {
+    uint64_t addr;
+    uint64_t size;
+    uint32_t name;              // Offset into map_image_t.names
+    uint32_t section;           // Index into map_image_t.sections
+} map_symbol_t;
+
+typedef struct {
+    mem_region_t regions[MAP_MAX_REGIONS];
+    int num_regions;
+
+    out_section_t *sections;
+    uint32_t num_sections;
+    uint32_t sections_cap;
+
+    map_symbol_t *symbols;
+    size_t num_symbols;
+    size_t symbols_cap;
+
+    char *names;                // All symbol names, NUL separated
+    size_t names_len;
+    size_t names_cap;
+} map_image_t;
+
+typedef enum {
+    MAP_OK,
+    MAP_ERR_IO,                 // Cannot open / read the file
+    MAP_ERR_FORMAT,             // Not a map / ELF file we understand
+    MAP_ERR_NOMEM
+} map_status_t;
+
+void map_image_init(map_image_t *img);
+void map_image_free(map_image_t *img);
+
+/**
+ * @brief Parses a file, picking the format from its contents: ELF magic,
+ *        a GNU ld map ("Memory Configuration"), else a linker script.
+ */
+map_status_t map_load(map_image_t *img, const char *path);
+
+map_status_t map_parse_map_file(map_image_t *img, const char *path);
+map_status_t map_parse_elf(map_image_t *img, const char *path);
+
+/**
+ * @brief Reads the MEMORY block of a linker script. Regions with the same
+ *        name as ones already in 'img' replace them.
+ */
+map_status_t map_parse_linker_script(map_image_t *img, const char *path);
+
+static inline const char *map_symbol_name(const map_image_t *img, const map_symbol_t *sym) {
+    return img->names + sym->name;
+}
+
+// Region that contains 'addr', or -1 (e.g. debug sections at address 0)
+int map_find_region(const map_image_t *img, uint64_t addr);
+
+const char *map_status_str(map_status_t status);
+
+#endif // MAP_PARSER_H
@@ -0,0 +1,361 @@
+/*
+Static Memory Budget Analyzer (host tool)
+
+Answers "how full is RAM / FLASH, and what is using it?" from the files
+the linker already produces, instead of adding up sections by hand.
+
+Usage:
+  mapbudget [options] BUILD [BASELINE]
+
+  BUILD, BASELINE   GNU ld map file (-Wl,-Map,...) or ELF file
+  --ld FILE         Take MEMORY regions from a linker script (needed for
+                    ELF input, overrides the regions listed in a map)
+  --top N           Symbols to list (default 10)
+  --limit R=PCT     Fail if region R is more than PCT percent full
+  --max-growth R=N  Fail if region R grew by more than N bytes (K/M ok)
+                    compared to BASELINE
+
+Exit code: 0 = within budget, 1 = budget exceeded, 2 = usage / input error
+
+Examples:
+  mapbudget --ld ../linkers/linker.ld output.map
+  mapbudget --limit RAM=90 --max-growth RAM=512 new.map old.map
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "map_parser.h"
+#include "mapbudget.h"
+
+#define MAX_RULES 16
+
+typedef struct {
+    char region[MAP_NAME_LEN];
+    uint64_t value;             // Percent for limits, bytes for growth
+} budget_rule_t;
+
+typedef struct {
+    uint64_t used[MAP_MAX_REGIONS];
+} region_usage_t;
+
+// --- Region Accounting ---
+
+// A section counts against the region it runs in (VMA) and, if it is
+// copied from somewhere else at boot (.data: "> RAM AT > FLASH"), also
+// against the region holding its load image (LMA).
+static void compute_usage(const map_image_t *img, region_usage_t *u) {
+    memset(u, 0, sizeof(*u));
+    for (uint32_t i = 0; i < img->num_sections; i++) {
+        const out_section_t *s = &img->sections[i];
+        if (s->size == 0) continue;
+
+        int run = map_find_region(img, s->vma);
+        if (run >= 0) u->used[run] += s->size;
+
+        if (!s->nobits && s->lma != s->vma) {
+            int load = map_find_region(img, s->lma);
+            if (load >= 0 && load != run) u->used[load] += s->size;
+        }
+    }
+}
+
+static int find_region_by_name(const map_image_t *img, const char *name) {
+    for (int i = 0; i < img->num_regions; i++) {
+        if (strcmp(img->regions[i].name, name) == 0) return i;
+    }
+    return -1;
+}
+
+// --- Symbol Totals by Name (open addressing hash table) ---
+
+typedef struct {
+    const char *name;
+    uint64_t size;
+    uint32_t section;
+    uint32_t hash;
+} name_entry_t;
+
+typedef struct {
+    name_entry_t *slots;
+    size_t mask;
+    size_t count;
+} name_table_t;
+
+static uint32_t fnv1a(const char *s) {
+    uint32_t h = 2166136261u;
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static name_entry_t *table_find(name_table_t *t, const char *name, uint32_t hash, bool insert) {
+    for (size_t i = hash & t->mask;; i = (i + 1) & t->mask) {
+        name_entry_t *e = &t->slots[i];
+        if (e->name == NULL) {
+            if (!insert) return NULL;
+            e->name = name;
+            e->hash = hash;
+            t->count++;
+            return e;
+        }
+        if (e->hash == hash && strcmp(e->name, name) == 0) return e;
+    }
+}
+
+// Same-named statics from different files are merged: that is also how
+// they are matched between two builds
+static bool build_table(const map_image_t *img, name_table_t *t) {
+    size_t cap = 16;
+    while (cap < img->num_symbols * 2) cap *= 2;
+    t->slots = calloc(cap, sizeof(name_entry_t));
+    t->mask = cap - 1;
+    t->count = 0;
+    if (t->slots == NULL) return false;
+
+    for (size_t i = 0; i < img->num_symbols; i++) {
+        const map_symbol_t *sym = &img->symbols[i];
+        const char *name = map_symbol_name(img, sym);
+        name_entry_t *e = table_find(t, name, fnv1a(name), true);
+        e->size += sym->size;
+        e->section = sym->section;
+    }
+    return true;
+}
+
+// --- Reports ---
+
+static void print_regions(const map_image_t *img, const region_usage_t *u, const region_usage_t *base) {
+    printf("%-12s %12s %12s %8s", "Region", "Used", "Size", "Use%");
+    if (base != NULL) printf(" %10s", "Delta");
+    printf("\n");
+
+    for (int r = 0; r < img->num_regions; r++) {
+        const mem_region_t *reg = &img->regions[r];
+        double pct = reg->length ? 100.0 * (double)u->used[r] / (double)reg->length : 0.0;
+        printf("%-12s %12" PRIu64 " %12" PRIu64 " %7.2f%%", reg->name, u->used[r], reg->length, pct);
+        if (base != NULL) printf(" %+10" PRId64, (int64_t)(u->used[r] - base->used[r]));
+        printf("\n");
+
+        for (uint32_t i = 0; i < img->num_sections; i++) {
+            const out_section_t *s = &img->sections[i];
+            if (s->size == 0) continue;
+            bool runs_here = map_find_region(img, s->vma) == r;
+            bool loads_here = !s->nobits && s->lma != s->vma && map_find_region(img, s->lma) == r;
+            if (runs_here || loads_here) {
+                printf("  %-22s 0x%08" PRIx64 " %10" PRIu64 "%s\n", s->name,
+                       runs_here ? s->vma : s->lma, s->size, runs_here ? "" : "  (load image)");
+            }
+        }
+    }
+}
+
+static const map_image_t *sort_img;
+
+static int by_size_desc(const void *a, const void *b) {
+    uint64_t x = sort_img->symbols[*(const size_t *)a].size;
+    uint64_t y = sort_img->symbols[*(const size_t *)b].size;
+    return (x < y) - (x > y);
+}
+
+static void print_top_symbols(const map_image_t *img, size_t top) {
+    size_t *idx = malloc(img->num_symbols * sizeof(size_t));
+    if (idx == NULL) return;
+    for (size_t i = 0; i < img->num_symbols; i++) idx[i] = i;
+    sort_img = img;
+    qsort(idx, img->num_symbols, sizeof(size_t), by_size_desc);
+
+    printf("\nLargest symbols (%zu total):\n", img->num_symbols);
+    for (size_t k = 0; k < top && k < img->num_symbols; k++) {
+        const map_symbol_t *sym = &img->symbols[idx[k]];
+        printf("  0x%08" PRIx64 " %8" PRIu64 "  %-14s %s\n", sym->addr, sym->size,
+               img->sections[sym->section].name, map_symbol_name(img, sym));
+    }
+    free(idx);
+}
+
+typedef struct {
+    const char *name;
+    int64_t delta;
+    uint64_t now;
+} sym_delta_t;
+
+static int by_abs_delta(const void *a, const void *b) {
+    int64_t x = ((const sym_delta_t *)a)->delta, y = ((const sym_delta_t *)b)->delta;
+    if (x < 0) x = -x;
+    if (y < 0) y = -y;
+    return (x < y) - (x > y);
+}
+
+static void print_symbol_diff(const map_image_t *cur, const map_image_t *base, size_t top) {
+    name_table_t tc, tb;
+    if (!build_table(cur, &tc) || !build_table(base, &tb)) {
+        free(tc.slots);
+        return;
+    }
+
+    sym_delta_t *d = malloc((tc.count + tb.count + 1) * sizeof(sym_delta_t));
+    size_t n = 0;
+    for (size_t i = 0; d != NULL && i <= tc.mask; i++) {
+        const name_entry_t *e = &tc.slots[i];
+        if (e->name == NULL) continue;
+        const name_entry_t *old = table_find(&tb, e->name, e->hash, false);
+        int64_t delta = (int64_t)e->size - (int64_t)(old ? old->size : 0);
+        if (delta != 0) d[n++] = (sym_delta_t){ e->name, delta, e->size };
+    }
+    for (size_t i = 0; d != NULL && i <= tb.mask; i++) {
+        const name_entry_t *e = &tb.slots[i];
+        if (e->name == NULL || table_find(&tc, e->name, e->hash, false) != NULL) continue;
+        d[n++] = (sym_delta_t){ e->name, -(int64_t)e->size, 0 };
+    }
+
+    if (d != NULL) {
+        qsort(d, n, sizeof(sym_delta_t), by_abs_delta);
+        printf("\nSymbol changes vs baseline (%zu changed):\n", n);
+        for (size_t k = 0; k < top && k < n; k++) {
+            const char *tag = (d[k].now == 0) ? "removed" : (d[k].now == (uint64_t)d[k].delta) ? "added" : "";
+            printf("  %+8" PRId64 " %8" PRIu64 "  %-8s %s\n", d[k].delta, d[k].now, tag, d[k].name);
+        }
+    }
+    free(d);
+    free(tc.slots);
+    free(tb.slots);
+}
+
+// --- Command Line ---
+
+static bool parse_rule(const char *arg, budget_rule_t *rule) {
+    const char *eq = strchr(arg, '=');
+    if (eq == NULL || eq == arg || (size_t)(eq - arg) >= MAP_NAME_LEN) return false;
+
+    memcpy(rule->region, arg, (size_t)(eq - arg));
+    rule->region[eq - arg] = '\0';
+
+    char *end;
+    rule->value = strtoull(eq + 1, &end, 0);
+    if (*end == 'K' || *end == 'k') rule->value *= 1024;
+    else if (*end == 'M' || *end == 'm') rule->value *= 1024 * 1024;
+    return end != eq + 1;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: mapbudget [--ld script] [--top N] [--limit REGION=PCT]...\n"
+                    "                 [--max-growth REGION=BYTES]... BUILD [BASELINE]\n");
+}
+
+static bool load(map_image_t *img, const char *path, const char *ld_script) {
+    map_status_t st = map_load(img, path);
+    if (st == MAP_OK && ld_script != NULL) {
+        path = ld_script;
+        st = map_parse_linker_script(img, ld_script);
+    }
+    if (st != MAP_OK) {
+        fprintf(stderr, "mapbudget: %s: %s\n", path, map_status_str(st));
+        return false;
+    }
+    return true;
+}
+
+int mapbudget_main(int argc, char **argv) {
+    const char *ld_script = NULL, *build = NULL, *baseline = NULL;
+    size_t top = 10;
+    budget_rule_t limits[MAX_RULES], growth[MAX_RULES];
+    int num_limits = 0, num_growth = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ld") == 0 && i + 1 < argc) {
+            ld_script = argv[++i];
+        } else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+            top = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--limit") == 0 && i + 1 < argc && num_limits < MAX_RULES) {
+            if (!parse_rule(argv[++i], &limits[num_limits++])) { usage(); return 2; }
+        } else if (strcmp(argv[i], "--max-growth") == 0 && i + 1 < argc && num_growth < MAX_RULES) {
+            if (!parse_rule(argv[++i], &growth[num_growth++])) { usage(); return 2; }
+        } else if (argv[i][0] == '-') {
+            usage();
+            return 2;
+        } else if (build == NULL) {
+            build = argv[i];
+        } else if (baseline == NULL) {
+            baseline = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (build == NULL || (num_growth > 0 && baseline == NULL)) {
+        usage();
+        return 2;
+    }
+
+    map_image_t cur, base;
+    map_image_init(&cur);
+    map_image_init(&base);
+    if (!load(&cur, build, ld_script) || (baseline != NULL && !load(&base, baseline, ld_script))) {
+        map_image_free(&cur);
+        map_image_free(&base);
+        return 2;
+    }
+
+    region_usage_t u_cur, u_base;
+    compute_usage(&cur, &u_cur);
+    if (baseline != NULL) {
+        // Match baseline regions to the current build by name
+        region_usage_t raw;
+        compute_usage(&base, &raw);
+        memset(&u_base, 0, sizeof(u_base));
+        for (int r = 0; r < cur.num_regions; r++) {
+            int b = find_region_by_name(&base, cur.regions[r].name);
+            if (b >= 0) u_base.used[r] = raw.used[b];
+        }
+    }
+
+    printf("=== %s%s%s ===\n", build, baseline ? " vs " : "", baseline ? baseline : "");
+    if (cur.num_regions == 0) printf("(no MEMORY regions: pass --ld <linker script>)\n");
+    print_regions(&cur, &u_cur, baseline ? &u_base : NULL);
+    print_top_symbols(&cur, top);
+    if (baseline != NULL) print_symbol_diff(&cur, &base, top);
+
+    // Budget checks
+    int failures = 0;
+    for (int i = 0; i < num_limits; i++) {
+        int r = find_region_by_name(&cur, limits[i].region);
+        if (r < 0) {
+            printf("BUDGET: unknown region %s\n", limits[i].region);
+            failures++;
+            continue;
+        }
+        double pct = 100.0 * (double)u_cur.used[r] / (double)cur.regions[r].length;
+        if (pct > (double)limits[i].value) {
+            printf("BUDGET FAIL: %s is %.2f%% full (limit %" PRIu64 "%%)\n", limits[i].region, pct, limits[i].value);
+            failures++;
+        }
+    }
+    for (int i = 0; i < num_growth; i++) {
+        int r = find_region_by_name(&cur, growth[i].region);
+        if (r < 0) {
+            printf("BUDGET: unknown region %s\n", growth[i].region);
+            failures++;
+            continue;
+        }
+        int64_t delta = (int64_t)(u_cur.used[r] - u_base.used[r]);
+        if (delta > (int64_t)growth[i].value) {
+            printf("BUDGET FAIL: %s grew by %" PRId64 " bytes (limit %" PRIu64 ")\n", growth[i].region, delta, growth[i].value);
+            failures++;
+        }
+    }
+    if (num_limits + num_growth > 0 && failures == 0) printf("\nBUDGET OK\n");
+
+    map_image_free(&cur);
+    map_image_free(&base);
+    return failures ? 1 : 0;
+}
+
+#ifndef MAPBUDGET_NO_MAIN
+int main(int argc, char **argv) {
+    return mapbudget_main(argc, argv);
+}
+#endif
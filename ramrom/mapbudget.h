@@ -0,0 +1,12 @@
+#ifndef MAPBUDGET_H
+#define MAPBUDGET_H
+
+/**
+ * @brief The whole mapbudget command line tool (see mapbudget.c for the
+ *        options). Build mapbudget.c with -DMAPBUDGET_NO_MAIN to call it
+ *        from another program.
+ * @return 0 = within budget, 1 = budget exceeded, 2 = usage / input error
+ */
+int mapbudget_main(int argc, char **argv);
+
+#endif // MAPBUDGET_H
@@ -0,0 +1,386 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "map_parser.h"
+#include "mapbudget.h"
+
+// --- Test Harness ---
+
+static int total_failures = 0;
+
+void run_test(int num, const char* desc, bool passed) {
+    if (passed) {
+        printf("[PASS] Test %d: %s\n", num, desc);
+    } else {
+        printf("[FAIL] Test %d: %s\n", num, desc);
+        total_failures++;
+    }
+}
+
+// --- Fixtures ---
+
+// Same layout ld prints: long section names wrap, their address and size
+// follow on the next line
+static const char build_map[] =
+    "Memory Configuration\n\n"
+    "Name             Origin             Length             Attributes\n"
+    "FLASH            0x0000000008000000 0x0000000000020000 xr\n"
+    "RAM              0x0000000020000000 0x0000000000005000 xrw\n"
+    "*default*        0x0000000000000000 0xffffffffffffffff\n\n"
+    "Linker script and memory map\n\n"
+    ".text           0x0000000008000000      0x100\n"
+    " *(.text)\n"
+    " .text          0x0000000008000000       0x80 main.o\n"
+    "                0x0000000008000000                main\n"
+    "                0x0000000008000040                helper\n"
+    " .text.a_very_long_function_name_that_wraps\n"
+    "                0x0000000008000080       0x80 main.o\n"
+    "                0x0000000008000080                a_very_long_function_name_that_wraps\n\n"
+    ".rodata.with_a_long_output_name\n"
+    "                0x0000000008000100       0x10\n"
+    " .rodata        0x0000000008000100       0x10 main.o\n"
+    "                0x0000000008000100                table\n\n"
+    ".data           0x0000000020000000        0x8 load address 0x0000000008000110\n"
+    " .data          0x0000000020000000        0x8 main.o\n"
+    "                0x0000000020000000                counter\n"
+    "                0x0000000020000004                mode\n\n"
+    ".bss            0x0000000020000008       0x20 load address 0x0000000008000118\n"
+    " .bss           0x0000000020000008       0x20 main.o\n"
+    "                0x0000000020000008                rx_buf\n"
+    "OUTPUT(output.elf elf32-littlearm)\n";
+
+// The previous build: no 'mode', a smaller rx_buf
+static const char baseline_map[] =
+    "Memory Configuration\n\n"
+    "Name             Origin             Length             Attributes\n"
+    "FLASH            0x0000000008000000 0x0000000000020000 xr\n"
+    "RAM              0x0000000020000000 0x0000000000005000 xrw\n\n"
+    "Linker script and memory map\n\n"
+    ".text           0x0000000008000000      0x100\n"
+    " .text          0x0000000008000000      0x100 main.o\n"
+    "                0x0000000008000000                main\n"
+    ".data           0x0000000020000000        0x4 load address 0x0000000008000100\n"
+    " .data          0x0000000020000000        0x4 main.o\n"
+    "                0x0000000020000000                counter\n"
+    ".bss            0x0000000020000004       0x10 load address 0x0000000008000104\n"
+    " .bss           0x0000000020000004       0x10 main.o\n"
+    "                0x0000000020000004                rx_buf\n";
+
+static void wr16(uint8_t *p, uint32_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static void wr32(uint8_t *p, uint32_t v) { wr16(p, v & 0xFFFF); wr16(p + 2, v >> 16); }
+
+#define ELF_PH   52
+#define ELF_SYM  116
+#define ELF_STR  212
+#define ELF_SHS  240
+#define ELF_SH   288
+#define ELF_SIZE (ELF_SH + 7 * 40)
+
+static void elf_section(uint8_t *elf, int i, uint32_t name, uint32_t type, uint32_t flags, uint32_t addr,
+                        uint32_t offset, uint32_t size, uint32_t link, uint32_t entsize) {
+    uint8_t *sh = elf + ELF_SH + i * 40;
+    wr32(sh, name);
+    wr32(sh + 4, type);
+    wr32(sh + 8, flags);
+    wr32(sh + 12, addr);
+    wr32(sh + 16, offset);
+    wr32(sh + 20, size);
+    wr32(sh + 24, link);
+    wr32(sh + 36, entsize);
+}
+
+static void elf_symbol(uint8_t *elf, int i, uint32_t name, uint32_t value, uint32_t size, uint8_t info, uint16_t shndx) {
+    uint8_t *s = elf + ELF_SYM + i * 16;
+    wr32(s, name);
+    wr32(s + 4, value);
+    wr32(s + 8, size);
+    s[12] = info;
+    wr16(s + 14, shndx);
+}
+
+// ELF32 as arm-none-eabi-ld would link it against generic.ld: .text and
+// .data's load image in FLASH, .data and .bss (NOBITS) in RAM
+static void build_elf(uint8_t *elf) {
+    memset(elf, 0, ELF_SIZE);
+    memcpy(elf, "\x7f" "ELF", 4);
+    elf[4] = 1;                                 // ELFCLASS32
+    elf[5] = 1;                                 // Little endian
+    wr32(elf + 28, ELF_PH);
+    wr32(elf + 32, ELF_SH);
+    wr16(elf + 42, 32);
+    wr16(elf + 44, 2);
+    wr16(elf + 46, 40);
+    wr16(elf + 48, 7);
+    wr16(elf + 50, 6);
+
+    // PT_LOAD for .text, and for .data/.bss with .data loaded from FLASH
+    uint8_t *ph = elf + ELF_PH;
+    wr32(ph, 1);
+    wr32(ph + 8, 0x08000000);
+    wr32(ph + 12, 0x08000000);
+    wr32(ph + 20, 0x20);
+    ph += 32;
+    wr32(ph, 1);
+    wr32(ph + 8, 0x20000000);
+    wr32(ph + 12, 0x08000020);
+    wr32(ph + 20, 0x14);
+
+    static const char strtab[] = "\0foo\0counter\0buf\0marker\0x.c";
+    static const char shstrtab[] = "\0.text\0.data\0.bss\0.symtab\0.strtab\0.shstrtab";
+    memcpy(elf + ELF_STR, strtab, sizeof(strtab));
+    memcpy(elf + ELF_SHS, shstrtab, sizeof(shstrtab));
+
+    elf_section(elf, 1, 1, 1, 0x6, 0x08000000, 0, 0x20, 0, 0);            // .text
+    elf_section(elf, 2, 7, 1, 0x3, 0x20000000, 0, 0x4, 0, 0);             // .data
+    elf_section(elf, 3, 13, 8, 0x3, 0x20000004, 0, 0x10, 0, 0);           // .bss
+    elf_section(elf, 4, 18, 2, 0, 0, ELF_SYM, 6 * 16, 5, 16);             // .symtab
+    elf_section(elf, 5, 26, 3, 0, 0, ELF_STR, sizeof(strtab), 0, 0);      // .strtab
+    elf_section(elf, 6, 34, 3, 0, 0, ELF_SHS, sizeof(shstrtab), 0, 0);    // .shstrtab
+
+    elf_symbol(elf, 1, 1, 0x08000000, 0x20, 0x12, 1);     // foo: FUNC
+    elf_symbol(elf, 2, 5, 0x20000000, 4, 0x11, 2);        // counter: OBJECT
+    elf_symbol(elf, 3, 13, 0x20000004, 16, 0x11, 3);      // buf: OBJECT
+    elf_symbol(elf, 4, 17, 0x08000010, 0, 0x00, 1);       // marker: no size, skipped
+    elf_symbol(elf, 5, 24, 0, 1, 0x04, 1);                // x.c: STT_FILE, skipped
+}
+
+static bool write_file(const char *path, const void *data, size_t len) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) return false;
+    bool ok = fwrite(data, 1, len, f) == len;
+    return fclose(f) == 0 && ok;
+}
+
+static void make_temp(char *path) {
+    int fd = mkstemp(path);
+    if (fd >= 0) close(fd);
+}
+
+// --- Lookups ---
+
+static const out_section_t *find_section(const map_image_t *img, const char *name) {
+    for (uint32_t i = 0; i < img->num_sections; i++) {
+        if (strcmp(img->sections[i].name, name) == 0) return &img->sections[i];
+    }
+    return NULL;
+}
+
+static uint64_t symbol_size(const map_image_t *img, const char *name) {
+    for (size_t i = 0; i < img->num_symbols; i++) {
+        if (strcmp(map_symbol_name(img, &img->symbols[i]), name) == 0) return img->symbols[i].size;
+    }
+    return UINT64_MAX;
+}
+
+// --- mapbudget runs ---
+
+static char out_path[] = "/tmp/maptest_out_XXXXXX";
+static char tool_output[8192];
+
+// Runs the tool with stdout and stderr captured into tool_output
+static int run_tool(int argc, char **argv) {
+    fflush(stdout);
+    fflush(stderr);
+    int saved_out = dup(1), saved_err = dup(2);
+    FILE *f = fopen(out_path, "w");
+    dup2(fileno(f), 1);
+    dup2(fileno(f), 2);
+
+    int rc = mapbudget_main(argc, argv);
+
+    fflush(stdout);
+    fflush(stderr);
+    dup2(saved_out, 1);
+    dup2(saved_err, 2);
+    close(saved_out);
+    close(saved_err);
+    fclose(f);
+
+    f = fopen(out_path, "r");
+    size_t n = fread(tool_output, 1, sizeof(tool_output) - 1, f);
+    tool_output[n] = '\0';
+    fclose(f);
+    return rc;
+}
+
+// True if some output line starts with 'prefix' and contains 'text'
+static bool output_line(const char *prefix, const char *text) {
+    for (const char *line = tool_output; *line != '\0';) {
+        const char *end = strchr(line, '\n');
+        size_t len = end ? (size_t)(end - line) : strlen(line);
+        char buf[256];
+        if (len >= sizeof(buf)) len = sizeof(buf) - 1;
+        memcpy(buf, line, len);
+        buf[len] = '\0';
+        if (strncmp(buf, prefix, strlen(prefix)) == 0 && strstr(buf, text) != NULL) return true;
+        if (end == NULL) break;
+        line = end + 1;
+    }
+    return false;
+}
+
+// --- Main Test Suite ---
+
+int main() {
+    char build_path[] = "/tmp/maptest_build_XXXXXX";
+    char base_path[] = "/tmp/maptest_base_XXXXXX";
+    char elf_path[] = "/tmp/maptest_elf_XXXXXX";
+    make_temp(build_path);
+    make_temp(base_path);
+    make_temp(elf_path);
+    make_temp(out_path);
+
+    static uint8_t elf[ELF_SIZE];
+    build_elf(elf);
+    bool written = write_file(build_path, build_map, sizeof(build_map) - 1) &&
+                   write_file(base_path, baseline_map, sizeof(baseline_map) - 1) &&
+                   write_file(elf_path, elf, sizeof(elf));
+    if (!written) {
+        printf("Cannot write test fixtures to /tmp\n");
+        return 1;
+    }
+
+    printf("--- Starting Map Parser / mapbudget Test Suite ---\n");
+
+    // Test 1: MEMORY regions from the map, *default* left out
+    map_image_t img;
+    map_image_init(&img);
+    map_status_t st = map_parse_map_file(&img, build_path);
+    run_test(1, "Map regions parsed, *default* skipped",
+             st == MAP_OK && img.num_regions == 2 &&
+             strcmp(img.regions[0].name, "FLASH") == 0 && img.regions[0].length == 0x20000 &&
+             strcmp(img.regions[1].name, "RAM") == 0 && img.regions[1].origin == 0x20000000);
+
+    // Test 2: Output section whose name wrapped onto its own line
+    const out_section_t *ro = find_section(&img, ".rodata.with_a_long_output_name");
+    run_test(2, "Wrapped output section keeps its address and size",
+             ro != NULL && ro->vma == 0x08000100 && ro->size == 0x10 && symbol_size(&img, "table") == 0x10);
+
+    // Test 3: Symbols inside a wrapped input section
+    run_test(3, "Wrapped input section sizes its symbols",
+             symbol_size(&img, "a_very_long_function_name_that_wraps") == 0x80 &&
+             symbol_size(&img, "main") == 0x40 && symbol_size(&img, "helper") == 0x40);
+
+    // Test 4: .data runs in RAM but is loaded from FLASH
+    const out_section_t *data = find_section(&img, ".data");
+    run_test(4, ".data has its load address",
+             data != NULL && data->vma == 0x20000000 && data->lma == 0x08000110 && !data->nobits &&
+             symbol_size(&img, "counter") == 4 && symbol_size(&img, "mode") == 4);
+
+    // Test 5: .bss gets a "load address" from ld too, but takes no FLASH
+    const out_section_t *bss = find_section(&img, ".bss");
+    run_test(5, ".bss is NOBITS", bss != NULL && bss->nobits && symbol_size(&img, "rx_buf") == 0x20);
+    map_image_free(&img);
+
+    // Test 6: ELF sections, LMA from the PT_LOAD segment, NOBITS from the type
+    map_image_init(&img);
+    st = map_load(&img, elf_path);
+    const out_section_t *edata = find_section(&img, ".data");
+    const out_section_t *ebss = find_section(&img, ".bss");
+    run_test(6, "ELF sections with LMA and NOBITS",
+             st == MAP_OK && img.num_sections == 3 && edata != NULL && edata->lma == 0x08000020 &&
+             !edata->nobits && ebss != NULL && ebss->nobits);
+
+    // Test 7: Sizes straight from the symbol table, empty and FILE symbols skipped
+    run_test(7, "ELF symtab sizes",
+             img.num_symbols == 3 && symbol_size(&img, "foo") == 0x20 &&
+             symbol_size(&img, "counter") == 4 && symbol_size(&img, "buf") == 16 &&
+             symbol_size(&img, "marker") == UINT64_MAX && symbol_size(&img, "x.c") == UINT64_MAX);
+    map_image_free(&img);
+
+    // Test 8: Headers that would make the parser read past its buffers
+    static uint8_t bad[ELF_SIZE];
+    bool rejected = true;
+    for (int variant = 0; variant < 5; variant++) {
+        size_t len = ELF_SIZE;
+        memcpy(bad, elf, ELF_SIZE);
+        switch (variant) {
+            case 0: len = ELF_SH + 3 * 40; break;               // Section table cut off
+            case 1: wr16(bad + 46, 20); break;                  // e_shentsize < 40
+            case 2: wr16(bad + 42, 16); break;                  // e_phentsize < 32
+            case 3: wr16(bad + 48, 0); break;                   // Extended numbering
+            case 4: wr32(bad + ELF_SH + 5 * 40 + 16, ELF_SIZE); break;  // .strtab past EOF
+        }
+        map_image_init(&img);
+        rejected &= write_file(elf_path, bad, len) && map_parse_elf(&img, elf_path) == MAP_ERR_FORMAT;
+        map_image_free(&img);
+    }
+    write_file(elf_path, elf, sizeof(elf));
+    run_test(8, "Truncated or malformed ELF headers rejected", rejected);
+
+    // Test 9: MEMORY block of the repo's linker script
+    map_image_init(&img);
+    st = map_parse_linker_script(&img, "generic.ld");
+    run_test(9, "generic.ld MEMORY regions",
+             st == MAP_OK && img.num_regions == 2 &&
+             strcmp(img.regions[0].name, "FLASH") == 0 && img.regions[0].origin == 0x08000000 &&
+             img.regions[0].length == 128 * 1024 &&
+             strcmp(img.regions[1].name, "RAM") == 0 && img.regions[1].origin == 0x20000000 &&
+             img.regions[1].length == 20 * 1024);
+    map_image_free(&img);
+
+    // Test 10: FLASH holds .text + .rodata + .data's image, RAM .data + .bss
+    char *argv_report[] = { "mapbudget", build_path };
+    int rc = run_tool(2, argv_report);
+    run_test(10, "Region usage counts .data twice, .bss once",
+             rc == 0 && output_line("FLASH", " 280 ") && output_line("RAM", " 40 ") &&
+             output_line("  .data", "(load image)"));
+
+    // Test 11: ELF with regions from --ld
+    char *argv_elf[] = { "mapbudget", "--ld", "generic.ld", elf_path };
+    rc = run_tool(4, argv_elf);
+    run_test(11, "ELF usage with --ld", rc == 0 && output_line("FLASH", " 36 ") && output_line("RAM", " 20 "));
+
+    // Test 12: Diff of two builds
+    char *argv_diff[] = { "mapbudget", build_path, base_path };
+    rc = run_tool(3, argv_diff);
+    run_test(12, "Diff against a baseline",
+             rc == 0 && output_line("RAM", "+20") && output_line("FLASH", "+20") &&
+             output_line("  ", "+16") && output_line("  ", "rx_buf") &&
+             output_line("  ", "added") && output_line("  ", "mode"));
+
+    // Test 13: Budgets that hold exit 0
+    char *argv_ok[] = { "mapbudget", "--limit", "RAM=90", "--max-growth", "RAM=20", build_path, base_path };
+    rc = run_tool(7, argv_ok);
+    run_test(13, "Budgets within limits exit 0", rc == 0 && strstr(tool_output, "BUDGET OK") != NULL);
+
+    // Test 14: Exceeded budgets exit 1
+    char *argv_full[] = { "mapbudget", "--limit", "FLASH=0", build_path };
+    char *argv_grew[] = { "mapbudget", "--max-growth", "RAM=19", build_path, base_path };
+    char *argv_region[] = { "mapbudget", "--limit", "SRAM2=50", build_path };
+    int rc_full = run_tool(4, argv_full);
+    int rc_grew = run_tool(5, argv_grew);
+    bool grew_msg = strstr(tool_output, "BUDGET FAIL: RAM grew by 20") != NULL;
+    int rc_region = run_tool(4, argv_region);
+    run_test(14, "Exceeded limit, growth or unknown region exit 1",
+             rc_full == 1 && rc_grew == 1 && grew_msg && rc_region == 1);
+
+    // Test 15: Usage and input errors exit 2
+    char missing[] = "/tmp/maptest_missing.map";
+    char *argv_nobase[] = { "mapbudget", "--max-growth", "RAM=1", build_path };
+    char *argv_rule[] = { "mapbudget", "--limit", "RAM", build_path };
+    char *argv_missing[] = { "mapbudget", missing };
+    char *argv_option[] = { "mapbudget", "--frobnicate", build_path };
+    remove(missing);
+    run_test(15, "Usage and input errors exit 2",
+             run_tool(4, argv_nobase) == 2 && run_tool(4, argv_rule) == 2 &&
+             run_tool(2, argv_missing) == 2 && run_tool(3, argv_option) == 2);
+
+    remove(build_path);
+    remove(base_path);
+    remove(elf_path);
+    remove(out_path);
+
+    printf("\n------------------------------------------\n");
+    if (total_failures == 0) {
+        printf("RESULT: ALL TESTS PASSED ✅\n");
+    } else {
+        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
+    }
+    printf("------------------------------------------\n");
+
+    return (total_failures > 0) ? 1 : 0;
+}
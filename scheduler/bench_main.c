@@ -0,0 +1,453 @@
+/*
+Scheduler Benchmarks
+Compares three ways to track "which priorities are ready":
+- Two-level bitmap (prio_bitmap_t)    : O(1) set / clear / find
+- Linear scan over a bool array       : O(1) set / clear, O(N) find
+- Indexed binary max-heap             : O(log N) set / clear, O(1) find
+
+Workloads (K tasks ready at the start, ns per step = set + find + clear):
+- run-highest: a random priority becomes ready, the scheduler finds the
+  highest and that task finishes (is cleared).
+- block/wake : a random priority becomes ready, another random priority
+  blocks (is cleared), then the scheduler finds the highest.
+
+Executor (work-stealing runtime) on 1..N worker threads:
+- Throughput of many short tasks with mixed priorities
+- Priority-inversion latency: while the pool is saturated with low
+  priority work, a top-priority probe is submitted every few microseconds.
+  Latency = probe start time - probe submit time.
+
+Timer wheel vs binary min-heap with 100k pending timers:
+- start (insert), restart (re-arm before expiry), cancel: ns per op
+- expiry: ns per tick while running the clock until every timer fired
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include "scheduler.h"
+#include "executor.h"
+#include "timer_wheel.h"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// --- Baseline 1: Linear Scan ---
+
+static bool linear_ready[SCHED_MAX_PRIORITIES];
+static int linear_levels;
+
+static void linear_set(uint16_t p)   { linear_ready[p] = true; }
+static void linear_clear(uint16_t p) { linear_ready[p] = false; }
+
+static int16_t linear_highest(void) {
+    for (int p = linear_levels - 1; p >= 0; p--) {
+        if (linear_ready[p]) return (int16_t)p;
+    }
+    return -1;
+}
+
+// --- Baseline 2: Indexed Binary Max-Heap ---
+
+static uint16_t heap[SCHED_MAX_PRIORITIES];
+static int16_t heap_pos[SCHED_MAX_PRIORITIES]; // -1 if not in heap
+static int heap_size;
+
+static void heap_swap(int i, int j) {
+    uint16_t t = heap[i];
+    heap[i] = heap[j];
+    heap[j] = t;
+    heap_pos[heap[i]] = (int16_t)i;
+    heap_pos[heap[j]] = (int16_t)j;
+}
+
+static void heap_sift_up(int i) {
+    while (i > 0 && heap[(i - 1) / 2] < heap[i]) {
+        heap_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static void heap_sift_down(int i) {
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, big = i;
+        if (l < heap_size && heap[l] > heap[big]) big = l;
+        if (r < heap_size && heap[r] > heap[big]) big = r;
+        if (big == i) return;
+        heap_swap(i, big);
+        i = big;
+    }
+}
+
+static void heap_set(uint16_t p) {
+    if (heap_pos[p] >= 0) return;
+    heap[heap_size] = p;
+    heap_pos[p] = (int16_t)heap_size;
+    heap_sift_up(heap_size++);
+}
+
+static void heap_clear(uint16_t p) {
+    int i = heap_pos[p];
+    if (i < 0) return;
+    heap_swap(i, --heap_size);
+    heap_pos[p] = -1;
+    if (i < heap_size) {
+        heap_sift_up(i);
+        heap_sift_down(i);
+    }
+}
+
+static int16_t heap_highest(void) {
+    return (heap_size > 0) ? (int16_t)heap[0] : -1;
+}
+
+// --- Benchmark Driver ---
+
+typedef enum { IMPL_BITMAP, IMPL_LINEAR, IMPL_HEAP } impl_t;
+typedef enum { WORK_RUN_HIGHEST, WORK_BLOCK_WAKE } workload_t;
+
+static prio_bitmap_t bench_map;
+
+static void reset_all(int levels) {
+    prio_bitmap_init(&bench_map);
+    memset(linear_ready, 0, sizeof(linear_ready));
+    linear_levels = levels;
+    memset(heap_pos, 0xFF, sizeof(heap_pos));
+    heap_size = 0;
+}
+
+// Returns ns per step. prios holds 2 random priorities per step.
+static double run_steps(impl_t impl, workload_t work, const uint16_t *prios, size_t steps,
+                        const uint16_t *initial, int ready, uint64_t *checksum) {
+    for (int i = 0; i < ready; i++) {
+        switch (impl) {
+            case IMPL_BITMAP: prio_bitmap_set(&bench_map, initial[i]); break;
+            case IMPL_LINEAR: linear_set(initial[i]); break;
+            case IMPL_HEAP:   heap_set(initial[i]); break;
+        }
+    }
+
+    uint64_t sum = 0;
+    uint64_t start = now_ns();
+    for (size_t s = 0; s < steps; s++) {
+        uint16_t wake = prios[2 * s];
+        uint16_t block = prios[2 * s + 1];
+        int16_t top = -1;
+
+        switch (impl) {
+            case IMPL_BITMAP:
+                prio_bitmap_set(&bench_map, wake);
+                if (work == WORK_BLOCK_WAKE) prio_bitmap_clear(&bench_map, block);
+                top = prio_bitmap_highest(&bench_map);
+                if (work == WORK_RUN_HIGHEST) prio_bitmap_clear(&bench_map, (uint16_t)top);
+                break;
+            case IMPL_LINEAR:
+                linear_set(wake);
+                if (work == WORK_BLOCK_WAKE) linear_clear(block);
+                top = linear_highest();
+                if (work == WORK_RUN_HIGHEST) linear_clear((uint16_t)top);
+                break;
+            case IMPL_HEAP:
+                heap_set(wake);
+                if (work == WORK_BLOCK_WAKE) heap_clear(block);
+                top = heap_highest();
+                if (work == WORK_RUN_HIGHEST) heap_clear((uint16_t)top);
+                break;
+        }
+        sum += (uint64_t)(top + 1);
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    *checksum = sum;
+    return (double)elapsed / (double)steps;
+}
+
+// --- Executor ---
+
+#define EXEC_TASK_WORK   200   // Inner loop iterations per short task
+#define EXEC_PROBES      500
+
+static atomic_uint_fast64_t work_sink;
+
+static void short_task(void *arg) {
+    uint32_t x = (uint32_t)(uintptr_t)arg | 1;
+    for (int i = 0; i < EXEC_TASK_WORK; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+    }
+    atomic_fetch_add_explicit(&work_sink, x, memory_order_relaxed);
+}
+
+typedef struct {
+    task_t task;
+    uint64_t submit_ns;
+    uint64_t start_ns;
+} probe_t;
+
+static void probe_task(void *arg) {
+    probe_t *probe = (probe_t *)arg;
+    probe->start_ns = now_ns();
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void run_executor_bench(size_t num_tasks, int max_workers) {
+    task_t *tasks = malloc(num_tasks * sizeof(task_t));
+    static probe_t probes[EXEC_PROBES];
+    static uint64_t lat[EXEC_PROBES];
+    if (tasks == NULL) return;
+
+    printf("\n--- Executor: %zu short tasks, priorities 0..%d ---\n", num_tasks, EXEC_PRIORITIES - 2);
+    printf("%-8s | %16s | %10s | %14s | %14s\n", "workers", "throughput", "stolen",
+           "probe p50", "probe p99");
+
+    for (int workers = 1; workers <= max_workers; workers *= 2) {
+        static executor_t exec;
+        if (executor_start(&exec, workers) != 0) break;
+
+        // 1. Throughput: submit everything, wait for completion
+        rng_state = 0xC0FFEE;
+        uint64_t start = now_ns();
+        for (size_t i = 0; i < num_tasks; i++) {
+            tasks[i] = (task_t){ NULL, (uint16_t)(xorshift32() % (EXEC_PRIORITIES - 1)),
+                                 short_task, (void *)(uintptr_t)i };
+            executor_submit(&exec, &tasks[i]);
+        }
+        executor_wait_idle(&exec);
+        uint64_t elapsed = now_ns() - start;
+
+        // 2. Priority inversion: saturate with low priority work, then probe
+        for (size_t i = 0; i < num_tasks; i++) {
+            tasks[i].priority = (uint16_t)(xorshift32() % 8);
+            executor_submit(&exec, &tasks[i]);
+        }
+        for (int p = 0; p < EXEC_PROBES; p++) {
+            probes[p].task = (task_t){ NULL, EXEC_PRIORITIES - 1, probe_task, &probes[p] };
+            probes[p].submit_ns = now_ns();
+            executor_submit(&exec, &probes[p].task);
+            uint64_t until = now_ns() + 5000;
+            while (now_ns() < until) { }
+        }
+        executor_wait_idle(&exec);
+
+        uint64_t stolen = 0;
+        for (int i = 0; i < workers; i++) stolen += exec.workers[i].stolen;
+        executor_stop(&exec);
+
+        for (int p = 0; p < EXEC_PROBES; p++) lat[p] = probes[p].start_ns - probes[p].submit_ns;
+        qsort(lat, EXEC_PROBES, sizeof(uint64_t), cmp_u64);
+
+        printf("%-8d | %9.2f Mtask/s | %10llu | %11llu ns | %11llu ns\n", workers,
+               (double)num_tasks * 1e3 / (double)elapsed, (unsigned long long)stolen,
+               (unsigned long long)lat[EXEC_PROBES / 2],
+               (unsigned long long)lat[(EXEC_PROBES * 99) / 100]);
+    }
+
+    free(tasks);
+}
+
+// --- Timer Wheel vs Heap ---
+
+#define TIMER_COUNT     100000
+#define TIMER_MAX_DELAY 1000000
+
+// Baseline: indexed binary min-heap keyed by expiry tick
+typedef struct {
+    uint64_t expires;
+    int32_t heap_idx;   // -1 if not armed
+    uint16_t priority;
+} heap_timer_t;
+
+static heap_timer_t *th_heap[TIMER_COUNT];
+static int th_size;
+static uint64_t th_now;
+
+static void th_swap(int i, int j) {
+    heap_timer_t *t = th_heap[i];
+    th_heap[i] = th_heap[j];
+    th_heap[j] = t;
+    th_heap[i]->heap_idx = i;
+    th_heap[j]->heap_idx = j;
+}
+
+static void th_sift_up(int i) {
+    while (i > 0 && th_heap[(i - 1) / 2]->expires > th_heap[i]->expires) {
+        th_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static void th_sift_down(int i) {
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, small = i;
+        if (l < th_size && th_heap[l]->expires < th_heap[small]->expires) small = l;
+        if (r < th_size && th_heap[r]->expires < th_heap[small]->expires) small = r;
+        if (small == i) return;
+        th_swap(i, small);
+        i = small;
+    }
+}
+
+static void th_cancel(heap_timer_t *t) {
+    int i = t->heap_idx;
+    if (i < 0) return;
+    th_swap(i, --th_size);
+    t->heap_idx = -1;
+    if (i < th_size) {
+        th_sift_up(i);
+        th_sift_down(i);
+    }
+}
+
+static void th_start(heap_timer_t *t, uint64_t delay) {
+    th_cancel(t);
+    t->expires = th_now + delay;
+    t->heap_idx = th_size;
+    th_heap[th_size] = t;
+    th_sift_up(th_size++);
+}
+
+static uint32_t th_tick(void) {
+    uint32_t fired = 0;
+    th_now++;
+    while (th_size > 0 && th_heap[0]->expires <= th_now) {
+        heap_timer_t *t = th_heap[0];
+        th_cancel(t);
+        set_task_ready(t->priority);
+        fired++;
+    }
+    return fired;
+}
+
+static void run_timer_bench(void) {
+    static sched_timer_t wheel_timers[TIMER_COUNT];
+    static heap_timer_t heap_timers[TIMER_COUNT];
+    static uint32_t delays[3 * TIMER_COUNT];
+    static uint32_t picks[TIMER_COUNT];
+    static timer_wheel_t tw;
+
+    rng_state = 0xBADC0DE;
+    for (int i = 0; i < 3 * TIMER_COUNT; i++) delays[i] = 1 + xorshift32() % TIMER_MAX_DELAY;
+    for (int i = 0; i < TIMER_COUNT; i++) picks[i] = xorshift32() % TIMER_COUNT;
+
+    double ns[2][4];
+    uint32_t fired[2];
+
+    for (int impl = 0; impl < 2; impl++) {
+        uint64_t t0, t1, t2, t3, t4;
+        fired[impl] = 0;
+
+        if (impl == 0) {
+            timer_wheel_init(&tw);
+            for (int i = 0; i < TIMER_COUNT; i++) sched_timer_init(&wheel_timers[i], (uint16_t)(i % 64), 0);
+
+            t0 = now_ns();
+            for (int i = 0; i < TIMER_COUNT; i++) sched_timer_start(&tw, &wheel_timers[i], delays[i]);
+            t1 = now_ns();
+            for (int i = 0; i < TIMER_COUNT; i++) sched_timer_start(&tw, &wheel_timers[picks[i]], delays[TIMER_COUNT + i]);
+            t2 = now_ns();
+            for (int i = 0; i < TIMER_COUNT / 2; i++) sched_timer_cancel(&tw, &wheel_timers[picks[i]]);
+            t3 = now_ns();
+            for (uint32_t tick = 0; tick < TIMER_MAX_DELAY; tick++) fired[impl] += timer_wheel_tick(&tw);
+            t4 = now_ns();
+        } else {
+            th_size = 0;
+            th_now = 0;
+            for (int i = 0; i < TIMER_COUNT; i++) heap_timers[i] = (heap_timer_t){ 0, -1, (uint16_t)(i % 64) };
+
+            t0 = now_ns();
+            for (int i = 0; i < TIMER_COUNT; i++) th_start(&heap_timers[i], delays[i]);
+            t1 = now_ns();
+            for (int i = 0; i < TIMER_COUNT; i++) th_start(&heap_timers[picks[i]], delays[TIMER_COUNT + i]);
+            t2 = now_ns();
+            for (int i = 0; i < TIMER_COUNT / 2; i++) th_cancel(&heap_timers[picks[i]]);
+            t3 = now_ns();
+            for (uint32_t tick = 0; tick < TIMER_MAX_DELAY; tick++) fired[impl] += th_tick();
+            t4 = now_ns();
+        }
+
+        ns[impl][0] = (double)(t1 - t0) / TIMER_COUNT;
+        ns[impl][1] = (double)(t2 - t1) / TIMER_COUNT;
+        ns[impl][2] = (double)(t3 - t2) / (TIMER_COUNT / 2);
+        ns[impl][3] = (double)(t4 - t3) / TIMER_MAX_DELAY;
+    }
+
+    printf("\n--- Timers: %d pending, delays 1..%d ticks ---\n", TIMER_COUNT, TIMER_MAX_DELAY);
+    printf("%-12s | %10s | %10s | %10s | %12s | %s\n", "", "start", "restart", "cancel", "per tick", "fired");
+    printf("%-12s | %7.1f ns | %7.1f ns | %7.1f ns | %9.1f ns | %u\n", "timer wheel",
+           ns[0][0], ns[0][1], ns[0][2], ns[0][3], fired[0]);
+    printf("%-12s | %7.1f ns | %7.1f ns | %7.1f ns | %9.1f ns | %u\n", "binary heap",
+           ns[1][0], ns[1][1], ns[1][2], ns[1][3], fired[1]);
+}
+
+int main(int argc, char **argv) {
+    size_t steps = (argc > 1) ? strtoull(argv[1], NULL, 10) : 2000000UL;
+    if (steps == 0) steps = 1;
+
+    static const int levels_list[] = { 32, 256, 4096 };
+    static const char *names[] = { "2-level bitmap", "linear scan", "binary heap" };
+    static const char *work_names[] = { "run-highest", "block/wake" };
+
+    uint16_t *prios = malloc(2 * steps * sizeof(uint16_t));
+    static uint16_t initial[SCHED_MAX_PRIORITIES];
+    if (prios == NULL) return 1;
+
+    printf("--- Scheduler Benchmark: %zu steps of set + find + clear ---\n", steps);
+    printf("%-12s %-7s %-6s | %18s | %18s | %18s\n", "workload", "levels", "ready",
+           names[0], names[1], names[2]);
+
+    for (int w = 0; w < 2 * 3; w++) {
+        int levels = levels_list[w % 3];
+        int ready_list[] = { 4, levels / 2 };
+
+        for (int r = 0; r < 2; r++) {
+            int ready = ready_list[r];
+            rng_state = 0x12345678;
+            for (size_t s = 0; s < 2 * steps; s++) prios[s] = (uint16_t)(xorshift32() % levels);
+            for (int i = 0; i < ready; i++) initial[i] = (uint16_t)(xorshift32() % levels);
+
+            uint64_t sums[3];
+            double ns[3];
+            for (int impl = 0; impl < 3; impl++) {
+                reset_all(levels);
+                ns[impl] = run_steps((impl_t)impl, (workload_t)(w / 3), prios, steps, initial, ready, &sums[impl]);
+            }
+
+            printf("%-12s %-7d %-6d | %12.1f ns/op | %12.1f ns/op | %12.1f ns/op %s\n",
+                   work_names[w / 3], levels, ready, ns[0], ns[1], ns[2],
+                   (sums[0] == sums[1] && sums[1] == sums[2]) ? "" : "(MISMATCH)");
+        }
+    }
+
+    free(prios);
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    int max_workers = (cores > 1) ? (int)cores : 4;
+    if (max_workers > EXEC_MAX_WORKERS) max_workers = EXEC_MAX_WORKERS;
+    run_executor_bench(steps / 4, max_workers);
+
+    run_timer_bench();
+
+    return 0;
+}
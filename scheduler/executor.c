@@ -0,0 +1,294 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include "executor.h"
+
+// Worker running on this thread (NULL on non-worker threads)
+static _Thread_local worker_t *current_worker = NULL;
+
+static inline int highest_bit(uint64_t bits) {
+    return (bits == 0) ? -1 : 63 - __builtin_clzll(bits);
+}
+
+// --- Chase-Lev Work-Stealing Deque ---
+// (C11 memory orders as in Le, Pop, Cohen, Zappa Nardelli, PPoPP'13)
+
+static bool deque_push(ws_deque_t *d, task_t *task) {
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t >= EXEC_DEQUE_CAP) return false;
+
+    atomic_store_explicit(&d->slots[b & (EXEC_DEQUE_CAP - 1)], task, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return true;
+}
+
+// Owner only: takes the newest task (cache-hot)
+static task_t *deque_pop(ws_deque_t *d) {
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    task_t *task = NULL;
+    if (t <= b) {
+        task = atomic_load_explicit(&d->slots[b & (EXEC_DEQUE_CAP - 1)], memory_order_relaxed);
+        if (t == b) {
+            // Last task: race any thief for it
+            if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                         memory_order_seq_cst,
+                                                         memory_order_relaxed)) {
+                task = NULL;
+            }
+            atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        }
+    } else {
+        // Was already empty
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+// Any thread: takes the oldest task, NULL if empty or we lost a race
+static task_t *deque_steal(ws_deque_t *d) {
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+
+    if (t >= b) return NULL;
+
+    task_t *task = atomic_load_explicit(&d->slots[t & (EXEC_DEQUE_CAP - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return NULL;
+    }
+    return task;
+}
+
+// --- Worker Internals ---
+
+// Owner only: park a task whose deque is full
+static void worker_overflow(worker_t *w, task_t *task) {
+    uint16_t p = task->priority;
+    task->next = NULL;
+    if (w->overflow_tail[p] != NULL) w->overflow_tail[p]->next = task;
+    else w->overflow_head[p] = task;
+    w->overflow_tail[p] = task;
+    w->overflow_bits |= 1ULL << p;
+}
+
+// Owner only: queue a task locally, keeping FIFO order with parked tasks
+static void worker_push_local(worker_t *w, task_t *task) {
+    uint16_t p = task->priority;
+    if ((w->overflow_bits & (1ULL << p)) == 0 && deque_push(&w->deque[p], task)) {
+        atomic_fetch_or_explicit(&w->ready_bitmap, 1ULL << p, memory_order_release);
+    } else {
+        worker_overflow(w, task);
+    }
+}
+
+// Owner only: move inbox submissions into the deques, and refill deques
+// from the overflow lists as space frees up
+static void worker_collect(worker_t *w) {
+    task_t *list = atomic_exchange_explicit(&w->inbox, NULL, memory_order_acquire);
+
+    // The inbox is a stack: reverse it so tasks keep submission order
+    task_t *fifo = NULL;
+    while (list != NULL) {
+        task_t *next = list->next;
+        list->next = fifo;
+        fifo = list;
+        list = next;
+    }
+    while (fifo != NULL) {
+        task_t *next = fifo->next;
+        worker_push_local(w, fifo);
+        fifo = next;
+    }
+
+    // Each overflowing level stops at its first failed push, so this is
+    // at most one wasted push per level
+    uint64_t pending = w->overflow_bits;
+    uint64_t pushed = 0;
+    while (pending != 0) {
+        int p = highest_bit(pending);
+        pending &= ~(1ULL << p);
+
+        task_t *task = w->overflow_head[p];
+        while (task != NULL) {
+            // Read the link first: once pushed, a thief may run the task
+            task_t *next = task->next;
+            if (!deque_push(&w->deque[p], task)) break;
+            pushed |= 1ULL << p;
+            task = next;
+        }
+        w->overflow_head[p] = task;
+        if (task == NULL) {
+            w->overflow_tail[p] = NULL;
+            w->overflow_bits &= ~(1ULL << p);
+        }
+    }
+
+    if (pushed != 0) {
+        atomic_fetch_or_explicit(&w->ready_bitmap, pushed, memory_order_release);
+    }
+}
+
+// Picks the highest-priority task visible to this worker
+static task_t *worker_find_task(worker_t *w) {
+    executor_t *exec = w->exec;
+    uint64_t victim_bits[EXEC_MAX_WORKERS];
+
+    for (;;) {
+        uint64_t own = atomic_load_explicit(&w->ready_bitmap, memory_order_acquire);
+        int own_prio = highest_bit(own);
+
+        // Only priorities strictly above our own are worth stealing
+        uint64_t above = (own_prio < 0) ? ~0ULL : ~((2ULL << own_prio) - 1);
+        for (int i = 0; i < exec->num_workers; i++) {
+            worker_t *v = &exec->workers[i];
+            victim_bits[i] = (v == w) ? 0
+                : (atomic_load_explicit(&v->ready_bitmap, memory_order_acquire) & above);
+        }
+
+        // Try the best (victim, priority) pair first. A bit can be stale
+        // (only the owner clears it), so on a miss drop it and try the next.
+        for (;;) {
+            int best_prio = -1, best = -1;
+            for (int i = 0; i < exec->num_workers; i++) {
+                int p = highest_bit(victim_bits[i]);
+                if (p > best_prio) {
+                    best_prio = p;
+                    best = i;
+                }
+            }
+            if (best < 0) break;
+
+            task_t *task = deque_steal(&exec->workers[best].deque[best_prio]);
+            if (task != NULL) {
+                w->stolen++;
+                return task;
+            }
+            victim_bits[best] &= ~(1ULL << best_prio);
+        }
+
+        if (own_prio < 0) return NULL;
+
+        task_t *task = deque_pop(&w->deque[own_prio]);
+        if (task != NULL) return task;
+
+        // Our deque is empty (or a thief got the last one): clear the hint.
+        // Only the owner pushes, so nothing can refill it behind our back.
+        atomic_fetch_and_explicit(&w->ready_bitmap, ~(1ULL << own_prio), memory_order_relaxed);
+    }
+}
+
+static void *worker_main(void *arg) {
+    worker_t *w = (worker_t *)arg;
+    executor_t *exec = w->exec;
+    current_worker = w;
+
+    while (!atomic_load_explicit(&exec->stop, memory_order_acquire)) {
+        if (atomic_load_explicit(&w->inbox, memory_order_relaxed) != NULL || w->overflow_bits != 0) {
+            worker_collect(w);
+        }
+
+        task_t *task = worker_find_task(w);
+        if (task == NULL) {
+            sched_yield();
+            continue;
+        }
+
+        task->entry(task->arg);
+        w->executed++;
+
+        // Completion: the task may be reused by its owner after this
+        atomic_fetch_sub_explicit(&exec->pending, 1, memory_order_release);
+    }
+
+    current_worker = NULL;
+    return NULL;
+}
+
+// --- Public API ---
+
+int executor_start(executor_t *exec, int num_workers) {
+    if (exec == NULL || num_workers <= 0 || num_workers > EXEC_MAX_WORKERS) return -1;
+
+    exec->workers = aligned_alloc(64, sizeof(worker_t) * (size_t)num_workers);
+    if (exec->workers == NULL) return -1;
+    memset(exec->workers, 0, sizeof(worker_t) * (size_t)num_workers);
+
+    exec->num_workers = num_workers;
+    atomic_init(&exec->pending, 0);
+    atomic_init(&exec->next_inbox, 0);
+    atomic_init(&exec->stop, false);
+
+    for (int i = 0; i < num_workers; i++) {
+        worker_t *w = &exec->workers[i];
+        w->exec = exec;
+        w->id = i;
+        atomic_init(&w->ready_bitmap, 0);
+        atomic_init(&w->inbox, NULL);
+        for (int p = 0; p < EXEC_PRIORITIES; p++) {
+            atomic_init(&w->deque[p].top, 0);
+            atomic_init(&w->deque[p].bottom, 0);
+        }
+    }
+
+    for (int i = 0; i < num_workers; i++) {
+        if (pthread_create(&exec->workers[i].thread, NULL, worker_main, &exec->workers[i]) != 0) {
+            atomic_store(&exec->stop, true);
+            for (int j = 0; j < i; j++) pthread_join(exec->workers[j].thread, NULL);
+            free(exec->workers);
+            exec->workers = NULL;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+bool executor_submit(executor_t *exec, task_t *task) {
+    if (task == NULL || task->priority >= EXEC_PRIORITIES) return false;
+
+    atomic_fetch_add_explicit(&exec->pending, 1, memory_order_relaxed);
+
+    // A task spawning more work keeps it local (thieves will spread it)
+    worker_t *self = current_worker;
+    if (self != NULL && self->exec == exec) {
+        worker_push_local(self, task);
+        return true;
+    }
+
+    // External thread: lock-free push onto a worker's inbox stack
+    unsigned idx = atomic_fetch_add_explicit(&exec->next_inbox, 1, memory_order_relaxed);
+    worker_t *target = &exec->workers[idx % (unsigned)exec->num_workers];
+
+    task_t *head = atomic_load_explicit(&target->inbox, memory_order_relaxed);
+    do {
+        task->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&target->inbox, &head, task,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+    return true;
+}
+
+void executor_wait_idle(executor_t *exec) {
+    while (atomic_load_explicit(&exec->pending, memory_order_acquire) != 0) {
+        sched_yield();
+    }
+}
+
+void executor_stop(executor_t *exec) {
+    if (exec->workers == NULL) return;
+
+    executor_wait_idle(exec);
+    atomic_store_explicit(&exec->stop, true, memory_order_release);
+    for (int i = 0; i < exec->num_workers; i++) {
+        pthread_join(exec->workers[i].thread, NULL);
+    }
+    free(exec->workers);
+    exec->workers = NULL;
+}
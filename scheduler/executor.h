@@ -0,0 +1,85 @@
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "scheduler.h"
+
+/*
+ * Host-side multi-core executor built on the priority-bitmap idea.
+ *
+ * Every worker thread owns:
+ * - one work-stealing deque per priority level (Chase-Lev: the owner pushes
+ *   and pops at the bottom, other workers steal from the top, no locks)
+ * - one atomic bitmap with bit p set while deque p may be non-empty
+ * - an inbox (lock-free stack) that other threads submit into
+ *
+ * A worker always runs the highest priority it can see: it compares the
+ * highest bit in its own bitmap against every other worker's bitmap and
+ * steals from a victim's highest non-empty deque if that beats its own.
+ *
+ * The bitmap is a single 64-bit word per worker (the leaf level of
+ * prio_bitmap_t), so the executor supports 64 priority levels.
+ */
+
+#define EXEC_PRIORITIES  64     // Priorities 0..63, 63 is the highest
+#define EXEC_MAX_WORKERS 64
+#define EXEC_DEQUE_CAP   256    // Tasks per (worker, priority) deque, power of two
+
+typedef struct {
+    _Alignas(64) _Atomic int64_t top;       // Thieves take from here
+    _Alignas(64) _Atomic int64_t bottom;    // Owner pushes/pops here
+    _Atomic(task_t *) slots[EXEC_DEQUE_CAP];
+} ws_deque_t;
+
+typedef struct executor executor_t;
+
+typedef struct {
+    _Alignas(64) _Atomic uint64_t ready_bitmap;  // Bit p: deque[p] may hold tasks
+    _Alignas(64) _Atomic(task_t *) inbox;        // Submissions from other threads
+    uint64_t overflow_bits;                      // Owner-only: bit p if overflow[p] non-empty
+    task_t *overflow_head[EXEC_PRIORITIES];      // Owner-only: tasks that did not fit
+    task_t *overflow_tail[EXEC_PRIORITIES];      // in a full deque, FIFO per priority
+    ws_deque_t deque[EXEC_PRIORITIES];
+    executor_t *exec;
+    pthread_t thread;
+    int id;
+    uint64_t executed;                           // Tasks run by this worker
+    uint64_t stolen;                             // Of which stolen from others
+} worker_t;
+
+struct executor {
+    worker_t *workers;
+    int num_workers;
+    _Alignas(64) atomic_size_t pending;          // Submitted but not finished
+    atomic_uint next_inbox;                      // Round-robin for submissions
+    atomic_bool stop;
+};
+
+/**
+ * @brief Starts num_workers threads.
+ * @return 0 on success, -1 on bad arguments or allocation/thread failure
+ */
+int executor_start(executor_t *exec, int num_workers);
+
+/**
+ * @brief Queues a task. Lock-free, callable from any thread (including tasks).
+ *        task->priority must be < EXEC_PRIORITIES. The task memory must stay
+ *        valid until its entry function has returned.
+ * @return false if the task is NULL or its priority is out of range
+ */
+bool executor_submit(executor_t *exec, task_t *task);
+
+/**
+ * @brief Spins until every submitted task has finished.
+ */
+void executor_wait_idle(executor_t *exec);
+
+/**
+ * @brief Waits for idle, stops and joins all workers, frees their state.
+ */
+void executor_stop(executor_t *exec);
+
+#endif // EXECUTOR_H
@@ -1,45 +1,86 @@
-#include <stdint.h>
-#include <stdio.h>
+#include <string.h>
+#include "scheduler.h"
 
-// A bitmask where Bit 31 is the highest priority, Bit 0 is the lowest.
-volatile uint32_t ready_tasks_bitmap = 0;
+// --- Ready Queue ---
 
-// 1. Mark a task as "Ready to Run"
-void set_task_ready(uint8_t priority) {
-    if (priority < 32)
+void ready_queue_init(ready_queue_t *rq) {
+    memset(rq, 0, sizeof(*rq));
+}
+
+bool ready_queue_push(ready_queue_t *rq, task_t *task) {
+    if (task == NULL || task->priority >= SCHED_MAX_PRIORITIES) return false;
+
+    uint16_t prio = task->priority;
+    task->next = NULL;
+
+    if (rq->tail[prio] == NULL)
     {
-        ready_tasks_bitmap |= (1UL << priority);
+        // Level was empty: it becomes ready
+        rq->head[prio] = task;
+        prio_bitmap_set(&rq->map, prio);
     }
+    else
+    {
+        rq->tail[prio]->next = task;
+    }
+    rq->tail[prio] = task;
+    return true;
 }
 
-// 2. Mark a task as "Finished/Waiting"
-void clear_task_ready(uint8_t priority) {
-    if (priority < 32)
+task_t *ready_queue_pop(ready_queue_t *rq) {
+    int16_t prio = prio_bitmap_highest(&rq->map);
+    if (prio < 0) return NULL;
+
+    task_t *task = rq->head[prio];
+    rq->head[prio] = task->next;
+
+    if (rq->head[prio] == NULL)
     {
-        ready_tasks_bitmap &= ~(1UL << priority);
+        // Level drained: no longer ready
+        rq->tail[prio] = NULL;
+        prio_bitmap_clear(&rq->map, (uint16_t)prio);
     }
+
+    task->next = NULL;
+    return task;
 }
 
-// 3. THE MAGIC: Find the highest priority task in O(1)
-int8_t get_highest_priority_task(void) {
-    if (ready_tasks_bitmap < 0)
+task_t *ready_queue_peek(const ready_queue_t *rq) {
+    int16_t prio = prio_bitmap_highest(&rq->map);
+    return (prio < 0) ? NULL : rq->head[prio];
+}
+
+task_t *ready_queue_rotate(ready_queue_t *rq) {
+    int16_t prio = prio_bitmap_highest(&rq->map);
+    if (prio < 0) return NULL;
+
+    task_t *task = rq->head[prio];
+    if (task->next != NULL)
     {
-        return -1;
+        rq->head[prio] = task->next;
+        task->next = NULL;
+        rq->tail[prio]->next = task;
+        rq->tail[prio] = task;
     }
+    return rq->head[prio];
+}
+
+// --- Global Ready Bitmap ---
 
-    uint32_t leading_zeros = __builtin_clz(ready_tasks_bitmap);
+// Priority SCHED_MAX_PRIORITIES - 1 is the highest, 0 is the lowest.
+static prio_bitmap_t ready_tasks_bitmap;
 
-    return (31 - leading_zeros);
+// 1. Mark a task as "Ready to Run"
+void set_task_ready(uint16_t priority) {
+    prio_bitmap_set(&ready_tasks_bitmap, priority);
 }
 
-int main() {
-    set_task_ready(5);
-    set_task_ready(12);
-    set_task_ready(2);
-    //clear_task_ready(12);
+// 2. Mark a task as "Finished/Waiting"
+void clear_task_ready(uint16_t priority) {
+    prio_bitmap_clear(&ready_tasks_bitmap, priority);
+}
 
-    printf("Highest Priority Ready: %d\n", get_highest_priority_task()); 
-    // Output: 21
-    
-    return 0;
-}
\ No newline at end of file
+// 3. THE MAGIC: Find the highest priority task in O(1)
+int16_t get_highest_priority_task(void) {
+    return prio_bitmap_highest(&ready_tasks_bitmap);
+}
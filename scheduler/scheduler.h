@@ -0,0 +1,141 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+// Number of priority levels. Higher number = higher priority.
+// Two levels of 64-bit words cover 64 * 64 = 4096 priorities.
+#define SCHED_MAX_PRIORITIES 4096
+#define SCHED_LEAF_WORDS     (SCHED_MAX_PRIORITIES / 64)
+
+#if SCHED_LEAF_WORDS > 64
+#error "Two-level bitmap covers at most 4096 priorities"
+#endif
+
+/*
+ * Two-level priority bitmap.
+ *
+ *   summary:  bit w is set  <=>  leaf[w] != 0
+ *   leaf[w]:  bit b is set  <=>  priority (w * 64 + b) is ready
+ *
+ * Finding the highest ready priority is two count-leading-zeros:
+ * one on the summary to pick the leaf word, one on that leaf.
+ * O(1) regardless of how many priorities exist.
+ */
+typedef struct {
+    uint64_t summary;
+    uint64_t leaf[SCHED_LEAF_WORDS];
+} prio_bitmap_t;
+
+// The bitmap ops are the scheduler's hot path, so they live here as
+// static inline functions and compile down to a handful of instructions.
+
+static inline void prio_bitmap_init(prio_bitmap_t *map) {
+    memset(map, 0, sizeof(*map));
+}
+
+static inline void prio_bitmap_set(prio_bitmap_t *map, uint16_t priority) {
+    if (priority < SCHED_MAX_PRIORITIES)
+    {
+        uint16_t word = priority >> 6;
+        map->leaf[word] |= (1ULL << (priority & 63));
+        map->summary |= (1ULL << word);
+    }
+}
+
+static inline void prio_bitmap_clear(prio_bitmap_t *map, uint16_t priority) {
+    if (priority < SCHED_MAX_PRIORITIES)
+    {
+        uint16_t word = priority >> 6;
+        map->leaf[word] &= ~(1ULL << (priority & 63));
+
+        // Only drop the summary bit once the whole leaf word is empty
+        if (map->leaf[word] == 0)
+        {
+            map->summary &= ~(1ULL << word);
+        }
+    }
+}
+
+static inline bool prio_bitmap_test(const prio_bitmap_t *map, uint16_t priority) {
+    if (priority >= SCHED_MAX_PRIORITIES) return false;
+    return (map->leaf[priority >> 6] >> (priority & 63)) & 1ULL;
+}
+
+/**
+ * @return Highest set priority, or -1 if the map is empty
+ */
+static inline int16_t prio_bitmap_highest(const prio_bitmap_t *map) {
+    // __builtin_clzll(0) is undefined, so the empty check must come first
+    if (map->summary == 0)
+    {
+        return -1;
+    }
+
+    uint32_t word = 63 - __builtin_clzll(map->summary);
+    uint32_t bit = 63 - __builtin_clzll(map->leaf[word]);
+
+    return (int16_t)((word << 6) | bit);
+}
+
+// --- Ready Queue ---
+
+// A schedulable unit. The scheduler only links it; the caller owns the memory.
+typedef struct task {
+    struct task *next;      // Intrusive link for the per-priority FIFO
+    uint16_t priority;
+    void (*entry)(void *arg);
+    void *arg;
+} task_t;
+
+/*
+ * Ready queue: one FIFO of tasks per priority level, plus the bitmap
+ * to find the highest non-empty level. Tasks with equal priority run
+ * round-robin: pop the head, run it, push it back at the tail.
+ */
+typedef struct {
+    prio_bitmap_t map;
+    task_t *head[SCHED_MAX_PRIORITIES];
+    task_t *tail[SCHED_MAX_PRIORITIES];
+} ready_queue_t;
+
+void ready_queue_init(ready_queue_t *rq);
+
+/**
+ * @brief Appends a task at the tail of its priority level
+ * @return false if task is NULL or its priority is out of range
+ */
+bool ready_queue_push(ready_queue_t *rq, task_t *task);
+
+/**
+ * @brief Removes and returns the oldest task at the highest ready priority
+ * @return The task, or NULL if nothing is ready
+ */
+task_t *ready_queue_pop(ready_queue_t *rq);
+
+/**
+ * @brief Returns the task ready_queue_pop would return, without removing it
+ */
+task_t *ready_queue_peek(const ready_queue_t *rq);
+
+/**
+ * @brief Round-robin: moves the head of the highest level to its tail
+ * @return The task now at the head of that level (next to run), or NULL
+ */
+task_t *ready_queue_rotate(ready_queue_t *rq);
+
+// --- Global Ready Bitmap (original API) ---
+
+// 1. Mark a task as "Ready to Run"
+void set_task_ready(uint16_t priority);
+
+// 2. Mark a task as "Finished/Waiting"
+void clear_task_ready(uint16_t priority);
+
+// 3. Find the highest priority task in O(1). Returns -1 if none is ready.
+int16_t get_highest_priority_task(void);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,231 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sched.h>
+#include "scheduler.h"
+#include "executor.h"
+#include "timer_wheel.h"
+
+// --- Test Harness ---
+
+static int total_failures = 0;
+
+void run_test(int num, const char* desc, bool passed) {
+    if (passed) {
+        printf("[PASS] Test %d: %s\n", num, desc);
+    } else {
+        printf("[FAIL] Test %d: %s\n", num, desc);
+        total_failures++;
+    }
+}
+
+// --- Executor Helpers ---
+
+static atomic_int exec_counter;
+static atomic_bool gate_open;
+static int run_order[8];
+static atomic_int run_order_len;
+
+static void count_task(void *arg) {
+    (void)arg;
+    atomic_fetch_add(&exec_counter, 1);
+}
+
+static void gate_task(void *arg) {
+    (void)arg;
+    while (!atomic_load(&gate_open)) sched_yield();
+}
+
+static void record_task(void *arg) {
+    int idx = atomic_fetch_add(&run_order_len, 1);
+    if (idx < 8) run_order[idx] = (int)(intptr_t)arg;
+}
+
+#define FANOUT_CHILDREN 2000
+static task_t fanout_children[FANOUT_CHILDREN];
+static executor_t *fanout_exec;
+
+static void fanout_task(void *arg) {
+    (void)arg;
+    // Spawned from inside a worker: goes to its own deques, others steal
+    for (int i = 0; i < FANOUT_CHILDREN; i++) {
+        fanout_children[i] = (task_t){ NULL, (uint16_t)(i % EXEC_PRIORITIES), count_task, NULL };
+        executor_submit(fanout_exec, &fanout_children[i]);
+    }
+}
+
+int main() {
+    printf("--- Running Scheduler Validation ---\n");
+
+    set_task_ready(5);
+    set_task_ready(12);
+    set_task_ready(2);
+    //clear_task_ready(12);
+
+    printf("Highest Priority Ready: %d\n", get_highest_priority_task());
+    // Output: 12
+
+    // Test 1: Original demo
+    run_test(1, "Highest of {5, 12, 2}", get_highest_priority_task() == 12);
+
+    // Test 2: Empty map reports -1 instead of clz(0) garbage
+    clear_task_ready(5);
+    clear_task_ready(12);
+    clear_task_ready(2);
+    run_test(2, "Empty Map Returns -1", get_highest_priority_task() == -1);
+
+    // Test 3: Priorities past 32, across leaf words
+    set_task_ready(40);
+    set_task_ready(4095);
+    set_task_ready(1000);
+    bool wide_ok = (get_highest_priority_task() == 4095);
+    clear_task_ready(4095);
+    wide_ok = wide_ok && (get_highest_priority_task() == 1000);
+    clear_task_ready(1000);
+    wide_ok = wide_ok && (get_highest_priority_task() == 40);
+    clear_task_ready(40);
+    run_test(3, "4096 Priorities Across Leaf Words", wide_ok && get_highest_priority_task() == -1);
+
+    // Test 4: Summary bit survives while another bit in the same leaf is set
+    prio_bitmap_t map;
+    prio_bitmap_init(&map);
+    prio_bitmap_set(&map, 130);
+    prio_bitmap_set(&map, 131);
+    prio_bitmap_clear(&map, 131);
+    bool leaf_ok = (prio_bitmap_highest(&map) == 130 && prio_bitmap_test(&map, 130));
+    prio_bitmap_set(&map, 5000); // Out of range: ignored
+    run_test(4, "Shared Leaf Word + Range Check", leaf_ok && prio_bitmap_highest(&map) == 130);
+
+    // Test 5: FIFO round-robin within a level, higher level always first
+    static ready_queue_t rq;
+    ready_queue_init(&rq);
+    task_t a = { NULL, 300, NULL, NULL };
+    task_t b = { NULL, 300, NULL, NULL };
+    task_t c = { NULL, 300, NULL, NULL };
+    task_t low = { NULL, 7, NULL, NULL };
+    ready_queue_push(&rq, &low);
+    ready_queue_push(&rq, &a);
+    ready_queue_push(&rq, &b);
+    ready_queue_push(&rq, &c);
+    bool rr_ok = (ready_queue_peek(&rq) == &a);
+    rr_ok = rr_ok && (ready_queue_rotate(&rq) == &b);
+    rr_ok = rr_ok && (ready_queue_rotate(&rq) == &c);
+    rr_ok = rr_ok && (ready_queue_rotate(&rq) == &a);
+    run_test(5, "Round-Robin Within One Priority", rr_ok);
+
+    // Test 6: Draining a level clears its bit and falls through to the next
+    bool drain_ok = (ready_queue_pop(&rq) == &a && ready_queue_pop(&rq) == &b &&
+                     ready_queue_pop(&rq) == &c && ready_queue_pop(&rq) == &low &&
+                     ready_queue_pop(&rq) == NULL);
+    run_test(6, "Drain Levels In Priority Order", drain_ok && prio_bitmap_highest(&rq.map) == -1);
+
+    // Test 7: Every submitted task runs exactly once across 4 workers
+    static executor_t exec;
+    static task_t tasks[10000];
+    bool started = (executor_start(&exec, 4) == 0);
+    atomic_store(&exec_counter, 0);
+    for (int i = 0; i < 10000; i++) {
+        tasks[i] = (task_t){ NULL, (uint16_t)(i % EXEC_PRIORITIES), count_task, NULL };
+        executor_submit(&exec, &tasks[i]);
+    }
+    executor_wait_idle(&exec);
+    run_test(7, "Executor Runs 10k Tasks Exactly Once", started && atomic_load(&exec_counter) == 10000);
+
+    // Test 8: Tasks spawned inside a task are stolen/run by the pool
+    atomic_store(&exec_counter, 0);
+    fanout_exec = &exec;
+    task_t root = { NULL, 10, fanout_task, NULL };
+    executor_submit(&exec, &root);
+    executor_wait_idle(&exec);
+    run_test(8, "Executor Nested Submit", atomic_load(&exec_counter) == FANOUT_CHILDREN);
+    executor_stop(&exec);
+
+    // Test 9: A single worker always runs the highest priority first
+    static executor_t solo;
+    executor_start(&solo, 1);
+    atomic_store(&gate_open, false);
+    // The gate runs at the top priority and blocks the only worker until
+    // every other task has been submitted
+    task_t gate = { NULL, EXEC_PRIORITIES - 1, gate_task, NULL };
+    executor_submit(&solo, &gate);
+    static const int prios[] = { 3, 40, 7, 62, 1, 20 };
+    static task_t ordered[6];
+    for (int i = 0; i < 6; i++) {
+        ordered[i] = (task_t){ NULL, (uint16_t)prios[i], record_task, (void *)(intptr_t)prios[i] };
+        executor_submit(&solo, &ordered[i]);
+    }
+    atomic_store(&gate_open, true);
+    executor_wait_idle(&solo);
+    executor_stop(&solo);
+    static const int expected_order[] = { 62, 40, 20, 7, 3, 1 };
+    bool order_ok = (atomic_load(&run_order_len) == 6);
+    for (int i = 0; i < 6 && order_ok; i++) order_ok = (run_order[i] == expected_order[i]);
+    run_test(9, "Executor Priority Order", order_ok);
+
+    // Test 10: One-shot timer wakes its task exactly on its tick
+    static timer_wheel_t tw;
+    timer_wheel_init(&tw);
+    sched_timer_t wake;
+    sched_timer_init(&wake, 77, 0);
+    sched_timer_start(&tw, &wake, 5);
+    uint32_t early = timer_wheel_advance(&tw, 4);
+    bool tw_ok = (early == 0 && get_highest_priority_task() == -1);
+    tw_ok = tw_ok && (timer_wheel_tick(&tw) == 1 && get_highest_priority_task() == 77);
+    clear_task_ready(77);
+    run_test(10, "Timer Wheel One-Shot -> set_task_ready", tw_ok && !sched_timer_is_armed(&wake));
+
+    // Test 11: Random delays across all levels, with cancels, fire on time
+    #define TW_TEST_TIMERS 5000
+    #define TW_TEST_SPAN   300000
+    static sched_timer_t timers[TW_TEST_TIMERS];
+    static uint64_t due[TW_TEST_TIMERS];
+    static uint16_t expect_fired[TW_TEST_SPAN + 1];
+    srand(1234);
+    timer_wheel_init(&tw);
+    timer_wheel_advance(&tw, 12345); // Start off a slot boundary
+    for (int i = 0; i < TW_TEST_TIMERS; i++) {
+        uint64_t delay = 1 + ((uint64_t)rand() % TW_TEST_SPAN);
+        sched_timer_init(&timers[i], (uint16_t)(i % SCHED_MAX_PRIORITIES), 0);
+        sched_timer_start(&tw, &timers[i], delay);
+        due[i] = delay;
+    }
+    for (int i = 0; i < TW_TEST_TIMERS; i += 3) sched_timer_cancel(&tw, &timers[i]);
+    for (int i = 0; i < TW_TEST_TIMERS; i++) {
+        if (sched_timer_is_armed(&timers[i])) expect_fired[due[i]]++;
+    }
+    bool on_time = true;
+    for (uint64_t tick = 1; tick <= TW_TEST_SPAN; tick++) {
+        if (timer_wheel_tick(&tw) != expect_fired[tick]) on_time = false;
+    }
+    run_test(11, "Timer Wheel Random Delays + Cancel Fire On Time", on_time && tw.pending == 0);
+    for (int p = 0; p < SCHED_MAX_PRIORITIES; p++) clear_task_ready((uint16_t)p);
+
+    // Test 12: Periodic timer re-arms itself
+    timer_wheel_init(&tw);
+    sched_timer_t periodic;
+    sched_timer_init(&periodic, 3, 100);
+    sched_timer_start(&tw, &periodic, 100);
+    uint32_t fires = timer_wheel_advance(&tw, 1000);
+    run_test(12, "Timer Wheel Periodic (100 ticks x 10)", fires == 10 && sched_timer_is_armed(&periodic));
+    sched_timer_cancel(&tw, &periodic);
+    clear_task_ready(3);
+
+    // Test 13: Delay longer than the wheel's range
+    sched_timer_t far;
+    sched_timer_init(&far, 9, 0);
+    sched_timer_start(&tw, &far, TW_MAX_DELAY + 1000);
+    uint32_t before = timer_wheel_advance(&tw, TW_MAX_DELAY + 999);
+    run_test(13, "Timer Wheel Delay Past TW_MAX_DELAY",
+             before == 0 && timer_wheel_tick(&tw) == 1 && get_highest_priority_task() == 9);
+    clear_task_ready(9);
+
+    printf("\n---------------------------------------\n");
+    if (total_failures == 0) {
+        printf("RESULT: ALL TESTS PASSED ✅\n");
+    } else {
+        printf("RESULT: %d TEST(S) FAILED ❌\n", total_failures);
+    }
+    printf("---------------------------------------\n");
+
+    return (total_failures == 0) ? 0 : 1;
+}
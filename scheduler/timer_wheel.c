@@ -0,0 +1,122 @@
+#include <string.h>
+#include "timer_wheel.h"
+
+void timer_wheel_init(timer_wheel_t *tw) {
+    memset(tw, 0, sizeof(*tw));
+}
+
+void sched_timer_init(sched_timer_t *t, uint16_t priority, uint32_t period) {
+    t->next = NULL;
+    t->pprev = NULL;
+    t->expires = 0;
+    t->period = period;
+    t->priority = priority;
+}
+
+// Hashes a timer into the wheel based on how far away it expires
+static void wheel_link(timer_wheel_t *tw, sched_timer_t *t) {
+    uint64_t delta = t->expires - tw->now;
+    uint64_t key = t->expires;
+    unsigned level = 0;
+
+    if (delta > TW_MAX_DELAY) {
+        // Too far out: park it in the farthest slot. When that slot
+        // cascades, the real expiry is re-hashed again.
+        key = tw->now + TW_MAX_DELAY;
+        delta = TW_MAX_DELAY;
+    }
+
+    while (level < TW_LEVELS - 1 && delta >= (1ULL << ((level + 1) * TW_SLOT_BITS))) {
+        level++;
+    }
+
+    unsigned slot = (unsigned)(key >> (level * TW_SLOT_BITS)) & TW_SLOT_MASK;
+    sched_timer_t **head = &tw->slots[level][slot];
+
+    t->next = *head;
+    if (*head != NULL) (*head)->pprev = &t->next;
+    *head = t;
+    t->pprev = head;
+}
+
+static void wheel_unlink(sched_timer_t *t) {
+    *t->pprev = t->next;
+    if (t->next != NULL) t->next->pprev = t->pprev;
+    t->next = NULL;
+    t->pprev = NULL;
+}
+
+void sched_timer_start(timer_wheel_t *tw, sched_timer_t *t, uint64_t delay) {
+    if (sched_timer_is_armed(t)) {
+        wheel_unlink(t);
+    } else {
+        tw->pending++;
+    }
+
+    t->expires = tw->now + (delay == 0 ? 1 : delay);
+    wheel_link(tw, t);
+}
+
+bool sched_timer_cancel(timer_wheel_t *tw, sched_timer_t *t) {
+    if (!sched_timer_is_armed(t)) return false;
+    wheel_unlink(t);
+    tw->pending--;
+    return true;
+}
+
+// Re-hashes every timer in one higher-level slot into the levels below.
+// Returns true if the next level up must cascade too.
+static bool wheel_cascade(timer_wheel_t *tw, unsigned level) {
+    unsigned slot = (unsigned)(tw->now >> (level * TW_SLOT_BITS)) & TW_SLOT_MASK;
+
+    sched_timer_t *list = tw->slots[level][slot];
+    tw->slots[level][slot] = NULL;
+
+    while (list != NULL) {
+        sched_timer_t *next = list->next;
+        wheel_link(tw, list);
+        list = next;
+    }
+    return slot == 0;
+}
+
+uint32_t timer_wheel_tick(timer_wheel_t *tw) {
+    tw->now++;
+
+    // Level 0 wrapped: pull the next block of timers down from above
+    unsigned slot = (unsigned)tw->now & TW_SLOT_MASK;
+    if (slot == 0) {
+        for (unsigned level = 1; level < TW_LEVELS; level++) {
+            if (!wheel_cascade(tw, level)) break;
+        }
+    }
+
+    // Detach the due list first so callbacks may re-arm timers safely
+    sched_timer_t *list = tw->slots[0][slot];
+    tw->slots[0][slot] = NULL;
+
+    uint32_t fired = 0;
+    while (list != NULL) {
+        sched_timer_t *t = list;
+        list = t->next;
+        t->next = NULL;
+        t->pprev = NULL;
+
+        tw->pending--;
+        fired++;
+        set_task_ready(t->priority);
+
+        if (t->period != 0) {
+            sched_timer_start(tw, t, t->period);
+        }
+    }
+    return fired;
+}
+
+uint32_t timer_wheel_advance(timer_wheel_t *tw, uint64_t ticks) {
+    uint32_t fired = 0;
+    while (ticks-- > 0) {
+        fired += timer_wheel_tick(tw);
+    }
+    return fired;
+}
@@ -0,0 +1,82 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+/*
+ * Hashed hierarchical timer wheel (Varghese & Lauck), as used by the
+ * Linux kernel for its classic timer list.
+ *
+ * TW_LEVELS wheels of TW_SLOTS slots each. Level 0 holds timers due in the
+ * next 64 ticks, one slot per tick. Level 1 slots cover 64 ticks each,
+ * level 2 slots 64 * 64 ticks, and so on. When level 0 wraps, the next
+ * level-1 slot is "cascaded": its timers are re-hashed into level 0.
+ *
+ * - Insert: pick level + slot from the expiry time, link into a list. O(1)
+ * - Cancel: unlink from a doubly linked list. O(1)
+ * - Tick:   run one level-0 slot, occasionally cascade. Amortized O(1)
+ *           (a timer is cascaded at most TW_LEVELS - 1 times)
+ *
+ * On expiry a timer calls set_task_ready(priority) to wake its task.
+ */
+
+#define TW_LEVELS     4
+#define TW_SLOT_BITS  6
+#define TW_SLOTS      (1u << TW_SLOT_BITS)
+#define TW_SLOT_MASK  (TW_SLOTS - 1)
+#define TW_MAX_DELAY  ((1ULL << (TW_LEVELS * TW_SLOT_BITS)) - 1) // ~16.7M ticks
+
+typedef struct sched_timer {
+    struct sched_timer *next;
+    struct sched_timer **pprev;   // Address of the pointer that points at us
+    uint64_t expires;             // Absolute tick
+    uint32_t period;              // 0 = one-shot, else re-armed every 'period' ticks
+    uint16_t priority;            // Task woken via set_task_ready()
+} sched_timer_t;
+
+typedef struct {
+    uint64_t now;                                 // Current tick
+    sched_timer_t *slots[TW_LEVELS][TW_SLOTS];
+    uint32_t pending;                             // Armed timers
+} timer_wheel_t;
+
+void timer_wheel_init(timer_wheel_t *tw);
+
+/**
+ * @brief Prepares a timer. Must be called once before the first start.
+ * @param period    0 for a one-shot timer, else the reload interval in ticks
+ */
+void sched_timer_init(sched_timer_t *t, uint16_t priority, uint32_t period);
+
+/**
+ * @brief Arms (or re-arms) a timer to expire 'delay' ticks from now. O(1)
+ *        A delay of 0 is treated as 1 (next tick). Delays past TW_MAX_DELAY
+ *        are supported but cost one extra cascade per TW_MAX_DELAY ticks.
+ */
+void sched_timer_start(timer_wheel_t *tw, sched_timer_t *t, uint64_t delay);
+
+/**
+ * @brief Disarms a timer. O(1). Safe to call on a timer that is not armed.
+ * @return true if the timer was armed
+ */
+bool sched_timer_cancel(timer_wheel_t *tw, sched_timer_t *t);
+
+static inline bool sched_timer_is_armed(const sched_timer_t *t) {
+    return t->pprev != NULL;
+}
+
+/**
+ * @brief Advances time by one tick and fires every timer due at the new tick.
+ * @return Number of timers that fired
+ */
+uint32_t timer_wheel_tick(timer_wheel_t *tw);
+
+/**
+ * @brief Advances time by 'ticks' ticks (e.g. after waking from sleep).
+ * @return Number of timers that fired
+ */
+uint32_t timer_wheel_advance(timer_wheel_t *tw, uint64_t ticks);
+
+#endif // TIMER_WHEEL_H
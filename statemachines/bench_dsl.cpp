@@ -0,0 +1,135 @@
+/*
+Coffee Machine Dispatch Benchmark: switch vs fsm_dsl.hpp
+- 4096 CoffeeMachines, 16 rounds of one event per machine, machines reset
+  before every rep, about 2 * 10^8 events per measurement.
+- Two event streams:
+    random   START 40%, TEMP 30%, BREW 29.9%, OUT_OF_WATER 0.1%
+             (as in bench_main.c; the switch's branches mispredict)
+    cycle    every machine sees START, TEMP, BREW, START, ... in step
+             (every branch predictable)
+- Four ways to run the same transitions:
+    FSM_Update        the switch, out of line (fsm_logic.c)
+    FSM_UpdateDsl     CoffeeFsm::dispatch, out of line (fsm_coffee.cpp)
+    switch, inline    the same switch in this file, inlined into the loop
+    dsl, inline       CoffeeFsm::dispatch inlined into the loop
+- Reported in millions of events per second. Final states are checked
+  against FSM_Update().
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include "fsm_coffee.hpp"
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static volatile int sink;
+
+#define MACHINES 4096
+#define ROUNDS 16
+
+// FSM_Update(), copied so the compiler can inline it
+static inline void switch_update(CoffeeMachine* m, Event_t e) {
+    switch (m->currentState) {
+        case STATE_IDLE:
+            if (e == EVENT_START_PRESSED) {
+                if (m->waterLevel > 10) m->currentState = STATE_HEATING;
+                else m->currentState = STATE_ERROR;
+            }
+            break;
+        case STATE_HEATING:
+            if (e == EVENT_TEMP_REACHED) m->currentState = STATE_BREWING;
+            else if (e == EVENT_OUT_OF_WATER) m->currentState = STATE_ERROR;
+            break;
+        case STATE_BREWING:
+            if (e == EVENT_BREW_COMPLETE) m->currentState = STATE_IDLE;
+            break;
+        case STATE_ERROR:
+            break;
+    }
+}
+
+enum Variant { OUT_OF_LINE_SWITCH, OUT_OF_LINE_DSL, INLINE_SWITCH, INLINE_DSL, VARIANTS };
+static const char* const variant_names[VARIANTS] = {
+    "FSM_Update", "FSM_UpdateDsl", "switch, inline", "dsl, inline",
+};
+
+// Runs all rounds with one variant; the switch on 'v' is outside the hot loop
+static void run(Variant v, CoffeeMachine* m, const uint8_t* events) {
+    for (int t = 0; t < ROUNDS; t++) {
+        const uint8_t* round = events + (size_t)t * MACHINES;
+        switch (v) {
+            case OUT_OF_LINE_SWITCH:
+                for (size_t i = 0; i < MACHINES; i++) FSM_Update(&m[i], (Event_t)round[i]);
+                break;
+            case OUT_OF_LINE_DSL:
+                for (size_t i = 0; i < MACHINES; i++) FSM_UpdateDsl(&m[i], (Event_t)round[i]);
+                break;
+            case INLINE_SWITCH:
+                for (size_t i = 0; i < MACHINES; i++) switch_update(&m[i], (Event_t)round[i]);
+                break;
+            default:
+                for (size_t i = 0; i < MACHINES; i++) {
+                    m[i].currentState = CoffeeFsm::dispatch(m[i].currentState, (Event_t)round[i], m[i]);
+                }
+                break;
+        }
+    }
+}
+
+static void bench_stream(const char* label, const CoffeeMachine* initial, const uint8_t* events) {
+    static CoffeeMachine machines[MACHINES], expected[MACHINES];
+    memcpy(expected, initial, sizeof(expected));
+    run(OUT_OF_LINE_SWITCH, expected, events);
+
+    const int reps = 200000000 / (MACHINES * ROUNDS);
+    printf("  %s (%d reps)\n", label, reps);
+    for (int v = 0; v < VARIANTS; v++) {
+        uint64_t total_ns = 0;
+        for (int r = 0; r < reps; r++) {
+            memcpy(machines, initial, sizeof(machines));
+            uint64_t start = now_ns();
+            run((Variant)v, machines, events);
+            total_ns += now_ns() - start;
+        }
+        bool same = memcmp(machines, expected, sizeof(machines)) == 0;
+        printf("    %-15s %7.0f M/s%s\n", variant_names[v],
+               (double)MACHINES * ROUNDS * reps / (total_ns / 1e3), same ? "" : "  MISMATCH");
+        sink = machines[0].currentState;
+    }
+}
+
+int main() {
+    static CoffeeMachine initial[MACHINES];
+    static uint8_t random_events[MACHINES * ROUNDS], cycle_events[MACHINES * ROUNDS];
+    for (size_t i = 0; i < MACHINES; i++) {
+        int water = xorshift32() % 20 == 0 ? (int)(xorshift32() % 11) : 11 + (int)(xorshift32() % 90);
+        initial[i] = CoffeeMachine{STATE_IDLE, water, 20};
+    }
+    for (size_t k = 0; k < MACHINES * ROUNDS; k++) {
+        uint32_t r = xorshift32() % 1000;
+        random_events[k] = r < 400 ? EVENT_START_PRESSED : r < 700 ? EVENT_TEMP_REACHED
+                         : r < 999 ? EVENT_BREW_COMPLETE : EVENT_OUT_OF_WATER;
+        cycle_events[k] = (uint8_t)((k / MACHINES) % 3);     // START, TEMP, BREW, ...
+    }
+
+    printf("--- Coffee dispatch: switch vs CoffeeFsm (%d machines, %d rounds) ---\n", MACHINES, ROUNDS);
+    bench_stream("random", initial, random_events);
+    bench_stream("cycle", initial, cycle_events);
+    return 0;
+}
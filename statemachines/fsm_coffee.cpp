@@ -0,0 +1,5 @@
+#include "fsm_coffee.hpp"
+
+void FSM_UpdateDsl(CoffeeMachine* m, Event_t e) {
+    m->currentState = CoffeeFsm::dispatch(m->currentState, e, *m);
+}
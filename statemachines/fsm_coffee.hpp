@@ -0,0 +1,40 @@
+#ifndef FSM_COFFEE_HPP
+#define FSM_COFFEE_HPP
+
+#include "fsm_logic.h"
+#include "fsm_dsl.hpp"
+
+/*
+ * FSM_Update() in the fsm_dsl.hpp DSL. Every (state, event) pair the
+ * switch silently falls through is named in an fsm::ignore here, so adding
+ * a state or event without deciding what it does stops the build.
+ */
+
+// waterLevel > 10, the check FSM_Update() makes before heating
+struct HasWater {
+    static bool check(const CoffeeMachine& m) { return m.waterLevel > 10; }
+};
+
+using CoffeeFsm = fsm::machine<CoffeeMachine,
+    fsm::states<STATE_IDLE, STATE_HEATING, STATE_BREWING, STATE_ERROR>,
+    fsm::events<EVENT_START_PRESSED, EVENT_TEMP_REACHED, EVENT_BREW_COMPLETE, EVENT_OUT_OF_WATER>,
+    fsm::initial<STATE_IDLE>,
+
+    fsm::transition<STATE_IDLE, EVENT_START_PRESSED, STATE_HEATING, HasWater>,
+    fsm::transition<STATE_IDLE, EVENT_START_PRESSED, STATE_ERROR>,
+    fsm::ignore<STATE_IDLE, EVENT_TEMP_REACHED, EVENT_BREW_COMPLETE, EVENT_OUT_OF_WATER>,
+
+    fsm::transition<STATE_HEATING, EVENT_TEMP_REACHED, STATE_BREWING>,
+    fsm::transition<STATE_HEATING, EVENT_OUT_OF_WATER, STATE_ERROR>,
+    fsm::ignore<STATE_HEATING, EVENT_START_PRESSED, EVENT_BREW_COMPLETE>,
+
+    fsm::transition<STATE_BREWING, EVENT_BREW_COMPLETE, STATE_IDLE>,
+    fsm::ignore<STATE_BREWING, EVENT_START_PRESSED, EVENT_TEMP_REACHED, EVENT_OUT_OF_WATER>,
+
+    // Error requires a reset (simplified for this example)
+    fsm::ignore<STATE_ERROR, EVENT_START_PRESSED, EVENT_TEMP_REACHED, EVENT_BREW_COMPLETE, EVENT_OUT_OF_WATER>>;
+
+// Same contract as FSM_Update(), out of line so it can be compared / disassembled
+void FSM_UpdateDsl(CoffeeMachine* m, Event_t e);
+
+#endif // FSM_COFFEE_HPP
@@ -0,0 +1,484 @@
+#ifndef FSM_DSL_HPP
+#define FSM_DSL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Compile-Time State Machine DSL (C++17, header only)
+ *
+ * The machine is a type: states, events and transitions are template
+ * arguments, and everything about them is worked out by the compiler.
+ *
+ *   using Fsm = fsm::machine<Context,
+ *       fsm::states<IDLE, RUNNING>,
+ *       fsm::events<START, STOP>,
+ *       fsm::initial<IDLE>,
+ *       fsm::transition<IDLE, START, RUNNING, HasPower>,   // Guard: first that holds wins
+ *       fsm::transition<IDLE, START, IDLE, none, Beep>,    // Unguarded 'else', with an action
+ *       fsm::ignore<IDLE, STOP>,                           // Explicitly nothing to do
+ *       fsm::transition<RUNNING, STOP, IDLE>,
+ *       fsm::ignore<RUNNING, START>>;                      // Already running
+ *
+ *   state = Fsm::dispatch(state, event, context);
+ *
+ * Checked at compile time (static_assert):
+ *   - every state / event used is in the lists, and each list has one enum type
+ *   - every (state, event) pair is either handled or explicitly ignored
+ *   - no transition is shadowed by an earlier unguarded one for its pair
+ *   - every state is reachable from the initial state
+ *
+ * Dispatch: state and event map to dense indices (the identity when the
+ * enum values are 0 .. N-1 in order, else a constexpr direct-mapped table,
+ * a perfect hash over the value range). Guards are evaluated once per
+ * event into a bitmask, one bit per guarded transition. Then:
+ *   - flat (pairs x 2^guards <= FSM_DSL_FLAT_LIMIT): (pair, guard bits)
+ *     indexes a constexpr table of precomputed outcomes, one load;
+ *   - chained (bigger machines): the pair indexes up to L options, L =
+ *     longest guard chain, and the first whose guard bit is set wins,
+ *     picked with masks.
+ * Either way: no virtual call, no function pointer, no heap, no branch
+ * on the event. Actions run after the choice, through an inlined compare
+ * chain.
+ *
+ * Guards are types with 'static bool check(const Context&)', actions
+ * types with 'static void run(Context&)'. Since every guard is evaluated
+ * for every event, guards must be cheap and free of side effects.
+ */
+
+// Largest flat table (entries) before dispatch() switches to the chained one
+#ifndef FSM_DSL_FLAT_LIMIT
+#define FSM_DSL_FLAT_LIMIT 4096
+#endif
+
+namespace fsm {
+
+template <auto... Values> struct states {};
+template <auto... Values> struct events {};
+template <auto State> struct initial {};
+
+// No guard / no action
+struct none {};
+
+template <auto From, auto Event, auto To, typename Guard = none, typename Action = none>
+struct transition {};
+
+// Events that 'State' deliberately ignores; none listed = every event it does not handle
+template <auto State, auto... Events>
+struct ignore {};
+
+namespace detail {
+
+template <auto A, auto B>
+constexpr bool equal() {
+    if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+        return A == B;
+    } else {
+        return false;
+    }
+}
+
+template <auto V, auto... Vs>
+constexpr int index_of() {
+    int i = 0, found = -1;
+    ((found = (found < 0 && equal<V, Vs>()) ? i : found, ++i), ...);
+    return found;
+}
+
+template <auto V, auto... Vs>
+constexpr bool same_type() {
+    return (std::is_same_v<decltype(V), decltype(Vs)> && ...);
+}
+
+// Value -> dense index for a list of enum values
+template <auto... Vs>
+struct dense {
+    using type = std::common_type_t<decltype(Vs)...>;
+    using raw = std::underlying_type_t<type>;
+    static constexpr std::size_t count = sizeof...(Vs);
+    static constexpr std::array<type, count> values = {Vs...};
+
+    static constexpr long long lowest() {
+        long long lo = (long long)values[0];
+        for (type v : values) lo = (long long)v < lo ? (long long)v : lo;
+        return lo;
+    }
+    static constexpr long long highest() {
+        long long hi = (long long)values[0];
+        for (type v : values) hi = (long long)v > hi ? (long long)v : hi;
+        return hi;
+    }
+    static constexpr bool identity() {
+        for (std::size_t i = 0; i < count; i++) {
+            if ((long long)values[i] != (long long)i) return false;
+        }
+        return true;
+    }
+    static constexpr long long span = highest() - lowest() + 1;
+    static_assert(span <= 256, "fsm: enum values must lie within 256 of each other");
+
+    static constexpr std::array<std::uint8_t, (std::size_t)span> make_map() {
+        std::array<std::uint8_t, (std::size_t)span> map{};
+        for (std::size_t i = 0; i < count; i++) map[(std::size_t)((long long)values[i] - lowest())] = (std::uint8_t)i;
+        return map;
+    }
+    static constexpr std::array<std::uint8_t, (std::size_t)span> map = make_map();
+
+    static constexpr std::size_t index(type v) {
+        if constexpr (identity()) {
+            return (std::size_t)(raw)v;
+        } else {
+            return map[(std::size_t)((long long)(raw)v - lowest())];
+        }
+    }
+};
+
+// What one rule says, in dense indices
+struct rule_info {
+    bool is_transition;
+    int from;               // -1: not a declared state
+    int to;
+    std::uint64_t events;   // Event bits this rule covers (0: unknown event)
+    bool guarded;
+    bool has_action;
+    bool blanket;           // fsm::ignore<State> without events
+};
+
+template <typename Rule, typename States, typename Events> struct describe;
+
+template <auto From, auto Event, auto To, typename Guard, typename Action, auto... S, auto... E>
+struct describe<transition<From, Event, To, Guard, Action>, states<S...>, events<E...>> {
+    static constexpr int e = index_of<Event, E...>();
+    static constexpr rule_info value = {
+        true, index_of<From, S...>(), index_of<To, S...>(), e < 0 ? 0 : std::uint64_t(1) << e,
+        !std::is_same_v<Guard, none>, !std::is_same_v<Action, none>, false,
+    };
+};
+
+template <auto State, auto... Ignored, auto... S, auto... E>
+struct describe<ignore<State, Ignored...>, states<S...>, events<E...>> {
+    static constexpr std::uint64_t mask() {
+        if constexpr (sizeof...(Ignored) == 0) {
+            return sizeof...(E) == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << sizeof...(E)) - 1;
+        } else {
+            int idx[] = {index_of<Ignored, E...>()...};
+            std::uint64_t m = 0;
+            for (int i : idx) {
+                if (i < 0) return 0;
+                m |= std::uint64_t(1) << i;
+            }
+            return m;
+        }
+    }
+    static constexpr rule_info value = {false, index_of<State, S...>(), 0, mask(), false, false, sizeof...(Ignored) == 0};
+};
+
+template <typename Rule> struct parts {
+    using guard = none;
+    using action = none;
+};
+template <auto From, auto Event, auto To, typename Guard, typename Action>
+struct parts<transition<From, Event, To, Guard, Action>> {
+    using guard = Guard;
+    using action = Action;
+};
+
+inline constexpr std::uint64_t single_event(std::uint64_t events) {
+    int i = 0;
+    while (events != 0 && !(events & 1)) {
+        events >>= 1;
+        i++;
+    }
+    return (std::uint64_t)i;
+}
+
+} // namespace detail
+
+template <typename Context, typename States, typename Events, typename Initial, typename... Rules>
+class machine;
+
+template <typename Context, auto... S, auto... E, auto Init, typename... Rules>
+class machine<Context, states<S...>, events<E...>, initial<Init>, Rules...> {
+    static_assert(sizeof...(S) > 0 && sizeof...(E) > 0, "fsm: need at least one state and one event");
+    static_assert(detail::same_type<S...>(), "fsm: all states must have one enum type");
+    static_assert(detail::same_type<E...>(), "fsm: all events must have one enum type");
+
+    using state_map = detail::dense<S...>;
+    using event_map = detail::dense<E...>;
+
+public:
+    using state_type = typename state_map::type;
+    using event_type = typename event_map::type;
+    static_assert(std::is_enum_v<state_type> && std::is_enum_v<event_type>, "fsm: states and events are enums");
+
+    static constexpr std::size_t state_count = sizeof...(S);
+    static constexpr std::size_t event_count = sizeof...(E);
+    static_assert(state_count <= 255 && event_count <= 64, "fsm: at most 255 states and 64 events");
+    static constexpr state_type initial_state = Init;
+
+private:
+    static constexpr std::size_t rule_count = sizeof...(Rules);
+    static constexpr std::array<detail::rule_info, rule_count + 1> rules = {
+        detail::describe<Rules, states<S...>, events<E...>>::value..., detail::rule_info{},
+    };
+
+    // --- Validation ---
+
+    static constexpr bool names_known() {
+        for (std::size_t r = 0; r < rule_count; r++) {
+            const detail::rule_info& i = rules[r];
+            if (i.from < 0 || i.to < 0 || i.events == 0) return false;
+        }
+        return true;
+    }
+
+    // Each transition's pair, as from * event_count + event
+    static constexpr std::size_t pair_of(const detail::rule_info& i) {
+        return (std::size_t)i.from * event_count + (std::size_t)detail::single_event(i.events);
+    }
+
+    static constexpr bool none_shadowed() {
+        for (std::size_t r = 0; r < rule_count; r++) {
+            if (!rules[r].is_transition) continue;
+            for (std::size_t q = 0; q < r; q++) {
+                if (rules[q].is_transition && !rules[q].guarded && pair_of(rules[q]) == pair_of(rules[r])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // A transition and a named (not blanket) ignore for the same pair
+    static constexpr bool no_conflicts() {
+        for (std::size_t r = 0; r < rule_count; r++) {
+            if (rules[r].is_transition || rules[r].blanket) continue;
+            for (std::size_t q = 0; q < rule_count; q++) {
+                if (rules[q].is_transition && rules[q].from == rules[r].from && (rules[q].events & rules[r].events)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static constexpr bool all_covered() {
+        for (std::size_t s = 0; s < state_count; s++) {
+            std::uint64_t covered = 0;
+            for (std::size_t r = 0; r < rule_count; r++) {
+                if (rules[r].from == (int)s) covered |= rules[r].events;
+            }
+            for (std::size_t e = 0; e < event_count; e++) {
+                if (!(covered & (std::uint64_t(1) << e))) return false;
+            }
+        }
+        return true;
+    }
+
+    static constexpr bool all_reachable() {
+        std::array<bool, state_count> seen{};
+        seen[state_map::index(Init)] = true;
+        for (bool grew = true; grew;) {
+            grew = false;
+            for (std::size_t r = 0; r < rule_count; r++) {
+                const detail::rule_info& i = rules[r];
+                if (i.is_transition && seen[(std::size_t)i.from] && !seen[(std::size_t)i.to]) {
+                    seen[(std::size_t)i.to] = grew = true;
+                }
+            }
+        }
+        for (bool s : seen) {
+            if (!s) return false;
+        }
+        return true;
+    }
+
+    static_assert(detail::index_of<Init, S...>() >= 0, "fsm: the initial state is not in the state list");
+    static_assert(names_known(), "fsm: a rule names a state or event that is not in the lists");
+    // The rest only make sense once every name resolved
+    static constexpr bool known = names_known() && detail::index_of<Init, S...>() >= 0;
+    static_assert(!known || none_shadowed(), "fsm: a transition follows an unguarded one for the same state and event");
+    static_assert(!known || no_conflicts(), "fsm: a (state, event) pair is both handled and ignored");
+    static_assert(!known || all_covered(), "fsm: a (state, event) pair has no transition; add one or an fsm::ignore");
+    static_assert(!known || all_reachable(), "fsm: a state cannot be reached from the initial state");
+
+    // --- Tables ---
+
+    static constexpr std::size_t pair_count = state_count * event_count;
+
+    static constexpr std::size_t guard_count() {
+        std::size_t n = 0;
+        for (std::size_t r = 0; r < rule_count; r++) n += rules[r].guarded;
+        return n;
+    }
+    static constexpr std::size_t G = guard_count();
+    static_assert(G <= 62, "fsm: at most 62 guarded transitions");
+
+    // Bit of rule r in guard_bits(): the guarded rules in order
+    static constexpr std::uint8_t guard_bit(std::size_t r) {
+        std::uint8_t bit = 0;
+        for (std::size_t q = 0; q < r; q++) bit += rules[q].guarded;
+        return bit;
+    }
+
+    // Action id of rule r: 0 = none, 1.. = the rules with actions in order
+    static constexpr std::uint8_t action_id(std::size_t r) {
+        if (!rules[r].has_action) return 0;
+        std::uint8_t id = 1;
+        for (std::size_t q = 0; q < r; q++) id += rules[q].has_action;
+        return id;
+    }
+    static constexpr bool has_actions = (false || ... || !std::is_same_v<typename detail::parts<Rules>::action, none>);
+
+    struct result {
+        std::uint8_t to;        // Dense state index
+        std::uint8_t action;
+    };
+
+    // What pair p does when the guards evaluate to 'bits'
+    static constexpr result resolve(std::size_t p, std::uint64_t bits) {
+        for (std::size_t r = 0; r < rule_count; r++) {
+            if (rules[r].is_transition && pair_of(rules[r]) == p &&
+                (!rules[r].guarded || ((bits >> guard_bit(r)) & 1))) {
+                return {(std::uint8_t)rules[r].to, action_id(r)};
+            }
+        }
+        return {(std::uint8_t)(p / event_count), 0};
+    }
+
+    // Flat layout: one result per (pair, guard bits), looked up directly
+    static constexpr bool flat = G <= 12 && (pair_count << G) <= FSM_DSL_FLAT_LIMIT;
+    static constexpr std::size_t flat_size = flat ? pair_count << G : 1;
+
+    static constexpr std::array<result, flat_size> make_flat() {
+        std::array<result, flat_size> table{};
+        if constexpr (flat) {
+            for (std::size_t i = 0; i < flat_size; i++) table[i] = resolve(i >> G, i & ((std::uint64_t(1) << G) - 1));
+        }
+        return table;
+    }
+    static constexpr std::array<result, flat_size> flat_table = make_flat();
+
+    // Chained layout: up to L options per pair, L = longest guard chain
+    static constexpr std::size_t chain_length() {
+        std::size_t longest = 1;
+        for (std::size_t p = 0; p < pair_count; p++) {
+            std::size_t n = 0;
+            for (std::size_t r = 0; r < rule_count; r++) n += rules[r].is_transition && pair_of(rules[r]) == p;
+            longest = n > longest ? n : longest;
+        }
+        return longest;
+    }
+    static constexpr std::size_t L = chain_length();
+
+    struct option {
+        std::uint8_t bit;       // Bit of (guard_bits() << 2 | 1) that must be set: 0 always, 1 never
+        std::uint8_t to;
+        std::uint8_t action;
+    };
+    struct cell {
+        option opt[L];
+    };
+
+    static constexpr std::array<cell, pair_count> make_chains() {
+        std::array<cell, pair_count> table{};
+        for (std::size_t p = 0; p < pair_count; p++) {
+            for (std::size_t k = 0; k < L; k++) table[p].opt[k] = {1, (std::uint8_t)(p / event_count), 0};
+            std::size_t k = 0;
+            for (std::size_t r = 0; r < rule_count; r++) {
+                if (rules[r].is_transition && pair_of(rules[r]) == p) {
+                    std::uint8_t bit = rules[r].guarded ? (std::uint8_t)(guard_bit(r) + 2) : 0;
+                    table[p].opt[k++] = {bit, (std::uint8_t)rules[r].to, action_id(r)};
+                }
+            }
+        }
+        return table;
+    }
+    static constexpr std::array<cell, pair_count> chains = make_chains();
+
+    template <std::size_t... R>
+    static std::uint64_t guard_bits(const Context& ctx, std::index_sequence<R...>) {
+        std::uint64_t bits = 0;
+        ((bits |= rules[R].guarded ? std::uint64_t(check<Rules>(ctx)) << guard_bit(R) : 0), ...);
+        return bits;
+    }
+
+    template <typename Rule>
+    static bool check(const Context& ctx) {
+        using Guard = typename detail::parts<Rule>::guard;
+        if constexpr (std::is_same_v<Guard, none>) {
+            (void)ctx;
+            return true;
+        } else {
+            return Guard::check(ctx);
+        }
+    }
+
+    template <std::size_t... R>
+    static void run_action(std::uint8_t id, Context& ctx, std::index_sequence<R...>) {
+        ((void)(rules[R].has_action && id == action_id(R) ? (run<Rules>(ctx), 0) : 0), ...);
+    }
+
+    template <typename Rule>
+    static void run(Context& ctx) {
+        using A = typename detail::parts<Rule>::action;
+        if constexpr (!std::is_same_v<A, none>) A::run(ctx);
+        (void)ctx;
+    }
+
+    static __attribute__((always_inline)) inline state_type finish(result r, Context& ctx) {
+        if constexpr (has_actions) {
+            if (r.action != 0) run_action(r.action, ctx, std::index_sequence_for<Rules...>{});
+        }
+        (void)ctx;
+        if constexpr (state_map::identity()) {
+            return (state_type)r.to;
+        } else {
+            return state_map::values[r.to];
+        }
+    }
+
+public:
+    // Whether dispatch() uses the flat table (else the chained one)
+    static constexpr bool uses_flat_table = flat;
+    static constexpr std::size_t options_per_pair = L;
+
+    /**
+     * @brief Delivers 'event' to a machine in 'state' with data 'ctx'.
+     * @return The next state (the same one if nothing fired)
+     */
+    static __attribute__((always_inline)) inline state_type dispatch(state_type state, event_type event, Context& ctx) {
+        if constexpr (flat) {
+            const std::size_t p = state_map::index(state) * event_count + event_map::index(event);
+            const std::uint64_t bits = guard_bits(ctx, std::index_sequence_for<Rules...>{});
+            return finish(flat_table[(p << G) | bits], ctx);
+        } else {
+            return dispatch_chained(state, event, ctx);
+        }
+    }
+
+    // dispatch() through the chained table whatever the size (for tests)
+    static __attribute__((always_inline)) inline state_type dispatch_chained(state_type state, event_type event,
+                                                                             Context& ctx) {
+        const std::size_t s = state_map::index(state);
+        const cell& c = chains[s * event_count + event_map::index(event)];
+        const std::uint64_t bits = guard_bits(ctx, std::index_sequence_for<Rules...>{}) << 2 | 1;
+
+        // Last option first, so the first one whose guard holds is the one
+        // kept. Masks rather than '?:' so the compiler cannot branch on data.
+        std::uint32_t to = (std::uint32_t)s, action = 0;
+        for (std::size_t k = L; k-- > 0;) {
+            const std::uint32_t take = 0u - (std::uint32_t)((bits >> c.opt[k].bit) & 1);
+            to = (to & ~take) | (c.opt[k].to & take);
+            action = (action & ~take) | (c.opt[k].action & take);
+        }
+        return finish({(std::uint8_t)to, (std::uint8_t)action}, ctx);
+    }
+};
+
+} // namespace fsm
+
+#endif // FSM_DSL_HPP
@@ -22,4 +22,37 @@ void FSM_Update(CoffeeMachine* m, Event_t e) {
             // Error requires a reset (simplified for this example)
             break;
     }
-}
\ No newline at end of file
+}
+
+// --- Table form ---
+
+// FSM_Update() as rules, in the order its ifs are tried
+static const FsmRule COFFEE_RULES[] = {
+    {STATE_IDLE,    EVENT_START_PRESSED, FSM_GT,     COFFEE_WATER_LEVEL, 10, STATE_HEATING, 0},
+    {STATE_IDLE,    EVENT_START_PRESSED, FSM_ALWAYS, 0,                  0,  STATE_ERROR,   0},
+    {STATE_HEATING, EVENT_TEMP_REACHED,  FSM_ALWAYS, 0,                  0,  STATE_BREWING, 0},
+    {STATE_HEATING, EVENT_OUT_OF_WATER,  FSM_ALWAYS, 0,                  0,  STATE_ERROR,   0},
+    {STATE_BREWING, EVENT_BREW_COMPLETE, FSM_ALWAYS, 0,                  0,  STATE_IDLE,    0},
+    // STATE_ERROR: requires a reset, nothing leaves it
+};
+
+bool FSM_Compile(FsmTable* table) {
+    return fsm_compile(table, COFFEE_RULES, sizeof(COFFEE_RULES) / sizeof(COFFEE_RULES[0]),
+                       STATE_ERROR + 1, EVENT_OUT_OF_WATER + 1, NULL, 0);
+}
+
+void FSM_StoreFleet(FsmFleet* fleet, const CoffeeMachine* machines, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        fleet->state[i] = (uint8_t)machines[i].currentState;
+        fleet->field[COFFEE_WATER_LEVEL][i] = machines[i].waterLevel;
+        fleet->field[COFFEE_CURRENT_TEMP][i] = machines[i].currentTemp;
+    }
+}
+
+void FSM_LoadFleet(const FsmFleet* fleet, CoffeeMachine* machines, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        machines[i].currentState = (State_t)fleet->state[i];
+        machines[i].waterLevel = fleet->field[COFFEE_WATER_LEVEL][i];
+        machines[i].currentTemp = fleet->field[COFFEE_CURRENT_TEMP][i];
+    }
+}
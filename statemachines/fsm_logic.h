@@ -1,3 +1,13 @@
+#ifndef FSM_LOGIC_H
+#define FSM_LOGIC_H
+
+#include <stddef.h>
+#include "fsm_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef enum {
     STATE_IDLE,
     STATE_HEATING,
@@ -20,4 +30,26 @@ typedef struct {
 } CoffeeMachine;
 
 // Function to process events
-void FSM_Update(CoffeeMachine* m, Event_t e);
\ No newline at end of file
+void FSM_Update(CoffeeMachine* m, Event_t e);
+
+// --- The same machine for fsm_table.h fleets ---
+
+// Columns of a coffee machine fleet
+enum {
+    COFFEE_WATER_LEVEL,
+    COFFEE_CURRENT_TEMP,
+    COFFEE_FIELD_COUNT
+};
+
+// Compiles FSM_Update()'s transitions into 'table'
+bool FSM_Compile(FsmTable* table);
+
+// Copies machines[0 .. count) into / out of a fleet made with COFFEE_FIELD_COUNT columns
+void FSM_StoreFleet(FsmFleet* fleet, const CoffeeMachine* machines, size_t count);
+void FSM_LoadFleet(const FsmFleet* fleet, CoffeeMachine* machines, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FSM_LOGIC_H
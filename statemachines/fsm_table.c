@@ -0,0 +1,199 @@
+#include <stdlib.h>
+#include "fsm_table.h"
+
+// --- Compiling ---
+
+// Fills in the guard of 'cell' as an interval test on one column
+static void compile_guard(FsmCell* cell, const FsmRule* r) {
+    cell->lo = INT32_MIN;
+    cell->hi = INT32_MAX;
+    cell->invert = 0;
+    cell->field = r->op == FSM_ALWAYS ? 0 : r->field;
+    switch (r->op) {
+        case FSM_GT:
+            if (r->value == INT32_MAX) cell->invert = 1;    // Never holds
+            else cell->lo = r->value + 1;
+            break;
+        case FSM_GE: cell->lo = r->value; break;
+        case FSM_LT:
+            if (r->value == INT32_MIN) cell->invert = 1;
+            else cell->hi = r->value - 1;
+            break;
+        case FSM_LE: cell->hi = r->value; break;
+        case FSM_EQ: cell->lo = cell->hi = r->value; break;
+        case FSM_NE: cell->lo = cell->hi = r->value; cell->invert = 1; break;
+        default: break;
+    }
+}
+
+static bool rule_valid(const FsmRule* r, uint8_t nstates, uint8_t nevents, const FsmAction* actions,
+                       size_t nactions) {
+    if (r->from >= nstates || r->to >= nstates || r->event >= nevents) return false;
+    if (r->op > FSM_NE || (r->op != FSM_ALWAYS && r->field >= FSM_MAX_FIELDS)) return false;
+    return r->action == 0 || (r->action <= nactions && actions[r->action - 1] != NULL);
+}
+
+bool fsm_compile(FsmTable* table, const FsmRule* rules, size_t nrules, uint8_t nstates, uint8_t nevents,
+                 const FsmAction* actions, size_t nactions) {
+    if (nstates == 0 || nevents == 0 || nactions > FSM_MAX_ACTIONS) {
+        return false;
+    }
+    size_t base = (size_t)nstates * nevents;
+    FsmCell* cells = malloc((base + nrules) * sizeof(FsmCell));
+    uint32_t* tail = malloc(base * sizeof(uint32_t));     // Last cell of each pair's chain
+    uint8_t* closed = calloc(base, 1);                      // Pair ends in an unguarded rule
+    if (cells == NULL || tail == NULL || closed == NULL) {
+        free(cells);
+        free(tail);
+        free(closed);
+        return false;
+    }
+
+    // Every pair starts as "stay put"
+    for (size_t p = 0; p < base; p++) {
+        uint8_t s = (uint8_t)(p / nevents);
+        cells[p] = (FsmCell){INT32_MIN, INT32_MAX, 0, 0, {s, s}, {0, 0}, FSM_NO_CELL};
+        tail[p] = UINT32_MAX;
+    }
+
+    size_t ncells = base;
+    uint8_t nfields = 1;
+    bool ok = true;
+    for (size_t k = 0; k < nrules; k++) {
+        const FsmRule* r = &rules[k];
+        if (!rule_valid(r, nstates, nevents, actions, nactions)) {
+            ok = false;
+            break;
+        }
+        size_t p = (size_t)r->from * nevents + r->event;
+        if (closed[p]) {
+            ok = false;                 // Shadowed by an earlier unguarded rule
+            break;
+        }
+        if (r->op != FSM_ALWAYS && r->field + 1 > nfields) nfields = r->field + 1;
+
+        FsmCell* cell;
+        if (tail[p] == UINT32_MAX) {
+            cell = &cells[p];
+            tail[p] = (uint32_t)p;
+        } else if (r->op == FSM_ALWAYS) {
+            // The 'else' of the previous guard: fold into its cell
+            cells[tail[p]].to[0] = r->to;
+            cells[tail[p]].action[0] = r->action;
+            closed[p] = 1;
+            continue;
+        } else {
+            if (ncells >= FSM_NO_CELL) {
+                ok = false;
+                break;
+            }
+            cells[tail[p]].next = (uint16_t)ncells;
+            tail[p] = (uint32_t)ncells;
+            cell = &cells[ncells++];
+            *cell = (FsmCell){0, 0, 0, 0, {r->from, r->from}, {0, 0}, FSM_NO_CELL};
+        }
+        compile_guard(cell, r);
+        cell->to[1] = r->to;
+        cell->action[1] = r->action;
+        if (r->op == FSM_ALWAYS) {
+            cell->to[0] = r->to;
+            cell->action[0] = r->action;
+            closed[p] = 1;
+        }
+    }
+    free(tail);
+    free(closed);
+    if (!ok) {
+        free(cells);
+        return false;
+    }
+
+    table->cells = cells;
+    table->ncells = ncells;
+    table->nstates = nstates;
+    table->nevents = nevents;
+    table->nfields = nfields;
+    table->has_actions = false;
+    for (size_t a = 0; a < FSM_MAX_ACTIONS; a++) {
+        table->actions[a] = a < nactions ? actions[a] : NULL;
+        table->has_actions |= table->actions[a] != NULL;
+    }
+    return true;
+}
+
+void fsm_table_free(FsmTable* table) {
+    free(table->cells);
+    table->cells = NULL;
+    table->ncells = 0;
+}
+
+// --- Fleet ---
+
+bool fsm_fleet_init(FsmFleet* fleet, size_t count, size_t nfields, uint8_t state) {
+    if (nfields > FSM_MAX_FIELDS) {
+        return false;
+    }
+    if (nfields == 0) nfields = 1;      // Unguarded cells still read column 0
+
+    size_t bytes = count > 0 ? count : 1;
+    fleet->state = malloc(bytes);
+    fleet->nfields = nfields;
+    fleet->count = count;
+    bool ok = fleet->state != NULL;
+    for (size_t f = 0; f < FSM_MAX_FIELDS; f++) {
+        fleet->field[f] = f < nfields ? calloc(bytes, sizeof(int32_t)) : NULL;
+        ok &= f >= nfields || fleet->field[f] != NULL;
+    }
+    if (!ok) {
+        fsm_fleet_free(fleet);
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) fleet->state[i] = state;
+    return true;
+}
+
+void fsm_fleet_free(FsmFleet* fleet) {
+    free(fleet->state);
+    fleet->state = NULL;
+    for (size_t f = 0; f < FSM_MAX_FIELDS; f++) {
+        free(fleet->field[f]);
+        fleet->field[f] = NULL;
+    }
+    fleet->count = 0;
+}
+
+// --- Running ---
+
+static inline bool guard_holds(const FsmCell* c, const FsmFleet* fleet, size_t i) {
+    uint32_t x = (uint32_t)fleet->field[c->field][i];
+    return (x - (uint32_t)c->lo <= (uint32_t)c->hi - (uint32_t)c->lo) ^ c->invert;
+}
+
+// Delivers event 'e' to machine 'i'. with_actions is a constant at every call site
+static inline void fire(const FsmTable* table, FsmFleet* fleet, size_t i, unsigned e, bool with_actions) {
+    const FsmCell* c = &table->cells[fleet->state[i] * table->nevents + e];
+    bool held = guard_holds(c, fleet, i);
+    while (!held && c->next != FSM_NO_CELL) {
+        c = &table->cells[c->next];
+        held = guard_holds(c, fleet, i);
+    }
+    fleet->state[i] = c->to[held];
+    if (with_actions && c->action[held] != 0) table->actions[c->action[held] - 1](fleet, i);
+}
+
+void fsm_dispatch(const FsmTable* table, FsmFleet* fleet, const uint32_t* machines, const uint8_t* events,
+                  size_t n) {
+    if (table->has_actions) {
+        for (size_t k = 0; k < n; k++) fire(table, fleet, machines[k], events[k], true);
+    } else {
+        for (size_t k = 0; k < n; k++) fire(table, fleet, machines[k], events[k], false);
+    }
+}
+
+void fsm_step(const FsmTable* table, FsmFleet* fleet, const uint8_t* events) {
+    if (table->has_actions) {
+        for (size_t i = 0; i < fleet->count; i++) fire(table, fleet, i, events[i], true);
+    } else {
+        for (size_t i = 0; i < fleet->count; i++) fire(table, fleet, i, events[i], false);
+    }
+}
@@ -0,0 +1,119 @@
+#ifndef FSM_TABLE_H
+#define FSM_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Table-Compiled FSM Engine for Fleets of Machines
+ *
+ * The same idea as FSM_Update()'s nested switch, but as data: a list of
+ * rules (from, event, guard, to, action) is compiled into one dense cell
+ * per (state, event) pair, so a transition is one indexed load plus one
+ * guard compare instead of two switches. Machines live as
+ * structure-of-arrays (one state byte and a few int32 columns each), so
+ * stepping thousands of them walks a few contiguous arrays.
+ *
+ * Guards compare one column against a constant (waterLevel > 10). They
+ * are compiled to "lo <= x <= hi" (or its negation) and checked with one
+ * unsigned compare. Rules for the same (state, event) are tried in the
+ * order given and the first whose guard holds fires; if none does, the
+ * machine stays put. A guarded rule followed by an unguarded one (the
+ * usual if / else) fits in a single cell; longer chains spill into extra
+ * cells linked from the first.
+ */
+
+#define FSM_MAX_FIELDS 8
+#define FSM_MAX_ACTIONS 16
+
+typedef enum {
+    FSM_ALWAYS,         // No guard
+    FSM_GT,             // field >  value
+    FSM_GE,             // field >= value
+    FSM_LT,             // field <  value
+    FSM_LE,             // field <= value
+    FSM_EQ,             // field == value
+    FSM_NE              // field != value
+} FsmGuardOp_t;
+
+typedef struct {
+    uint8_t from;
+    uint8_t event;
+    uint8_t op;         // FsmGuardOp_t
+    uint8_t field;      // Column the guard reads
+    int32_t value;
+    uint8_t to;
+    uint8_t action;     // 0 = none, else index into the action table
+} FsmRule;
+
+// Structure-of-arrays fleet: machine i is state[i], field[0][i], field[1][i], ...
+typedef struct {
+    uint8_t* state;
+    int32_t* field[FSM_MAX_FIELDS];
+    size_t nfields;
+    size_t count;
+} FsmFleet;
+
+// Runs after machine 'i' took a transition that names it
+typedef void (*FsmAction)(FsmFleet* fleet, size_t i);
+
+typedef struct {
+    int32_t lo, hi;     // Guard holds when lo <= x <= hi ...
+    uint8_t invert;     // ... or, if set, when it does not
+    uint8_t field;
+    uint8_t to[2];      // [guard failed, guard held]
+    uint8_t action[2];
+    uint16_t next;      // Cell to try when the guard fails, or FSM_NO_CELL
+} FsmCell;
+
+#define FSM_NO_CELL 0xFFFF
+
+typedef struct {
+    FsmCell* cells;     // [state * nevents + event], then chained cells
+    size_t ncells;
+    uint8_t nstates;
+    uint8_t nevents;
+    uint8_t nfields;    // Columns the guards read (at least 1)
+    bool has_actions;
+    FsmAction actions[FSM_MAX_ACTIONS];
+} FsmTable;
+
+/**
+ * @brief Compiles rules[0 .. nrules) for states 0 .. nstates-1 and events
+ *        0 .. nevents-1. actions[k] is what action k + 1 runs.
+ * @return false if a rule is out of range, can never fire (after an
+ *         unguarded rule for the same pair), or memory runs out
+ */
+bool fsm_compile(FsmTable* table, const FsmRule* rules, size_t nrules, uint8_t nstates, uint8_t nevents,
+                 const FsmAction* actions, size_t nactions);
+void fsm_table_free(FsmTable* table);
+
+/**
+ * @brief All machines start in 'state' with zeroed columns. A fleet run
+ *        through a table needs at least table->nfields columns.
+ * @return false if out of memory
+ */
+bool fsm_fleet_init(FsmFleet* fleet, size_t count, size_t nfields, uint8_t state);
+void fsm_fleet_free(FsmFleet* fleet);
+
+/**
+ * @brief Delivers events[k] to machine machines[k], for k = 0 .. n-1, in
+ *        that order (so several events for one machine are fine).
+ *        Indices and events are not range-checked.
+ */
+void fsm_dispatch(const FsmTable* table, FsmFleet* fleet, const uint32_t* machines, const uint8_t* events,
+                  size_t n);
+
+// One tick: delivers events[i] to machine i for every machine in the fleet
+void fsm_step(const FsmTable* table, FsmFleet* fleet, const uint8_t* events);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FSM_TABLE_H
@@ -0,0 +1,148 @@
+#include <cstdio>
+#include <climits>
+#include "fsm_coffee.hpp"
+
+// --- A second machine: scattered enum values, a guard chain, actions ---
+
+enum class Door : int { Closed = 10, Open = 20, Locked = 40, Alarm = 41 };
+enum class Input : unsigned char { Push = 3, Key = 7, Force = 9 };
+
+struct DoorData {
+    int code;
+    int opened;         // Times the 'Open' action ran
+    int alarms;
+};
+
+struct CodeOk     { static bool check(const DoorData& d) { return d.code == 1234; } };
+struct CodeMaster { static bool check(const DoorData& d) { return d.code == 9999; } };
+struct CodeAny    { static bool check(const DoorData& d) { return d.code != 0; } };
+struct CountOpen  { static void run(DoorData& d) { d.opened++; } };
+struct RaiseAlarm { static void run(DoorData& d) { d.alarms++; } };
+
+using DoorFsm = fsm::machine<DoorData,
+    fsm::states<Door::Closed, Door::Open, Door::Locked, Door::Alarm>,
+    fsm::events<Input::Push, Input::Key, Input::Force>,
+    fsm::initial<Door::Closed>,
+    fsm::transition<Door::Closed, Input::Push, Door::Open, fsm::none, CountOpen>,
+    fsm::transition<Door::Closed, Input::Key, Door::Locked>,
+    fsm::transition<Door::Closed, Input::Force, Door::Alarm, fsm::none, RaiseAlarm>,
+    fsm::transition<Door::Open, Input::Push, Door::Closed>,
+    fsm::ignore<Door::Open>,
+    // Three guards in a row, then stay put
+    fsm::transition<Door::Locked, Input::Key, Door::Closed, CodeOk>,
+    fsm::transition<Door::Locked, Input::Key, Door::Open, CodeMaster, CountOpen>,
+    fsm::transition<Door::Locked, Input::Key, Door::Alarm, CodeAny, RaiseAlarm>,
+    fsm::transition<Door::Locked, Input::Force, Door::Alarm, fsm::none, RaiseAlarm>,
+    fsm::ignore<Door::Locked, Input::Push>,
+    fsm::transition<Door::Alarm, Input::Key, Door::Locked, CodeMaster>,
+    fsm::ignore<Door::Alarm>>;
+
+// The same machine as a switch
+static Door door_switch(Door s, Input in, DoorData& d) {
+    switch (s) {
+        case Door::Closed:
+            if (in == Input::Push) { d.opened++; return Door::Open; }
+            if (in == Input::Key) return Door::Locked;
+            d.alarms++;
+            return Door::Alarm;
+        case Door::Open:
+            return in == Input::Push ? Door::Closed : s;
+        case Door::Locked:
+            if (in == Input::Key) {
+                if (d.code == 1234) return Door::Closed;
+                if (d.code == 9999) { d.opened++; return Door::Open; }
+                if (d.code != 0) { d.alarms++; return Door::Alarm; }
+                return s;
+            }
+            if (in == Input::Force) { d.alarms++; return Door::Alarm; }
+            return s;
+        case Door::Alarm:
+            return in == Input::Key && d.code == 9999 ? Door::Locked : s;
+    }
+    return s;
+}
+
+// --- Compile-time checks: each of these must fail to build ---
+// g++ -std=c++17 -DFSM_DSL_BROKEN=<1..5> -fsyntax-only test_dsl.cpp
+
+#if FSM_DSL_BROKEN == 1      // BREWING + TEMP_REACHED neither handled nor ignored
+using Broken = fsm::machine<CoffeeMachine,
+    fsm::states<STATE_IDLE, STATE_BREWING>, fsm::events<EVENT_START_PRESSED, EVENT_TEMP_REACHED>,
+    fsm::initial<STATE_IDLE>,
+    fsm::transition<STATE_IDLE, EVENT_START_PRESSED, STATE_BREWING>, fsm::ignore<STATE_IDLE>,
+    fsm::transition<STATE_BREWING, EVENT_START_PRESSED, STATE_IDLE>>;
+#elif FSM_DSL_BROKEN == 2    // STATE_ERROR is never entered
+using Broken = fsm::machine<CoffeeMachine,
+    fsm::states<STATE_IDLE, STATE_ERROR>, fsm::events<EVENT_START_PRESSED>, fsm::initial<STATE_IDLE>,
+    fsm::ignore<STATE_IDLE>, fsm::ignore<STATE_ERROR>>;
+#elif FSM_DSL_BROKEN == 3    // The guarded rule after the unguarded one can never fire
+using Broken = fsm::machine<CoffeeMachine,
+    fsm::states<STATE_IDLE, STATE_ERROR>, fsm::events<EVENT_START_PRESSED>, fsm::initial<STATE_IDLE>,
+    fsm::transition<STATE_IDLE, EVENT_START_PRESSED, STATE_ERROR>,
+    fsm::transition<STATE_IDLE, EVENT_START_PRESSED, STATE_IDLE, HasWater>, fsm::ignore<STATE_ERROR>>;
+#elif FSM_DSL_BROKEN == 4    // STATE_HEATING is not a declared state
+using Broken = fsm::machine<CoffeeMachine,
+    fsm::states<STATE_IDLE>, fsm::events<EVENT_START_PRESSED>, fsm::initial<STATE_IDLE>,
+    fsm::transition<STATE_IDLE, EVENT_START_PRESSED, STATE_HEATING>>;
+#elif FSM_DSL_BROKEN == 5    // Handled and ignored at once
+using Broken = fsm::machine<CoffeeMachine,
+    fsm::states<STATE_IDLE>, fsm::events<EVENT_START_PRESSED>, fsm::initial<STATE_IDLE>,
+    fsm::transition<STATE_IDLE, EVENT_START_PRESSED, STATE_IDLE>, fsm::ignore<STATE_IDLE, EVENT_START_PRESSED>>;
+#endif
+#ifdef FSM_DSL_BROKEN
+static Broken::state_type instantiate = Broken::initial_state;
+#endif
+
+static int total_failures = 0;
+
+static void run_check(int num, const char* desc, bool passed) {
+    printf("[%s] Test %d: %s\n", passed ? "PASS" : "FAIL", num, desc);
+    total_failures += !passed;
+}
+
+int main() {
+    printf("--- fsm_dsl.hpp ---\n");
+
+    // Every state x event x interesting water level against the switch
+    const int levels[] = {INT_MIN, -1, 0, 9, 10, 11, 12, 100, INT_MAX};
+    bool coffee_ok = true;
+    for (int s = STATE_IDLE; s <= STATE_ERROR; s++) {
+        for (int e = EVENT_START_PRESSED; e <= EVENT_OUT_OF_WATER; e++) {
+            for (int water : levels) {
+                CoffeeMachine a = {(State_t)s, water, 20}, b = a, c = a;
+                FSM_Update(&a, (Event_t)e);
+                FSM_UpdateDsl(&b, (Event_t)e);
+                CoffeeMachine d = c;
+                c.currentState = CoffeeFsm::dispatch(c.currentState, (Event_t)e, c);
+                d.currentState = CoffeeFsm::dispatch_chained(d.currentState, (Event_t)e, d);
+                coffee_ok &= a.currentState == b.currentState && a.currentState == c.currentState &&
+                             a.currentState == d.currentState;
+            }
+        }
+    }
+    run_check(1, "CoffeeFsm matches FSM_Update on every state / event / level", coffee_ok);
+    run_check(2, "CoffeeFsm is small enough for the flat table",
+              CoffeeFsm::uses_flat_table && CoffeeFsm::options_per_pair == 2);
+
+    const Door doors[] = {Door::Closed, Door::Open, Door::Locked, Door::Alarm};
+    const Input inputs[] = {Input::Push, Input::Key, Input::Force};
+    const int codes[] = {0, 1234, 9999, 5};
+    bool door_ok = true;
+    for (Door s : doors) {
+        for (Input in : inputs) {
+            for (int code : codes) {
+                DoorData a = {code, 0, 0}, b = a, c = a;
+                Door next_a = door_switch(s, in, a);
+                Door next_b = DoorFsm::dispatch(s, in, b);
+                Door next_c = DoorFsm::dispatch_chained(s, in, c);
+                door_ok &= next_a == next_b && a.opened == b.opened && a.alarms == b.alarms;
+                door_ok &= next_a == next_c && a.opened == c.opened && a.alarms == c.alarms;
+            }
+        }
+    }
+    run_check(3, "Scattered enum values, guard chain and actions match a switch (both tables)", door_ok);
+    run_check(4, "Three guards in a row give three options per pair", DoorFsm::options_per_pair == 3);
+
+    printf("\n%s\n", total_failures == 0 ? "RESULT: ALL TESTS PASSED" : "RESULT: TESTS FAILED");
+    return total_failures == 0 ? 0 : 1;
+}
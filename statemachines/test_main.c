@@ -1,6 +1,8 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h> // For usleep (simulation timing)
 #include "fsm_logic.h"
+#include "fsm_table.h"
 
 // --- Visual Feedback Helpers ---
 
@@ -25,6 +27,119 @@ void render_machine_ui(CoffeeMachine* m) {
     fflush(stdout); 
 }
 
+// --- Table Engine Checks ---
+
+static uint32_t rng_state = 2463534242u;
+
+static uint32_t xorshift32(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Random machines and events through FSM_Update() and through the fleet engine
+static bool fleet_matches_fsm_update(void) {
+    enum { MACHINES = 1000, TICKS = 64, BATCH = 5000 };
+    CoffeeMachine* aos = malloc(MACHINES * sizeof(CoffeeMachine));
+    CoffeeMachine* back = malloc(MACHINES * sizeof(CoffeeMachine));
+    uint8_t* events = malloc(MACHINES);
+    uint32_t* targets = malloc(BATCH * sizeof(uint32_t));
+    FsmTable table;
+    FsmFleet fleet;
+    bool ok = aos && back && events && targets && FSM_Compile(&table);
+    if (ok && !fsm_fleet_init(&fleet, MACHINES, COFFEE_FIELD_COUNT, STATE_IDLE)) {
+        fsm_table_free(&table);
+        ok = false;
+    }
+    if (!ok) {
+        free(aos); free(back); free(events); free(targets);
+        return false;
+    }
+
+    for (size_t i = 0; i < MACHINES; i++) {
+        aos[i] = (CoffeeMachine){(State_t)(xorshift32() % 4), (int)(xorshift32() % 21), 20};
+    }
+    FSM_StoreFleet(&fleet, aos, MACHINES);
+
+    // One event per machine per tick
+    for (int t = 0; t < TICKS; t++) {
+        for (size_t i = 0; i < MACHINES; i++) {
+            events[i] = (uint8_t)(xorshift32() % 4);
+            FSM_Update(&aos[i], (Event_t)events[i]);
+        }
+        fsm_step(&table, &fleet, events);
+    }
+    // Scattered events, several per machine
+    for (size_t k = 0; k < BATCH; k++) {
+        targets[k] = xorshift32() % MACHINES;
+        events[k % MACHINES] = (uint8_t)(xorshift32() % 4);
+    }
+    for (size_t start = 0; start < BATCH; start += MACHINES) {
+        for (size_t k = 0; k < MACHINES; k++) FSM_Update(&aos[targets[start + k]], (Event_t)events[k]);
+        fsm_dispatch(&table, &fleet, targets + start, events, MACHINES);
+    }
+
+    FSM_LoadFleet(&fleet, back, MACHINES);
+    for (size_t i = 0; i < MACHINES; i++) {
+        ok &= back[i].currentState == aos[i].currentState && back[i].waterLevel == aos[i].waterLevel;
+    }
+    fsm_fleet_free(&fleet);
+    fsm_table_free(&table);
+    free(aos); free(back); free(events); free(targets);
+    return ok;
+}
+
+static void count_fired(FsmFleet* fleet, size_t i) {
+    fleet->field[1][i]++;
+}
+
+// A three-way guard chain (spills into two extra cells), edge values and an action
+static bool guard_chain_works(void) {
+    const FsmRule rules[] = {
+        {0, 0, FSM_LT, 0, 0,         1, 1},     // x < 0        -> 1, count
+        {0, 0, FSM_EQ, 0, 0,         2, 0},     // x == 0       -> 2
+        {0, 0, FSM_GE, 0, INT32_MAX, 3, 0},     // x == MAX     -> 3, else stay
+        {1, 0, FSM_NE, 0, 5,         0, 1},     // x != 5       -> 0, count
+        {2, 0, FSM_GT, 0, INT32_MAX, 3, 0},     // Never holds
+    };
+    const FsmAction actions[] = {count_fired};
+    const int32_t x[] = {INT32_MIN, -1, 0, 1, INT32_MAX, 5};
+    const uint8_t expected[][2] = {{1, 0}, {1, 0}, {2, 2}, {0, 0}, {3, 3}, {1, 1}};
+    enum { N = sizeof(x) / sizeof(x[0]) };
+
+    FsmTable table;
+    FsmFleet fleet;
+    if (!fsm_compile(&table, rules, 5, 4, 1, actions, 1)) return false;
+    if (!fsm_fleet_init(&fleet, N, 2, 0)) {
+        fsm_table_free(&table);
+        return false;
+    }
+    uint8_t events[N] = {0};
+    for (size_t i = 0; i < N; i++) fleet.field[0][i] = x[i];
+    fleet.state[N - 1] = 1;                     // x == 5 in state 1: stays
+
+    bool ok = table.nfields == 1 && table.ncells == 4 + 2;
+    for (int t = 0; t < 2; t++) {
+        fsm_step(&table, &fleet, events);
+        for (size_t i = 0; i < N; i++) ok &= fleet.state[i] == expected[i][t];
+    }
+    // Fired once (x < 0 into 1) and once more (1 -> 0 with x != 5)
+    ok &= fleet.field[1][0] == 2 && fleet.field[1][1] == 2 && fleet.field[1][5] == 0;
+
+    // A rule after an unguarded one for the same pair can never fire
+    const FsmRule shadowed[] = {
+        {0, 0, FSM_ALWAYS, 0, 0, 1, 0},
+        {0, 0, FSM_LT,     0, 0, 2, 0},
+    };
+    FsmTable rejected;
+    ok &= !fsm_compile(&rejected, shadowed, 2, 3, 1, NULL, 0);
+
+    fsm_fleet_free(&fleet);
+    fsm_table_free(&table);
+    return ok;
+}
+
 // --- The Simulation ---
 
 int main() {
@@ -61,7 +176,16 @@ int main() {
     printf("\n\n> Dispenser: Brew Complete.\n");
     FSM_Update(&myMachine, EVENT_BREW_COMPLETE);
     render_machine_ui(&myMachine);
-    printf("\n\n--- TEST SUCCESSFUL ---\n");
+
+    // 5. The fleet engine must agree with FSM_Update()
+    printf("\n\n> Table engine: fleet vs FSM_Update... ");
+    bool fleet_ok = fleet_matches_fsm_update() && guard_chain_works();
+    printf("%s\n", fleet_ok ? "OK" : "MISMATCH");
+    if (!fleet_ok) {
+        printf("\n--- TEST FAILED ---\n");
+        return 1;
+    }
+    printf("\n--- TEST SUCCESSFUL ---\n");
 
     return 0;
 }
\ No newline at end of file